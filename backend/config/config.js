@@ -69,7 +69,39 @@ const config = {
         // Maximum concurrent video conversions
         maxConcurrentConversions: parseInt(process.env.THERMAL_MAX_CONVERSIONS || '2'),
         // Cache timeout (24 hours by default)
-        cacheTimeoutHours: parseInt(process.env.THERMAL_CACHE_TIMEOUT_HOURS || '24')
+        cacheTimeoutHours: parseInt(process.env.THERMAL_CACHE_TIMEOUT_HOURS || '24'),
+        // Per-experiment analysis files (frame statistics, thumbnail sheets,
+        // temperature volumes); kept apart from cacheDir, which is served
+        // over HTTP. Files unused for dataCacheTimeoutHours are deleted, and
+        // the least recently used ones beyond the size limit (checked at
+        // startup and after each build)
+        dataCacheDir: path.join(__dirname, '..', 'cache', 'thermal-data'),
+        dataCacheTimeoutHours: parseInt(process.env.THERMAL_DATA_CACHE_TIMEOUT_HOURS || '168'),
+        dataCacheMaxSizeMB: parseInt(process.env.THERMAL_DATA_CACHE_MAX_SIZE_MB || '10240'),
+        // Precomputed temperature volume (opt-in): build in the background when
+        // an experiment is first parsed; tile edge length of the compression
+        temperatureVolume: {
+            autoBuild: process.env.THERMAL_VOLUME_AUTO_BUILD === 'true',
+            tileSize: parseInt(process.env.THERMAL_VOLUME_TILE_SIZE || '16')
+        }
+    },
+
+    // Binary (.bin) oscilloscope files
+    binary: {
+        // Files at least this large are opened for streaming (decoded per
+        // request from a memory-mapped file) instead of being loaded whole;
+        // needs the native binary parser
+        streamingThresholdMB: parseInt(process.env.BINARY_STREAMING_THRESHOLD_MB || '1024'),
+        // Decoded column cache per experiment (raw and calculated channels,
+        // min/max pyramid) for files of at least streamingThresholdMB, written
+        // by the native parser after the first parse and reopened
+        // memory-mapped instead of re-parsing
+        persistentCache: process.env.BINARY_PERSISTENT_CACHE !== 'false',
+        cacheDir: path.join(__dirname, '..', 'cache', 'binary'),
+        // Column caches unused for this long are deleted, and the least
+        // recently used ones beyond the size limit (checked after each write)
+        cacheTimeoutHours: parseInt(process.env.BINARY_CACHE_TIMEOUT_HOURS || '168'),
+        cacheMaxSizeMB: parseInt(process.env.BINARY_CACHE_MAX_SIZE_MB || '20480')
     },
 
     // NEW: Electron-specific configuration with UNC support
@@ -221,6 +253,7 @@ function logEnvironmentInfo() {
     console.log(`   Database: ${config.database.fullPath}`);
     console.log(`   Experiments: ${config.experiments.rootPath}`);
     console.log(`   Thermal cache: ${config.thermal.cacheDir}`);
+    console.log(`   Thermal data cache: ${config.thermal.dataCacheDir}`);
     
     if (isElectron) {
         console.log('📱 Electron Configuration:');
@@ -0,0 +1,41 @@
+{
+  "targets": [
+    {
+      "target_name": "binary_native",
+      "sources": [
+        "src/binding.cpp"
+      ],
+      "include_dirs": [
+        "<!@(node -p \"require('node-addon-api').include\")",
+        "../common"
+      ],
+      "dependencies": [
+        "<!(node -p \"require('node-addon-api').gyp\")"
+      ],
+      "cflags!": [ "-fno-exceptions" ],
+      "cflags_cc!": [ "-fno-exceptions" ],
+      "cflags_cc": [ "-std=c++17", "-O3" ],
+      "msvs_settings": {
+        "VCCLCompilerTool": {
+          "ExceptionHandling": 1,
+          "Optimization": 2,
+          "AdditionalOptions": [
+            "/std:c++17",
+            "/EHsc"
+          ]
+        }
+      },
+      "defines": [
+        "NAPI_DISABLE_CPP_EXCEPTIONS"
+      ],
+      "conditions": [
+        ["OS=='win'", {
+          "msvs_version": "2022",
+          "defines": [
+            "_WIN32_WINNT=0x0600"
+          ]
+        }]
+      ]
+    }
+  ]
+}
@@ -0,0 +1,295 @@
+// Persistent column cache of a .bin file.
+//
+// Layout (native endianness, arrays 64-byte aligned):
+//   Header
+//   uint8 metadata[header.metadataSize]   the source bytes before the samples
+//                                         (header string and metadata section)
+//   Column directory[header.columns]      at header.directoryOffset
+//   per column: float values[points], min[pyramid entries], max[pyramid entries],
+//               overview[overviewCount]
+//
+// Columns 0-7 are the raw channels, 8-14 the calculated channels, decoded to
+// physical values. The pyramid is a BinPyramid; the overview is every
+// overviewStep-th value, the strided sample the stream processor takes at
+// open. The source size and modification time tie the cache to its .bin.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bin_calc.h"
+#include "bin_parser.h"
+#include "bin_pyramid.h"
+#include "mapped_file.h"
+
+constexpr int BIN_CACHE_COLUMNS = BIN_CHANNELS + BIN_CALC_CHANNELS;
+
+class BinCache {
+public:
+    struct Header {
+        char magic[4];
+        uint32_t columns;
+        uint32_t pyramidBase;
+        uint32_t overviewPoints;
+        uint64_t sourceSize;
+        int64_t sourceMtime;
+        uint64_t metadataSize;
+        uint64_t directoryOffset;
+    };
+    static_assert(sizeof(Header) == 48, "BinCache::Header must not be padded");
+
+    struct Column {
+        uint64_t points;
+        uint64_t valuesOffset;
+        uint64_t pyramidOffset;
+        uint64_t overviewOffset;
+        uint64_t overviewStep;
+        uint64_t overviewCount;
+        double min;
+        double max;
+        double mean;
+        double rms;
+    };
+    static_assert(sizeof(Column) == 80, "BinCache::Column must not be padded");
+
+    static constexpr const char* MAGIC = "BCC1";
+    // Matches OVERVIEW_POINTS of BinaryStreamProcessor.js
+    static constexpr uint64_t OVERVIEW_POINTS = 65536;
+
+    // Fills out[0, count) with values [start, start + count) of a column
+    using ColumnReader = std::function<void(int column, size_t start, size_t count, float* out)>;
+
+    // Size and modification time identifying a source file
+    static bool sourceStamp(const std::string& path, uint64_t& size, int64_t& mtime) {
+        std::error_code ec;
+        auto fsPath = std::filesystem::u8path(path);
+        size = static_cast<uint64_t>(std::filesystem::file_size(fsPath, ec));
+        if (ec) return false;
+        mtime = static_cast<int64_t>(std::filesystem::last_write_time(fsPath, ec).time_since_epoch().count());
+        return !ec;
+    }
+
+    // Write a cache for columns with the given summaries (whose counts are
+    // the column lengths), reading each column once in chunks. Goes through a
+    // temporary file (<path>.<random hex>.tmp, unique per write so concurrent
+    // writers never share one) so readers never see a partial cache. Returns
+    // the file size; throws std::runtime_error.
+    static uint64_t write(const std::string& path, const uint8_t* metadata, size_t metadataSize,
+                          uint64_t sourceSize, int64_t sourceMtime,
+                          const std::array<BinChannelSummary, BIN_CACHE_COLUMNS>& summaries,
+                          const ColumnReader& readColumn) {
+        const auto fsPath = std::filesystem::u8path(path);
+        const std::string tempName = temporaryPath(path);
+        const auto tempPath = std::filesystem::u8path(tempName);
+
+        Header header = {};
+        std::memcpy(header.magic, MAGIC, 4);
+        header.columns = BIN_CACHE_COLUMNS;
+        header.pyramidBase = static_cast<uint32_t>(BinPyramid::BASE);
+        header.overviewPoints = static_cast<uint32_t>(OVERVIEW_POINTS);
+        header.sourceSize = sourceSize;
+        header.sourceMtime = sourceMtime;
+        header.metadataSize = metadataSize;
+        header.directoryOffset = align(sizeof(Header) + metadataSize);
+
+        std::vector<Column> directory(BIN_CACHE_COLUMNS);
+        uint64_t end = header.directoryOffset + sizeof(Column) * BIN_CACHE_COLUMNS;
+        uint64_t offset = align(end);
+
+        try {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not create cache file: " + tempName);
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(metadata), static_cast<std::streamsize>(metadataSize));
+
+            std::vector<float> chunk(CHUNK_SAMPLES);
+            for (int c = 0; c < BIN_CACHE_COLUMNS; c++) {
+                Column& column = directory[c];
+                const BinChannelSummary& summary = summaries[c];
+                const size_t n = summary.count;
+                column.points = n;
+                column.min = summary.min;
+                column.max = summary.max;
+                column.mean = summary.mean;
+                column.rms = summary.rms;
+                column.overviewStep = std::max<uint64_t>(1, (n + OVERVIEW_POINTS - 1) / OVERVIEW_POINTS);
+                column.overviewCount = n > 0 ? (n - 1) / column.overviewStep + 1 : 0;
+
+                BinPyramid::Builder pyramid(n);
+                std::vector<float> overview;
+                overview.reserve(column.overviewCount);
+
+                column.valuesOffset = offset;
+                file.seekp(static_cast<std::streamoff>(offset));
+                for (size_t start = 0; start < n; start += chunk.size()) {
+                    size_t count = std::min(chunk.size(), n - start);
+                    readColumn(c, start, count, chunk.data());
+                    file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(count * sizeof(float)));
+                    pyramid.append(chunk.data(), count);
+                    for (size_t k = (start + column.overviewStep - 1) / column.overviewStep * column.overviewStep;
+                         k < start + count; k += column.overviewStep) {
+                        overview.push_back(chunk[k - start]);
+                    }
+                }
+                pyramid.finish();
+                offset = align(offset + n * sizeof(float));
+
+                const size_t entries = pyramid.min().size();
+                column.pyramidOffset = offset;
+                file.seekp(static_cast<std::streamoff>(offset));
+                file.write(reinterpret_cast<const char*>(pyramid.min().data()), static_cast<std::streamsize>(entries * sizeof(float)));
+                file.write(reinterpret_cast<const char*>(pyramid.max().data()), static_cast<std::streamsize>(entries * sizeof(float)));
+                offset = align(offset + 2 * entries * sizeof(float));
+
+                column.overviewOffset = offset;
+                file.seekp(static_cast<std::streamoff>(offset));
+                file.write(reinterpret_cast<const char*>(overview.data()), static_cast<std::streamsize>(overview.size() * sizeof(float)));
+                end = offset + overview.size() * sizeof(float);
+                offset = align(end);
+            }
+
+            // Pad to the aligned end so every offset lies in the file
+            const std::vector<char> padding(static_cast<size_t>(offset - end), 0);
+            file.seekp(static_cast<std::streamoff>(end));
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            file.seekp(static_cast<std::streamoff>(header.directoryOffset));
+            file.write(reinterpret_cast<const char*>(directory.data()), sizeof(Column) * BIN_CACHE_COLUMNS);
+            file.close();
+            if (!file) {
+                throw std::runtime_error("Could not write cache file: " + tempName);
+            }
+
+            std::filesystem::rename(tempPath, fsPath);
+            return offset;
+
+        } catch (...) {
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            throw;
+        }
+    }
+
+    // Map a cache file and check it belongs to the given source. Returns
+    // false if it is missing, truncated or stale.
+    bool open(const std::string& path, uint64_t sourceSize, int64_t sourceMtime) {
+        close();
+        if (!file.open(path) || file.size() < sizeof(Header)) {
+            close();
+            return false;
+        }
+        std::memcpy(&header, file.data(), sizeof(Header));
+
+        bool matches = std::memcmp(header.magic, MAGIC, 4) == 0 &&
+            header.columns == BIN_CACHE_COLUMNS &&
+            header.pyramidBase == BinPyramid::BASE &&
+            header.overviewPoints == OVERVIEW_POINTS &&
+            header.sourceSize == sourceSize && header.sourceMtime == sourceMtime &&
+            header.metadataSize <= file.size() - sizeof(Header) &&
+            header.directoryOffset <= file.size() &&
+            (file.size() - header.directoryOffset) / sizeof(Column) >= BIN_CACHE_COLUMNS;
+        if (!matches) {
+            close();
+            return false;
+        }
+
+        directory.resize(BIN_CACHE_COLUMNS);
+        std::memcpy(directory.data(), file.data() + header.directoryOffset, sizeof(Column) * BIN_CACHE_COLUMNS);
+        for (const Column& column : directory) {
+            const uint64_t entries = BinPyramid::Layout(static_cast<size_t>(column.points)).entries();
+            if (!fits(column.valuesOffset, column.points) || !fits(column.pyramidOffset, 2 * entries) ||
+                column.overviewStep == 0 || !fits(column.overviewOffset, column.overviewCount)) {
+                close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void close() {
+        file.close();
+        directory.clear();
+    }
+
+    bool isOpen() const { return file.isOpen(); }
+    size_t byteSize() const { return file.size(); }
+    const uint8_t* metadata() const { return file.data() + sizeof(Header); }
+    size_t metadataSize() const { return static_cast<size_t>(header.metadataSize); }
+    size_t points(int column) const { return static_cast<size_t>(directory[column].points); }
+
+    BinChannelSummary summary(int column) const {
+        const Column& entry = directory[column];
+        BinChannelSummary result;
+        result.count = static_cast<size_t>(entry.points);
+        result.min = static_cast<float>(entry.min);
+        result.max = static_cast<float>(entry.max);
+        result.mean = entry.mean;
+        result.rms = entry.rms;
+        return result;
+    }
+
+    // Copy values of a column; the range has been checked by the caller. The
+    // strided read from 0 at the overview step comes from the stored
+    // overview, which avoids touching a page per sample.
+    void read(int column, size_t start, size_t count, size_t step, float* out) const {
+        const Column& entry = directory[column];
+        if (start == 0 && step == entry.overviewStep && count <= entry.overviewCount) {
+            std::memcpy(out, array(entry.overviewOffset), count * sizeof(float));
+            return;
+        }
+        const float* values = array(entry.valuesOffset) + start;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = values[i * step];
+        }
+    }
+
+    size_t envelope(int column, size_t start, size_t count, size_t buckets,
+                    float* minOut, float* maxOut, double* minIndexOut, double* maxIndexOut) const {
+        const Column& entry = directory[column];
+        const size_t entries = BinPyramid::Layout(static_cast<size_t>(entry.points)).entries();
+        const float* minimum = array(entry.pyramidOffset);
+        BinPyramid pyramid(array(entry.valuesOffset), static_cast<size_t>(entry.points), minimum, minimum + entries);
+        return pyramid.envelope(start, count, buckets, minOut, maxOut, minIndexOut, maxIndexOut);
+    }
+
+private:
+    static constexpr size_t CHUNK_SAMPLES = 1 << 20;
+
+    static uint64_t align(uint64_t offset) {
+        return (offset + 63) & ~static_cast<uint64_t>(63);
+    }
+
+    // <path>.<16 random hex digits>.tmp
+    static std::string temporaryPath(const std::string& path) {
+        std::random_device device;
+        const uint64_t token = (static_cast<uint64_t>(device()) << 32) ^ device();
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(token));
+        return path + "." + hex + ".tmp";
+    }
+
+    bool fits(uint64_t offset, uint64_t floats) const {
+        return offset % alignof(float) == 0 && offset <= file.size() &&
+            floats <= (file.size() - offset) / sizeof(float);
+    }
+
+    const float* array(uint64_t offset) const {
+        return reinterpret_cast<const float*>(file.data() + offset);
+    }
+
+    MappedFile file;
+    Header header = {};
+    std::vector<Column> directory;
+};
@@ -0,0 +1,139 @@
+// Calculated engineering channels of the oscilloscope recordings
+// (UL3L1*, IL2GR1*, IL2GR2*, I_DC_GR1*, I_DC_GR2*, U_DC*, F_Schlitten*).
+//
+// Arithmetic mirrors BinaryReader.computeCalculatedValues: double precision
+// on the float channel values, rounded to float once per result, so native
+// and JS output are identical.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "bin_parser.h"
+
+constexpr int BIN_CALC_CHANNELS = 7;
+
+// Raw source channels of each calculated channel
+constexpr int BIN_CALC_SOURCES[BIN_CALC_CHANNELS][2] = {
+    { 0, 1 }, { 2, 3 }, { 4, 5 },   // UL3L1*, IL2GR1*, IL2GR2*: -a - b
+    { 2, 3 }, { 4, 5 },             // I_DC_GR1*, I_DC_GR2*: 35 * (|a| + |b| + |-a - b|)
+    { 0, 1 },                       // U_DC*: (|a| + |b| + |-a - b|) / 35
+    { 6, 7 }                        // F_Schlitten*: a * 6.2832 - b * 5.0108
+};
+
+class BinCalc {
+public:
+    static constexpr double TRAFO_STROM_MULTIPLIER = 35.0;
+    static constexpr double FORCE_COEFF_1 = 6.2832;
+    static constexpr double FORCE_COEFF_2 = 5.0108;
+
+    // One calculated value from its two source samples
+    static float value(int calcIndex, float a, float b) {
+        switch (calcIndex) {
+            case 0: case 1: case 2:
+                return differential(a, b);
+            case 3: case 4:
+                return static_cast<float>(TRAFO_STROM_MULTIPLIER * magnitudeSum(a, b));
+            case 5:
+                return static_cast<float>(magnitudeSum(a, b) / TRAFO_STROM_MULTIPLIER);
+            default:
+                return static_cast<float>(static_cast<double>(a) * FORCE_COEFF_1 - static_cast<double>(b) * FORCE_COEFF_2);
+        }
+    }
+
+    // All seven calculated values of one acquisition step
+    static void record(const float* raw, float* out) {
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            out[c] = value(c, raw[BIN_CALC_SOURCES[c][0]], raw[BIN_CALC_SOURCES[c][1]]);
+        }
+    }
+
+    // Compute every calculated channel in one pass over the raw channels.
+    // Each output has the samples where both sources are present (the shorter
+    // source's count under mixed downsampling), as BinSource::calculatedPoints.
+    static void computeAll(const std::array<BinChannel, BIN_CHANNELS>& channels,
+                           std::array<std::vector<float>, BIN_CALC_CHANNELS>& out) {
+        std::array<const float*, BIN_CHANNELS> in;
+        size_t common = std::numeric_limits<size_t>::max();
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            in[ch] = channels[ch].values.data();
+            common = std::min(common, channels[ch].values.size());
+        }
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            out[c].resize(std::min(channels[BIN_CALC_SOURCES[c][0]].values.size(),
+                                   channels[BIN_CALC_SOURCES[c][1]].values.size()));
+        }
+
+        size_t i = 0;
+
+#ifdef BIN_PARSER_SSE2
+        // Two samples per step in double lanes; reads each raw channel once
+        // for all seven outputs
+        const __m128d signMask = _mm_set1_pd(-0.0);
+        const __m128d trafo = _mm_set1_pd(TRAFO_STROM_MULTIPLIER);
+        const __m128d force1 = _mm_set1_pd(FORCE_COEFF_1);
+        const __m128d force2 = _mm_set1_pd(FORCE_COEFF_2);
+
+        auto load = [&](int ch) {
+            return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in[ch] + i))));
+        };
+        auto store = [&](int c, __m128d value) {
+            _mm_storel_pi(reinterpret_cast<__m64*>(out[c].data() + i), _mm_cvtpd_ps(value));
+        };
+        auto abs = [&](__m128d value) { return _mm_andnot_pd(signMask, value); };
+        // -a - b, rounded to float and back like the stored JS differential
+        auto differential = [&](__m128d a, __m128d b) {
+            return _mm_cvtps_pd(_mm_cvtpd_ps(_mm_sub_pd(_mm_xor_pd(a, signMask), b)));
+        };
+        auto magnitudeSum = [&](__m128d a, __m128d b, __m128d diff) {
+            return _mm_add_pd(_mm_add_pd(abs(a), abs(b)), abs(diff));
+        };
+
+        for (; i + 2 <= common; i += 2) {
+            __m128d c0 = load(0), c1 = load(1), c2 = load(2), c3 = load(3);
+            __m128d c4 = load(4), c5 = load(5), c6 = load(6), c7 = load(7);
+
+            __m128d d01 = differential(c0, c1);
+            __m128d d23 = differential(c2, c3);
+            __m128d d45 = differential(c4, c5);
+
+            store(0, d01);
+            store(1, d23);
+            store(2, d45);
+            store(3, _mm_mul_pd(trafo, magnitudeSum(c2, c3, d23)));
+            store(4, _mm_mul_pd(trafo, magnitudeSum(c4, c5, d45)));
+            store(5, _mm_div_pd(magnitudeSum(c0, c1, d01), trafo));
+            store(6, _mm_sub_pd(_mm_mul_pd(c6, force1), _mm_mul_pd(c7, force2)));
+        }
+#endif
+
+        for (; i < common; i++) {
+            float raw[BIN_CHANNELS];
+            for (int ch = 0; ch < BIN_CHANNELS; ch++) raw[ch] = in[ch][i];
+            float values[BIN_CALC_CHANNELS];
+            record(raw, values);
+            for (int c = 0; c < BIN_CALC_CHANNELS; c++) out[c][i] = values[c];
+        }
+
+        // Tails beyond the shortest raw channel (only with mixed downsampling)
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            const std::vector<float>& a = channels[BIN_CALC_SOURCES[c][0]].values;
+            const std::vector<float>& b = channels[BIN_CALC_SOURCES[c][1]].values;
+            for (size_t k = common; k < out[c].size(); k++) {
+                out[c][k] = value(c, a[k], b[k]);
+            }
+        }
+    }
+
+private:
+    static float differential(float a, float b) {
+        return static_cast<float>(-static_cast<double>(a) - static_cast<double>(b));
+    }
+
+    static double magnitudeSum(float a, float b) {
+        return std::abs(static_cast<double>(a)) + std::abs(static_cast<double>(b)) + std::abs(static_cast<double>(differential(a, b)));
+    }
+};
@@ -0,0 +1,305 @@
+// Parser for the oscilloscope .bin files written by the C# acquisition tool.
+// Node-free so it can be used (and benchmarked) outside the addon.
+//
+// File layout (little-endian, strings are C# BinaryReader strings):
+//   string header
+//   uint32 bufferSize, int64 startTime (DateTime.ToBinary), int16 maxAdcValue
+//   int32 channelRanges[8], int16 channelScaling[8], uint32 samplingInterval (ns)
+//   int32 downsampling[8], string units[8], string labels[8]
+//   int16 samples: for j in [0, bufferSize), for each channel with
+//   j % downsampling[channel] == 0, one sample of that channel
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BIN_PARSER_SSE2 1
+#endif
+
+constexpr int BIN_CHANNELS = 8;
+
+struct BinMetadata {
+    std::string header;
+    uint32_t bufferSize = 0;
+    int64_t startTimeBinary = 0;
+    int16_t maxAdcValue = 0;
+    std::array<int32_t, BIN_CHANNELS> channelRanges{};
+    std::array<int16_t, BIN_CHANNELS> channelScaling{};
+    uint32_t samplingInterval = 0;
+    std::array<int32_t, BIN_CHANNELS> downsampling{};
+    std::array<std::string, BIN_CHANNELS> units;
+    std::array<std::string, BIN_CHANNELS> labels;
+    size_t dataOffset = 0;               // first byte of the interleaved samples
+};
+
+// Samples are uniformly spaced from the start of the recording, so the time
+// axis is implicit: sample i is at i * channelTimeStep(meta, channel) seconds.
+struct BinChannel {
+    std::vector<float> values;           // physical values
+};
+
+struct BinChannelSummary {
+    float min = 0.0f;
+    float max = 0.0f;
+    double mean = 0.0;
+    double rms = 0.0;
+    size_t count = 0;
+};
+
+// Running extremes and moments of physical values (NaN ignored in the extremes)
+struct BinSummaryAccumulator {
+    float lo = std::numeric_limits<float>::infinity();
+    float hi = -std::numeric_limits<float>::infinity();
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    size_t count = 0;
+
+    void add(float value) {
+        lo = std::min(lo, value);
+        hi = std::max(hi, value);
+        sum += value;
+        sumSquares += static_cast<double>(value) * value;
+        count++;
+    }
+
+    BinChannelSummary summary() const {
+        BinChannelSummary result;
+        result.count = count;
+        if (count == 0) return result;
+        result.min = lo;
+        result.max = hi;
+        result.mean = sum / count;
+        result.rms = std::sqrt(sumSquares / count);
+        return result;
+    }
+};
+
+class BinParser {
+public:
+    // Header and metadata section. Throws std::runtime_error on malformed input.
+    static BinMetadata parseMetadata(const uint8_t* data, size_t size) {
+        Cursor cursor(data, size);
+        BinMetadata meta;
+
+        meta.header = cursor.readString("header");
+        meta.bufferSize = cursor.read<uint32_t>("buffer size");
+        meta.startTimeBinary = cursor.read<int64_t>("start time");
+        meta.maxAdcValue = cursor.read<int16_t>("max ADC value");
+        for (int32_t& range : meta.channelRanges) range = cursor.read<int32_t>("channel ranges");
+        for (int16_t& scaling : meta.channelScaling) scaling = cursor.read<int16_t>("channel scaling");
+        meta.samplingInterval = cursor.read<uint32_t>("sampling interval");
+        for (int32_t& factor : meta.downsampling) factor = cursor.read<int32_t>("downsampling");
+        for (std::string& unit : meta.units) unit = cursor.readString("units");
+        for (std::string& label : meta.labels) label = cursor.readString("labels");
+        meta.dataOffset = cursor.offset();
+
+        for (int32_t factor : meta.downsampling) {
+            if (factor < 1) {
+                throw std::runtime_error("Invalid downsampling factor " + std::to_string(factor));
+            }
+        }
+        return meta;
+    }
+
+    // Physical units per ADC count, matching convertAdcToPhysical in utils.js:
+    // (raw / maxAdc) * range[V] * 1000 (mV) * scaling / 1000
+    static double channelScale(const BinMetadata& meta, int channel) {
+        return voltageRange(meta.channelRanges[channel]) * meta.channelScaling[channel] / meta.maxAdcValue;
+    }
+
+    // Samples each channel holds: floor(bufferSize / downsampling)
+    static size_t channelCapacity(const BinMetadata& meta, int channel) {
+        return meta.bufferSize / static_cast<uint32_t>(meta.downsampling[channel]);
+    }
+
+    // Seconds between consecutive samples of a channel
+    static double channelTimeStep(const BinMetadata& meta, int channel) {
+        return static_cast<double>(meta.samplingInterval) * meta.downsampling[channel] / 1e9;
+    }
+
+    // De-interleave and scale all samples into per-channel arrays. A file
+    // that ends early yields shorter channels, like the JS reader.
+    static void readChannels(const uint8_t* data, size_t size, const BinMetadata& meta,
+                             std::array<BinChannel, BIN_CHANNELS>& channels) {
+        const uint8_t* samples = data + meta.dataOffset;
+        const size_t available = (size - meta.dataOffset) / 2;
+
+        std::array<double, BIN_CHANNELS> scale;
+        std::array<size_t, BIN_CHANNELS> count{};
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            scale[ch] = channelScale(meta, ch);
+            channels[ch].values.resize(channelCapacity(meta, ch));
+        }
+
+        size_t consumed = 0;
+        uint32_t j = 0;
+
+        // Common case: one downsampling factor for all channels, so every
+        // sampled j holds a complete 8-channel record
+        bool uniform = true;
+        for (int32_t factor : meta.downsampling) uniform = uniform && factor == meta.downsampling[0];
+
+        if (uniform) {
+            size_t records = std::min(channels[0].values.size(), available / BIN_CHANNELS);
+            std::array<float*, BIN_CHANNELS> out;
+            for (int ch = 0; ch < BIN_CHANNELS; ch++) out[ch] = channels[ch].values.data();
+
+            deinterleaveRecords(samples, records, scale, out);
+            consumed = records * BIN_CHANNELS;
+            count.fill(records);
+            j = static_cast<uint32_t>(records * static_cast<uint32_t>(meta.downsampling[0]));
+        }
+
+        // General path (mixed factors, and the tail of the uniform case).
+        // Countdowns replace the per-sample modulo of the JS reader.
+        std::array<uint32_t, BIN_CHANNELS> countdown;
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            uint32_t factor = static_cast<uint32_t>(meta.downsampling[ch]);
+            countdown[ch] = (factor - j % factor) % factor;
+        }
+
+        for (; j < meta.bufferSize; j++) {
+            for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+                if (countdown[ch] > 0) {
+                    countdown[ch]--;
+                    continue;
+                }
+                if (consumed >= available) {
+                    j = meta.bufferSize;  // file ends early
+                    break;
+                }
+
+                int16_t raw;
+                std::memcpy(&raw, samples + consumed * 2, sizeof(raw));
+                consumed++;
+                if (count[ch] < channels[ch].values.size()) {
+                    channels[ch].values[count[ch]++] = static_cast<float>(raw * scale[ch]);
+                }
+                countdown[ch] = static_cast<uint32_t>(meta.downsampling[ch]) - 1;
+            }
+        }
+
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            BinChannel& channel = channels[ch];
+            channel.values.resize(count[ch]);
+            channel.values.shrink_to_fit();
+        }
+    }
+
+private:
+    // VOLTAGE_RANGES in utils.js; unknown codes fall back to 5 V
+    static double voltageRange(int32_t code) {
+        static const double ranges[] = { 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0 };
+        return code >= 0 && code < static_cast<int32_t>(sizeof(ranges) / sizeof(ranges[0])) ? ranges[code] : 5.0;
+    }
+
+    // Split `records` 8-channel int16 records into the channel arrays, scaled.
+    // The scale is applied in double precision like the JS reader, then rounded
+    // to float. SSE2 handles four records per step with a 4x4 transpose.
+    static void deinterleaveRecords(const uint8_t* samples, size_t records, const std::array<double, BIN_CHANNELS>& scale,
+                                    const std::array<float*, BIN_CHANNELS>& out) {
+        size_t r = 0;
+
+#ifdef BIN_PARSER_SSE2
+        __m128d scales[4];
+        for (int i = 0; i < 4; i++) {
+            scales[i] = _mm_set_pd(scale[i * 2 + 1], scale[i * 2]);
+        }
+
+        // One record (8 x int16) to two float vectors: channels 0-3 and 4-7
+        auto convert = [&](const uint8_t* record, __m128& low, __m128& high) {
+            __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(record));
+            __m128i lo32 = _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);
+            __m128i hi32 = _mm_srai_epi32(_mm_unpackhi_epi16(raw, raw), 16);
+
+            __m128 p0 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(lo32), scales[0]));
+            __m128 p1 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(lo32, 0x0E)), scales[1]));
+            __m128 p2 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(hi32), scales[2]));
+            __m128 p3 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(hi32, 0x0E)), scales[3]));
+            low = _mm_movelh_ps(p0, p1);
+            high = _mm_movelh_ps(p2, p3);
+        };
+
+        for (; r + 4 <= records; r += 4) {
+            const uint8_t* block = samples + r * BIN_CHANNELS * 2;
+            __m128 lo[4], hi[4];
+            for (int i = 0; i < 4; i++) {
+                convert(block + i * BIN_CHANNELS * 2, lo[i], hi[i]);
+            }
+
+            // Rows are records, columns channels; transpose to channel-major
+            _MM_TRANSPOSE4_PS(lo[0], lo[1], lo[2], lo[3]);
+            _MM_TRANSPOSE4_PS(hi[0], hi[1], hi[2], hi[3]);
+            for (int ch = 0; ch < 4; ch++) {
+                _mm_storeu_ps(out[ch] + r, lo[ch]);
+                _mm_storeu_ps(out[ch + 4] + r, hi[ch]);
+            }
+        }
+#endif
+
+        for (; r < records; r++) {
+            const uint8_t* record = samples + r * BIN_CHANNELS * 2;
+            for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+                int16_t raw;
+                std::memcpy(&raw, record + ch * 2, sizeof(raw));
+                out[ch][r] = static_cast<float>(raw * scale[ch]);
+            }
+        }
+    }
+
+    // Bounds-checked little-endian reader over the file bytes
+    class Cursor {
+    public:
+        Cursor(const uint8_t* data, size_t size) : data(data), size(size), pos(0) {}
+
+        size_t offset() const { return pos; }
+
+        template <typename T>
+        T read(const char* what) {
+            require(sizeof(T), what);
+            T value;
+            std::memcpy(&value, data + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        // C# BinaryReader.ReadString: 7-bit encoded length, then UTF-8 bytes
+        std::string readString(const char* what) {
+            uint32_t length = 0;
+            int shift = 0;
+            for (;;) {
+                uint8_t byte = read<uint8_t>(what);
+                length |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) break;
+                shift += 7;
+                if (shift > 28) {
+                    throw std::runtime_error(std::string("String length encoding too long in ") + what);
+                }
+            }
+            require(length, what);
+            std::string value(reinterpret_cast<const char*>(data + pos), length);
+            pos += length;
+            return value;
+        }
+
+    private:
+        void require(size_t bytes, const char* what) const {
+            if (bytes > size - pos) {
+                throw std::runtime_error(std::string("Unexpected end of file while reading ") + what);
+            }
+        }
+
+        const uint8_t* data;
+        size_t size;
+        size_t pos;
+    };
+};
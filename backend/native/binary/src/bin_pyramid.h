@@ -0,0 +1,180 @@
+// Multi-level min/max envelope of a float column.
+//
+// Level l (1..levels) holds the minimum and maximum of each block of BASE^l
+// consecutive samples (the last block of a level may be shorter); the levels
+// are stored one after another in a min and a max array. The extremes of any
+// range then come from O(BASE * levels) blocks instead of every sample, and
+// descending into the winning block recovers the sample index. NaN samples
+// are ignored.
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+class BinPyramid {
+public:
+    static constexpr size_t BASE = 16;
+
+    // Offsets and sizes of the levels for a column of n samples
+    class Layout {
+    public:
+        explicit Layout(size_t n) {
+            size_t size = n;
+            while (size > 1) {
+                size = (size + BASE - 1) / BASE;
+                offsets.push_back(total);
+                sizes.push_back(size);
+                total += size;
+            }
+        }
+
+        int levels() const { return static_cast<int>(sizes.size()); }
+        size_t offset(int level) const { return offsets[level - 1]; }
+        size_t size(int level) const { return sizes[level - 1]; }
+        // Entries of the min (and of the max) array
+        size_t entries() const { return total; }
+
+    private:
+        std::vector<size_t> offsets;
+        std::vector<size_t> sizes;
+        size_t total = 0;
+    };
+
+    // Builds the levels from the samples in order, in as many append()
+    // calls as convenient
+    class Builder {
+    public:
+        explicit Builder(size_t n)
+            : layout(n),
+              minimum(layout.entries(), std::numeric_limits<float>::infinity()),
+              maximum(layout.entries(), -std::numeric_limits<float>::infinity()) {}
+
+        void append(const float* values, size_t count) {
+            if (layout.levels() == 0) return;
+            for (size_t i = 0; i < count; i++) {
+                float value = values[i];
+                if (value < minimum[block]) minimum[block] = value;
+                if (value > maximum[block]) maximum[block] = value;
+                if (++inBlock == BASE) {
+                    inBlock = 0;
+                    block++;
+                }
+            }
+        }
+
+        // Reduce level 1 into the higher levels once all samples are in
+        void finish() {
+            for (int level = 2; level <= layout.levels(); level++) {
+                const size_t below = layout.offset(level - 1);
+                const size_t belowSize = layout.size(level - 1);
+                const size_t here = layout.offset(level);
+                for (size_t k = 0; k < belowSize; k++) {
+                    size_t target = here + k / BASE;
+                    if (minimum[below + k] < minimum[target]) minimum[target] = minimum[below + k];
+                    if (maximum[below + k] > maximum[target]) maximum[target] = maximum[below + k];
+                }
+            }
+        }
+
+        const std::vector<float>& min() const { return minimum; }
+        const std::vector<float>& max() const { return maximum; }
+
+        // Hand the finished levels over without copying
+        void release(std::vector<float>& min, std::vector<float>& max) {
+            min.swap(minimum);
+            max.swap(maximum);
+        }
+
+    private:
+        Layout layout;
+        std::vector<float> minimum;
+        std::vector<float> maximum;
+        size_t block = 0;
+        size_t inBlock = 0;
+    };
+
+    // View over a column and its built levels (not owned)
+    BinPyramid(const float* values, size_t n, const float* minimum, const float* maximum)
+        : values(values), n(n), layout(n), minimum(minimum), maximum(maximum) {}
+
+    // Split [start, start + count) into buckets of near-equal size and report
+    // the extremes of each with the index of their first occurrence, as a
+    // scan of every sample would. Returns the number of buckets filled.
+    size_t envelope(size_t start, size_t count, size_t buckets,
+                    float* minOut, float* maxOut, double* minIndexOut, double* maxIndexOut) const {
+        if (buckets > count) buckets = count;
+
+        for (size_t b = 0; b < buckets; b++) {
+            size_t first = start + count * b / buckets;
+            size_t last = start + count * (b + 1) / buckets;
+
+            Extreme lo(first), hi(first);
+            lo.value = std::numeric_limits<float>::infinity();
+            hi.value = -std::numeric_limits<float>::infinity();
+
+            // Largest aligned blocks that fit, left to right
+            size_t position = first;
+            while (position < last) {
+                int level = 0;
+                size_t width = 1;
+                while (level < layout.levels() && position % (width * BASE) == 0 && position + width * BASE <= last) {
+                    width *= BASE;
+                    level++;
+                }
+
+                size_t block = position / width;
+                float blockMin = level == 0 ? values[position] : minimum[layout.offset(level) + block];
+                float blockMax = level == 0 ? values[position] : maximum[layout.offset(level) + block];
+                if (blockMin < lo.value) lo = Extreme(blockMin, level, block);
+                if (blockMax > hi.value) hi = Extreme(blockMax, level, block);
+                position += width;
+            }
+
+            // A bucket of NaN samples only reports NaN at its first index
+            if (!(lo.value <= hi.value)) {
+                minOut[b] = maxOut[b] = std::numeric_limits<float>::quiet_NaN();
+                minIndexOut[b] = maxIndexOut[b] = static_cast<double>(first);
+                continue;
+            }
+
+            minOut[b] = lo.value;
+            maxOut[b] = hi.value;
+            minIndexOut[b] = static_cast<double>(locate(lo, minimum));
+            maxIndexOut[b] = static_cast<double>(locate(hi, maximum));
+        }
+        return buckets;
+    }
+
+private:
+    // An extreme value and the block (sample, at level 0) it was found in
+    struct Extreme {
+        explicit Extreme(size_t sample) : level(0), block(sample) {}
+        Extreme(float value, int level, size_t block) : value(value), level(level), block(block) {}
+        float value = 0.0f;
+        int level;
+        size_t block;
+    };
+
+    // Sample index of the first occurrence of the extreme within its block
+    size_t locate(const Extreme& extreme, const float* levelValues) const {
+        int level = extreme.level;
+        size_t block = extreme.block;
+        while (level > 0) {
+            size_t child = block * BASE;
+            size_t end = level == 1 ? n : layout.size(level - 1);
+            if (end > child + BASE) end = child + BASE;
+            const float* below = level == 1 ? values : levelValues + layout.offset(level - 1);
+            while (child + 1 < end && !(below[child] == extreme.value)) child++;
+            block = child;
+            level--;
+        }
+        return block;
+    }
+
+    const float* values;
+    size_t n;
+    Layout layout;
+    const float* minimum;
+    const float* maximum;
+};
@@ -0,0 +1,397 @@
+// Random access to the samples of a memory-mapped .bin file.
+//
+// The interleave layout is fully determined by the downsampling factors:
+// the samples written before acquisition step j are sum_c ceil(j / ds[c]),
+// so the position of any channel sample is computed directly instead of
+// scanning the stream. Only the pages of the requested range are touched;
+// there is no limit on the file size.
+//
+// With a valid BinCache attached, samples, envelopes and summaries come from
+// the decoded columns of the cache instead.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "bin_cache.h"
+#include "bin_calc.h"
+#include "bin_parser.h"
+#include "mapped_file.h"
+
+struct BinSummaries {
+    std::array<BinChannelSummary, BIN_CHANNELS> channels;
+    std::array<BinChannelSummary, BIN_CALC_CHANNELS> calculated;
+};
+
+class BinSource {
+public:
+    // Map path and index its layout, then attach the cache at cachePath if
+    // one is given and still matches the file. Throws std::runtime_error on
+    // failure (a missing or stale cache is not an error).
+    void open(const std::string& path, const std::string& cachePath = std::string()) {
+        sourcePath = path;
+        if (!file.open(path)) {
+            throw std::runtime_error("Could not open binary file: " + path);
+        }
+        meta = BinParser::parseMetadata(file.data(), file.size());
+        samples = file.data() + meta.dataOffset;
+        available = (file.size() - meta.dataOffset) / 2;
+
+        uniform = true;
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            uniform = uniform && meta.downsampling[ch] == meta.downsampling[0];
+            scales[ch] = BinParser::channelScale(meta, ch);
+        }
+
+        // Samples present per channel: capacity, less whatever a truncated
+        // file is missing (positions grow with k, so search the last one)
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            uint64_t lo = 0;
+            uint64_t hi = BinParser::channelCapacity(meta, ch);
+            while (lo < hi) {
+                uint64_t mid = lo + (hi - lo) / 2;
+                if (samplePosition(ch, mid) < available) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            counts[ch] = static_cast<size_t>(lo);
+        }
+
+        if (!cachePath.empty()) {
+            attachCache(cachePath);
+        }
+    }
+
+    bool cached() const { return cache.isOpen(); }
+    size_t cacheSize() const { return cache.isOpen() ? cache.byteSize() : 0; }
+
+    // Decode every raw and calculated channel into a cache file for later
+    // opens. Returns its size; throws std::runtime_error.
+    uint64_t writeCache(const std::string& cachePath) const {
+        uint64_t sourceSize = 0;
+        int64_t sourceMtime = 0;
+        if (!BinCache::sourceStamp(sourcePath, sourceSize, sourceMtime)) {
+            throw std::runtime_error("Could not stat binary file: " + sourcePath);
+        }
+
+        // Summaries (and so column lengths) exactly as an uncached summarize()
+        BinSummaries summaries = summarize();
+        std::array<BinChannelSummary, BIN_CACHE_COLUMNS> columns;
+        std::copy(summaries.channels.begin(), summaries.channels.end(), columns.begin());
+        std::copy(summaries.calculated.begin(), summaries.calculated.end(), columns.begin() + BIN_CHANNELS);
+
+        return BinCache::write(cachePath, file.data(), meta.dataOffset, sourceSize, sourceMtime, columns,
+            [this](int column, size_t start, size_t count, float* out) {
+                if (column < BIN_CHANNELS) {
+                    read(column, start, count, 1, out);
+                } else {
+                    readCalculated(column - BIN_CHANNELS, start, count, 1, out);
+                }
+            });
+    }
+
+    const BinMetadata& metadata() const { return meta; }
+    size_t fileSize() const { return file.size(); }
+    size_t points(int channel) const { return counts[channel]; }
+    double scale(int channel) const { return scales[channel]; }
+
+    // Samples of a calculated channel: those where both sources are present
+    size_t calculatedPoints(int calcIndex) const {
+        return std::min(counts[BIN_CALC_SOURCES[calcIndex][0]], counts[BIN_CALC_SOURCES[calcIndex][1]]);
+    }
+
+    // Throw unless count samples from start, every step-th one, lie within
+    // the channel (what read() and envelope() require); lets callers check a
+    // request before allocating its output
+    void requireRange(int channel, size_t start, size_t count, size_t step) const {
+        if (channel < 0 || channel >= BIN_CHANNELS) {
+            throw std::out_of_range("Channel out of range");
+        }
+        requireSpan(counts[channel], start, count, step);
+    }
+
+    // Like requireRange(), for a calculated channel
+    void requireCalculatedRange(int calcIndex, size_t start, size_t count, size_t step) const {
+        if (calcIndex < 0 || calcIndex >= BIN_CALC_CHANNELS) {
+            throw std::out_of_range("Calculated channel out of range");
+        }
+        requireSpan(calculatedPoints(calcIndex), start, count, step);
+    }
+
+    // Decode count samples of channel from start, taking every step-th one.
+    // The range must lie within points(channel).
+    void read(int channel, size_t start, size_t count, size_t step, float* out) const {
+        requireRange(channel, start, count, step);
+        if (cache.isOpen()) {
+            cache.read(channel, start, count, step, out);
+            return;
+        }
+        const double channelScale = scales[channel];
+
+        if (uniform) {
+            const uint8_t* p = samples + (static_cast<uint64_t>(start) * BIN_CHANNELS + channel) * 2;
+            const size_t stride = step * BIN_CHANNELS * 2;
+            for (size_t i = 0; i < count; i++, p += stride) {
+                out[i] = static_cast<float>(load(p) * channelScale);
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = static_cast<float>(rawSample(channel, start + i * step) * channelScale);
+            }
+        }
+    }
+
+    // Split [start, start + count) into buckets of near-equal size and report
+    // the extremes of each with their sample indices. Works on raw ADC counts
+    // and scales once per bucket. Returns the number of buckets filled.
+    size_t envelope(int channel, size_t start, size_t count, size_t buckets,
+                    float* minOut, float* maxOut, double* minIndexOut, double* maxIndexOut) const {
+        requireRange(channel, start, count, 1);
+        if (cache.isOpen()) {
+            return cache.envelope(channel, start, count, buckets, minOut, maxOut, minIndexOut, maxIndexOut);
+        }
+        buckets = std::min(buckets, count);
+        if (buckets == 0) return 0;
+
+        const double channelScale = scales[channel];
+        const size_t stride = BIN_CHANNELS * 2;
+
+        for (size_t b = 0; b < buckets; b++) {
+            size_t first = start + count * b / buckets;
+            size_t last = start + count * (b + 1) / buckets;
+
+            int16_t lo = std::numeric_limits<int16_t>::max();
+            int16_t hi = std::numeric_limits<int16_t>::min();
+            size_t loIndex = first;
+            size_t hiIndex = first;
+
+            if (uniform) {
+                const uint8_t* p = samples + (static_cast<uint64_t>(first) * BIN_CHANNELS + channel) * 2;
+                for (size_t k = first; k < last; k++, p += stride) {
+                    int16_t value = load(p);
+                    if (value < lo) { lo = value; loIndex = k; }
+                    if (value > hi) { hi = value; hiIndex = k; }
+                }
+            } else {
+                for (size_t k = first; k < last; k++) {
+                    int16_t value = rawSample(channel, k);
+                    if (value < lo) { lo = value; loIndex = k; }
+                    if (value > hi) { hi = value; hiIndex = k; }
+                }
+            }
+
+            // A negative scaling factor swaps the physical extremes
+            if (channelScale < 0) {
+                std::swap(lo, hi);
+                std::swap(loIndex, hiIndex);
+            }
+            minOut[b] = static_cast<float>(lo * channelScale);
+            maxOut[b] = static_cast<float>(hi * channelScale);
+            minIndexOut[b] = static_cast<double>(loIndex);
+            maxIndexOut[b] = static_cast<double>(hiIndex);
+        }
+        return buckets;
+    }
+
+    // Like read(), for a calculated channel evaluated from its source samples
+    void readCalculated(int calcIndex, size_t start, size_t count, size_t step, float* out) const {
+        requireCalculatedRange(calcIndex, start, count, step);
+        if (cache.isOpen()) {
+            cache.read(BIN_CHANNELS + calcIndex, start, count, step, out);
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            out[i] = calculatedSample(calcIndex, start + i * step);
+        }
+    }
+
+    // Like envelope(), for a calculated channel at full resolution
+    size_t envelopeCalculated(int calcIndex, size_t start, size_t count, size_t buckets,
+                              float* minOut, float* maxOut, double* minIndexOut, double* maxIndexOut) const {
+        requireCalculatedRange(calcIndex, start, count, 1);
+        if (cache.isOpen()) {
+            return cache.envelope(BIN_CHANNELS + calcIndex, start, count, buckets, minOut, maxOut, minIndexOut, maxIndexOut);
+        }
+        buckets = std::min(buckets, count);
+
+        for (size_t b = 0; b < buckets; b++) {
+            size_t first = start + count * b / buckets;
+            size_t last = start + count * (b + 1) / buckets;
+
+            float lo = std::numeric_limits<float>::infinity();
+            float hi = -std::numeric_limits<float>::infinity();
+            size_t loIndex = first;
+            size_t hiIndex = first;
+            for (size_t k = first; k < last; k++) {
+                float value = calculatedSample(calcIndex, k);
+                if (value < lo) { lo = value; loIndex = k; }
+                if (value > hi) { hi = value; hiIndex = k; }
+            }
+
+            minOut[b] = lo;
+            maxOut[b] = hi;
+            minIndexOut[b] = static_cast<double>(loIndex);
+            maxIndexOut[b] = static_cast<double>(hiIndex);
+        }
+        return buckets;
+    }
+
+    // Min, max, mean and RMS of every raw and calculated channel in a single
+    // sequential pass
+    BinSummaries summarize() const {
+        if (cache.isOpen()) {
+            BinSummaries result;
+            for (int ch = 0; ch < BIN_CHANNELS; ch++) result.channels[ch] = cache.summary(ch);
+            for (int c = 0; c < BIN_CALC_CHANNELS; c++) result.calculated[c] = cache.summary(BIN_CHANNELS + c);
+            return result;
+        }
+
+        std::array<int16_t, BIN_CHANNELS> lo, hi;
+        std::array<int64_t, BIN_CHANNELS> sum{};
+        std::array<uint64_t, BIN_CHANNELS> sumSquares{};
+        lo.fill(std::numeric_limits<int16_t>::max());
+        hi.fill(std::numeric_limits<int16_t>::min());
+
+        auto visit = [&](int ch, int16_t value) {
+            lo[ch] = std::min(lo[ch], value);
+            hi[ch] = std::max(hi[ch], value);
+            sum[ch] += value;
+            sumSquares[ch] += static_cast<uint64_t>(static_cast<int32_t>(value) * value);
+        };
+
+        std::array<BinSummaryAccumulator, BIN_CALC_CHANNELS> calculated;
+
+        // Whole records stream straight through, the calculated channels
+        // evaluated on the way; the rest (a record cut off by truncation, or
+        // any mixed-factor layout) goes per channel
+        size_t records = 0;
+        if (uniform) {
+            records = counts[BIN_CHANNELS - 1];
+            const uint8_t* p = samples;
+            for (size_t r = 0; r < records; r++) {
+                float physical[BIN_CHANNELS];
+                for (int ch = 0; ch < BIN_CHANNELS; ch++, p += 2) {
+                    int16_t value = load(p);
+                    visit(ch, value);
+                    physical[ch] = static_cast<float>(value * scales[ch]);
+                }
+                float values[BIN_CALC_CHANNELS];
+                BinCalc::record(physical, values);
+                for (int c = 0; c < BIN_CALC_CHANNELS; c++) calculated[c].add(values[c]);
+            }
+        }
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            for (size_t k = records; k < counts[ch]; k++) {
+                visit(ch, rawSample(ch, k));
+            }
+        }
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            size_t n = calculatedPoints(c);
+            for (size_t k = records; k < n; k++) {
+                calculated[c].add(calculatedSample(c, k));
+            }
+        }
+
+        BinSummaries result;
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            result.calculated[c] = calculated[c].summary();
+        }
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            BinChannelSummary& summary = result.channels[ch];
+            summary.count = counts[ch];
+            if (summary.count == 0) continue;
+
+            double s = scales[ch];
+            double a = lo[ch] * s;
+            double b = hi[ch] * s;
+            summary.min = static_cast<float>(std::min(a, b));
+            summary.max = static_cast<float>(std::max(a, b));
+            summary.mean = static_cast<double>(sum[ch]) / summary.count * s;
+            summary.rms = std::sqrt(static_cast<double>(sumSquares[ch]) / summary.count) * std::abs(s);
+        }
+        return result;
+    }
+
+private:
+    // Attach a cache written for this file (same stamp, metadata and lengths)
+    bool attachCache(const std::string& cachePath) {
+        uint64_t sourceSize = 0;
+        int64_t sourceMtime = 0;
+        if (!BinCache::sourceStamp(sourcePath, sourceSize, sourceMtime) ||
+            !cache.open(cachePath, sourceSize, sourceMtime)) {
+            return false;
+        }
+
+        bool matches = cache.metadataSize() == meta.dataOffset &&
+            std::memcmp(cache.metadata(), file.data(), meta.dataOffset) == 0;
+        for (int ch = 0; ch < BIN_CHANNELS && matches; ch++) {
+            matches = cache.points(ch) == counts[ch];
+        }
+        for (int c = 0; c < BIN_CALC_CHANNELS && matches; c++) {
+            matches = cache.points(BIN_CHANNELS + c) == calculatedPoints(c);
+        }
+        if (!matches) {
+            cache.close();
+        }
+        return matches;
+    }
+
+    float calculatedSample(int calcIndex, uint64_t k) const {
+        int a = BIN_CALC_SOURCES[calcIndex][0];
+        int b = BIN_CALC_SOURCES[calcIndex][1];
+        return BinCalc::value(calcIndex, static_cast<float>(rawSample(a, k) * scales[a]),
+                              static_cast<float>(rawSample(b, k) * scales[b]));
+    }
+
+    // Position (in int16 samples from dataOffset) of sample k of channel
+    uint64_t samplePosition(int channel, uint64_t k) const {
+        if (uniform) {
+            return k * BIN_CHANNELS + channel;
+        }
+        const uint64_t j = k * static_cast<uint64_t>(meta.downsampling[channel]);
+        uint64_t position = 0;
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            const uint64_t factor = static_cast<uint64_t>(meta.downsampling[ch]);
+            position += (j + factor - 1) / factor;
+            if (ch < channel && j % factor == 0) position++;
+        }
+        return position;
+    }
+
+    int16_t rawSample(int channel, uint64_t k) const {
+        return load(samples + samplePosition(channel, k) * 2);
+    }
+
+    static int16_t load(const uint8_t* p) {
+        int16_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static void requireSpan(size_t points, size_t start, size_t count, size_t step) {
+        if (step == 0) {
+            throw std::invalid_argument("Step must be at least 1");
+        }
+        if (count > 0 && (start >= points || (count - 1) > (points - 1 - start) / step)) {
+            throw std::out_of_range("Sample range out of range");
+        }
+    }
+
+    std::string sourcePath;
+    MappedFile file;
+    BinCache cache;
+    BinMetadata meta;
+    const uint8_t* samples = nullptr;
+    size_t available = 0;                // whole int16 samples after the metadata
+    bool uniform = true;                 // one downsampling factor for all channels
+    std::array<double, BIN_CHANNELS> scales{};
+    std::array<size_t, BIN_CHANNELS> counts{};
+};
@@ -0,0 +1,598 @@
+#include <napi.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bin_calc.h"
+#include "bin_parser.h"
+#include "bin_pyramid.h"
+#include "bin_source.h"
+#include "mapped_file.h"
+
+namespace {
+
+Napi::Float32Array CopyToFloat32Array(Napi::Env env, const std::vector<float>& values) {
+    Napi::Float32Array result = Napi::Float32Array::New(env, values.size());
+    std::copy(values.begin(), values.end(), result.Data());
+    return result;
+}
+
+// Min/max pyramid of a column as { min, max } typed arrays
+struct PyramidLevels {
+    std::vector<float> min;
+    std::vector<float> max;
+
+    void build(const std::vector<float>& values) {
+        BinPyramid::Builder builder(values.size());
+        builder.append(values.data(), values.size());
+        builder.finish();
+        builder.release(min, max);
+    }
+
+    Napi::Object toObject(Napi::Env env) const {
+        Napi::Object object = Napi::Object::New(env);
+        object.Set("min", CopyToFloat32Array(env, min));
+        object.Set("max", CopyToFloat32Array(env, max));
+        return object;
+    }
+};
+
+Napi::Object MetadataToObject(Napi::Env env, const BinMetadata& meta) {
+    Napi::Object metadata = Napi::Object::New(env);
+    metadata.Set("bufferSize", Napi::Number::New(env, meta.bufferSize));
+    metadata.Set("startTimeBinary", Napi::BigInt::New(env, meta.startTimeBinary));
+    metadata.Set("maxAdcValue", Napi::Number::New(env, meta.maxAdcValue));
+    metadata.Set("samplingInterval", Napi::Number::New(env, meta.samplingInterval));
+    metadata.Set("dataOffset", Napi::Number::New(env, static_cast<double>(meta.dataOffset)));
+
+    Napi::Array channelRanges = Napi::Array::New(env, BIN_CHANNELS);
+    Napi::Array channelScaling = Napi::Array::New(env, BIN_CHANNELS);
+    Napi::Array downsampling = Napi::Array::New(env, BIN_CHANNELS);
+    Napi::Array units = Napi::Array::New(env, BIN_CHANNELS);
+    Napi::Array labels = Napi::Array::New(env, BIN_CHANNELS);
+
+    for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+        channelRanges[ch] = Napi::Number::New(env, meta.channelRanges[ch]);
+        channelScaling[ch] = Napi::Number::New(env, meta.channelScaling[ch]);
+        downsampling[ch] = Napi::Number::New(env, meta.downsampling[ch]);
+        units[ch] = Napi::String::New(env, meta.units[ch]);
+        labels[ch] = Napi::String::New(env, meta.labels[ch]);
+    }
+
+    metadata.Set("channelRanges", channelRanges);
+    metadata.Set("channelScaling", channelScaling);
+    metadata.Set("downsampling", downsampling);
+    metadata.Set("units", units);
+    metadata.Set("labels", labels);
+    return metadata;
+}
+
+struct ParseResult {
+    BinMetadata metadata;
+    std::array<BinChannel, BIN_CHANNELS> channels;
+    std::array<std::vector<float>, BIN_CALC_CHANNELS> calculated;
+    std::array<PyramidLevels, BIN_CHANNELS> channelPyramids;
+    std::array<PyramidLevels, BIN_CALC_CHANNELS> calculatedPyramids;
+    size_t fileSize = 0;
+    double parseTimeMs = 0.0;
+};
+
+// Maps and parses a .bin file off the main thread and derives the calculated
+// channels and the min/max pyramid of every channel in the same job; the
+// arrays are copied into JS-owned typed arrays once the parse has finished.
+class ParseWorker : public Napi::AsyncWorker {
+public:
+    ParseWorker(Napi::Env env, const std::string& path)
+        : Napi::AsyncWorker(env, "BinaryParse"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          path(path) {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        try {
+            auto started = std::chrono::steady_clock::now();
+
+            MappedFile file;
+            if (!file.open(path)) {
+                SetError("Could not open binary file: " + path);
+                return;
+            }
+
+            result.fileSize = file.size();
+            result.metadata = BinParser::parseMetadata(file.data(), file.size());
+            BinParser::readChannels(file.data(), file.size(), result.metadata, result.channels);
+            BinCalc::computeAll(result.channels, result.calculated);
+            for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+                result.channelPyramids[ch].build(result.channels[ch].values);
+            }
+            for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+                result.calculatedPyramids[c].build(result.calculated[c]);
+            }
+
+            result.parseTimeMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - started).count();
+        } catch (const std::exception& e) {
+            SetError(std::string("Error parsing binary file: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        const BinMetadata& meta = result.metadata;
+
+        Napi::Array channels = Napi::Array::New(env, BIN_CHANNELS);
+        size_t totalPoints = 0;
+
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            const BinChannel& source = result.channels[ch];
+            Napi::Object channel = Napi::Object::New(env);
+            channel.Set("values", CopyToFloat32Array(env, source.values));
+            channel.Set("timeStart", Napi::Number::New(env, 0.0));
+            channel.Set("timeStep", Napi::Number::New(env, BinParser::channelTimeStep(meta, ch)));
+            channel.Set("points", Napi::Number::New(env, static_cast<double>(source.values.size())));
+            channel.Set("pyramid", result.channelPyramids[ch].toObject(env));
+            channels[ch] = channel;
+            totalPoints += source.values.size();
+        }
+
+        // Calculated channels share the time axis of their first source
+        Napi::Array calculated = Napi::Array::New(env, BIN_CALC_CHANNELS);
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            Napi::Object channel = Napi::Object::New(env);
+            channel.Set("values", CopyToFloat32Array(env, result.calculated[c]));
+            channel.Set("points", Napi::Number::New(env, static_cast<double>(result.calculated[c].size())));
+            channel.Set("pyramid", result.calculatedPyramids[c].toObject(env));
+            calculated[c] = channel;
+        }
+
+        Napi::Object stats = Napi::Object::New(env);
+        stats.Set("fileSize", Napi::Number::New(env, static_cast<double>(result.fileSize)));
+        stats.Set("totalPoints", Napi::Number::New(env, static_cast<double>(totalPoints)));
+        stats.Set("parseTimeMs", Napi::Number::New(env, result.parseTimeMs));
+
+        Napi::Object object = Napi::Object::New(env);
+        object.Set("header", Napi::String::New(env, meta.header));
+        object.Set("metadata", MetadataToObject(env, meta));
+        object.Set("channels", channels);
+        object.Set("calculated", calculated);
+        object.Set("stats", stats);
+        deferred.Resolve(object);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    std::string path;
+    ParseResult result;
+};
+
+// parseBinFile(path) -> Promise<{ header, metadata, channels[8], calculated[7], stats }>,
+// each channel with { values, points, pyramid: { min, max } }
+Napi::Value ParseBinFile(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "File path expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    ParseWorker* worker = new ParseWorker(env, info[0].As<Napi::String>().Utf8Value());
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+// Runs one read against an open file off the main thread. The task holds
+// its own reference, so close() during a read only unmaps once it is done.
+template <typename Result>
+class SourceTask : public Napi::AsyncWorker {
+public:
+    using Work = std::function<void(const BinSource&, Result&)>;
+    using Convert = std::function<Napi::Value(Napi::Env, Result&)>;
+
+    SourceTask(Napi::Env env, std::shared_ptr<const BinSource> source, const char* name, Work work, Convert convert)
+        : Napi::AsyncWorker(env, name),
+          deferred(Napi::Promise::Deferred::New(env)),
+          source(std::move(source)), work(std::move(work)), convert(std::move(convert)), result() {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        try {
+            work(*source, result);
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred.Resolve(convert(Env(), result));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    std::shared_ptr<const BinSource> source;
+    Work work;
+    Convert convert;
+    Result result;
+};
+
+// Non-negative integer argument, or fallback when omitted
+bool GetIndexParam(const Napi::CallbackInfo& info, size_t index, const char* name, double& value, double fallback = -1) {
+    if (info.Length() <= index || info[index].IsUndefined()) {
+        if (fallback < 0) {
+            Napi::TypeError::New(info.Env(), std::string(name) + " expected").ThrowAsJavaScriptException();
+            return false;
+        }
+        value = fallback;
+        return true;
+    }
+    if (!info[index].IsNumber()) {
+        Napi::TypeError::New(info.Env(), std::string(name) + " must be a number").ThrowAsJavaScriptException();
+        return false;
+    }
+    value = info[index].As<Napi::Number>().DoubleValue();
+    if (!(value >= 0 && value <= 9007199254740991.0) || value != std::floor(value)) {
+        Napi::RangeError::New(info.Env(), std::string(name) + " must be a non-negative integer").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Per-bucket extremes of an envelope query
+struct Extremes {
+    std::vector<float> min, max;
+    std::vector<double> minIndex, maxIndex;
+
+    void resize(size_t buckets) {
+        min.resize(buckets);
+        max.resize(buckets);
+        minIndex.resize(buckets);
+        maxIndex.resize(buckets);
+    }
+
+    Napi::Object toObject(Napi::Env env) const {
+        Napi::Float64Array minIndexArray = Napi::Float64Array::New(env, minIndex.size());
+        Napi::Float64Array maxIndexArray = Napi::Float64Array::New(env, maxIndex.size());
+        std::copy(minIndex.begin(), minIndex.end(), minIndexArray.Data());
+        std::copy(maxIndex.begin(), maxIndex.end(), maxIndexArray.Data());
+
+        Napi::Object object = Napi::Object::New(env);
+        object.Set("min", CopyToFloat32Array(env, min));
+        object.Set("max", CopyToFloat32Array(env, max));
+        object.Set("minIndex", minIndexArray);
+        object.Set("maxIndex", maxIndexArray);
+        return object;
+    }
+};
+
+// pyramidEnvelope(values, pyramid, start, count, buckets)
+//   -> { min, max: Float32Array, minIndex, maxIndex: Float64Array }
+// Envelope of a loaded channel from the pyramid parseBinFile built for it.
+// Synchronous: touches O(buckets) pyramid entries whatever the range length.
+Napi::Value PyramidEnvelope(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsTypedArray() || !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Values and pyramid expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::TypedArray valuesArray = info[0].As<Napi::TypedArray>();
+    Napi::Object pyramid = info[1].As<Napi::Object>();
+    Napi::Value minValue = pyramid.Get("min");
+    Napi::Value maxValue = pyramid.Get("max");
+    if (valuesArray.TypedArrayType() != napi_float32_array ||
+        !minValue.IsTypedArray() || minValue.As<Napi::TypedArray>().TypedArrayType() != napi_float32_array ||
+        !maxValue.IsTypedArray() || maxValue.As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+        Napi::TypeError::New(env, "Values and pyramid levels must be Float32Arrays").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Float32Array values = valuesArray.As<Napi::Float32Array>();
+    Napi::Float32Array minimum = minValue.As<Napi::Float32Array>();
+    Napi::Float32Array maximum = maxValue.As<Napi::Float32Array>();
+
+    double start, count, buckets;
+    if (!GetIndexParam(info, 2, "start", start) || !GetIndexParam(info, 3, "count", count) ||
+        !GetIndexParam(info, 4, "buckets", buckets)) {
+        return env.Null();
+    }
+
+    const size_t n = values.ElementLength();
+    const size_t entries = BinPyramid::Layout(n).entries();
+    if (minimum.ElementLength() != entries || maximum.ElementLength() != entries) {
+        Napi::RangeError::New(env, "Pyramid does not match the values").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (start > n || count > n - start) {
+        Napi::RangeError::New(env, "Sample range out of range").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Extremes result;
+    result.resize(static_cast<size_t>(std::min(buckets, count)));
+    BinPyramid(values.Data(), n, minimum.Data(), maximum.Data())
+        .envelope(static_cast<size_t>(start), static_cast<size_t>(count), result.min.size(),
+                  result.min.data(), result.max.data(), result.minIndex.data(), result.maxIndex.data());
+    return result.toObject(env);
+}
+
+// JS class BinFile: an open, memory-mapped .bin file. Samples are decoded
+// on demand, per channel and range, in Promise-returning calls that may
+// run concurrently (the mapping is read-only).
+class BinFileObject : public Napi::ObjectWrap<BinFileObject> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "BinFile", {
+            InstanceMethod("info", &BinFileObject::Info),
+            InstanceMethod("read", &BinFileObject::Read),
+            InstanceMethod("envelope", &BinFileObject::Envelope),
+            InstanceMethod("readCalculated", &BinFileObject::ReadCalculated),
+            InstanceMethod("envelopeCalculated", &BinFileObject::EnvelopeCalculated),
+            InstanceMethod("summarize", &BinFileObject::Summarize),
+            InstanceMethod("buildCache", &BinFileObject::BuildCache),
+            InstanceMethod("close", &BinFileObject::Close)
+        });
+    }
+
+    // new BinFile(path, cachePath?): maps the file and parses its metadata
+    // (throws on failure); serves reads from the cache file at cachePath if it
+    // was built for this file
+    explicit BinFileObject(const Napi::CallbackInfo& info)
+        : Napi::ObjectWrap<BinFileObject>(info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            Napi::TypeError::New(env, "File path expected").ThrowAsJavaScriptException();
+            return;
+        }
+
+        std::string cachePath;
+        if (info.Length() > 1 && !info[1].IsUndefined() && !info[1].IsNull()) {
+            if (!info[1].IsString()) {
+                Napi::TypeError::New(env, "Cache path must be a string").ThrowAsJavaScriptException();
+                return;
+            }
+            cachePath = info[1].As<Napi::String>().Utf8Value();
+        }
+
+        try {
+            auto opened = std::make_shared<BinSource>();
+            opened->open(info[0].As<Napi::String>().Utf8Value(), cachePath);
+            source = std::move(opened);
+        } catch (const std::exception& e) {
+            Napi::Error::New(env, std::string("Error opening binary file: ") + e.what()).ThrowAsJavaScriptException();
+        }
+    }
+
+private:
+    // info() -> { header, metadata, points[8], calculatedPoints[7], fileSize, cached, cacheSize }
+    Napi::Value Info(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!RequireOpen(env)) return env.Null();
+
+        const BinMetadata& meta = source->metadata();
+        Napi::Array points = Napi::Array::New(env, BIN_CHANNELS);
+        for (int ch = 0; ch < BIN_CHANNELS; ch++) {
+            points[ch] = Napi::Number::New(env, static_cast<double>(source->points(ch)));
+        }
+        Napi::Array calculatedPoints = Napi::Array::New(env, BIN_CALC_CHANNELS);
+        for (int c = 0; c < BIN_CALC_CHANNELS; c++) {
+            calculatedPoints[c] = Napi::Number::New(env, static_cast<double>(source->calculatedPoints(c)));
+        }
+
+        Napi::Object object = Napi::Object::New(env);
+        object.Set("header", Napi::String::New(env, meta.header));
+        object.Set("metadata", MetadataToObject(env, meta));
+        object.Set("points", points);
+        object.Set("calculatedPoints", calculatedPoints);
+        object.Set("fileSize", Napi::Number::New(env, static_cast<double>(source->fileSize())));
+        object.Set("cached", Napi::Boolean::New(env, source->cached()));
+        object.Set("cacheSize", Napi::Number::New(env, static_cast<double>(source->cacheSize())));
+        return object;
+    }
+
+    // read(channel, start, count, step = 1) -> Promise<Float32Array>
+    Napi::Value Read(const Napi::CallbackInfo& info) {
+        return ReadRange(info, false);
+    }
+
+    // readCalculated(calcIndex, start, count, step = 1) -> Promise<Float32Array>
+    Napi::Value ReadCalculated(const Napi::CallbackInfo& info) {
+        return ReadRange(info, true);
+    }
+
+    // envelope(channel, start, count, buckets)
+    //   -> Promise<{ min, max: Float32Array, minIndex, maxIndex: Float64Array }>
+    Napi::Value Envelope(const Napi::CallbackInfo& info) {
+        return EnvelopeRange(info, false);
+    }
+
+    // envelopeCalculated(calcIndex, start, count, buckets) -> as envelope()
+    Napi::Value EnvelopeCalculated(const Napi::CallbackInfo& info) {
+        return EnvelopeRange(info, true);
+    }
+
+    // summarize() -> Promise<{ channels[8], calculated[7] }> of { min, max, mean, rms, count },
+    // one pass over the file
+    Napi::Value Summarize(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!RequireOpen(env)) return env.Null();
+
+        return Run<BinSummaries>(env, "BinarySummarize",
+            [](const BinSource& file, BinSummaries& summaries) {
+                summaries = file.summarize();
+            },
+            [](Napi::Env env, BinSummaries& summaries) -> Napi::Value {
+                Napi::Object result = Napi::Object::New(env);
+                result.Set("channels", SummariesToArray(env, summaries.channels.data(), BIN_CHANNELS));
+                result.Set("calculated", SummariesToArray(env, summaries.calculated.data(), BIN_CALC_CHANNELS));
+                return result;
+            });
+    }
+
+    // buildCache(cachePath) -> Promise<{ path, byteSize }>: decode every channel
+    // into a cache file for later opens (this object keeps reading as before)
+    Napi::Value BuildCache(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!RequireOpen(env)) return env.Null();
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            Napi::TypeError::New(env, "Cache path expected").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        std::string cachePath = info[0].As<Napi::String>().Utf8Value();
+
+        return Run<uint64_t>(env, "BinaryBuildCache",
+            [cachePath](const BinSource& file, uint64_t& byteSize) {
+                byteSize = file.writeCache(cachePath);
+            },
+            [cachePath](Napi::Env env, uint64_t& byteSize) -> Napi::Value {
+                Napi::Object result = Napi::Object::New(env);
+                result.Set("path", Napi::String::New(env, cachePath));
+                result.Set("byteSize", Napi::Number::New(env, static_cast<double>(byteSize)));
+                return result;
+            });
+    }
+
+    // close(): release the mapping (after any reads still in flight)
+    Napi::Value Close(const Napi::CallbackInfo& info) {
+        source.reset();
+        return info.Env().Undefined();
+    }
+
+    Napi::Value ReadRange(const Napi::CallbackInfo& info, bool calculated) {
+        Napi::Env env = info.Env();
+        if (!RequireOpen(env)) return env.Null();
+
+        double channel, start, count, step;
+        if (!GetIndexParam(info, 0, "channel", channel) || !GetIndexParam(info, 1, "start", start) ||
+            !GetIndexParam(info, 2, "count", count) || !GetIndexParam(info, 3, "step", step, 1)) {
+            return env.Null();
+        }
+
+        return Run<std::vector<float>>(env, "BinaryRead",
+            [=](const BinSource& file, std::vector<float>& values) {
+                if (calculated) {
+                    file.requireCalculatedRange(static_cast<int>(channel), static_cast<size_t>(start),
+                                                static_cast<size_t>(count), static_cast<size_t>(step));
+                } else {
+                    file.requireRange(static_cast<int>(channel), static_cast<size_t>(start),
+                                      static_cast<size_t>(count), static_cast<size_t>(step));
+                }
+                values.resize(static_cast<size_t>(count));
+                if (calculated) {
+                    file.readCalculated(static_cast<int>(channel), static_cast<size_t>(start), values.size(),
+                                        static_cast<size_t>(step), values.data());
+                } else {
+                    file.read(static_cast<int>(channel), static_cast<size_t>(start), values.size(),
+                              static_cast<size_t>(step), values.data());
+                }
+            },
+            [](Napi::Env env, std::vector<float>& values) -> Napi::Value {
+                return CopyToFloat32Array(env, values);
+            });
+    }
+
+    Napi::Value EnvelopeRange(const Napi::CallbackInfo& info, bool calculated) {
+        Napi::Env env = info.Env();
+        if (!RequireOpen(env)) return env.Null();
+
+        double channel, start, count, buckets;
+        if (!GetIndexParam(info, 0, "channel", channel) || !GetIndexParam(info, 1, "start", start) ||
+            !GetIndexParam(info, 2, "count", count) || !GetIndexParam(info, 3, "buckets", buckets)) {
+            return env.Null();
+        }
+
+        return Run<Extremes>(env, "BinaryEnvelope",
+            [=](const BinSource& file, Extremes& result) {
+                if (calculated) {
+                    file.requireCalculatedRange(static_cast<int>(channel), static_cast<size_t>(start),
+                                                static_cast<size_t>(count), 1);
+                } else {
+                    file.requireRange(static_cast<int>(channel), static_cast<size_t>(start),
+                                      static_cast<size_t>(count), 1);
+                }
+                result.resize(static_cast<size_t>(std::min(buckets, count)));
+                if (calculated) {
+                    file.envelopeCalculated(static_cast<int>(channel), static_cast<size_t>(start), static_cast<size_t>(count), result.min.size(),
+                                            result.min.data(), result.max.data(), result.minIndex.data(), result.maxIndex.data());
+                } else {
+                    file.envelope(static_cast<int>(channel), static_cast<size_t>(start), static_cast<size_t>(count), result.min.size(),
+                                  result.min.data(), result.max.data(), result.minIndex.data(), result.maxIndex.data());
+                }
+            },
+            [](Napi::Env env, Extremes& result) -> Napi::Value {
+                return result.toObject(env);
+            });
+    }
+
+    static Napi::Array SummariesToArray(Napi::Env env, const BinChannelSummary* summaries, int count) {
+        Napi::Array result = Napi::Array::New(env, count);
+        for (int i = 0; i < count; i++) {
+            const BinChannelSummary& summary = summaries[i];
+            Napi::Object object = Napi::Object::New(env);
+            object.Set("min", Napi::Number::New(env, summary.min));
+            object.Set("max", Napi::Number::New(env, summary.max));
+            object.Set("mean", Napi::Number::New(env, summary.mean));
+            object.Set("rms", Napi::Number::New(env, summary.rms));
+            object.Set("count", Napi::Number::New(env, static_cast<double>(summary.count)));
+            result[i] = object;
+        }
+        return result;
+    }
+
+    bool RequireOpen(Napi::Env env) {
+        if (!source) {
+            Napi::Error::New(env, "Binary file is closed").ThrowAsJavaScriptException();
+            return false;
+        }
+        return true;
+    }
+
+    template <typename Result>
+    Napi::Value Run(Napi::Env env, const char* name,
+                    typename SourceTask<Result>::Work work,
+                    typename SourceTask<Result>::Convert convert) {
+        SourceTask<Result>* task = new SourceTask<Result>(env, source, name, std::move(work), std::move(convert));
+        Napi::Promise promise = task->GetPromise();
+        task->Queue();
+        return promise;
+    }
+
+    std::shared_ptr<const BinSource> source;
+};
+
+} // namespace
+
+// Module initialization
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("parseBinFile", Napi::Function::New(env, ParseBinFile));
+    exports.Set("pyramidEnvelope", Napi::Function::New(env, PyramidEnvelope));
+    exports.Set("BinFile", BinFileObject::Define(env));
+    exports.Set("channelCount", Napi::Number::New(env, BIN_CHANNELS));
+    exports.Set("calculatedChannelCount", Napi::Number::New(env, BIN_CALC_CHANNELS));
+#ifdef BIN_PARSER_SSE2
+    exports.Set("simd", Napi::String::New(env, "sse2"));
+#else
+    exports.Set("simd", Napi::String::New(env, "none"));
+#endif
+    return exports;
+}
+
+NODE_API_MODULE(binary_native, Init)
@@ -0,0 +1,321 @@
+// CSV ingest benchmark on synthetic sensor files.
+//
+// Generates in-memory files shaped like the ones the readers ingest:
+//   acceleration  comma-separated, device header lines, time + X/Y/Z
+//   temperature   comma-separated, quoted cells with a decimal comma
+//   position      tab-separated datetime, unix time and position
+// with a few comment lines, empty lines and unparsable cells mixed in. Each
+// file is parsed with CsvParser on one thread and in chunks on --threads
+// threads, and every typed cell is compared with the value the generator
+// wrote; any difference is reported and fails the run.
+//
+// Build with bench/CMakeLists.txt; see --help for options.
+#include "csv_parser.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Options {
+    std::vector<size_t> megabytes = { 10, 100, 300 };
+    int repeats = 3;
+    size_t threads = 0;
+    bool quick = false;
+};
+
+// A generated file and the value each typed column must hold per row
+struct Sample {
+    std::string name;
+    std::string text;
+    CsvOptions options;
+    std::vector<CsvType> types;
+    std::vector<std::vector<double>> expected;
+};
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// Appends a number printed with decimals digits, optionally with a decimal
+// comma; returns the value the text denotes
+double appendNumber(std::string& text, double value, int decimals, bool comma) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    const double printed = std::strtod(buffer, nullptr);
+    if (comma) {
+        for (char* p = buffer; *p; p++) if (*p == '.') *p = ',';
+    }
+    text += buffer;
+    return printed;
+}
+
+Sample makeAcceleration(size_t bytes, unsigned seed) {
+    Sample sample;
+    sample.name = "acceleration";
+    sample.options.comment = '#';
+    sample.types = { CsvType::Number, CsvType::Number, CsvType::Number, CsvType::Number };
+    sample.expected.resize(4);
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 2.0);
+    std::uniform_int_distribution<int> rare(0, 20000);
+
+    std::string& text = sample.text;
+    text.reserve(bytes + 256);
+    text += "Device,DAQ-1200\nSerial,SN-00042\n# exported\nTime [s],X [m*s^-2],Y [m*s^-2],Z [m*s^-2]\r\n";
+    // Header rows parse as NaN in the numeric columns
+    for (int row = 0; row < 3; row++) {
+        for (auto& column : sample.expected) column.push_back(NaN);
+    }
+
+    for (size_t i = 0; text.size() < bytes; i++) {
+        const int event = rare(rng);
+        if (event == 0) {
+            text += "# marker\n";
+            continue;
+        }
+        if (event == 1) {
+            text += "\n";
+            continue;
+        }
+        sample.expected[0].push_back(appendNumber(text, i * 1e-4, 6, false));
+        for (int axis = 0; axis < 3; axis++) {
+            text += ',';
+            if (event == 2 && axis == 1) {
+                text += "ovf";
+                sample.expected[1 + axis].push_back(NaN);
+            } else {
+                sample.expected[1 + axis].push_back(appendNumber(text, 9.81 * (axis == 2) + noise(rng), 5, false));
+            }
+        }
+        text += event == 3 ? "\r\n" : "\n";
+    }
+    return sample;
+}
+
+Sample makeTemperature(size_t bytes, unsigned seed) {
+    Sample sample;
+    sample.name = "temperature";
+    sample.options.delimiter = ',';
+    sample.types = { CsvType::Number, CsvType::Number, CsvType::Number };
+    sample.expected.resize(3);
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.2);
+
+    std::string& text = sample.text;
+    text.reserve(bytes + 256);
+    text += "\"\",\"Schweissen Durchschn.\",\"Kanal 5 Durchschn.\"\n";
+    for (auto& column : sample.expected) column.push_back(NaN);
+
+    for (size_t i = 0; text.size() < bytes; i++) {
+        text += '"';
+        sample.expected[0].push_back(appendNumber(text, 1722345678.0 + i * 0.1, 3, true));
+        text += "\",\"";
+        sample.expected[1].push_back(appendNumber(text, 400.0 + 50.0 * std::sin(i * 1e-3) + noise(rng), 6, true));
+        text += "\",\"";
+        if (i % 5000 == 17) {
+            sample.expected[2].push_back(NaN);
+        } else {
+            sample.expected[2].push_back(appendNumber(text, 22.0 + noise(rng), 6, true));
+        }
+        text += "\"\n";
+    }
+    return sample;
+}
+
+// Wall-clock milliseconds since 1970-01-01 of a date and time
+double civilMilliseconds(int year, int month, int day, int hour, int minute, int second) {
+    // Days from civil, counted by months (independent of the parser's formula)
+    static const int monthDays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    long long days = 0;
+    for (int y = 1970; y < year; y++) days += (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 366 : 365;
+    for (int m = 1; m < month; m++) {
+        days += monthDays[m - 1] + (m == 2 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)));
+    }
+    days += day - 1;
+    return static_cast<double>(((days * 24 + hour) * 60 + minute) * 60000LL + second * 1000LL);
+}
+
+Sample makePosition(size_t bytes, unsigned seed) {
+    Sample sample;
+    sample.name = "position";
+    sample.options.delimiter = '\t';
+    sample.options.comment = '#';
+    sample.types = { CsvType::DateTime, CsvType::Number, CsvType::Number };
+    sample.expected.resize(3);
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.01);
+
+    std::string& text = sample.text;
+    text.reserve(bytes + 256);
+    long long micros = 0;
+    char buffer[64];
+    for (size_t i = 0; text.size() < bytes; i++, micros += 1000 + static_cast<long long>(rng() % 7)) {
+        const long long seconds = micros / 1000000;
+        const int fraction = static_cast<int>(micros % 1000000);
+        const int hour = 10 + static_cast<int>(seconds / 3600) % 14;
+        const int minute = static_cast<int>(seconds / 60) % 60;
+        const int second = static_cast<int>(seconds % 60);
+        std::snprintf(buffer, sizeof(buffer), "2025-07-30 %02d:%02d:%02d.%06d\t", hour, minute, second, fraction);
+        text += buffer;
+        sample.expected[0].push_back(civilMilliseconds(2025, 7, 30, hour, minute, second) + fraction / 1000.0);
+        sample.expected[1].push_back(appendNumber(text, 1753870530.0 + micros * 1e-6, 6, false));
+        text += '\t';
+        sample.expected[2].push_back(appendNumber(text, 12.0 + 3.0 * std::sin(i * 1e-4) + noise(rng), 4, false));
+        text += '\n';
+    }
+    return sample;
+}
+
+bool sameValue(double a, double b) {
+    return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+
+bool check(const Sample& sample, const CsvResult& result) {
+    bool ok = true;
+    for (size_t c = 0; c < sample.types.size(); c++) {
+        if (c >= result.columns.size() || result.columns[c].type != sample.types[c]) {
+            std::cerr << "  " << sample.name << ": column " << c << " inferred as "
+                      << (c < result.columns.size() ? CsvTypeName(result.columns[c].type) : "missing")
+                      << ", expected " << CsvTypeName(sample.types[c]) << std::endl;
+            return false;
+        }
+        const std::vector<double>& values = result.columns[c].values;
+        const std::vector<double>& expected = sample.expected[c];
+        if (values.size() != expected.size()) {
+            std::cerr << "  " << sample.name << ": column " << c << " has " << values.size()
+                      << " rows, expected " << expected.size() << std::endl;
+            ok = false;
+            continue;
+        }
+        size_t mismatches = 0;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (!sameValue(values[i], expected[i]) && mismatches++ < 3) {
+                std::cerr << "  " << sample.name << ": column " << c << " row " << i << ": "
+                          << std::setprecision(17) << values[i] << " != " << expected[i] << std::endl;
+            }
+        }
+        ok &= mismatches == 0;
+    }
+    return ok;
+}
+
+bool run(const Options& options, const Sample& sample, size_t threads) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(sample.text.data());
+    const double megabytes = sample.text.size() / (1024.0 * 1024.0);
+    CsvOptions parseOptions = sample.options;
+    parseOptions.threads = threads;
+
+    double best = 1e30;
+    CsvResult result;
+    for (int repeat = 0; repeat < options.repeats; repeat++) {
+        result = CsvResult();
+        auto start = Clock::now();
+        CsvParser::parse(data, sample.text.size(), parseOptions, result);
+        best = std::min(best, secondsSince(start));
+    }
+
+    const bool ok = check(sample, result);
+    std::cout << "  " << std::left << std::setw(14) << sample.name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(8) << megabytes << " MB"
+              << std::setw(4) << result.chunks << " chunks"
+              << std::setw(12) << result.rows << " rows"
+              << std::setw(9) << std::setprecision(3) << best << " s"
+              << std::setw(9) << std::setprecision(0) << megabytes / best << " MB/s"
+              << std::setw(8) << std::setprecision(1) << result.rows / best / 1e6 << " Mrows/s"
+              << (ok ? "" : "  MISMATCH") << std::endl;
+    return ok;
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: csv_bench [options]\n"
+        "  --mb a,b,...    file sizes in MB (default 10,100,300)\n"
+        "  --repeats N     timed repeats per file, best reported (default 3)\n"
+        "  --threads N     threads for the chunked parse (default: one per core, up to 8)\n"
+        "  --quick         small sizes, for a correctness check\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--mb") {
+            options.megabytes.clear();
+            std::string list = value();
+            for (size_t pos = 0; pos < list.size();) {
+                size_t comma = list.find(',', pos);
+                if (comma == std::string::npos) comma = list.size();
+                options.megabytes.push_back(std::strtoull(list.substr(pos, comma - pos).c_str(), nullptr, 10));
+                pos = comma + 1;
+            }
+        }
+        else if (arg == "--repeats") options.repeats = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--threads") options.threads = std::strtoull(value().c_str(), nullptr, 10);
+        else if (arg == "--quick") options.quick = true;
+        else if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (options.quick) {
+        options.megabytes = { 1, 5 };
+        options.repeats = std::min(options.repeats, 2);
+    }
+
+    std::cout << "CSV ingest benchmark (" <<
+#ifdef CSV_SSE2
+        "SSE2"
+#else
+        "scalar"
+#endif
+        << ")" << std::endl;
+
+    const size_t threads = options.threads ? options.threads : CsvParser::defaultThreadCount();
+    bool ok = true;
+    unsigned seed = 1;
+    for (size_t mb : options.megabytes) {
+        const size_t bytes = std::max<size_t>(1, mb) * 1024 * 1024;
+        for (const Sample& sample : { makeAcceleration(bytes, seed), makeTemperature(bytes, seed + 1),
+                                      makePosition(bytes, seed + 2) }) {
+            ok &= run(options, sample, 1);
+            if (threads > 1) ok &= run(options, sample, threads);
+        }
+        seed += 3;
+    }
+
+    if (!ok) {
+        std::cerr << "Parsed values differ from the generated ones" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,323 @@
+#include <napi.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "csv_overview.h"
+#include "csv_parser.h"
+#include "mapped_file.h"
+
+namespace {
+
+Napi::Float64Array CopyToFloat64Array(Napi::Env env, const std::vector<double>& values) {
+    Napi::Float64Array result = Napi::Float64Array::New(env, values.size());
+    std::copy(values.begin(), values.end(), result.Data());
+    return result;
+}
+
+// Single-character option ("auto" or omitted keeps the default)
+bool GetCharOption(Napi::Object options, const char* name, char& value) {
+    Napi::Value option = options.Get(name);
+    if (option.IsUndefined() || option.IsNull()) return true;
+    if (!option.IsString()) {
+        Napi::TypeError::New(options.Env(), std::string(name) + " must be a string").ThrowAsJavaScriptException();
+        return false;
+    }
+    std::string text = option.As<Napi::String>().Utf8Value();
+    if (text == "auto" || text.empty()) {
+        value = 0;
+        return true;
+    }
+    if (text.size() != 1 || text[0] == '"' || text[0] == '\n' || text[0] == '\r') {
+        Napi::RangeError::New(options.Env(), std::string(name) + " must be a single character").ThrowAsJavaScriptException();
+        return false;
+    }
+    value = text[0];
+    return true;
+}
+
+bool GetCountOption(Napi::Object options, const char* name, size_t& value) {
+    Napi::Value option = options.Get(name);
+    if (option.IsUndefined()) return true;
+    double number = option.IsNumber() ? option.As<Napi::Number>().DoubleValue() : -1;
+    if (!(number >= 0 && number <= 1e9) || number != static_cast<double>(static_cast<size_t>(number))) {
+        Napi::RangeError::New(options.Env(), std::string(name) + " must be a non-negative integer").ThrowAsJavaScriptException();
+        return false;
+    }
+    value = static_cast<size_t>(number);
+    return true;
+}
+
+// { delimiter, comment, decimal, skipEmptyLines, prefixRows, inferRows, types, threads }
+bool GetOptions(Napi::Object object, CsvOptions& options) {
+    if (!GetCharOption(object, "delimiter", options.delimiter)) return false;
+    if (!GetCharOption(object, "comment", options.comment)) return false;
+
+    Napi::Value decimal = object.Get("decimal");
+    if (!decimal.IsUndefined()) {
+        std::string text = decimal.IsString() ? decimal.As<Napi::String>().Utf8Value() : "";
+        if (text == "auto") options.decimal = CsvDecimal::Auto;
+        else if (text == ".") options.decimal = CsvDecimal::Point;
+        else if (text == ",") options.decimal = CsvDecimal::Comma;
+        else {
+            Napi::RangeError::New(object.Env(), "decimal must be 'auto', '.' or ','").ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+
+    Napi::Value skipEmptyLines = object.Get("skipEmptyLines");
+    if (!skipEmptyLines.IsUndefined()) options.skipEmptyLines = skipEmptyLines.ToBoolean();
+
+    if (!GetCountOption(object, "prefixRows", options.prefixRows)) return false;
+    if (!GetCountOption(object, "inferRows", options.inferRows)) return false;
+    if (!GetCountOption(object, "threads", options.threads)) return false;
+
+    Napi::Value types = object.Get("types");
+    if (!types.IsUndefined() && !types.IsNull()) {
+        if (!types.IsArray()) {
+            Napi::TypeError::New(object.Env(), "types must be an array").ThrowAsJavaScriptException();
+            return false;
+        }
+        Napi::Array array = types.As<Napi::Array>();
+        for (uint32_t i = 0; i < array.Length(); i++) {
+            Napi::Value type = array.Get(i);
+            std::string name = type.IsString() ? type.As<Napi::String>().Utf8Value() : "";
+            if (name == "number") options.types.push_back(CsvType::Number);
+            else if (name == "datetime") options.types.push_back(CsvType::DateTime);
+            else if (name == "pair") options.types.push_back(CsvType::Pair);
+            else if (name == "text") options.types.push_back(CsvType::Text);
+            else {
+                Napi::RangeError::New(object.Env(), "types must be 'number', 'datetime', 'pair' or 'text'").ThrowAsJavaScriptException();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Rows parsed so far and their overview, sent after every wave of a
+// progressive parse; the prefix rows go with the first message only
+struct CsvProgress {
+    size_t rows = 0;
+    size_t bytes = 0;
+    char delimiter = ',';
+    size_t rowsPerBucket = 1;
+    std::vector<std::vector<double>> min;   // per column, empty when untracked
+    std::vector<std::vector<double>> max;
+    std::vector<std::vector<std::string>> prefix;
+};
+
+Napi::Array PrefixToArray(Napi::Env env, const std::vector<std::vector<std::string>>& rows) {
+    Napi::Array prefix = Napi::Array::New(env, rows.size());
+    for (size_t r = 0; r < rows.size(); r++) {
+        const std::vector<std::string>& cells = rows[r];
+        Napi::Array row = Napi::Array::New(env, cells.size());
+        for (size_t c = 0; c < cells.size(); c++) {
+            row[c] = Napi::String::New(env, cells[c]);
+        }
+        prefix[r] = row;
+    }
+    return prefix;
+}
+
+// Maps and parses a CSV file off the main thread (large files in chunks on
+// several threads); the columns are copied into JS-owned typed arrays once
+// the parse has finished. With an onProgress callback the file is parsed in
+// waves and the callback receives the row count and overview after each.
+class ParseWorker : public Napi::AsyncProgressQueueWorker<CsvProgress> {
+public:
+    ParseWorker(Napi::Env env, const std::string& path, const CsvOptions& options, Napi::Value onProgress)
+        : Napi::AsyncProgressQueueWorker<CsvProgress>(env, "CsvParse"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          path(path), options(options) {
+        if (onProgress.IsFunction()) {
+            progressCallback = Napi::Persistent(onProgress.As<Napi::Function>());
+        }
+    }
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute(const ExecutionProgress& progress) override {
+        try {
+            auto started = std::chrono::steady_clock::now();
+
+            MappedFile file;
+            if (!file.open(path)) {
+                SetError("Could not open CSV file: " + path);
+                return;
+            }
+
+            fileSize = file.size();
+            if (progressCallback.IsEmpty()) {
+                CsvParser::parse(file.data(), file.size(), options, result);
+            } else {
+                CsvOverview overview(OVERVIEW_BUCKETS);
+                CsvParser::parseProgressive(file.data(), file.size(), options, result, FIRST_WAVE_BYTES,
+                    [&](size_t bytes) {
+                        overview.update(result.columns, result.rows);
+
+                        CsvProgress message;
+                        message.rows = result.rows;
+                        message.bytes = bytes;
+                        message.delimiter = result.format.delimiter;
+                        message.rowsPerBucket = overview.rowsPerBucket();
+                        message.min.resize(result.columns.size());
+                        message.max.resize(result.columns.size());
+                        for (size_t c = 0; c < result.columns.size(); c++) {
+                            if (overview.tracked(c)) overview.copy(c, message.min[c], message.max[c]);
+                        }
+                        if (!prefixSent) {
+                            message.prefix = result.prefix;
+                            prefixSent = true;
+                        }
+                        progress.Send(&message, 1);
+                    });
+            }
+
+            parseTimeMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - started).count();
+        } catch (const std::exception& e) {
+            SetError(std::string("Error parsing CSV file: ") + e.what());
+        }
+    }
+
+    void OnProgress(const CsvProgress* messages, size_t count) override {
+        if (progressCallback.IsEmpty()) return;
+
+        Napi::Env env = Env();
+        Napi::HandleScope scope(env);
+
+        for (size_t i = 0; i < count; i++) {
+            const CsvProgress& message = messages[i];
+
+            Napi::Array columns = Napi::Array::New(env, message.min.size());
+            for (size_t c = 0; c < message.min.size(); c++) {
+                if (message.min[c].empty()) {
+                    columns[c] = env.Null();
+                    continue;
+                }
+                Napi::Object column = Napi::Object::New(env);
+                column.Set("min", CopyToFloat64Array(env, message.min[c]));
+                column.Set("max", CopyToFloat64Array(env, message.max[c]));
+                columns[c] = column;
+            }
+
+            Napi::Object overview = Napi::Object::New(env);
+            overview.Set("rowsPerBucket", Napi::Number::New(env, static_cast<double>(message.rowsPerBucket)));
+            overview.Set("columns", columns);
+
+            Napi::Object object = Napi::Object::New(env);
+            object.Set("rows", Napi::Number::New(env, static_cast<double>(message.rows)));
+            object.Set("bytesParsed", Napi::Number::New(env, static_cast<double>(message.bytes)));
+            object.Set("fileSize", Napi::Number::New(env, static_cast<double>(fileSize)));
+            object.Set("delimiter", Napi::String::New(env, std::string(1, message.delimiter)));
+            if (!message.prefix.empty()) object.Set("prefixRows", PrefixToArray(env, message.prefix));
+            object.Set("overview", overview);
+
+            progressCallback.Call({ object });
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+
+        Napi::Array prefix = PrefixToArray(env, result.prefix);
+
+        Napi::Array columns = Napi::Array::New(env, result.columns.size());
+        for (size_t c = 0; c < result.columns.size(); c++) {
+            const CsvColumn& source = result.columns[c];
+            Napi::Object column = Napi::Object::New(env);
+            column.Set("type", Napi::String::New(env, CsvTypeName(source.type)));
+            if (source.type == CsvType::Pair) {
+                column.Set("x", CopyToFloat64Array(env, source.values));
+                column.Set("y", CopyToFloat64Array(env, source.y));
+            } else if (source.type == CsvType::Number || source.type == CsvType::DateTime) {
+                column.Set("values", CopyToFloat64Array(env, source.values));
+            }
+            column.Set("invalid", Napi::Number::New(env, static_cast<double>(source.invalid)));
+            columns[c] = column;
+        }
+
+        Napi::Object stats = Napi::Object::New(env);
+        stats.Set("fileSize", Napi::Number::New(env, static_cast<double>(fileSize)));
+        stats.Set("parseTimeMs", Napi::Number::New(env, parseTimeMs));
+        stats.Set("chunks", Napi::Number::New(env, static_cast<double>(result.chunks)));
+
+        Napi::Object object = Napi::Object::New(env);
+        object.Set("delimiter", Napi::String::New(env, std::string(1, result.format.delimiter)));
+        object.Set("rows", Napi::Number::New(env, static_cast<double>(result.rows)));
+        object.Set("prefixRows", prefix);
+        object.Set("columns", columns);
+        object.Set("stats", stats);
+        deferred.Resolve(object);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred.Reject(error.Value());
+    }
+
+private:
+    // First wave of a progressive parse, small for an early first message
+    static constexpr size_t FIRST_WAVE_BYTES = 256 * 1024;
+    static constexpr size_t OVERVIEW_BUCKETS = 2048;
+
+    Napi::Promise::Deferred deferred;
+    Napi::FunctionReference progressCallback;
+    bool prefixSent = false;
+    std::string path;
+    CsvOptions options;
+    CsvResult result;
+    size_t fileSize = 0;
+    double parseTimeMs = 0.0;
+};
+
+// parseCsvFile(path, options?, onProgress?) -> Promise<{ delimiter, rows, prefixRows, columns, stats }>,
+// each column { type, values | x, y, invalid }. onProgress({ rows, bytesParsed, fileSize,
+// delimiter, prefixRows (first call only), overview: { rowsPerBucket, columns: [{ min, max } | null] } })
+// runs on the main thread while the file is parsed.
+Napi::Value ParseCsvFile(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "File path expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    CsvOptions options;
+    if (info.Length() > 1 && !info[1].IsUndefined()) {
+        if (!info[1].IsObject()) {
+            Napi::TypeError::New(env, "Options must be an object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        if (!GetOptions(info[1].As<Napi::Object>(), options)) return env.Null();
+    }
+
+    Napi::Value onProgress = info.Length() > 2 ? info[2] : env.Undefined();
+    if (!onProgress.IsUndefined() && !onProgress.IsNull() && !onProgress.IsFunction()) {
+        Napi::TypeError::New(env, "onProgress must be a function").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    ParseWorker* worker = new ParseWorker(env, info[0].As<Napi::String>().Utf8Value(), options, onProgress);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+} // namespace
+
+// Module initialization
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("parseCsvFile", Napi::Function::New(env, ParseCsvFile));
+#ifdef CSV_SSE2
+    exports.Set("simd", Napi::String::New(env, "sse2"));
+#else
+    exports.Set("simd", Napi::String::New(env, "none"));
+#endif
+    return exports;
+}
+
+NODE_API_MODULE(csv_native, Init)
@@ -0,0 +1,304 @@
+// Field-level parsing for the CSV ingester: numbers with a point or comma
+// decimal separator, datetimes, {X=.., Y=..} coordinate pairs, and the
+// type classification used for per-column type inference.
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+enum class CsvType : uint8_t {
+    Empty,     // no cell had content
+    Number,    // 1.5, -2,25, 3e-4
+    DateTime,  // 2025-07-30 10:15:30.123456 or 31.07.2025 14:53:00
+    Pair,      // {X=0.013733, Y=2.268685}
+    Text
+};
+
+enum class CsvDecimal : uint8_t {
+    Auto,   // per field: comma if the field has a comma and no point
+    Point,
+    Comma
+};
+
+inline const char* CsvTypeName(CsvType type) {
+    switch (type) {
+        case CsvType::Number: return "number";
+        case CsvType::DateTime: return "datetime";
+        case CsvType::Pair: return "pair";
+        case CsvType::Text: return "text";
+        default: return "empty";
+    }
+}
+
+// A field as a byte range of the input
+struct CsvSpan {
+    const char* begin;
+    const char* end;
+
+    size_t size() const { return static_cast<size_t>(end - begin); }
+    bool empty() const { return begin == end; }
+};
+
+class CsvField {
+public:
+    // Strip blanks (space, tab, CR) at both ends
+    static CsvSpan trim(CsvSpan span) {
+        while (span.begin < span.end && isBlank(*span.begin)) span.begin++;
+        while (span.end > span.begin && isBlank(span.end[-1])) span.end--;
+        return span;
+    }
+
+    // Trimmed content without enclosing quotes (escaped quotes left as "")
+    static CsvSpan content(CsvSpan span) {
+        span = trim(span);
+        if (span.size() >= 2 && *span.begin == '"' && span.end[-1] == '"') {
+            span.begin++;
+            span.end--;
+            span = trim(span);
+        }
+        return span;
+    }
+
+    // Field content as a string, "" unescaped
+    static std::string text(CsvSpan span) {
+        span = content(span);
+        std::string out;
+        out.reserve(span.size());
+        for (const char* p = span.begin; p < span.end; p++) {
+            out.push_back(*p);
+            if (*p == '"' && p + 1 < span.end && p[1] == '"') p++;
+        }
+        return out;
+    }
+
+    // [+-]digits[sep digits][e[+-]digits], nothing else. Correctly rounded:
+    // exact when the mantissa and power of ten fit a double, from_chars
+    // otherwise.
+    static bool parseNumber(CsvSpan span, CsvDecimal decimal, double& out) {
+        const char* p = span.begin;
+        const char* end = span.end;
+        if (p == end) return false;
+
+        const char separator = separatorFor(span, decimal);
+        bool negative = false;
+        if (*p == '+' || *p == '-') {
+            negative = *p == '-';
+            p++;
+        }
+
+        uint64_t mantissa = 0;
+        int significant = 0;
+        int exponent = 0;
+        bool digits = false;
+        bool truncated = false;
+
+        for (; p < end && isDigit(*p); p++) {
+            digits = true;
+            if (significant < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0) significant++;
+            } else {
+                exponent++;
+                truncated |= *p != '0';
+            }
+        }
+        if (p < end && *p == separator) {
+            for (p++; p < end && isDigit(*p); p++) {
+                digits = true;
+                if (significant < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa != 0) significant++;
+                    exponent--;
+                } else {
+                    truncated |= *p != '0';
+                }
+            }
+        }
+        if (!digits) return false;
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            p++;
+            bool negativeExponent = false;
+            if (p < end && (*p == '+' || *p == '-')) {
+                negativeExponent = *p == '-';
+                p++;
+            }
+            if (p == end || !isDigit(*p)) return false;
+            int value = 0;
+            for (; p < end && isDigit(*p); p++) {
+                if (value < 100000) value = value * 10 + (*p - '0');
+            }
+            exponent += negativeExponent ? -value : value;
+        }
+        if (p != end) return false;
+
+        if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+            double value = static_cast<double>(mantissa);
+            value = exponent < 0 ? value / kPow10[-exponent] : value * kPow10[exponent];
+            out = negative ? -value : value;
+            return true;
+        }
+        return parseSlow(span, separator, exponent + significant > 0, out);
+    }
+
+    // yyyy-MM-dd[ T]HH:mm:ss[.ffffff] or d.M.yyyy H:m:s, as milliseconds
+    // since 1970-01-01 of the wall-clock time (no time zone applied)
+    static bool parseDateTime(CsvSpan span, double& out) {
+        const char* p = span.begin;
+        const char* end = span.end;
+        int year, month, day;
+
+        int first;
+        int firstDigits = readInt(p, end, 4, first);
+        if (firstDigits == 4 && p < end && *p == '-') {
+            year = first;
+            p++;
+            if (readInt(p, end, 2, month) != 2 || p == end || *p++ != '-') return false;
+            if (readInt(p, end, 2, day) != 2) return false;
+            if (p == end || (*p != ' ' && *p != 'T')) return false;
+            p++;
+        } else if (firstDigits >= 1 && firstDigits <= 2 && p < end && *p == '.') {
+            day = first;
+            p++;
+            if (readInt(p, end, 2, month) < 1 || p == end || *p++ != '.') return false;
+            if (readInt(p, end, 4, year) != 4) return false;
+            if (p == end || *p != ' ') return false;
+            while (p < end && *p == ' ') p++;
+        } else {
+            return false;
+        }
+
+        int hour, minute, second;
+        if (readInt(p, end, 2, hour) < 1 || p == end || *p++ != ':') return false;
+        if (readInt(p, end, 2, minute) < 1 || p == end || *p++ != ':') return false;
+        if (readInt(p, end, 2, second) < 1) return false;
+
+        // Fraction as an integer over a power of ten: ms = digits / 10^(n - 3)
+        double fraction = 0.0;
+        if (p < end && *p == '.') {
+            p++;
+            uint64_t digits = 0;
+            int count = 0;
+            if (p == end || !isDigit(*p)) return false;
+            for (; p < end && isDigit(*p); p++) {
+                if (count < 9) {
+                    digits = digits * 10 + static_cast<uint64_t>(*p - '0');
+                    count++;
+                }
+            }
+            fraction = count >= 3 ? static_cast<double>(digits) / kPow10[count - 3]
+                                  : static_cast<double>(digits) * kPow10[3 - count];
+        }
+        if (p != end) return false;
+        if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+
+        double days = static_cast<double>(daysFromCivil(year, month, day));
+        out = ((days * 24.0 + hour) * 60.0 + minute) * 60000.0 + second * 1000.0 + fraction;
+        return true;
+    }
+
+    // {X=number, Y=number}; numbers use a decimal point
+    static bool parsePair(CsvSpan span, double& x, double& y) {
+        const char* p = span.begin;
+        const char* end = span.end;
+        if (end - p < 9 || *p != '{' || end[-1] != '}') return false;
+        p++;
+        skipSpaces(p, end);
+        if (end - p < 2 || p[0] != 'X' || p[1] != '=') return false;
+        p += 2;
+
+        const char* xBegin = p;
+        while (p < end && *p != ',') p++;
+        if (p == end || !parseNumber(CsvField::trim({ xBegin, p }), CsvDecimal::Point, x)) return false;
+        p++;
+        skipSpaces(p, end);
+        if (end - p < 2 || p[0] != 'Y' || p[1] != '=') return false;
+        p += 2;
+
+        return parseNumber(CsvField::trim({ p, end - 1 }), CsvDecimal::Point, y);
+    }
+
+    // Type of one field's content
+    static CsvType classify(CsvSpan span, CsvDecimal decimal) {
+        span = content(span);
+        if (span.empty()) return CsvType::Empty;
+
+        double a, b;
+        if (parseNumber(span, decimal, a)) return CsvType::Number;
+        if (*span.begin == '{' && parsePair(span, a, b)) return CsvType::Pair;
+        if (isDigit(*span.begin) && parseDateTime(span, a)) return CsvType::DateTime;
+        return CsvType::Text;
+    }
+
+private:
+    static constexpr double kPow10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    static void skipSpaces(const char*& p, const char* end) {
+        while (p < end && *p == ' ') p++;
+    }
+
+    static char separatorFor(CsvSpan span, CsvDecimal decimal) {
+        if (decimal == CsvDecimal::Point) return '.';
+        if (decimal == CsvDecimal::Comma) return ',';
+        bool comma = false;
+        for (const char* p = span.begin; p < span.end; p++) {
+            if (*p == '.') return '.';
+            comma |= *p == ',';
+        }
+        return comma ? ',' : '.';
+    }
+
+    // Up to maxDigits digits; returns the number read
+    static int readInt(const char*& p, const char* end, int maxDigits, int& value) {
+        int count = 0;
+        value = 0;
+        while (p < end && count < maxDigits && isDigit(*p)) {
+            value = value * 10 + (*p++ - '0');
+            count++;
+        }
+        return count;
+    }
+
+    // Days since 1970-01-01 of a proleptic Gregorian date
+    static int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+        const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+    }
+
+    // Long or out-of-range mantissas: normalize the separator and let
+    // from_chars round. large tells overflow (to infinity) from underflow
+    // (to zero), which from_chars reports alike.
+    static bool parseSlow(CsvSpan span, char separator, bool large, double& out) {
+        char buffer[128];
+        size_t length = 0;
+        for (const char* p = span.begin; p < span.end; p++) {
+            if (length == sizeof(buffer)) return false;
+            if (*p == '+' && p == span.begin) continue;
+            buffer[length++] = *p == separator ? '.' : *p;
+        }
+        auto result = std::from_chars(buffer, buffer + length, out);
+        if (result.ptr != buffer + length) return false;
+        if (result.ec == std::errc::result_out_of_range) {
+            double magnitude = large ? std::numeric_limits<double>::infinity() : 0.0;
+            out = buffer[0] == '-' ? -magnitude : magnitude;
+            return true;
+        }
+        return result.ec == std::errc();
+    }
+};
@@ -0,0 +1,101 @@
+// Coarse min/max overview of the number and datetime columns, grown while
+// rows are parsed so a rough plot can be drawn before the file is done.
+//
+// Each bucket covers rowsPerBucket consecutive rows (a power of two). Once
+// the rows no longer fit maxBuckets buckets, neighbouring buckets merge and
+// rowsPerBucket doubles, so the overview stays between maxBuckets / 2 and
+// maxBuckets buckets whatever the file size. NaN values are ignored.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "csv_parser.h"
+
+class CsvOverview {
+public:
+    explicit CsvOverview(size_t maxBuckets = 1024) : maxBuckets(std::max<size_t>(2, maxBuckets & ~size_t(1))) {}
+
+    // Adds rows [rows(), end) of columns, which must hold at least end rows
+    void update(const std::vector<CsvColumn>& columns, size_t end) {
+        if (end <= count) return;
+        if (ranges.size() < columns.size()) ranges.resize(columns.size());
+        while ((end + perBucket - 1) / perBucket > maxBuckets) merge();
+
+        const size_t buckets = (end + perBucket - 1) / perBucket;
+        for (size_t c = 0; c < columns.size(); c++) {
+            const CsvColumn& column = columns[c];
+            if (column.type != CsvType::Number && column.type != CsvType::DateTime) continue;
+
+            Range& range = ranges[c];
+            range.tracked = true;
+            range.min.resize(buckets, kEmptyMin);
+            range.max.resize(buckets, kEmptyMax);
+
+            const double* values = column.values.data();
+            for (size_t row = count; row < end;) {
+                const size_t bucket = row / perBucket;
+                const size_t stop = std::min(end, (bucket + 1) * perBucket);
+                double low = range.min[bucket];
+                double high = range.max[bucket];
+                for (; row < stop; row++) {
+                    const double value = values[row];
+                    if (value < low) low = value;
+                    if (value > high) high = value;
+                }
+                range.min[bucket] = low;
+                range.max[bucket] = high;
+            }
+        }
+        count = end;
+    }
+
+    size_t rows() const { return count; }
+    size_t rowsPerBucket() const { return perBucket; }
+    size_t buckets() const { return (count + perBucket - 1) / perBucket; }
+
+    // Whether column c has an overview (number and datetime columns)
+    bool tracked(size_t c) const { return c < ranges.size() && ranges[c].tracked; }
+
+    // Bucket minima and maxima of column c, NaN for buckets without values
+    void copy(size_t c, std::vector<double>& min, std::vector<double>& max) const {
+        const Range& range = ranges[c];
+        min = range.min;
+        max = range.max;
+        for (size_t b = 0; b < min.size(); b++) {
+            if (min[b] > max[b]) min[b] = max[b] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+private:
+    static constexpr double kEmptyMin = std::numeric_limits<double>::infinity();
+    static constexpr double kEmptyMax = -std::numeric_limits<double>::infinity();
+
+    struct Range {
+        bool tracked = false;
+        std::vector<double> min;
+        std::vector<double> max;
+    };
+
+    // Halve the bucket count: bucket b takes buckets 2b and 2b + 1
+    void merge() {
+        for (Range& range : ranges) {
+            const size_t merged = (range.min.size() + 1) / 2;
+            for (size_t b = 0; b < merged; b++) {
+                const size_t pair = std::min(2 * b + 1, range.min.size() - 1);
+                range.min[b] = std::min(range.min[2 * b], range.min[pair]);
+                range.max[b] = std::max(range.max[2 * b], range.max[pair]);
+            }
+            range.min.resize(merged);
+            range.max.resize(merged);
+        }
+        perBucket *= 2;
+    }
+
+    size_t maxBuckets;
+    size_t perBucket = 1;
+    size_t count = 0;
+    std::vector<Range> ranges;
+};
@@ -0,0 +1,474 @@
+// CSV ingester: splits rows and fields with the structural scanner, infers a
+// type per column from the first rows and parses every row straight into
+// typed columns. Node-free so it can be used (and benchmarked) outside the
+// addon.
+//
+// Rows follow Papa Parse's rules as used by the readers: quoted fields may
+// contain delimiters, lines starting with the comment character are
+// skipped, and empty lines are skipped unless skipEmptyLines is off.
+//
+// Large files are split at row boundaries into chunks parsed on separate
+// threads and stitched in order; the format comes from the first rows only.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "csv_field.h"
+#include "csv_scan.h"
+
+struct CsvOptions {
+    char delimiter = 0;            // 0: detect from the first lines
+    char comment = 0;              // 0: no comment lines
+    CsvDecimal decimal = CsvDecimal::Auto;
+    bool skipEmptyLines = true;
+    size_t prefixRows = 100;       // leading rows also returned as text
+    size_t inferRows = 1000;       // leading rows sampled for column types
+    size_t maxColumns = 256;
+    size_t threads = 0;            // 0: one per core, up to 8
+    size_t minChunkBytes = 4 << 20; // smaller files are parsed on one thread
+    std::vector<CsvType> types;    // fixed column types, no inference; other
+                                   // columns only appear in the prefix rows
+};
+
+// Delimiter and column types, fixed from the first rows
+struct CsvFormat {
+    char delimiter = ',';
+    std::vector<CsvType> types;
+    double bytesPerRow = 0.0;      // in the sampled rows, for reserving
+};
+
+// One column, one entry per row (NaN where a cell is missing, empty or
+// does not parse as the column type). Text and empty columns hold no values.
+struct CsvColumn {
+    CsvType type = CsvType::Empty;
+    std::vector<double> values;    // number, datetime (ms), pair x
+    std::vector<double> y;         // pair y
+    size_t invalid = 0;            // non-empty cells that did not parse
+};
+
+struct CsvResult {
+    CsvFormat format;
+    std::vector<std::vector<std::string>> prefix;
+    std::vector<CsvColumn> columns;
+    size_t rows = 0;
+    size_t chunks = 0;             // row-aligned parts parsed
+};
+
+class CsvParser {
+public:
+    // Whole file: inspect the first rows, then parse all rows, in chunks
+    // when the file is large enough
+    static void parse(const uint8_t* data, size_t size, const CsvOptions& options, CsvResult& result) {
+        inspect(data, size, options, result);
+
+        const size_t begin = dataStart(data, size);
+        const size_t threads = threadCount(options);
+        const size_t chunks = std::min(threads, (size - begin) / std::max<size_t>(1, options.minChunkBytes));
+
+        std::vector<size_t> targets;
+        for (size_t i = 1; i < chunks; i++) targets.push_back(begin + (size - begin) / chunks * i);
+        const std::vector<size_t> bounds = rowBounds(data, begin, size, targets, threads);
+        parseWaves(data, bounds, { bounds.size() - 1 }, options, result, [](size_t) {});
+    }
+
+    // Like parse, in waves of growing size: the first firstWaveBytes on one
+    // thread, each later wave four times larger (up to MAX_WAVE_BYTES) and in
+    // chunks. onWave(bytesParsed) runs after every wave on the calling
+    // thread, with result.rows rows of result.columns complete.
+    template <typename OnWave>
+    static void parseProgressive(const uint8_t* data, size_t size, const CsvOptions& options, CsvResult& result,
+                                 size_t firstWaveBytes, OnWave&& onWave) {
+        inspect(data, size, options, result);
+
+        const size_t begin = dataStart(data, size);
+        const size_t threads = threadCount(options);
+        std::vector<size_t> targets;
+        std::vector<size_t> waveStarts;
+        size_t waveBytes = std::max<size_t>(1, firstWaveBytes);
+        for (size_t start = begin; start < size;) {
+            const size_t length = std::min(waveBytes, size - start);
+            const size_t chunks = std::clamp<size_t>(length / std::max<size_t>(1, options.minChunkBytes), 1, threads);
+            if (start > begin) targets.push_back(start);
+            waveStarts.push_back(start);
+            for (size_t i = 1; i < chunks; i++) targets.push_back(start + length / chunks * i);
+            start += length;
+            waveBytes = std::min(waveBytes * 4, MAX_WAVE_BYTES);
+        }
+        const std::vector<size_t> bounds = rowBounds(data, begin, size, targets, threads);
+
+        // A wave is the chunks starting in its byte range
+        std::vector<size_t> waveEnds;
+        size_t wave = 0;
+        for (size_t i = 1; i + 1 < bounds.size(); i++) {
+            const size_t chunkWave = static_cast<size_t>(
+                std::upper_bound(waveStarts.begin(), waveStarts.end(), bounds[i]) - waveStarts.begin()) - 1;
+            if (chunkWave != wave) {
+                waveEnds.push_back(i);
+                wave = chunkWave;
+            }
+        }
+        waveEnds.push_back(bounds.size() - 1);
+        parseWaves(data, bounds, waveEnds, options, result, onWave);
+    }
+
+    // Row-aligned bounds for [begin, end): each target moved past the next
+    // newline, dropped where that newline is inside quotes (going by the
+    // parity of the quotes before it, counted on up to threads threads).
+    // Returns begin, the inner bounds and end.
+    static std::vector<size_t> rowBounds(const uint8_t* data, size_t begin, size_t end,
+                                         const std::vector<size_t>& targets, size_t threads) {
+        std::vector<size_t> bounds = { begin };
+        for (size_t target : targets) {
+            target = std::max(target, bounds.back());
+            const uint8_t* newline = static_cast<const uint8_t*>(std::memchr(data + target, '\n', end - target));
+            if (!newline) break;
+            const size_t bound = static_cast<size_t>(newline - data) + 1;
+            if (bound > bounds.back() && bound < end) bounds.push_back(bound);
+        }
+        bounds.push_back(end);
+        if (bounds.size() <= 2) return bounds;
+
+        std::vector<size_t> quotes(bounds.size() - 1);
+        const size_t workers = std::min(threads, quotes.size());
+        runParallel(workers, [&](size_t worker) {
+            for (size_t i = worker; i < quotes.size(); i += workers) {
+                quotes[i] = static_cast<size_t>(std::count(data + bounds[i], data + bounds[i + 1], '"'));
+            }
+        });
+
+        std::vector<size_t> outside = { begin };
+        size_t parity = 0;
+        for (size_t i = 1; i + 1 < bounds.size(); i++) {
+            parity += quotes[i - 1];
+            if (parity % 2 == 0) outside.push_back(bounds[i]);
+        }
+        outside.push_back(end);
+        return outside;
+    }
+
+    // Offset of the first row: past a UTF-8 byte order mark, if any
+    static size_t dataStart(const uint8_t* data, size_t size) {
+        return size >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF ? 3 : 0;
+    }
+
+    // Delimiter as the Acceleration reader picked it: the character found on
+    // most of the first 20 lines, tab and semicolon only if strictly ahead
+    static char detectDelimiter(const uint8_t* data, size_t size) {
+        int tabs = 0, commas = 0, semicolons = 0;
+        size_t pos = 0;
+        for (int line = 0; line < 20 && pos < size; line++) {
+            const uint8_t* newline = static_cast<const uint8_t*>(std::memchr(data + pos, '\n', size - pos));
+            const size_t lineEnd = newline ? static_cast<size_t>(newline - data) : size;
+            bool tab = false, comma = false, semicolon = false;
+            for (size_t i = pos; i < lineEnd; i++) {
+                tab |= data[i] == '\t';
+                comma |= data[i] == ',';
+                semicolon |= data[i] == ';';
+            }
+            tabs += tab;
+            commas += comma;
+            semicolons += semicolon;
+            pos = lineEnd + 1;
+        }
+        if (tabs > commas && tabs > semicolons) return '\t';
+        if (semicolons > commas && semicolons > tabs) return ';';
+        return ',';
+    }
+
+    // Delimiter, prefix rows and column types from the first rows
+    static void inspect(const uint8_t* data, size_t size, const CsvOptions& options, CsvResult& result) {
+        const size_t begin = dataStart(data, size);
+        result.format.delimiter = options.delimiter ? options.delimiter : detectDelimiter(data + begin, size - begin);
+        result.prefix.clear();
+
+        const size_t inferRows = options.types.empty() ? options.inferRows : 0;
+        const size_t sampleRows = std::max(options.prefixRows, inferRows);
+        std::vector<std::array<size_t, 5>> counts;
+        size_t row = 0;
+
+        const size_t sampled = forEachRow(data, begin, size, options, result.format.delimiter,
+            [&](const CsvSpan* fields, size_t count) {
+                count = std::min(count, options.maxColumns);
+                if (row < options.prefixRows) {
+                    std::vector<std::string> cells(count);
+                    for (size_t c = 0; c < count; c++) cells[c] = CsvField::text(fields[c]);
+                    result.prefix.push_back(std::move(cells));
+                }
+                if (row < inferRows) {
+                    if (counts.size() < count) counts.resize(count, std::array<size_t, 5>{});
+                    for (size_t c = 0; c < count; c++) {
+                        counts[c][static_cast<size_t>(CsvField::classify(fields[c], options.decimal))]++;
+                    }
+                }
+                return ++row < sampleRows;
+            });
+
+        if (!options.types.empty()) {
+            result.format.types = options.types;
+        } else {
+            result.format.types.resize(counts.size());
+            for (size_t c = 0; c < counts.size(); c++) {
+                result.format.types[c] = dominantType(counts[c]);
+            }
+        }
+        result.format.bytesPerRow = row > 0 ? static_cast<double>(sampled - begin) / static_cast<double>(row) : 0.0;
+    }
+
+    // Rows of [begin, end) (begin at a row start) appended to columns, typed
+    // as format.types; returns the number of rows. openQuote, if given, is
+    // set when end falls inside a quoted field.
+    static size_t parseRows(const uint8_t* data, size_t begin, size_t end, const CsvOptions& options,
+                            const CsvFormat& format, std::vector<CsvColumn>& columns,
+                            bool* openQuote = nullptr) {
+        reserveRows(format, end - begin, columns);
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        size_t rows = 0;
+        forEachRow(data, begin, end, options, format.delimiter, [&](const CsvSpan* fields, size_t count) {
+            for (size_t c = 0; c < columns.size(); c++) {
+                CsvColumn& column = columns[c];
+                if (column.type == CsvType::Text || column.type == CsvType::Empty) continue;
+
+                const CsvSpan span = c < count ? CsvField::content(fields[c]) : CsvSpan{ nullptr, nullptr };
+                double value = nan, y = nan;
+                bool parsed = true;
+                if (!span.empty()) {
+                    switch (column.type) {
+                        case CsvType::Number: parsed = CsvField::parseNumber(span, options.decimal, value); break;
+                        case CsvType::DateTime: parsed = CsvField::parseDateTime(span, value); break;
+                        default: parsed = CsvField::parsePair(span, value, y); break;
+                    }
+                    if (!parsed) {
+                        value = y = nan;
+                        column.invalid++;
+                    }
+                }
+                column.values.push_back(value);
+                if (column.type == CsvType::Pair) column.y.push_back(y);
+            }
+            rows++;
+            return true;
+        }, openQuote);
+        return rows;
+    }
+
+    // Calls onRow(fields, count) for every row of [begin, end), begin being a
+    // row start, until it returns false. Returns the offset after the last
+    // row visited; openQuote, if given, tells whether the scan ended inside
+    // a quoted field.
+    template <typename OnRow>
+    static size_t forEachRow(const uint8_t* data, size_t begin, size_t end, const CsvOptions& options,
+                             char delimiter, OnRow&& onRow, bool* openQuote = nullptr) {
+        const char* text = reinterpret_cast<const char*>(data);
+        std::vector<CsvSpan> fields;
+        fields.reserve(16);
+
+        auto emit = [&]() {
+            if (options.skipEmptyLines && fields.size() == 1 && CsvField::trim(fields[0]).empty()) return true;
+            return static_cast<bool>(onRow(fields.data(), fields.size()));
+        };
+
+        size_t pos = skipComments(data, begin, end, options.comment);
+        size_t fieldStart = pos;
+        uint64_t inQuote = 0;
+
+        while (pos < end) {
+            const size_t length = std::min(CsvScan::BLOCK, end - pos);
+            const CsvScan::Masks masks = CsvScan::classify(data + pos, length, static_cast<uint8_t>(delimiter));
+            const uint64_t quoted = CsvScan::prefixXor(masks.quote) ^ inQuote;
+            inQuote = (quoted >> 63) ? ~uint64_t(0) : 0;
+
+            uint64_t structural = (masks.delimiter | masks.newline) & ~quoted;
+            size_t next = pos + length;
+            while (structural) {
+                const unsigned bit = CsvScan::lowestBit(structural);
+                structural &= structural - 1;
+                const size_t at = pos + bit;
+                fields.push_back({ text + fieldStart, text + at });
+                fieldStart = at + 1;
+
+                if ((masks.newline >> bit) & 1) {
+                    if (!emit()) return at + 1;
+                    fields.clear();
+                    if (options.comment && at + 1 < end && data[at + 1] == static_cast<uint8_t>(options.comment)) {
+                        // Restart the block scan after the comment lines
+                        next = fieldStart = skipComments(data, at + 1, end, options.comment);
+                        inQuote = 0;
+                        break;
+                    }
+                }
+            }
+            pos = next;
+        }
+
+        if (openQuote) *openQuote = inQuote != 0;
+        if (fieldStart < end || !fields.empty()) {
+            fields.push_back({ text + fieldStart, text + end });
+            emit();
+        }
+        return end;
+    }
+
+    // Typed columns for format, with room for the rows expected in bytes
+    // more input
+    static void reserveRows(const CsvFormat& format, size_t bytes, std::vector<CsvColumn>& columns) {
+        columns.resize(format.types.size());
+        const size_t expectedRows = format.bytesPerRow > 0
+            ? static_cast<size_t>(static_cast<double>(bytes) / format.bytesPerRow * 1.05) + 16
+            : 0;
+        for (size_t c = 0; c < columns.size(); c++) {
+            CsvColumn& column = columns[c];
+            column.type = format.types[c];
+            if (column.type == CsvType::Number || column.type == CsvType::DateTime || column.type == CsvType::Pair) {
+                column.values.reserve(column.values.size() + expectedRows);
+            }
+            if (column.type == CsvType::Pair) column.y.reserve(column.y.size() + expectedRows);
+        }
+    }
+
+    static size_t defaultThreadCount() {
+        const unsigned cores = std::thread::hardware_concurrency();
+        return std::max(1u, std::min(cores, 8u));
+    }
+
+    // Largest wave of parseProgressive
+    static constexpr size_t MAX_WAVE_BYTES = size_t(64) << 20;
+
+private:
+    static size_t threadCount(const CsvOptions& options) {
+        return options.threads ? options.threads : defaultThreadCount();
+    }
+
+    // Runs task(0..count-1) on count threads, the calling thread taking
+    // task 0; rethrows the first exception once all have finished
+    template <typename Task>
+    static void runParallel(size_t count, Task&& task) {
+        std::vector<std::exception_ptr> errors(count);
+        auto run = [&](size_t i) {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < count; i++) {
+            threads.emplace_back(run, i);
+        }
+        run(0);
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        for (const std::exception_ptr& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    // Parses the chunks between bounds wave by wave (waveEnds: index after
+    // the last chunk of each wave), the chunks of a wave concurrently, and
+    // appends them to result.columns in order; the first chunk of a wave
+    // parses straight into result.columns, reserved for the whole input.
+    // A chunk ending inside a quoted field means the quote parity misjudged
+    // the bound after it (e.g. after quotes in a comment line): the rows
+    // from that chunk on are parsed again on one thread.
+    template <typename OnWave>
+    static void parseWaves(const uint8_t* data, const std::vector<size_t>& bounds,
+                           const std::vector<size_t>& waveEnds, const CsvOptions& options,
+                           CsvResult& result, OnWave&& onWave) {
+        const size_t chunks = bounds.size() - 1;
+        std::vector<CsvColumn>& columns = result.columns;
+        columns.clear();
+        reserveRows(result.format, bounds.back() - bounds.front(), columns);
+        result.rows = 0;
+        result.chunks = 0;
+
+        size_t first = 0;
+        for (size_t waveEnd : waveEnds) {
+            const size_t count = waveEnd - first;
+            std::vector<std::vector<CsvColumn>> parts(count);
+            std::vector<size_t> rows(count, 0);
+            std::vector<uint8_t> open(count, 0);
+            std::vector<size_t> invalid(columns.size());
+            for (size_t c = 0; c < columns.size(); c++) invalid[c] = columns[c].invalid;
+
+            runParallel(count, [&](size_t k) {
+                bool openQuote = false;
+                rows[k] = parseRows(data, bounds[first + k], bounds[first + k + 1], options, result.format,
+                                    k == 0 ? columns : parts[k], &openQuote);
+                open[k] = openQuote;
+            });
+
+            size_t valid = count;
+            for (size_t k = 0; k < count && first + k + 1 < chunks; k++) {
+                if (open[k]) {
+                    valid = k;
+                    break;
+                }
+            }
+            if (valid == 0) {
+                for (size_t c = 0; c < columns.size(); c++) {
+                    if (columns[c].values.size() > result.rows) columns[c].values.resize(result.rows);
+                    if (columns[c].y.size() > result.rows) columns[c].y.resize(result.rows);
+                    columns[c].invalid = invalid[c];
+                }
+            } else {
+                result.rows += rows[0];
+            }
+
+            for (size_t k = 1; k < valid; k++) {
+                for (size_t c = 0; c < columns.size(); c++) {
+                    CsvColumn& part = parts[k][c];
+                    columns[c].values.insert(columns[c].values.end(), part.values.begin(), part.values.end());
+                    columns[c].y.insert(columns[c].y.end(), part.y.begin(), part.y.end());
+                    columns[c].invalid += part.invalid;
+                    std::vector<double>().swap(part.values);
+                    std::vector<double>().swap(part.y);
+                }
+                result.rows += rows[k];
+            }
+            result.chunks += valid;
+
+            if (valid < count) {
+                result.rows += parseRows(data, bounds[first + valid], bounds.back(), options, result.format, columns);
+                result.chunks++;
+                onWave(bounds.back());
+                return;
+            }
+            onWave(bounds[waveEnd]);
+            first = waveEnd;
+        }
+    }
+
+    static size_t skipComments(const uint8_t* data, size_t pos, size_t end, char comment) {
+        while (comment && pos < end && data[pos] == static_cast<uint8_t>(comment)) {
+            const uint8_t* newline = static_cast<const uint8_t*>(std::memchr(data + pos, '\n', end - pos));
+            pos = newline ? static_cast<size_t>(newline - data) + 1 : end;
+        }
+        return pos;
+    }
+
+    // Most frequent typed content of a column (number before pair before
+    // datetime on ties); text if text cells outnumber it
+    static CsvType dominantType(const std::array<size_t, 5>& counts) {
+        CsvType best = CsvType::Number;
+        for (CsvType type : { CsvType::Pair, CsvType::DateTime }) {
+            if (counts[static_cast<size_t>(type)] > counts[static_cast<size_t>(best)]) best = type;
+        }
+        const size_t bestCount = counts[static_cast<size_t>(best)];
+        const size_t textCount = counts[static_cast<size_t>(CsvType::Text)];
+        if (bestCount == 0) return textCount > 0 ? CsvType::Text : CsvType::Empty;
+        return textCount > bestCount ? CsvType::Text : best;
+    }
+};
@@ -0,0 +1,94 @@
+// Structural scanning for the CSV ingester: 64-byte blocks are classified
+// into delimiter, newline and quote bitmasks (SSE2, 16 bytes per compare),
+// quoted regions are masked with a prefix XOR over the quote bits, and the
+// remaining delimiter/newline bits are the field boundaries.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CSV_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class CsvScan {
+public:
+    static constexpr size_t BLOCK = 64;
+
+    struct Masks {
+        uint64_t delimiter;
+        uint64_t newline;
+        uint64_t quote;
+    };
+
+    // Masks of the first length (<= 64) bytes at p; reads only those bytes
+    static Masks classify(const uint8_t* p, size_t length, uint8_t delimiter) {
+        if (length < BLOCK) {
+            uint8_t padded[BLOCK] = {};
+            std::memcpy(padded, p, length);
+            Masks masks = classifyBlock(padded, delimiter);
+            const uint64_t valid = (uint64_t(1) << length) - 1;
+            masks.delimiter &= valid;
+            masks.newline &= valid;
+            masks.quote &= valid;
+            return masks;
+        }
+        return classifyBlock(p, delimiter);
+    }
+
+    // Bit i set if an odd number of bits at or below i are set: the bytes
+    // from an opening quote up to (not including) its closing quote
+    static uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    static unsigned lowestBit(uint64_t bits) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+    }
+
+private:
+    static Masks classifyBlock(const uint8_t* p, uint8_t delimiter) {
+        Masks masks = { 0, 0, 0 };
+#ifdef CSV_SSE2
+        const __m128i vDelimiter = _mm_set1_epi8(static_cast<char>(delimiter));
+        const __m128i vNewline = _mm_set1_epi8('\n');
+        const __m128i vQuote = _mm_set1_epi8('"');
+        for (int part = 0; part < 4; part++) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + part * 16));
+            const int shift = part * 16;
+            masks.delimiter |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, vDelimiter)))) << shift;
+            masks.newline |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, vNewline)))) << shift;
+            masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, vQuote)))) << shift;
+        }
+#else
+        for (size_t i = 0; i < BLOCK; i++) {
+            const uint64_t bit = uint64_t(1) << i;
+            if (p[i] == delimiter) masks.delimiter |= bit;
+            if (p[i] == '\n') masks.newline |= bit;
+            if (p[i] == '"') masks.quote |= bit;
+        }
+#endif
+        return masks;
+    }
+};
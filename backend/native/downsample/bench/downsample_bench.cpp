@@ -0,0 +1,333 @@
+// Downsampling kernel benchmark on synthetic sensor signals.
+//
+// Generates float and double signals shaped like the data the processors
+// serve (a drifting sine with noise and sparse spikes, on an index axis or
+// a jittered time array) and, for each kernel of downsample.h, measures
+// the throughput over the whole signal at a typical plot width against a
+// plain scalar loop with the same rules. The selected samples must match
+// the scalar loop exactly; any difference is reported and fails the run.
+//
+// Build with bench/CMakeLists.txt; see --help for options.
+#include "downsample.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Options {
+    std::vector<size_t> sizes = { 100000, 1000000, 10000000, 50000000 };
+    size_t points = 2000;
+    int repeats = 5;
+    bool quick = false;
+};
+
+template <typename T>
+struct Signal {
+    std::vector<T> values;
+    std::vector<T> time;
+};
+
+// Drifting sine, noise, a spike every ~10k samples, and a few NaN gaps
+template <typename T>
+Signal<T> makeSignal(size_t n, unsigned seed) {
+    Signal<T> signal;
+    signal.values.resize(n);
+    signal.time.resize(n);
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    std::uniform_real_distribution<double> jitter(0.9, 1.1);
+    std::uniform_int_distribution<size_t> spike(0, 10000);
+
+    double t = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double value = std::sin(i * 2e-4) + 0.3 * std::sin(i * 3.1e-3) + noise(rng);
+        if (spike(rng) == 0) value += (rng() % 2 ? 5.0 : -5.0);
+        signal.values[i] = static_cast<T>(value);
+        signal.time[i] = static_cast<T>(t);
+        t += jitter(rng);
+    }
+    for (size_t gap = n / 7; gap + 16 < n; gap += n / 3 + 1) {
+        for (size_t i = gap; i < gap + 16; i++) signal.values[i] = std::numeric_limits<T>::quiet_NaN();
+    }
+    return signal;
+}
+
+// === Scalar references (one plain loop each, same rules as downsample.h) ===
+
+template <typename V>
+Downsample::Extremes scalarExtremes(const V* values, size_t first, size_t last) {
+    size_t minIndex = first, maxIndex = first;
+    V lo = std::numeric_limits<V>::infinity(), hi = -std::numeric_limits<V>::infinity();
+    for (size_t i = first; i < last; i++) {
+        if (values[i] < lo) { lo = values[i]; minIndex = i; }
+        if (values[i] > hi) { hi = values[i]; maxIndex = i; }
+    }
+    return { minIndex, maxIndex };
+}
+
+template <typename V>
+void scalarEnvelope(const V* values, size_t count, size_t buckets, std::vector<size_t>& out) {
+    out.clear();
+    buckets = std::min(buckets, count);
+    for (size_t b = 0; b < buckets; b++) {
+        auto e = scalarExtremes(values, count * b / buckets, count * (b + 1) / buckets);
+        out.push_back(e.minIndex);
+        out.push_back(e.maxIndex);
+    }
+}
+
+template <typename V>
+void scalarM4(const V* values, size_t count, size_t buckets, std::vector<size_t>& out) {
+    out.clear();
+    buckets = std::min(buckets, count);
+    for (size_t b = 0; b < buckets; b++) {
+        size_t first = count * b / buckets, last = count * (b + 1) / buckets;
+        auto e = scalarExtremes(values, first, last);
+        size_t picks[4] = { first, e.minIndex, e.maxIndex, last - 1 };
+        std::sort(picks, picks + 4);
+        for (size_t pick : picks) {
+            if (out.empty() || out.back() != pick) out.push_back(pick);
+        }
+    }
+}
+
+// Two interleaved partial sums, the order downsample.h uses
+template <typename F>
+double laneSum(size_t first, size_t last, F term) {
+    double lanes[2] = { 0.0, 0.0 };
+    size_t i = first;
+    for (; i + 2 <= last; i += 2) {
+        lanes[0] += term(i);
+        lanes[1] += term(i + 1);
+    }
+    if (i < last) lanes[0] += term(i);
+    return lanes[0] + lanes[1];
+}
+
+template <typename V, typename Axis>
+void scalarRms(const V* values, Axis x, size_t count, size_t buckets, std::vector<double>& out) {
+    out.clear();
+    buckets = std::min(buckets, count);
+    for (size_t b = 0; b < buckets; b++) {
+        size_t first = count * b / buckets, last = count * (b + 1) / buckets;
+        double n = static_cast<double>(last - first);
+        out.push_back(laneSum(first, last, [&](size_t i) { double v = values[i]; return v * v; }) / n);
+        out.push_back(laneSum(first, last, [&](size_t i) { return x(i); }) / n);
+    }
+    for (size_t i = 0; i < out.size(); i += 2) out[i] = std::sqrt(out[i]);
+}
+
+template <typename V, typename Axis>
+void scalarLttb(const V* values, Axis x, size_t n, size_t threshold, std::vector<size_t>& out) {
+    out.clear();
+    if (n <= threshold) {
+        for (size_t k = 0; k < n; k++) out.push_back(k);
+        return;
+    }
+    const double every = static_cast<double>(n - 2) / static_cast<double>(threshold - 2);
+    size_t a = 0;
+    out.push_back(0);
+    for (size_t i = 0; i < threshold - 2; i++) {
+        size_t avgFirst = static_cast<size_t>(std::floor((i + 1) * every)) + 1;
+        size_t avgLast = std::min(static_cast<size_t>(std::floor((i + 2) * every)) + 1, n);
+        double count = static_cast<double>(avgLast - avgFirst);
+        double avgX = laneSum(avgFirst, avgLast, [&](size_t k) { return x(k); }) / count;
+        double avgY = laneSum(avgFirst, avgLast, [&](size_t k) { return static_cast<double>(values[k]); }) / count;
+
+        size_t first = static_cast<size_t>(std::floor(i * every)) + 1;
+        size_t last = static_cast<size_t>(std::floor((i + 1) * every)) + 1;
+        double ax = x(a), ay = values[a];
+        double maxArea = -1.0;
+        size_t next = first;
+        for (size_t k = first; k < last; k++) {
+            double area = std::abs((ax - avgX) * (values[k] - ay) - (ax - x(k)) * (avgY - ay));
+            if (area > maxArea) { maxArea = area; next = k; }
+        }
+        out.push_back(next);
+        a = next;
+    }
+    out.push_back(n - 1);
+}
+
+// === Timing ===
+
+struct Result {
+    double simdMs = 0;
+    double scalarMs = 0;
+    bool match = true;
+};
+
+template <typename F>
+double bestOf(int repeats, F run) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto started = Clock::now();
+        run();
+        best = std::min(best, secondsSince(started) * 1000.0);
+    }
+    return best;
+}
+
+void report(const char* kernel, const char* type, size_t n, const Result& result) {
+    double samplesPerSecond = n / (result.simdMs / 1000.0);
+    std::cout << "  " << std::left << std::setw(12) << kernel << std::setw(8) << type << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10) << result.simdMs << " ms "
+              << std::setprecision(0) << std::setw(8) << samplesPerSecond / 1e6 << " M samples/s"
+              << std::setprecision(2) << "   scalar " << std::setw(9) << result.scalarMs << " ms ("
+              << std::setprecision(1) << result.scalarMs / result.simdMs << "x)"
+              << (result.match ? "" : "   MISMATCH") << std::endl;
+}
+
+template <typename T>
+bool runSize(const Options& options, size_t n, const char* type) {
+    Signal<T> signal = makeSignal<T>(n, 42);
+    const T* values = signal.values.data();
+    Downsample::TimeAxis<T> time{ signal.time.data() };
+    const size_t points = options.points;
+    bool ok = true;
+
+    std::vector<size_t> simd, scalar, minIndex, maxIndex;
+    std::vector<double> xs, rmsValues, scalarRmsValues;
+    Result result;
+
+    // decimate has no scalar counterpart; it is the floor for the others
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::decimate(0, n, points, simd); });
+    result.scalarMs = result.simdMs;
+    report("decimate", type, n, result);
+
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::envelope(values, 0, n, points / 2, minIndex, maxIndex); });
+    result.scalarMs = bestOf(options.repeats, [&] { scalarEnvelope(values, n, points / 2, scalar); });
+    simd.clear();
+    for (size_t b = 0; b < minIndex.size(); b++) {
+        simd.push_back(minIndex[b]);
+        simd.push_back(maxIndex[b]);
+    }
+    result.match = simd == scalar;
+    report("envelope", type, n, result);
+    ok &= result.match;
+
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::m4(values, 0, n, points / 4, simd); });
+    result.scalarMs = bestOf(options.repeats, [&] { scalarM4(values, n, points / 4, scalar); });
+    result.match = simd == scalar;
+    report("m4", type, n, result);
+    ok &= result.match;
+
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::rms(values, time, 0, n, points, xs, rmsValues); });
+    result.scalarMs = bestOf(options.repeats, [&] { scalarRms(values, time, n, points, scalarRmsValues); });
+    result.match = rmsValues.size() * 2 == scalarRmsValues.size();
+    for (size_t b = 0; result.match && b < rmsValues.size(); b++) {
+        auto same = [](double a, double c) { return a == c || (std::isnan(a) && std::isnan(c)); };
+        result.match = same(rmsValues[b], scalarRmsValues[b * 2]) && same(xs[b], scalarRmsValues[b * 2 + 1]);
+    }
+    report("rms", type, n, result);
+    ok &= result.match;
+
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::lttb(values, time, 0, n, points, simd); });
+    result.scalarMs = bestOf(options.repeats, [&] { scalarLttb(values, time, n, points, scalar); });
+    result.match = simd == scalar;
+    report("lttb", type, n, result);
+    ok &= result.match;
+
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::lttb(values, Downsample::IndexAxis{}, 0, n, points, simd); });
+    result.scalarMs = bestOf(options.repeats, [&] { scalarLttb(values, Downsample::IndexAxis{}, n, points, scalar); });
+    result.match = simd == scalar;
+    report("lttb/index", type, n, result);
+    ok &= result.match;
+
+    // MinMaxLTTB against full LTTB, the quality reference it approximates
+    result.simdMs = bestOf(options.repeats, [&] { Downsample::minMaxLttb(values, time, 0, n, points, 4, simd); });
+    result.scalarMs = bestOf(options.repeats, [&] { Downsample::lttb(values, time, 0, n, points, scalar); });
+    result.match = simd.size() == std::min(n, points);
+    report("minmaxlttb", type, n, result);
+    ok &= result.match;
+
+    return ok;
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: downsample_bench [options]\n"
+        "  --sizes <a,b,..>  signal lengths (default 100000,1000000,10000000,50000000)\n"
+        "  --points <n>      output points per query (default 2000)\n"
+        "  --repeats <n>     timed runs per kernel, best reported (default 5)\n"
+        "  --quick           small signals, fewer repetitions\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--sizes") {
+            options.sizes.clear();
+            std::string list = value();
+            for (size_t pos = 0; pos < list.size();) {
+                size_t comma = list.find(',', pos);
+                if (comma == std::string::npos) comma = list.size();
+                options.sizes.push_back(std::strtoull(list.substr(pos, comma - pos).c_str(), nullptr, 10));
+                pos = comma + 1;
+            }
+        }
+        else if (arg == "--points") options.points = std::max<size_t>(8, std::strtoull(value().c_str(), nullptr, 10));
+        else if (arg == "--repeats") options.repeats = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--quick") options.quick = true;
+        else if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (options.quick) {
+        options.sizes = { 100000, 1000000 };
+        options.repeats = std::min(options.repeats, 2);
+    }
+
+    std::cout << "Downsampling kernel benchmark (" <<
+#ifdef DOWNSAMPLE_SSE2
+        "SSE2"
+#else
+        "scalar"
+#endif
+        << ", " << options.points << " points per query)" << std::endl;
+
+    bool ok = true;
+    for (size_t n : options.sizes) {
+        if (n < 16) continue;
+        std::cout << n << " samples" << std::endl;
+        ok &= runSize<float>(options, n, "float");
+        ok &= runSize<double>(options, n, "double");
+    }
+
+    if (!ok) {
+        std::cerr << "Kernel results differ from the scalar reference" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <napi.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "downsample.h"
+
+namespace {
+
+// A Float32Array or Float64Array argument
+struct Column {
+    const float* f32 = nullptr;
+    const double* f64 = nullptr;
+    size_t length = 0;
+};
+
+bool GetColumn(const Napi::CallbackInfo& info, size_t index, const char* name, Column& column, bool optional = false) {
+    if (optional && (info.Length() <= index || info[index].IsUndefined() || info[index].IsNull())) {
+        return true;
+    }
+    if (info.Length() <= index || !info[index].IsTypedArray()) {
+        Napi::TypeError::New(info.Env(), std::string(name) + " must be a Float32Array or Float64Array").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    Napi::TypedArray array = info[index].As<Napi::TypedArray>();
+    column.length = array.ElementLength();
+    if (array.TypedArrayType() == napi_float32_array) {
+        column.f32 = array.As<Napi::Float32Array>().Data();
+    } else if (array.TypedArrayType() == napi_float64_array) {
+        column.f64 = array.As<Napi::Float64Array>().Data();
+    } else {
+        Napi::TypeError::New(info.Env(), std::string(name) + " must be a Float32Array or Float64Array").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Non-negative integer argument, or fallback when omitted
+bool GetIndexParam(const Napi::CallbackInfo& info, size_t index, const char* name, size_t& value, double fallback = -1) {
+    double number;
+    if (info.Length() <= index || info[index].IsUndefined()) {
+        if (fallback < 0) {
+            Napi::TypeError::New(info.Env(), std::string(name) + " expected").ThrowAsJavaScriptException();
+            return false;
+        }
+        number = fallback;
+    } else {
+        if (!info[index].IsNumber()) {
+            Napi::TypeError::New(info.Env(), std::string(name) + " must be a number").ThrowAsJavaScriptException();
+            return false;
+        }
+        number = info[index].As<Napi::Number>().DoubleValue();
+    }
+    if (!(number >= 0 && number <= 9007199254740991.0) || number != std::floor(number)) {
+        Napi::RangeError::New(info.Env(), std::string(name) + " must be a non-negative integer").ThrowAsJavaScriptException();
+        return false;
+    }
+    value = static_cast<size_t>(number);
+    return true;
+}
+
+bool CheckRange(Napi::Env env, const Column& values, size_t start, size_t count) {
+    if (start > values.length || count > values.length - start) {
+        Napi::RangeError::New(env, "Sample range out of range").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Call f with the typed values pointer
+template <typename F>
+void WithValues(const Column& values, F f) {
+    if (values.f32) f(values.f32);
+    else f(values.f64);
+}
+
+// Call f with the values pointer and the x axis (time array or indices)
+template <typename F>
+void WithValuesAndAxis(const Column& values, const Column& time, F f) {
+    WithValues(values, [&](auto data) {
+        if (time.f32) f(data, Downsample::TimeAxis<float>{ time.f32 });
+        else if (time.f64) f(data, Downsample::TimeAxis<double>{ time.f64 });
+        else f(data, Downsample::IndexAxis{});
+    });
+}
+
+template <typename T>
+Napi::Float64Array ToFloat64Array(Napi::Env env, const std::vector<T>& values) {
+    Napi::Float64Array result = Napi::Float64Array::New(env, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        result[i] = static_cast<double>(values[i]);
+    }
+    return result;
+}
+
+// Parses (values, time?, start, count, n): time is optional only where the
+// kernel takes an x axis
+bool GetSeriesArgs(const Napi::CallbackInfo& info, bool withTime, Column& values, Column& time,
+                   size_t& start, size_t& count, size_t& n, const char* nName) {
+    size_t next = withTime ? 2 : 1;
+    return GetColumn(info, 0, "values", values) &&
+        (!withTime || GetColumn(info, 1, "time", time, true)) &&
+        GetIndexParam(info, next, "start", start) &&
+        GetIndexParam(info, next + 1, "count", count) &&
+        GetIndexParam(info, next + 2, nName, n) &&
+        CheckRange(info.Env(), values, start, count) &&
+        (!(time.f32 || time.f64) || time.length >= start + count ||
+         (Napi::RangeError::New(info.Env(), "time is shorter than the sample range").ThrowAsJavaScriptException(), false));
+}
+
+// decimate(start, count, maxPoints) -> Float64Array of sample indices
+Napi::Value Decimate(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t start, count, maxPoints;
+    if (!GetIndexParam(info, 0, "start", start) || !GetIndexParam(info, 1, "count", count) ||
+        !GetIndexParam(info, 2, "maxPoints", maxPoints)) {
+        return env.Null();
+    }
+
+    std::vector<size_t> indices;
+    Downsample::decimate(start, count, maxPoints, indices);
+    return ToFloat64Array(env, indices);
+}
+
+// envelope(values, start, count, buckets) -> { minIndex, maxIndex: Float64Array }
+Napi::Value Envelope(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Column values, time;
+    size_t start, count, buckets;
+    if (!GetSeriesArgs(info, false, values, time, start, count, buckets, "buckets")) return env.Null();
+
+    std::vector<size_t> minIndex, maxIndex;
+    WithValues(values, [&](auto data) {
+        Downsample::envelope(data, start, count, buckets, minIndex, maxIndex);
+    });
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("minIndex", ToFloat64Array(env, minIndex));
+    result.Set("maxIndex", ToFloat64Array(env, maxIndex));
+    return result;
+}
+
+// m4(values, start, count, buckets) -> Float64Array of sample indices
+Napi::Value M4(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Column values, time;
+    size_t start, count, buckets;
+    if (!GetSeriesArgs(info, false, values, time, start, count, buckets, "buckets")) return env.Null();
+
+    std::vector<size_t> indices;
+    WithValues(values, [&](auto data) {
+        Downsample::m4(data, start, count, buckets, indices);
+    });
+    return ToFloat64Array(env, indices);
+}
+
+// rms(values, time?, start, count, buckets) -> { x, values: Float64Array },
+// x being the mean time (or mean index without time) of each bucket
+Napi::Value Rms(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Column values, time;
+    size_t start, count, buckets;
+    if (!GetSeriesArgs(info, true, values, time, start, count, buckets, "buckets")) return env.Null();
+
+    std::vector<double> x, rms;
+    WithValuesAndAxis(values, time, [&](auto data, auto axis) {
+        Downsample::rms(data, axis, start, count, buckets, x, rms);
+    });
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("x", ToFloat64Array(env, x));
+    result.Set("values", ToFloat64Array(env, rms));
+    return result;
+}
+
+// lttb(values, time?, start, count, threshold) -> Float64Array of sample indices
+Napi::Value Lttb(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Column values, time;
+    size_t start, count, threshold;
+    if (!GetSeriesArgs(info, true, values, time, start, count, threshold, "threshold")) return env.Null();
+
+    std::vector<size_t> indices;
+    WithValuesAndAxis(values, time, [&](auto data, auto axis) {
+        Downsample::lttb(data, axis, start, count, threshold, indices);
+    });
+    return ToFloat64Array(env, indices);
+}
+
+// minMaxLttb(values, time?, start, count, threshold, ratio = 4) -> Float64Array of sample indices
+Napi::Value MinMaxLttb(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Column values, time;
+    size_t start, count, threshold, ratio;
+    if (!GetSeriesArgs(info, true, values, time, start, count, threshold, "threshold") ||
+        !GetIndexParam(info, 5, "ratio", ratio, 4)) {
+        return env.Null();
+    }
+
+    std::vector<size_t> indices;
+    WithValuesAndAxis(values, time, [&](auto data, auto axis) {
+        Downsample::minMaxLttb(data, axis, start, count, threshold, std::max<size_t>(1, ratio), indices);
+    });
+    return ToFloat64Array(env, indices);
+}
+
+} // namespace
+
+// Module initialization
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("decimate", Napi::Function::New(env, Decimate));
+    exports.Set("envelope", Napi::Function::New(env, Envelope));
+    exports.Set("m4", Napi::Function::New(env, M4));
+    exports.Set("rms", Napi::Function::New(env, Rms));
+    exports.Set("lttb", Napi::Function::New(env, Lttb));
+    exports.Set("minMaxLttb", Napi::Function::New(env, MinMaxLttb));
+#ifdef DOWNSAMPLE_SSE2
+    exports.Set("simd", Napi::String::New(env, "sse2"));
+#else
+    exports.Set("simd", Napi::String::New(env, "none"));
+#endif
+    return exports;
+}
+
+NODE_API_MODULE(downsample_native, Init)
@@ -0,0 +1,453 @@
+// Downsampling kernels shared by the data processors: pick the samples of a
+// channel range worth plotting. Node-free so it can be used (and
+// benchmarked) outside the addon.
+//
+//   decimate     every step-th sample
+//   envelope     minimum and maximum of each bucket (MinMax)
+//   m4           first, minimum, maximum and last sample of each bucket
+//   rms          root mean square and mean x of each bucket
+//   lttb         Largest-Triangle-Three-Buckets
+//   minMaxLttb   LTTB over a MinMax preselection of ratio * threshold samples
+//
+// Buckets split [start, start + count) at start + count * b / buckets.
+// Values are float or double; x coordinates come from a time array (float
+// or double) or are the sample indices. Extremes ignore NaN and report the
+// first occurrence; a bucket without a number reports its first sample.
+//
+// Sums run in two interleaved partial sums (even and odd offsets from the
+// bucket start, added at the end), the order of the SSE2 lanes, so the SIMD
+// and scalar paths and the JS fallback (utils/Downsampler.js) give
+// identical results.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOWNSAMPLE_SSE2 1
+#endif
+
+class Downsample {
+public:
+    // x coordinate of a sample: its index
+    struct IndexAxis {
+        double operator()(size_t i) const { return static_cast<double>(i); }
+    };
+
+    // x coordinate of a sample: its time
+    template <typename T>
+    struct TimeAxis {
+        const T* time;
+        double operator()(size_t i) const { return static_cast<double>(time[i]); }
+    };
+
+    // Indices of the minimum and maximum of one bucket
+    struct Extremes {
+        size_t minIndex;
+        size_t maxIndex;
+    };
+
+    // Every step-th sample, step = ceil(count / maxPoints)
+    static void decimate(size_t start, size_t count, size_t maxPoints, std::vector<size_t>& out) {
+        out.clear();
+        if (count == 0 || maxPoints == 0) return;
+        const size_t step = (count + maxPoints - 1) / maxPoints;
+        for (size_t i = 0; i < count; i += step) {
+            out.push_back(start + i);
+        }
+    }
+
+    // Minimum and maximum of [first, last)
+    template <typename V>
+    static Extremes extremes(const V* values, size_t first, size_t last) {
+        V lo, hi;
+        extremeValues(values + first, last - first, lo, hi);
+        if (!(lo <= hi)) {
+            return { first, first };
+        }
+        return { find(values, first, last, lo), find(values, first, last, hi) };
+    }
+
+    // Per-bucket extremes; fills minIndex/maxIndex (min(buckets, count) entries)
+    template <typename V>
+    static size_t envelope(const V* values, size_t start, size_t count, size_t buckets,
+                           std::vector<size_t>& minIndex, std::vector<size_t>& maxIndex) {
+        buckets = std::min(buckets, count);
+        minIndex.resize(buckets);
+        maxIndex.resize(buckets);
+        for (size_t b = 0; b < buckets; b++) {
+            Extremes e = extremes(values, bucketStart(start, count, buckets, b), bucketStart(start, count, buckets, b + 1));
+            minIndex[b] = e.minIndex;
+            maxIndex[b] = e.maxIndex;
+        }
+        return buckets;
+    }
+
+    // First, minimum, maximum and last of each bucket, ascending and unique
+    template <typename V>
+    static void m4(const V* values, size_t start, size_t count, size_t buckets, std::vector<size_t>& out) {
+        out.clear();
+        buckets = std::min(buckets, count);
+        for (size_t b = 0; b < buckets; b++) {
+            size_t first = bucketStart(start, count, buckets, b);
+            size_t last = bucketStart(start, count, buckets, b + 1);
+            Extremes e = extremes(values, first, last);
+            size_t picks[4] = { first, e.minIndex, e.maxIndex, last - 1 };
+            std::sort(picks, picks + 4);
+            for (size_t pick : picks) {
+                if (out.empty() || out.back() != pick) out.push_back(pick);
+            }
+        }
+    }
+
+    // Root mean square and mean x of each bucket
+    template <typename V, typename Axis>
+    static size_t rms(const V* values, Axis x, size_t start, size_t count, size_t buckets,
+                      std::vector<double>& xOut, std::vector<double>& rmsOut) {
+        buckets = std::min(buckets, count);
+        xOut.resize(buckets);
+        rmsOut.resize(buckets);
+        for (size_t b = 0; b < buckets; b++) {
+            size_t first = bucketStart(start, count, buckets, b);
+            size_t last = bucketStart(start, count, buckets, b + 1);
+            double n = static_cast<double>(last - first);
+            rmsOut[b] = std::sqrt(sumSquares(values, first, last) / n);
+            xOut[b] = sumX(x, first, last) / n;
+        }
+        return buckets;
+    }
+
+    // Largest-Triangle-Three-Buckets over [start, start + count)
+    template <typename V, typename Axis>
+    static void lttb(const V* values, Axis x, size_t start, size_t count, size_t threshold, std::vector<size_t>& out) {
+        lttbOver(values, x, [start](size_t k) { return start + k; }, count, threshold, true, out);
+    }
+
+    // LTTB over the per-bucket extremes of ratio * threshold / 2 buckets
+    // (MinMaxLTTB); first and last sample always kept
+    template <typename V, typename Axis>
+    static void minMaxLttb(const V* values, Axis x, size_t start, size_t count, size_t threshold, size_t ratio,
+                           std::vector<size_t>& out) {
+        out.clear();
+        if (count <= threshold || count <= 2 || threshold < 3) {
+            lttb(values, x, start, count, threshold, out);
+            return;
+        }
+
+        std::vector<size_t> minIndex, maxIndex;
+        envelope(values, start + 1, count - 2, std::max<size_t>(1, threshold * ratio / 2), minIndex, maxIndex);
+
+        std::vector<size_t> candidates;
+        candidates.reserve(minIndex.size() * 2 + 2);
+        candidates.push_back(start);
+        for (size_t b = 0; b < minIndex.size(); b++) {
+            size_t a = std::min(minIndex[b], maxIndex[b]);
+            size_t c = std::max(minIndex[b], maxIndex[b]);
+            candidates.push_back(a);
+            if (c != a) candidates.push_back(c);
+        }
+        candidates.push_back(start + count - 1);
+
+        if (candidates.size() <= threshold) {
+            out = std::move(candidates);
+            return;
+        }
+        const size_t* list = candidates.data();
+        lttbOver(values, x, [list](size_t k) { return list[k]; }, candidates.size(), threshold, false, out);
+    }
+
+    static size_t bucketStart(size_t start, size_t count, size_t buckets, size_t b) {
+        return start + count * b / buckets;
+    }
+
+private:
+    // LTTB over n points, point k being sample at(k). Contiguous points
+    // (sample = first + k) use the SIMD area scan.
+    template <typename V, typename Axis, typename At>
+    static void lttbOver(const V* values, Axis x, At at, size_t n, size_t threshold, bool contiguous,
+                         std::vector<size_t>& out) {
+        out.clear();
+        if (n == 0 || threshold == 0) return;
+        if (n <= threshold || threshold < 3) {
+            if (threshold < 3) {
+                out.push_back(at(0));
+                if (threshold == 2 && n > 1) out.push_back(at(n - 1));
+                return;
+            }
+            for (size_t k = 0; k < n; k++) out.push_back(at(k));
+            return;
+        }
+
+        const double every = static_cast<double>(n - 2) / static_cast<double>(threshold - 2);
+        size_t a = 0;
+        out.push_back(at(0));
+
+        for (size_t i = 0; i < threshold - 2; i++) {
+            // Average of the next bucket (the last point for the final one)
+            size_t avgFirst = static_cast<size_t>(std::floor((i + 1) * every)) + 1;
+            size_t avgLast = std::min(static_cast<size_t>(std::floor((i + 2) * every)) + 1, n);
+            double avgX, avgY;
+            if (contiguous) {
+                double count = static_cast<double>(avgLast - avgFirst);
+                avgX = sumX(x, at(avgFirst), at(avgFirst) + (avgLast - avgFirst)) / count;
+                avgY = sum(values, at(avgFirst), at(avgFirst) + (avgLast - avgFirst)) / count;
+            } else {
+                double sx0 = 0, sx1 = 0, sy0 = 0, sy1 = 0;
+                size_t k = avgFirst;
+                for (; k + 1 < avgLast; k += 2) {
+                    sx0 += x(at(k));
+                    sx1 += x(at(k + 1));
+                    sy0 += static_cast<double>(values[at(k)]);
+                    sy1 += static_cast<double>(values[at(k + 1)]);
+                }
+                if (k < avgLast) {
+                    sx0 += x(at(k));
+                    sy0 += static_cast<double>(values[at(k)]);
+                }
+                double count = static_cast<double>(avgLast - avgFirst);
+                avgX = (sx0 + sx1) / count;
+                avgY = (sy0 + sy1) / count;
+            }
+
+            size_t first = static_cast<size_t>(std::floor(i * every)) + 1;
+            size_t last = static_cast<size_t>(std::floor((i + 1) * every)) + 1;
+            const double ax = x(at(a));
+            const double ay = static_cast<double>(values[at(a)]);
+
+            size_t next;
+            if (contiguous) {
+                next = largestTriangle(values, x, at(first), at(first) + (last - first), ax, ay, avgX, avgY) - at(0);
+            } else {
+                double maxArea = -1.0;
+                next = first;
+                for (size_t k = first; k < last; k++) {
+                    double area = triangleArea(ax, ay, avgX, avgY, x(at(k)), static_cast<double>(values[at(k)]));
+                    if (area > maxArea) {
+                        maxArea = area;
+                        next = k;
+                    }
+                }
+            }
+            out.push_back(at(next));
+            a = next;
+        }
+
+        out.push_back(at(n - 1));
+    }
+
+    // Twice the area of the triangle (a, sample, average of next bucket)
+    static double triangleArea(double ax, double ay, double cx, double cy, double px, double py) {
+        return std::abs((ax - cx) * (py - ay) - (ax - px) * (cy - ay));
+    }
+
+    // Sample in [first, last) forming the largest triangle; the first on ties
+    template <typename V, typename Axis>
+    static size_t largestTriangle(const V* values, Axis x, size_t first, size_t last,
+                                  double ax, double ay, double cx, double cy) {
+        double best[2] = { -1.0, -1.0 };
+        size_t bestIndex[2] = { first, first + 1 };
+        size_t i = first;
+
+#ifdef DOWNSAMPLE_SSE2
+        const __m128d vax = _mm_set1_pd(ax);
+        const __m128d vay = _mm_set1_pd(ay);
+        const __m128d dx = _mm_set1_pd(ax - cx);
+        const __m128d dy = _mm_set1_pd(cy - ay);
+        const __m128d signMask = _mm_set1_pd(-0.0);
+        __m128d vbest = _mm_loadu_pd(best);
+
+        // New maxima are rare after the first few samples: compare both
+        // lanes at once and only branch to record an improvement
+        for (; i + 2 <= last; i += 2) {
+            __m128d py = load2(values + i);
+            __m128d px = loadX(x, i);
+            __m128d area = _mm_andnot_pd(signMask,
+                _mm_sub_pd(_mm_mul_pd(dx, _mm_sub_pd(py, vay)), _mm_mul_pd(_mm_sub_pd(vax, px), dy)));
+            int better = _mm_movemask_pd(_mm_cmpgt_pd(area, vbest));
+            if (better) {
+                double areas[2];
+                _mm_storeu_pd(areas, area);
+                for (int lane = 0; lane < 2; lane++) {
+                    if (better & (1 << lane)) {
+                        best[lane] = areas[lane];
+                        bestIndex[lane] = i + lane;
+                    }
+                }
+                vbest = _mm_loadu_pd(best);
+            }
+        }
+#else
+        for (; i + 2 <= last; i += 2) {
+            for (int lane = 0; lane < 2; lane++) {
+                double area = triangleArea(ax, ay, cx, cy, x(i + lane), static_cast<double>(values[i + lane]));
+                if (area > best[lane]) {
+                    best[lane] = area;
+                    bestIndex[lane] = i + lane;
+                }
+            }
+        }
+#endif
+
+        if (i < last) {
+            double area = triangleArea(ax, ay, cx, cy, x(i), static_cast<double>(values[i]));
+            if (area > best[0]) {
+                best[0] = area;
+                bestIndex[0] = i;
+            }
+        }
+
+        if (best[1] > best[0] || (best[1] == best[0] && best[1] >= 0 && bestIndex[1] < bestIndex[0])) {
+            return bestIndex[1];
+        }
+        return bestIndex[0];
+    }
+
+    template <typename V>
+    static size_t find(const V* values, size_t first, size_t last, V target) {
+        while (first + 1 < last && !(values[first] == target)) first++;
+        return first;
+    }
+
+    // Extreme values of n samples, NaN ignored (+inf/-inf if none)
+    static void extremeValues(const float* values, size_t n, float& lo, float& hi) {
+        size_t i = 0;
+        lo = std::numeric_limits<float>::infinity();
+        hi = -std::numeric_limits<float>::infinity();
+
+#ifdef DOWNSAMPLE_SSE2
+        if (n >= 8) {
+            // minps/maxps return the second operand if either is NaN, so
+            // the accumulator goes second and NaN samples drop out
+            __m128 vlo = _mm_set1_ps(lo), vhi = _mm_set1_ps(hi);
+            __m128 vlo2 = vlo, vhi2 = vhi;
+            for (; i + 8 <= n; i += 8) {
+                __m128 a = _mm_loadu_ps(values + i);
+                __m128 b = _mm_loadu_ps(values + i + 4);
+                vlo = _mm_min_ps(a, vlo);
+                vhi = _mm_max_ps(a, vhi);
+                vlo2 = _mm_min_ps(b, vlo2);
+                vhi2 = _mm_max_ps(b, vhi2);
+            }
+            float lanes[4];
+            _mm_storeu_ps(lanes, _mm_min_ps(vlo, vlo2));
+            for (float lane : lanes) if (lane < lo) lo = lane;
+            _mm_storeu_ps(lanes, _mm_max_ps(vhi, vhi2));
+            for (float lane : lanes) if (lane > hi) hi = lane;
+        }
+#endif
+
+        for (; i < n; i++) {
+            if (values[i] < lo) lo = values[i];
+            if (values[i] > hi) hi = values[i];
+        }
+    }
+
+    static void extremeValues(const double* values, size_t n, double& lo, double& hi) {
+        size_t i = 0;
+        lo = std::numeric_limits<double>::infinity();
+        hi = -std::numeric_limits<double>::infinity();
+
+#ifdef DOWNSAMPLE_SSE2
+        if (n >= 4) {
+            __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+            __m128d vlo2 = vlo, vhi2 = vhi;
+            for (; i + 4 <= n; i += 4) {
+                __m128d a = _mm_loadu_pd(values + i);
+                __m128d b = _mm_loadu_pd(values + i + 2);
+                vlo = _mm_min_pd(a, vlo);
+                vhi = _mm_max_pd(a, vhi);
+                vlo2 = _mm_min_pd(b, vlo2);
+                vhi2 = _mm_max_pd(b, vhi2);
+            }
+            double lanes[2];
+            _mm_storeu_pd(lanes, _mm_min_pd(vlo, vlo2));
+            for (double lane : lanes) if (lane < lo) lo = lane;
+            _mm_storeu_pd(lanes, _mm_max_pd(vhi, vhi2));
+            for (double lane : lanes) if (lane > hi) hi = lane;
+        }
+#endif
+
+        for (; i < n; i++) {
+            if (values[i] < lo) lo = values[i];
+            if (values[i] > hi) hi = values[i];
+        }
+    }
+
+#ifdef DOWNSAMPLE_SSE2
+    static __m128d load2(const float* p) {
+        return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+    }
+    static __m128d load2(const double* p) { return _mm_loadu_pd(p); }
+
+    static __m128d loadX(IndexAxis, size_t i) {
+        return _mm_set_pd(static_cast<double>(i + 1), static_cast<double>(i));
+    }
+    template <typename T>
+    static __m128d loadX(TimeAxis<T> axis, size_t i) { return load2(axis.time + i); }
+#endif
+
+    // Terms of the sums: a scalar per sample and, for SSE2, a pair of
+    // consecutive samples in double lanes
+    template <typename V>
+    struct ValueTerm {
+        const V* values;
+        double operator()(size_t i) const { return static_cast<double>(values[i]); }
+#ifdef DOWNSAMPLE_SSE2
+        __m128d pair(size_t i) const { return load2(values + i); }
+#endif
+    };
+
+    template <typename V>
+    struct SquareTerm {
+        const V* values;
+        double operator()(size_t i) const { double v = static_cast<double>(values[i]); return v * v; }
+#ifdef DOWNSAMPLE_SSE2
+        __m128d pair(size_t i) const { __m128d v = load2(values + i); return _mm_mul_pd(v, v); }
+#endif
+    };
+
+    template <typename Axis>
+    struct AxisTerm {
+        Axis x;
+        double operator()(size_t i) const { return x(i); }
+#ifdef DOWNSAMPLE_SSE2
+        __m128d pair(size_t i) const { return loadX(x, i); }
+#endif
+    };
+
+    template <typename V>
+    static double sum(const V* values, size_t first, size_t last) { return sumTerms(ValueTerm<V>{ values }, first, last); }
+
+    template <typename V>
+    static double sumSquares(const V* values, size_t first, size_t last) { return sumTerms(SquareTerm<V>{ values }, first, last); }
+
+    template <typename Axis>
+    static double sumX(Axis x, size_t first, size_t last) { return sumTerms(AxisTerm<Axis>{ x }, first, last); }
+
+    // Sum over [first, last) in the two-lane order
+    template <typename Term>
+    static double sumTerms(const Term& term, size_t first, size_t last) {
+        double lanes[2] = { 0.0, 0.0 };
+        size_t i = first;
+
+#ifdef DOWNSAMPLE_SSE2
+        __m128d acc = _mm_setzero_pd();
+        for (; i + 2 <= last; i += 2) {
+            acc = _mm_add_pd(acc, term.pair(i));
+        }
+        _mm_storeu_pd(lanes, acc);
+#else
+        for (; i + 2 <= last; i += 2) {
+            lanes[0] += term(i);
+            lanes[1] += term(i + 1);
+        }
+#endif
+
+        if (i < last) lanes[0] += term(i);
+        return lanes[0] + lanes[1];
+    }
+};
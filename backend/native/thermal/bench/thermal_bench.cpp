@@ -0,0 +1,365 @@
+// Thermal engine benchmark on synthetic videos.
+//
+// Renders weld-like temperature fields (a hot spot travelling over a cooler
+// plate, plus sensor noise), colours them with temp_mapping.csv and writes
+// AVIs at several resolutions and GOP sizes. Each video is then loaded into
+// ThermalEngine to measure:
+//   - decode throughput, sequential and on the decoder pool (frames/s)
+//   - colour-to-temperature mapping throughput (pixels/s, warm colour LUT)
+//   - random seek latency (getFrame on random frames)
+//   - line analysis latency on a decoded frame and with a seek
+//
+// Build with bench/CMakeLists.txt; see --help for options.
+#include "thermal_engine.cpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+
+#ifndef THERMAL_BENCH_MAPPING
+#define THERMAL_BENCH_MAPPING "temp_mapping.csv"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Options {
+    std::string mappingPath = THERMAL_BENCH_MAPPING;
+    std::string outputDir;
+    int frames = 300;
+    int seeks = 200;
+    int lines = 500;
+    bool keep = false;
+    bool quick = false;
+};
+
+struct Scenario {
+    int width;
+    int height;
+    int gop;                             // 1 = intra-only (MJPG)
+};
+
+struct Palette {
+    std::vector<float> temps;            // ascending
+    std::vector<cv::Vec3b> colors;       // BGR, same order
+};
+
+// Percentiles of latencies in ms
+struct Latency {
+    double p50 = 0, p90 = 0, p99 = 0, max = 0;
+
+    static Latency of(std::vector<double> ms) {
+        Latency result;
+        if (ms.empty()) return result;
+        std::sort(ms.begin(), ms.end());
+        auto at = [&](double p) { return ms[std::min(ms.size() - 1, static_cast<size_t>(p * ms.size()))]; };
+        result.p50 = at(0.50);
+        result.p90 = at(0.90);
+        result.p99 = at(0.99);
+        result.max = ms.back();
+        return result;
+    }
+};
+
+std::ostream& operator<<(std::ostream& out, const Latency& l) {
+    return out << std::fixed << std::setprecision(3)
+               << "p50 " << l.p50 << " ms, p90 " << l.p90 << " ms, p99 " << l.p99 << " ms, max " << l.max << " ms";
+}
+
+bool loadPalette(const std::string& path, Palette& palette) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    std::getline(file, line); // X,Y,R,G,B,Temperature_C
+    std::vector<std::pair<float, cv::Vec3b>> entries;
+
+    while (std::getline(file, line)) {
+        int x, y, r, g, b;
+        float temp;
+        if (std::sscanf(line.c_str(), "%d,%d,%d,%d,%d,%f", &x, &y, &r, &g, &b, &temp) == 6) {
+            entries.push_back({ temp, cv::Vec3b(static_cast<uchar>(b), static_cast<uchar>(g), static_cast<uchar>(r)) });
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& entry : entries) {
+        palette.temps.push_back(entry.first);
+        palette.colors.push_back(entry.second);
+    }
+    return !palette.temps.empty();
+}
+
+// Temperature field of frame i: background gradient, a Gaussian hot spot
+// moving along the seam, and per-pixel noise
+void renderFrame(const Palette& palette, int width, int height, int frameIndex, int frameCount,
+                 std::mt19937& rng, cv::Mat& image) {
+    image.create(height, width, CV_8UC3);
+    const float minT = palette.temps.front();
+    const float maxT = palette.temps.back();
+    const float span = maxT - minT;
+
+    float progress = frameCount > 1 ? static_cast<float>(frameIndex) / (frameCount - 1) : 0.0f;
+    float spotX = width * (0.1f + 0.8f * progress);
+    float spotY = height * 0.5f;
+    float sigma = std::max(4.0f, width * 0.04f);
+    std::normal_distribution<float> noise(0.0f, span * 0.004f);
+
+    for (int y = 0; y < height; y++) {
+        cv::Vec3b* row = image.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < width; x++) {
+            float dx = (x - spotX) / sigma;
+            float dy = (y - spotY) / (sigma * 0.6f);
+            float temp = minT + span * (0.05f + 0.1f * x / width + 0.85f * std::exp(-0.5f * (dx * dx + dy * dy)));
+            temp += noise(rng);
+
+            size_t index = static_cast<size_t>(std::lower_bound(palette.temps.begin(), palette.temps.end(), temp)
+                                               - palette.temps.begin());
+            row[x] = palette.colors[std::min(index, palette.colors.size() - 1)];
+        }
+    }
+}
+
+// Write a synthetic AVI. GOP 1 uses MJPG (every frame a keyframe); larger
+// GOPs use MPEG-4 part 2 with the keyframe interval passed to FFmpeg.
+bool writeVideo(const std::string& path, const Scenario& scenario, int frames, const Palette& palette) {
+    std::string writerOptions = "g;" + std::to_string(scenario.gop);
+#ifdef _WIN32
+    _putenv_s("OPENCV_FFMPEG_WRITER_OPTIONS", writerOptions.c_str());
+#else
+    setenv("OPENCV_FFMPEG_WRITER_OPTIONS", writerOptions.c_str(), 1);
+#endif
+
+    int fourcc = scenario.gop <= 1 ? cv::VideoWriter::fourcc('M', 'J', 'P', 'G')
+                                   : cv::VideoWriter::fourcc('F', 'M', 'P', '4');
+    cv::VideoWriter writer;
+    bool opened = writer.open(path, cv::CAP_FFMPEG, fourcc, 30.0, cv::Size(scenario.width, scenario.height), true);
+
+#ifdef _WIN32
+    _putenv_s("OPENCV_FFMPEG_WRITER_OPTIONS", "");
+#else
+    unsetenv("OPENCV_FFMPEG_WRITER_OPTIONS");
+#endif
+
+    if (!opened) {
+        return false;
+    }
+
+    std::mt19937 rng(12345);
+    cv::Mat image;
+    for (int i = 0; i < frames; i++) {
+        renderFrame(palette, scenario.width, scenario.height, i, frames, rng, image);
+        writer.write(image);
+    }
+    writer.release();
+    return true;
+}
+
+double sequentialDecodeFps(const std::string& path) {
+    cv::VideoCapture capture(path);
+    if (!capture.isOpened()) {
+        return 0.0;
+    }
+
+    cv::Mat frame;
+    int frames = 0;
+    auto start = Clock::now();
+    while (capture.read(frame)) {
+        frames++;
+    }
+    double seconds = secondsSince(start);
+    return seconds > 0 ? frames / seconds : 0.0;
+}
+
+void runScenario(const Options& options, const Scenario& scenario, const Palette& palette) {
+    std::string name = std::to_string(scenario.width) + "x" + std::to_string(scenario.height) +
+                       "_gop" + std::to_string(scenario.gop);
+    std::string path = (std::filesystem::path(options.outputDir) / ("thermal_bench_" + name + ".avi")).string();
+
+    std::cout << "\n== " << name << " (" << options.frames << " frames) ==" << std::endl;
+
+    auto writeStart = Clock::now();
+    if (!writeVideo(path, scenario, options.frames, palette)) {
+        std::cout << "  skipped: no video writer for this codec" << std::endl;
+        return;
+    }
+    std::cout << "  generated in " << std::fixed << std::setprecision(2) << secondsSince(writeStart) << " s, "
+              << std::filesystem::file_size(path) / 1024 << " KiB" << std::endl;
+
+    ThermalEngine engine;
+    if (!engine.loadTempMapping(options.mappingPath) || !engine.loadVideo(path)) {
+        std::cout << "  skipped: engine could not load the video" << std::endl;
+        return;
+    }
+    int totalFrames = engine.getTotalFrames();
+    const double pixelsPerFrame = static_cast<double>(scenario.width) * scenario.height;
+    std::mt19937 rng(4242);
+
+    // Decode throughput
+    std::cout << "  decode, sequential:      " << std::setprecision(1) << sequentialDecodeFps(path) << " frames/s" << std::endl;
+
+    std::atomic<int> decoded(0);
+    auto poolStart = Clock::now();
+    engine.forEachFrameParallel(0, totalFrames - 1, 1, ThermalEngine::defaultDecoderCount(),
+        [&](int, int, const cv::Mat&) { decoded++; });
+    double poolSeconds = secondsSince(poolStart);
+    std::cout << "  decode, pool (" << ThermalEngine::defaultDecoderCount() << " decoders): "
+              << decoded / poolSeconds << " frames/s" << std::endl;
+
+    // Mapping throughput: getFrame caches the last frame, so repeated calls
+    // for one frame measure the colour mapping alone
+    std::vector<float> temps(static_cast<size_t>(pixelsPerFrame));
+    int mapFrame = totalFrames / 2;
+    auto coldStart = Clock::now();
+    engine.getTemperatureFrame(mapFrame, temps.data());
+    double coldSeconds = secondsSince(coldStart);
+
+    int mapRuns = options.quick ? 5 : 20;
+    auto warmStart = Clock::now();
+    for (int i = 0; i < mapRuns; i++) {
+        engine.getTemperatureFrame(mapFrame, temps.data());
+    }
+    double warmSeconds = secondsSince(warmStart) / mapRuns;
+    std::cout << "  mapping, first frame:    " << std::setprecision(2) << coldSeconds * 1000.0 << " ms (cold colour LUT)" << std::endl;
+    std::cout << "  mapping, warm:           " << std::setprecision(1) << pixelsPerFrame / warmSeconds / 1e6 << " Mpixels/s" << std::endl;
+
+    // Random seeks
+    std::uniform_int_distribution<int> anyFrame(0, totalFrames - 1);
+    std::vector<double> seekMs;
+    for (int i = 0; i < options.seeks; i++) {
+        int frame = anyFrame(rng);
+        auto start = Clock::now();
+        engine.getFrame(frame);
+        seekMs.push_back(secondsSince(start) * 1000.0);
+    }
+    std::cout << "  random seek:             " << Latency::of(seekMs) << std::endl;
+
+    // Line analysis: random lines across the frame, on the decoded frame
+    // and on random frames (seek included)
+    std::uniform_int_distribution<int> anyX(0, scenario.width - 1);
+    std::uniform_int_distribution<int> anyY(0, scenario.height - 1);
+    std::vector<double> cachedMs, seekingMs, bilinearMs;
+    engine.getFrame(mapFrame);
+
+    LineSampling bilinear;
+    bilinear.mode = LineSampling::BILINEAR;
+    bilinear.samples = 256;
+    bilinear.width = 5.0f;
+
+    for (int i = 0; i < options.lines; i++) {
+        int x1 = anyX(rng), y1 = anyY(rng), x2 = anyX(rng), y2 = anyY(rng);
+
+        auto start = Clock::now();
+        engine.analyzeLine(mapFrame, x1, y1, x2, y2);
+        cachedMs.push_back(secondsSince(start) * 1000.0);
+
+        float coords[4] = { static_cast<float>(x1), static_cast<float>(y1), static_cast<float>(x2), static_cast<float>(y2) };
+        start = Clock::now();
+        engine.analyzeLines(mapFrame, coords, 1, bilinear);
+        bilinearMs.push_back(secondsSince(start) * 1000.0);
+    }
+
+    int seekingLines = std::max(1, options.lines / 10);
+    for (int i = 0; i < seekingLines; i++) {
+        int frame = anyFrame(rng);
+        auto start = Clock::now();
+        engine.analyzeLine(frame, anyX(rng), anyY(rng), anyX(rng), anyY(rng));
+        seekingMs.push_back(secondsSince(start) * 1000.0);
+    }
+
+    std::cout << "  line, decoded frame:     " << Latency::of(cachedMs) << std::endl;
+    std::cout << "  line, bilinear 256x5:    " << Latency::of(bilinearMs) << std::endl;
+    std::cout << "  line, with seek:         " << Latency::of(seekingMs) << std::endl;
+
+    if (!options.keep) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: thermal_bench [options]\n"
+        "  --mapping <csv>   temperature mapping (default: " THERMAL_BENCH_MAPPING ")\n"
+        "  --out <dir>       directory for the synthetic videos (default: system temp)\n"
+        "  --frames <n>      frames per video (default 300)\n"
+        "  --seeks <n>       random seeks per video (default 200)\n"
+        "  --lines <n>       line analyses per video (default 500)\n"
+        "  --quick           one small resolution, fewer repetitions\n"
+        "  --keep            keep the generated videos\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--mapping") options.mappingPath = value();
+        else if (arg == "--out") options.outputDir = value();
+        else if (arg == "--frames") options.frames = std::max(2, std::atoi(value().c_str()));
+        else if (arg == "--seeks") options.seeks = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--lines") options.lines = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--quick") options.quick = true;
+        else if (arg == "--keep") options.keep = true;
+        else if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (options.outputDir.empty()) {
+        options.outputDir = std::filesystem::temp_directory_path().string();
+    }
+
+    Palette palette;
+    if (!loadPalette(options.mappingPath, palette)) {
+        std::cerr << "Could not read temperature mapping: " << options.mappingPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "Thermal engine benchmark" << std::endl;
+    std::cout << "  OpenCV " << CV_VERSION << ", " << cv::getNumberOfCPUs() << " CPUs, "
+              << palette.temps.size() << " mapping colours (" << palette.temps.front() << "-"
+              << palette.temps.back() << " C)" << std::endl;
+
+    std::vector<Scenario> scenarios;
+    if (options.quick) {
+        options.frames = std::min(options.frames, 120);
+        options.seeks = std::min(options.seeks, 50);
+        options.lines = std::min(options.lines, 100);
+        scenarios = { { 320, 240, 1 }, { 320, 240, 30 } };
+    } else {
+        for (cv::Size size : { cv::Size(320, 240), cv::Size(640, 480), cv::Size(1280, 1024) }) {
+            for (int gop : { 1, 12, 250 }) {
+                scenarios.push_back({ size.width, size.height, gop });
+            }
+        }
+    }
+
+    for (const Scenario& scenario : scenarios) {
+        runScenario(options, scenario, palette);
+    }
+
+    return 0;
+}
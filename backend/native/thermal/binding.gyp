@@ -8,6 +8,7 @@
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
+        "../common",
         "C:/opencv/build/include",
         "C:/opencv/build/include/opencv2"
       ],
@@ -1,9 +1,10 @@
 #include <napi.h>
 #include "thermal_engine.cpp"  // Include the thermal engine
 #include <iostream>
-
-// Global engine instance
-static ThermalEngine engine;
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
 
 // Helper function to validate and extract number parameters
 double GetNumberParam(const Napi::CallbackInfo& info, int index, const std::string& paramName) {
@@ -21,8 +22,420 @@ std::string GetStringParam(const Napi::CallbackInfo& info, int index, const std:
     return info[index].As<Napi::String>().Utf8Value();
 }
 
+// Read a numeric array (JS Array or TypedArray) into floats
+std::vector<float> GetFloatList(Napi::Env env, Napi::Value value, const std::string& paramName) {
+    std::vector<float> result;
+    if (value.IsUndefined() || value.IsNull()) {
+        return result;
+    }
+    if (!value.IsArray() && !value.IsTypedArray()) {
+        throw Napi::TypeError::New(env, paramName + " must be an array of numbers");
+    }
+    
+    Napi::Object list = value.As<Napi::Object>();
+    uint32_t length = value.IsArray()
+        ? value.As<Napi::Array>().Length()
+        : static_cast<uint32_t>(value.As<Napi::TypedArray>().ElementLength());
+    
+    for (uint32_t i = 0; i < length; i++) {
+        Napi::Value item = list.Get(i);
+        if (!item.IsNumber()) {
+            throw Napi::TypeError::New(env, paramName + " must be an array of numbers");
+        }
+        result.push_back(item.As<Napi::Number>().FloatValue());
+    }
+    return result;
+}
+
+// Parse an ROI description:
+//   { type: 'rect', x, y, width, height }
+//   { type: 'polygon', points: [x0, y0, x1, y1, ...] }
+//   { type: 'mask', data: Uint8Array(width * height) }
+RoiShape GetRoiParam(const Napi::CallbackInfo& info, int index) {
+    Napi::Env env = info.Env();
+    if (info.Length() <= static_cast<size_t>(index) || !info[index].IsObject()) {
+        throw Napi::TypeError::New(env, "roi must be an object");
+    }
+    
+    Napi::Object roi = info[index].As<Napi::Object>();
+    std::string type = roi.Get("type").IsString() ? roi.Get("type").As<Napi::String>().Utf8Value() : "";
+    RoiShape shape;
+    
+    auto getInt = [&](const char* key) {
+        Napi::Value v = roi.Get(key);
+        if (!v.IsNumber()) {
+            throw Napi::TypeError::New(env, std::string("roi.") + key + " must be a number");
+        }
+        return v.As<Napi::Number>().Int32Value();
+    };
+    
+    if (type == "rect") {
+        shape.type = RoiShape::RECT;
+        shape.rect = cv::Rect(getInt("x"), getInt("y"), getInt("width"), getInt("height"));
+    } else if (type == "polygon") {
+        shape.type = RoiShape::POLYGON;
+        std::vector<float> coords = GetFloatList(env, roi.Get("points"), "roi.points");
+        if (coords.size() < 6 || coords.size() % 2 != 0) {
+            throw Napi::TypeError::New(env, "roi.points must hold at least 3 x, y pairs");
+        }
+        for (size_t i = 0; i < coords.size(); i += 2) {
+            shape.points.emplace_back(static_cast<int>(std::lround(coords[i])),
+                                      static_cast<int>(std::lround(coords[i + 1])));
+        }
+    } else if (type == "mask") {
+        shape.type = RoiShape::MASK;
+        Napi::Value data = roi.Get("data");
+        if (!data.IsTypedArray() || data.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            throw Napi::TypeError::New(env, "roi.data must be a Uint8Array");
+        }
+        Napi::Uint8Array mask = data.As<Napi::Uint8Array>();
+        shape.mask.assign(mask.Data(), mask.Data() + mask.ElementLength());
+    } else {
+        throw Napi::TypeError::New(env, "roi.type must be 'rect', 'polygon' or 'mask'");
+    }
+    
+    return shape;
+}
+
+// Parse { percentiles: [...], thresholds: [...] }
+RoiOptions GetRoiOptionsParam(const Napi::CallbackInfo& info, int index) {
+    RoiOptions options;
+    if (info.Length() > static_cast<size_t>(index) && info[index].IsObject()) {
+        Napi::Object obj = info[index].As<Napi::Object>();
+        options.percentiles = GetFloatList(info.Env(), obj.Get("percentiles"), "percentiles");
+        options.thresholds = GetFloatList(info.Env(), obj.Get("thresholds"), "thresholds");
+    }
+    return options;
+}
+
+Napi::Object RoiStatsToObject(Napi::Env env, const RoiMask& roi, const RoiOptions& options, const RoiStats& stats) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("pixelCount", Napi::Number::New(env, static_cast<double>(roi.pixelCount)));
+    result.Set("min", Napi::Number::New(env, stats.min));
+    result.Set("max", Napi::Number::New(env, stats.max));
+    result.Set("mean", Napi::Number::New(env, stats.mean));
+    
+    Napi::Array percentiles = Napi::Array::New(env, options.percentiles.size());
+    for (size_t i = 0; i < options.percentiles.size(); i++) {
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("percentile", Napi::Number::New(env, options.percentiles[i]));
+        entry.Set("value", Napi::Number::New(env, stats.percentiles[i]));
+        percentiles[i] = entry;
+    }
+    result.Set("percentiles", percentiles);
+    
+    Napi::Array areaAbove = Napi::Array::New(env, options.thresholds.size());
+    for (size_t i = 0; i < options.thresholds.size(); i++) {
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("threshold", Napi::Number::New(env, options.thresholds[i]));
+        entry.Set("pixels", Napi::Number::New(env, stats.areaAbove[i]));
+        entry.Set("fraction", Napi::Number::New(env, static_cast<double>(stats.areaAbove[i]) / roi.pixelCount));
+        areaAbove[i] = entry;
+    }
+    result.Set("areaAbove", areaAbove);
+    
+    return result;
+}
+
+// Parse { thresholds: [...], contours, simplify }; at least one threshold is required
+IsothermOptions GetIsothermOptionsParam(const Napi::CallbackInfo& info, int index) {
+    Napi::Env env = info.Env();
+    if (info.Length() <= static_cast<size_t>(index) || !info[index].IsObject()) {
+        throw Napi::TypeError::New(env, "options must be an object with thresholds");
+    }
+    
+    Napi::Object obj = info[index].As<Napi::Object>();
+    IsothermOptions options;
+    options.thresholds = GetFloatList(env, obj.Get("thresholds"), "thresholds");
+    if (options.thresholds.empty()) {
+        throw Napi::TypeError::New(env, "thresholds must hold at least one temperature");
+    }
+    
+    options.contours = obj.Get("contours").ToBoolean();
+    
+    Napi::Value simplify = obj.Get("simplify");
+    if (!simplify.IsUndefined()) {
+        if (!simplify.IsNumber() || simplify.As<Napi::Number>().DoubleValue() < 0) {
+            throw Napi::TypeError::New(env, "simplify must be a non-negative number");
+        }
+        options.simplify = simplify.As<Napi::Number>().DoubleValue();
+    }
+    
+    return options;
+}
+
+// Outline as an Int32Array of x, y pairs
+Napi::Int32Array ContourToArray(Napi::Env env, const std::vector<cv::Point>& contour) {
+    Napi::Int32Array points = Napi::Int32Array::New(env, contour.size() * 2);
+    for (size_t i = 0; i < contour.size(); i++) {
+        points[i * 2] = contour[i].x;
+        points[i * 2 + 1] = contour[i].y;
+    }
+    return points;
+}
+
+// Forwards (done, total) progress from worker threads to a JS callback
+// through a ThreadSafeFunction. Does nothing when no callback was given.
+class ProgressReporter {
+public:
+    ProgressReporter(Napi::Env env, Napi::Value callback, const char* resourceName) {
+        if (callback.IsFunction()) {
+            tsfn = Napi::ThreadSafeFunction::New(env, callback.As<Napi::Function>(), resourceName, 0, 1);
+        }
+    }
+
+    void Report(int done, int total) const {
+        if (!tsfn) return;
+        
+        auto* progress = new std::pair<int, int>(done, total);
+        napi_status status = tsfn.NonBlockingCall(progress,
+            [](Napi::Env env, Napi::Function callback, std::pair<int, int>* data) {
+                // env is null when the function is being torn down
+                if (env != nullptr) {
+                    callback.Call({ Napi::Number::New(env, data->first), Napi::Number::New(env, data->second) });
+                }
+                delete data;
+            });
+        
+        if (status != napi_ok) {
+            delete progress;
+        }
+    }
+
+    // Must be called once on the main thread after the worker has finished
+    void Release() {
+        if (tsfn) {
+            tsfn.Release();
+            tsfn = Napi::ThreadSafeFunction();
+        }
+    }
+
+private:
+    Napi::ThreadSafeFunction tsfn;
+};
+
+// Convert a frame statistics series to a JS object of typed arrays
+Napi::Object FrameStatsToObject(Napi::Env env, const FrameStatsSeries& series) {
+    size_t frames = series.size();
+    
+    Napi::Float32Array maxTemp = Napi::Float32Array::New(env, frames);
+    Napi::Float32Array minTemp = Napi::Float32Array::New(env, frames);
+    Napi::Float32Array meanTemp = Napi::Float32Array::New(env, frames);
+    Napi::Uint16Array hotspotX = Napi::Uint16Array::New(env, frames);
+    Napi::Uint16Array hotspotY = Napi::Uint16Array::New(env, frames);
+    
+    std::copy(series.maxTemp.begin(), series.maxTemp.end(), maxTemp.Data());
+    std::copy(series.minTemp.begin(), series.minTemp.end(), minTemp.Data());
+    std::copy(series.meanTemp.begin(), series.meanTemp.end(), meanTemp.Data());
+    std::copy(series.hotspotX.begin(), series.hotspotX.end(), hotspotX.Data());
+    std::copy(series.hotspotY.begin(), series.hotspotY.end(), hotspotY.Data());
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("frames", Napi::Number::New(env, static_cast<double>(frames)));
+    result.Set("maxTemp", maxTemp);
+    result.Set("minTemp", minTemp);
+    result.Set("meanTemp", meanTemp);
+    result.Set("hotspotX", hotspotX);
+    result.Set("hotspotY", hotspotY);
+    
+    return result;
+}
+
+// Rows of a line-over-time matrix that are ready to be streamed
+struct LineChunk {
+    size_t firstRow;
+    size_t rowCount;
+};
+
+// One native engine plus the queue that serializes jobs on it. The slot is
+// only touched on the JS thread; the engine only by the job that is running.
+struct EngineSlot {
+    ThermalEngine engine;
+    ThermalEngine::VideoInfo info = { 0, 0.0, 0, 0, false };  // published when loadVideo completes
+    std::deque<Napi::AsyncWorker*> pending;
+    bool busy = false;
+
+    // Start the worker now, or once the jobs queued before it have finished
+    void Submit(Napi::AsyncWorker* worker) {
+        if (busy) {
+            pending.push_back(worker);
+            return;
+        }
+        busy = true;
+        worker->Queue();
+    }
+
+    // Called when the running job has completed
+    void RunNext() {
+        if (pending.empty()) {
+            busy = false;
+            return;
+        }
+        Napi::AsyncWorker* next = pending.front();
+        pending.pop_front();
+        next->Queue();
+    }
+};
+
+// Held by every engine job. Workers are destroyed on the JS thread after
+// OnOK/OnError, so releasing the lease there starts the next queued job.
+class EngineLease {
+public:
+    explicit EngineLease(std::shared_ptr<EngineSlot> slot) : slot(std::move(slot)) {}
+    ~EngineLease() { slot->RunNext(); }
+
+    EngineLease(const EngineLease&) = delete;
+    EngineLease& operator=(const EngineLease&) = delete;
+
+    ThermalEngine& engine() const { return slot->engine; }
+
+private:
+    std::shared_ptr<EngineSlot> slot;
+};
+
+// Promise-returning job on one engine: work runs on the libuv thread pool and
+// reports failure by throwing, convert builds the JS result on the main thread
+template <typename Result>
+class EngineTask : public Napi::AsyncWorker {
+public:
+    using Work = std::function<void(ThermalEngine&, Result&)>;
+    using Convert = std::function<Napi::Value(Napi::Env, Result&)>;
+
+    EngineTask(Napi::Env env, std::shared_ptr<EngineSlot> slot, const char* name, Work work, Convert convert)
+        : Napi::AsyncWorker(env, name),
+          deferred(Napi::Promise::Deferred::New(env)),
+          lease(std::move(slot)), work(std::move(work)), convert(std::move(convert)), result() {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        try {
+            work(lease.engine(), result);
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred.Resolve(convert(Env(), result));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    EngineLease lease;
+    Work work;
+    Convert convert;
+    Result result;
+};
+
+// Engine-side checks run inside the job, after earlier queued loads have finished
+void RequireVideo(const ThermalEngine& engine) {
+    if (!engine.isVideoLoaded()) {
+        throw std::runtime_error("Video not loaded");
+    }
+}
+
+void RequireFrame(const ThermalEngine& engine, int frameNum) {
+    RequireVideo(engine);
+    if (frameNum < 0 || frameNum >= engine.getTotalFrames()) {
+        throw std::out_of_range("Frame number out of range");
+    }
+}
+
+void RequireFrameRange(const ThermalEngine& engine, int startFrame, int endFrame) {
+    RequireVideo(engine);
+    if (startFrame < 0 || endFrame >= engine.getTotalFrames() || startFrame > endFrame) {
+        throw std::out_of_range("Frame range out of range");
+    }
+}
+
+// JS class ThermalEngine: one video and temperature mapping per instance.
+// Heavy calls return Promises and run off the main thread. Calls on one
+// instance run one after another in call order; instances run in parallel.
+class ThermalEngineObject : public Napi::ObjectWrap<ThermalEngineObject> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "ThermalEngine", {
+            // Core functions
+            InstanceMethod("loadVideo", &ThermalEngineObject::LoadVideo),
+            InstanceMethod("loadTempMapping", &ThermalEngineObject::LoadTempMapping),
+            InstanceMethod("analyzeLine", &ThermalEngineObject::AnalyzeLine),
+            InstanceMethod("analyzeLines", &ThermalEngineObject::AnalyzeLines),
+            InstanceMethod("analyzeLineOverTime", &ThermalEngineObject::AnalyzeLineOverTime),
+            InstanceMethod("computeFrameStats", &ThermalEngineObject::ComputeFrameStats),
+            InstanceMethod("loadFrameStats", &ThermalEngineObject::LoadFrameStats),
+            InstanceMethod("analyzeRoi", &ThermalEngineObject::AnalyzeRoi),
+            InstanceMethod("analyzeRoiOverTime", &ThermalEngineObject::AnalyzeRoiOverTime),
+            InstanceMethod("analyzeIsotherms", &ThermalEngineObject::AnalyzeIsotherms),
+            InstanceMethod("analyzeIsothermsOverTime", &ThermalEngineObject::AnalyzeIsothermsOverTime),
+            InstanceMethod("getTemperatureFrame", &ThermalEngineObject::GetTemperatureFrame),
+            InstanceMethod("getVideoInfo", &ThermalEngineObject::GetVideoInfo),
+            
+            // Utility functions
+            InstanceMethod("getPixelTemperature", &ThermalEngineObject::GetPixelTemperature),
+            InstanceMethod("isReady", &ThermalEngineObject::IsReady),
+            InstanceMethod("exportFrame", &ThermalEngineObject::ExportFrame),
+            InstanceMethod("buildThumbnails", &ThermalEngineObject::BuildThumbnails),
+            
+            // Precomputed temperature volume
+            InstanceMethod("buildTemperatureVolume", &ThermalEngineObject::BuildTemperatureVolume),
+            InstanceMethod("attachTemperatureVolume", &ThermalEngineObject::AttachTemperatureVolume),
+            InstanceMethod("detachTemperatureVolume", &ThermalEngineObject::DetachTemperatureVolume),
+            
+            // Release the video and mapping once queued jobs have finished
+            InstanceMethod("close", &ThermalEngineObject::Close)
+        });
+    }
+
+    explicit ThermalEngineObject(const Napi::CallbackInfo& info)
+        : Napi::ObjectWrap<ThermalEngineObject>(info),
+          slot(std::make_shared<EngineSlot>()) {}
+
+private:
+    Napi::Value LoadVideo(const Napi::CallbackInfo& info);
+    Napi::Value LoadTempMapping(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeLine(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeLines(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeLineOverTime(const Napi::CallbackInfo& info);
+    Napi::Value ComputeFrameStats(const Napi::CallbackInfo& info);
+    Napi::Value LoadFrameStats(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeRoi(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeRoiOverTime(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeIsotherms(const Napi::CallbackInfo& info);
+    Napi::Value AnalyzeIsothermsOverTime(const Napi::CallbackInfo& info);
+    Napi::Value GetTemperatureFrame(const Napi::CallbackInfo& info);
+    Napi::Value GetVideoInfo(const Napi::CallbackInfo& info);
+    Napi::Value GetPixelTemperature(const Napi::CallbackInfo& info);
+    Napi::Value IsReady(const Napi::CallbackInfo& info);
+    Napi::Value ExportFrame(const Napi::CallbackInfo& info);
+    Napi::Value BuildThumbnails(const Napi::CallbackInfo& info);
+    Napi::Value BuildTemperatureVolume(const Napi::CallbackInfo& info);
+    Napi::Value AttachTemperatureVolume(const Napi::CallbackInfo& info);
+    Napi::Value DetachTemperatureVolume(const Napi::CallbackInfo& info);
+    Napi::Value Close(const Napi::CallbackInfo& info);
+
+    // Queue a job on this instance's engine and return its promise
+    template <typename Result>
+    Napi::Value Run(Napi::Env env, const char* name,
+                    typename EngineTask<Result>::Work work,
+                    typename EngineTask<Result>::Convert convert) {
+        EngineTask<Result>* task = new EngineTask<Result>(env, slot, name, std::move(work), std::move(convert));
+        Napi::Promise promise = task->GetPromise();
+        slot->Submit(task);
+        return promise;
+    }
+
+    std::shared_ptr<EngineSlot> slot;
+};
+
 // Load video file
-Napi::Value LoadVideo(const Napi::CallbackInfo& info) {
+// Returns Promise<boolean>
+Napi::Value ThermalEngineObject::LoadVideo(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -32,17 +445,25 @@ Napi::Value LoadVideo(const Napi::CallbackInfo& info) {
         }
         
         std::string videoPath = GetStringParam(info, 0, "videoPath");
+        EngineSlot* owner = slot.get();
         
-        // Load video
-        bool success = engine.loadVideo(videoPath);
-        
-        if (success) {
-            std::cout << "Video loaded successfully via Node.js binding" << std::endl;
-        } else {
-            std::cout << "Failed to load video via Node.js binding" << std::endl;
-        }
-        
-        return Napi::Boolean::New(env, success);
+        struct Loaded { bool success; ThermalEngine::VideoInfo info; };
+        return Run<Loaded>(env, "ThermalLoadVideo",
+            [videoPath](ThermalEngine& engine, Loaded& result) {
+                result.success = engine.loadVideo(videoPath);
+                result.info = engine.getVideoInfo();
+            },
+            [owner](Napi::Env env, Loaded& result) -> Napi::Value {
+                owner->info = result.info;
+                
+                if (result.success) {
+                    std::cout << "Video loaded successfully via Node.js binding" << std::endl;
+                } else {
+                    std::cout << "Failed to load video via Node.js binding" << std::endl;
+                }
+                
+                return Napi::Boolean::New(env, result.success);
+            });
         
     } catch (const std::exception& e) {
         throw Napi::Error::New(env, std::string("Error loading video: ") + e.what());
@@ -50,7 +471,8 @@ Napi::Value LoadVideo(const Napi::CallbackInfo& info) {
 }
 
 // Load temperature mapping CSV
-Napi::Value LoadTempMapping(const Napi::CallbackInfo& info) {
+// Returns Promise<boolean>
+Napi::Value ThermalEngineObject::LoadTempMapping(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -61,16 +483,19 @@ Napi::Value LoadTempMapping(const Napi::CallbackInfo& info) {
         
         std::string csvPath = GetStringParam(info, 0, "csvPath");
         
-        // Load temperature mapping
-        bool success = engine.loadTempMapping(csvPath);
-        
-        if (success) {
-            std::cout << "Temperature mapping loaded successfully via Node.js binding" << std::endl;
-        } else {
-            std::cout << "Failed to load temperature mapping via Node.js binding" << std::endl;
-        }
-        
-        return Napi::Boolean::New(env, success);
+        return Run<bool>(env, "ThermalLoadTempMapping",
+            [csvPath](ThermalEngine& engine, bool& success) {
+                success = engine.loadTempMapping(csvPath);
+            },
+            [](Napi::Env env, bool& success) -> Napi::Value {
+                if (success) {
+                    std::cout << "Temperature mapping loaded successfully via Node.js binding" << std::endl;
+                } else {
+                    std::cout << "Failed to load temperature mapping via Node.js binding" << std::endl;
+                }
+                
+                return Napi::Boolean::New(env, success);
+            });
         
     } catch (const std::exception& e) {
         throw Napi::Error::New(env, std::string("Error loading temperature mapping: ") + e.what());
@@ -78,7 +503,8 @@ Napi::Value LoadTempMapping(const Napi::CallbackInfo& info) {
 }
 
 // Analyze temperature along a line
-Napi::Value AnalyzeLine(const Napi::CallbackInfo& info) {
+// Returns Promise<number[]>
+Napi::Value ThermalEngineObject::AnalyzeLine(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -93,34 +519,692 @@ Napi::Value AnalyzeLine(const Napi::CallbackInfo& info) {
         int x2 = static_cast<int>(GetNumberParam(info, 3, "x2"));
         int y2 = static_cast<int>(GetNumberParam(info, 4, "y2"));
         
-        // Validate frame number
-        if (frameNum < 0 || frameNum >= engine.getTotalFrames()) {
-            throw Napi::RangeError::New(env, "Frame number out of range");
+        return Run<std::vector<float>>(env, "ThermalAnalyzeLine",
+            [=](ThermalEngine& engine, std::vector<float>& temperatures) {
+                RequireFrame(engine, frameNum);
+                temperatures = engine.analyzeLine(frameNum, x1, y1, x2, y2);
+            },
+            [](Napi::Env env, std::vector<float>& temperatures) -> Napi::Value {
+                // Convert std::vector<float> to Napi::Array
+                Napi::Array result = Napi::Array::New(env, temperatures.size());
+                
+                for (size_t i = 0; i < temperatures.size(); i++) {
+                    result[i] = Napi::Number::New(env, temperatures[i]);
+                }
+                
+                return result;
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error analyzing line: ") + e.what());
+    }
+}
+
+// Analyze several lines against one decoded frame
+// coords: Int32Array or Float32Array of x1, y1, x2, y2 per line
+// sampling (optional): { mode: 'pixels' | 'bilinear', samples, width }
+// Returns Promise of one packed Float32Array (layout documented at ThermalEngine::analyzeLines)
+Napi::Value ThermalEngineObject::AnalyzeLines(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        // Validate parameters: frameNum, coords, [sampling]
+        if (info.Length() < 2) {
+            throw Napi::TypeError::New(env, "Expected 2 arguments: frameNum, coords");
         }
         
-        // Analyze line
-        std::vector<float> temperatures = engine.analyzeLine(frameNum, x1, y1, x2, y2);
+        int frameNum = static_cast<int>(GetNumberParam(info, 0, "frameNum"));
         
-        // Convert std::vector<float> to Napi::Array
-        Napi::Array result = Napi::Array::New(env, temperatures.size());
+        if (!info[1].IsTypedArray()) {
+            throw Napi::TypeError::New(env, "coords must be an Int32Array or Float32Array");
+        }
         
-        for (size_t i = 0; i < temperatures.size(); i++) {
-            result[i] = Napi::Number::New(env, temperatures[i]);
+        // Copied so the caller may reuse its array while the job is queued
+        std::vector<float> coords;
+        Napi::TypedArray coordArray = info[1].As<Napi::TypedArray>();
+        if (coordArray.TypedArrayType() == napi_int32_array) {
+            Napi::Int32Array ints = coordArray.As<Napi::Int32Array>();
+            coords.assign(ints.Data(), ints.Data() + ints.ElementLength());
+        } else if (coordArray.TypedArrayType() == napi_float32_array) {
+            Napi::Float32Array floats = coordArray.As<Napi::Float32Array>();
+            coords.assign(floats.Data(), floats.Data() + floats.ElementLength());
+        } else {
+            throw Napi::TypeError::New(env, "coords must be an Int32Array or Float32Array");
         }
         
-        return result;
+        if (coords.empty() || coords.size() % 4 != 0) {
+            throw Napi::TypeError::New(env, "coords length must be a non-zero multiple of 4");
+        }
+        
+        LineSampling sampling;
+        if (info.Length() > 2 && info[2].IsObject()) {
+            Napi::Object obj = info[2].As<Napi::Object>();
+            
+            Napi::Value mode = obj.Get("mode");
+            if (mode.IsString()) {
+                std::string name = mode.As<Napi::String>().Utf8Value();
+                if (name == "bilinear") {
+                    sampling.mode = LineSampling::BILINEAR;
+                } else if (name != "pixels") {
+                    throw Napi::TypeError::New(env, "sampling.mode must be 'pixels' or 'bilinear'");
+                }
+            }
+            
+            Napi::Value samples = obj.Get("samples");
+            if (samples.IsNumber()) {
+                sampling.samples = samples.As<Napi::Number>().Int32Value();
+                if (sampling.samples < 1 || sampling.samples > LineSampling::MAX_SAMPLES) {
+                    throw Napi::RangeError::New(env, "sampling.samples must be between 1 and " + std::to_string(LineSampling::MAX_SAMPLES));
+                }
+            }
+            
+            Napi::Value width = obj.Get("width");
+            if (width.IsNumber()) {
+                sampling.width = width.As<Napi::Number>().FloatValue();
+                if (!(sampling.width >= 1.0f && sampling.width <= LineSampling::MAX_WIDTH)) {
+                    throw Napi::RangeError::New(env, "sampling.width must be between 1 and " + std::to_string(static_cast<int>(LineSampling::MAX_WIDTH)));
+                }
+            }
+        }
+        
+        return Run<std::vector<float>>(env, "ThermalAnalyzeLines",
+            [frameNum, coords, sampling](ThermalEngine& engine, std::vector<float>& packed) {
+                RequireFrame(engine, frameNum);
+                packed = engine.analyzeLines(frameNum, coords.data(), coords.size() / 4, sampling);
+            },
+            [](Napi::Env env, std::vector<float>& packed) -> Napi::Value {
+                if (packed.empty()) {
+                    return env.Null();
+                }
+                
+                Napi::Float32Array result = Napi::Float32Array::New(env, packed.size());
+                std::copy(packed.begin(), packed.end(), result.Data());
+                return result;
+            });
         
     } catch (const std::exception& e) {
-        throw Napi::Error::New(env, std::string("Error analyzing line: ") + e.what());
+        throw Napi::Error::New(env, std::string("Error analyzing lines: ") + e.what());
+    }
+}
+
+// Convert a whole frame to temperatures
+// Returns Promise<Float32Array> (°C) or, when quantized, Promise<Uint16Array> (0.1 °C steps)
+Napi::Value ThermalEngineObject::GetTemperatureFrame(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        // Validate parameters: frameNum, [quantized]
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected at least 1 argument: frameNum");
+        }
+        
+        int frameNum = static_cast<int>(GetNumberParam(info, 0, "frameNum"));
+        bool quantized = info.Length() > 1 && info[1].ToBoolean();
+        
+        if (!slot->info.loaded) {
+            throw Napi::Error::New(env, "Video not loaded");
+        }
+        
+        // The engine writes straight into the typed array's backing store; the
+        // reference keeps it alive until the job has finished
+        size_t pixelCount = static_cast<size_t>(slot->info.width) * slot->info.height;
+        Napi::TypedArray output = quantized
+            ? static_cast<Napi::TypedArray>(Napi::Uint16Array::New(env, pixelCount))
+            : static_cast<Napi::TypedArray>(Napi::Float32Array::New(env, pixelCount));
+        auto outputRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(static_cast<Napi::Object>(output)));
+        void* data = static_cast<uint8_t*>(output.ArrayBuffer().Data()) + output.ByteOffset();
+        
+        return Run<bool>(env, "ThermalTemperatureFrame",
+            [frameNum, quantized, data, pixelCount](ThermalEngine& engine, bool& success) {
+                RequireFrame(engine, frameNum);
+                if (static_cast<size_t>(engine.getFrameWidth()) * engine.getFrameHeight() != pixelCount) {
+                    throw std::runtime_error("Video changed while the frame was queued");
+                }
+                success = quantized
+                    ? engine.getTemperatureFrameQuantized(frameNum, static_cast<uint16_t*>(data))
+                    : engine.getTemperatureFrame(frameNum, static_cast<float*>(data));
+            },
+            [outputRef](Napi::Env env, bool& success) -> Napi::Value {
+                return success ? outputRef->Value() : env.Null();
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error getting temperature frame: ") + e.what());
+    }
+}
+
+// ROI statistics for one frame
+// Args: frameNum, roi, [options { percentiles, thresholds }]
+// Returns Promise<{ pixelCount, min, max, mean, percentiles, areaAbove }>
+Napi::Value ThermalEngineObject::AnalyzeRoi(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 2) {
+            throw Napi::TypeError::New(env, "Expected at least 2 arguments: frameNum, roi");
+        }
+        
+        int frameNum = static_cast<int>(GetNumberParam(info, 0, "frameNum"));
+        RoiShape shape = GetRoiParam(info, 1);
+        RoiOptions options = GetRoiOptionsParam(info, 2);
+        
+        struct RoiResult { bool success; RoiMask roi; RoiStats stats; };
+        return Run<RoiResult>(env, "ThermalAnalyzeRoi",
+            [frameNum, shape, options](ThermalEngine& engine, RoiResult& result) {
+                RequireFrame(engine, frameNum);
+                result.success = engine.analyzeRoi(frameNum, shape, options, result.roi, result.stats);
+            },
+            [options](Napi::Env env, RoiResult& result) -> Napi::Value {
+                if (!result.success) {
+                    return env.Null();
+                }
+                return RoiStatsToObject(env, result.roi, options, result.stats);
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error analyzing ROI: ") + e.what());
+    }
+}
+
+// ROI statistics over a frame range
+// Args: roi, startFrame, endFrame, step, [options { percentiles, thresholds }]
+// Returns Promise with per-frame typed arrays
+Napi::Value ThermalEngineObject::AnalyzeRoiOverTime(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 4) {
+            throw Napi::TypeError::New(env, "Expected at least 4 arguments: roi, startFrame, endFrame, step");
+        }
+        
+        RoiShape shape = GetRoiParam(info, 0);
+        int startFrame = static_cast<int>(GetNumberParam(info, 1, "startFrame"));
+        int endFrame = static_cast<int>(GetNumberParam(info, 2, "endFrame"));
+        int step = static_cast<int>(GetNumberParam(info, 3, "step"));
+        RoiOptions options = GetRoiOptionsParam(info, 4);
+        
+        if (step < 1) {
+            throw Napi::RangeError::New(env, "step must be at least 1");
+        }
+        
+        struct RoiSeries { RoiMask roi; std::vector<RoiStats> series; };
+        return Run<RoiSeries>(env, "ThermalRoiOverTime",
+            [=](ThermalEngine& engine, RoiSeries& result) {
+                RequireFrameRange(engine, startFrame, endFrame);
+                if (!engine.analyzeRoiOverTime(shape, options, startFrame, endFrame, step, result.roi, result.series)) {
+                    throw std::runtime_error("Could not analyze ROI over the frame range");
+                }
+            },
+            [=](Napi::Env env, RoiSeries& result) -> Napi::Value {
+                const std::vector<RoiStats>& series = result.series;
+                size_t frames = series.size();
+                size_t percentileCount = options.percentiles.size();
+                size_t thresholdCount = options.thresholds.size();
+                
+                Napi::Float32Array minTemp = Napi::Float32Array::New(env, frames);
+                Napi::Float32Array maxTemp = Napi::Float32Array::New(env, frames);
+                Napi::Float32Array meanTemp = Napi::Float32Array::New(env, frames);
+                Napi::Float32Array percentiles = Napi::Float32Array::New(env, frames * percentileCount);
+                Napi::Uint32Array areaAbove = Napi::Uint32Array::New(env, frames * thresholdCount);
+                
+                for (size_t i = 0; i < frames; i++) {
+                    minTemp[i] = series[i].min;
+                    maxTemp[i] = series[i].max;
+                    meanTemp[i] = series[i].mean;
+                    std::copy(series[i].percentiles.begin(), series[i].percentiles.end(),
+                              percentiles.Data() + i * percentileCount);
+                    std::copy(series[i].areaAbove.begin(), series[i].areaAbove.end(),
+                              areaAbove.Data() + i * thresholdCount);
+                }
+                
+                Napi::Float32Array percentileLevels = Napi::Float32Array::New(env, percentileCount);
+                std::copy(options.percentiles.begin(), options.percentiles.end(), percentileLevels.Data());
+                Napi::Float32Array thresholds = Napi::Float32Array::New(env, thresholdCount);
+                std::copy(options.thresholds.begin(), options.thresholds.end(), thresholds.Data());
+                
+                Napi::Object object = Napi::Object::New(env);
+                object.Set("startFrame", Napi::Number::New(env, startFrame));
+                object.Set("endFrame", Napi::Number::New(env, endFrame));
+                object.Set("step", Napi::Number::New(env, step));
+                object.Set("frameCount", Napi::Number::New(env, static_cast<double>(frames)));
+                object.Set("pixelCount", Napi::Number::New(env, static_cast<double>(result.roi.pixelCount)));
+                object.Set("min", minTemp);
+                object.Set("max", maxTemp);
+                object.Set("mean", meanTemp);
+                object.Set("percentileLevels", percentileLevels);
+                object.Set("percentiles", percentiles);     // frameCount x percentileLevels
+                object.Set("thresholds", thresholds);
+                object.Set("areaAbove", areaAbove);         // frameCount x thresholds
+                
+                return object;
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error analyzing ROI over time: ") + e.what());
+    }
+}
+
+// Isotherms (area above each threshold) for one frame
+// Args: frameNum, options { thresholds, [contours], [simplify] }
+// Returns Promise<{ pixelCount, levels: [{ threshold, area, fraction, bounds, [contours] }] }>
+Napi::Value ThermalEngineObject::AnalyzeIsotherms(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 2) {
+            throw Napi::TypeError::New(env, "Expected 2 arguments: frameNum, options");
+        }
+        
+        int frameNum = static_cast<int>(GetNumberParam(info, 0, "frameNum"));
+        IsothermOptions options = GetIsothermOptionsParam(info, 1);
+        
+        struct IsothermResult { bool success; double pixelCount; std::vector<IsothermLevel> levels; };
+        return Run<IsothermResult>(env, "ThermalAnalyzeIsotherms",
+            [frameNum, options](ThermalEngine& engine, IsothermResult& result) {
+                RequireFrame(engine, frameNum);
+                result.pixelCount = static_cast<double>(engine.getFrameWidth()) * engine.getFrameHeight();
+                result.success = engine.analyzeIsotherms(frameNum, options, result.levels);
+            },
+            [options](Napi::Env env, IsothermResult& result) -> Napi::Value {
+                if (!result.success) {
+                    return env.Null();
+                }
+                
+                Napi::Array levels = Napi::Array::New(env, result.levels.size());
+                for (size_t i = 0; i < result.levels.size(); i++) {
+                    const IsothermLevel& level = result.levels[i];
+                    Napi::Object entry = Napi::Object::New(env);
+                    entry.Set("threshold", Napi::Number::New(env, options.thresholds[i]));
+                    entry.Set("area", Napi::Number::New(env, level.area));
+                    entry.Set("fraction", Napi::Number::New(env, level.area / result.pixelCount));
+                    
+                    if (level.area > 0) {
+                        Napi::Object bounds = Napi::Object::New(env);
+                        bounds.Set("x", Napi::Number::New(env, level.bounds.x));
+                        bounds.Set("y", Napi::Number::New(env, level.bounds.y));
+                        bounds.Set("width", Napi::Number::New(env, level.bounds.width));
+                        bounds.Set("height", Napi::Number::New(env, level.bounds.height));
+                        entry.Set("bounds", bounds);
+                    } else {
+                        entry.Set("bounds", env.Null());
+                    }
+                    
+                    if (options.contours) {
+                        Napi::Array contours = Napi::Array::New(env, level.contours.size());
+                        for (size_t c = 0; c < level.contours.size(); c++) {
+                            contours[c] = ContourToArray(env, level.contours[c]);
+                        }
+                        entry.Set("contours", contours);
+                    }
+                    levels[i] = entry;
+                }
+                
+                Napi::Object object = Napi::Object::New(env);
+                object.Set("pixelCount", Napi::Number::New(env, result.pixelCount));
+                object.Set("levels", levels);
+                return object;
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error analyzing isotherms: ") + e.what());
+    }
+}
+
+// Isotherms over a frame range
+// Args: startFrame, endFrame, step, options { thresholds, [contours], [simplify] }
+// Returns Promise with frameCount x thresholds typed arrays; with contours the
+// outlines are flattened: contourCounts (per frame and threshold), contourLengths
+// (points per outline) and contourPoints (x, y pairs), all in the same order
+Napi::Value ThermalEngineObject::AnalyzeIsothermsOverTime(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 4) {
+            throw Napi::TypeError::New(env, "Expected 4 arguments: startFrame, endFrame, step, options");
+        }
+        
+        int startFrame = static_cast<int>(GetNumberParam(info, 0, "startFrame"));
+        int endFrame = static_cast<int>(GetNumberParam(info, 1, "endFrame"));
+        int step = static_cast<int>(GetNumberParam(info, 2, "step"));
+        IsothermOptions options = GetIsothermOptionsParam(info, 3);
+        
+        if (step < 1) {
+            throw Napi::RangeError::New(env, "step must be at least 1");
+        }
+        
+        struct IsothermSeries { double pixelCount; std::vector<std::vector<IsothermLevel>> series; };
+        return Run<IsothermSeries>(env, "ThermalIsothermsOverTime",
+            [=](ThermalEngine& engine, IsothermSeries& result) {
+                RequireFrameRange(engine, startFrame, endFrame);
+                result.pixelCount = static_cast<double>(engine.getFrameWidth()) * engine.getFrameHeight();
+                if (!engine.analyzeIsothermsOverTime(options, startFrame, endFrame, step, result.series)) {
+                    throw std::runtime_error("Could not analyze isotherms over the frame range");
+                }
+            },
+            [=](Napi::Env env, IsothermSeries& result) -> Napi::Value {
+                const std::vector<std::vector<IsothermLevel>>& series = result.series;
+                size_t frames = series.size();
+                size_t thresholdCount = options.thresholds.size();
+                
+                Napi::Uint32Array area = Napi::Uint32Array::New(env, frames * thresholdCount);
+                Napi::Int32Array bounds = Napi::Int32Array::New(env, frames * thresholdCount * 4);
+                size_t contourCount = 0, pointCount = 0;
+                
+                for (size_t i = 0; i < frames; i++) {
+                    for (size_t t = 0; t < thresholdCount; t++) {
+                        const IsothermLevel& level = series[i][t];
+                        size_t index = i * thresholdCount + t;
+                        area[index] = level.area;
+                        bounds[index * 4] = level.bounds.x;
+                        bounds[index * 4 + 1] = level.bounds.y;
+                        bounds[index * 4 + 2] = level.bounds.width;
+                        bounds[index * 4 + 3] = level.bounds.height;
+                        
+                        contourCount += level.contours.size();
+                        for (const std::vector<cv::Point>& contour : level.contours) {
+                            pointCount += contour.size();
+                        }
+                    }
+                }
+                
+                Napi::Float32Array thresholds = Napi::Float32Array::New(env, thresholdCount);
+                std::copy(options.thresholds.begin(), options.thresholds.end(), thresholds.Data());
+                
+                Napi::Object object = Napi::Object::New(env);
+                object.Set("startFrame", Napi::Number::New(env, startFrame));
+                object.Set("endFrame", Napi::Number::New(env, endFrame));
+                object.Set("step", Napi::Number::New(env, step));
+                object.Set("frameCount", Napi::Number::New(env, static_cast<double>(frames)));
+                object.Set("pixelCount", Napi::Number::New(env, result.pixelCount));
+                object.Set("thresholds", thresholds);
+                object.Set("area", area);                   // frameCount x thresholds
+                object.Set("bounds", bounds);               // frameCount x thresholds x (x, y, width, height)
+                
+                if (options.contours) {
+                    Napi::Uint32Array contourCounts = Napi::Uint32Array::New(env, frames * thresholdCount);
+                    Napi::Uint32Array contourLengths = Napi::Uint32Array::New(env, contourCount);
+                    Napi::Int32Array contourPoints = Napi::Int32Array::New(env, pointCount * 2);
+                    size_t contour = 0, point = 0;
+                    
+                    for (size_t i = 0; i < frames; i++) {
+                        for (size_t t = 0; t < thresholdCount; t++) {
+                            const IsothermLevel& level = series[i][t];
+                            contourCounts[i * thresholdCount + t] = static_cast<uint32_t>(level.contours.size());
+                            for (const std::vector<cv::Point>& outline : level.contours) {
+                                contourLengths[contour++] = static_cast<uint32_t>(outline.size());
+                                for (const cv::Point& p : outline) {
+                                    contourPoints[point++] = p.x;
+                                    contourPoints[point++] = p.y;
+                                }
+                            }
+                        }
+                    }
+                    
+                    object.Set("contourCounts", contourCounts);
+                    object.Set("contourLengths", contourLengths);
+                    object.Set("contourPoints", contourPoints);
+                }
+                
+                return object;
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error analyzing isotherms over time: ") + e.what());
     }
 }
 
-// Get video information
-Napi::Value GetVideoInfo(const Napi::CallbackInfo& info) {
+// Background job: per-frame statistics for the whole video, persisted as a sidecar.
+// An up-to-date sidecar is loaded instead of decoding the video again.
+class FrameStatsWorker : public Napi::AsyncWorker {
+public:
+    FrameStatsWorker(Napi::Env env, std::shared_ptr<EngineSlot> slot, const std::string& sidecarPath,
+                     bool forceRecompute, Napi::Value onProgress)
+        : Napi::AsyncWorker(env, "ThermalFrameStats"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          lease(std::move(slot)),
+          progress(env, onProgress, "ThermalFrameStatsProgress"),
+          sidecarPath(sidecarPath), forceRecompute(forceRecompute), fromSidecar(false) {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        ThermalEngine& engine = lease.engine();
+        if (!engine.isVideoLoaded()) {
+            SetError("Video not loaded");
+            return;
+        }
+        
+        if (!forceRecompute && engine.loadFrameStats(sidecarPath, series)) {
+            fromSidecar = true;
+            return;
+        }
+        
+        if (!engine.computeFrameStats(series, [this](int done, int total) { progress.Report(done, total); })) {
+            SetError("Could not decode video for frame statistics");
+            return;
+        }
+        
+        if (!engine.saveFrameStats(sidecarPath, series)) {
+            std::cerr << "Warning: frame statistics computed but sidecar not written: " << sidecarPath << std::endl;
+        }
+    }
+
+    void OnOK() override {
+        progress.Release();
+        
+        Napi::Object result = FrameStatsToObject(Env(), series);
+        result.Set("fromSidecar", Napi::Boolean::New(Env(), fromSidecar));
+        deferred.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        progress.Release();
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    EngineLease lease;
+    ProgressReporter progress;
+    std::string sidecarPath;
+    bool forceRecompute;
+    bool fromSidecar;
+    FrameStatsSeries series;
+};
+
+// Compute (or load) per-frame max/min/mean temperature and hotspot location
+// Args: sidecarPath, [onProgress(done, total)], [forceRecompute]
+// Returns Promise<{ frames, maxTemp, minTemp, meanTemp, hotspotX, hotspotY, fromSidecar }>
+Napi::Value ThermalEngineObject::ComputeFrameStats(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        auto videoInfo = engine.getVideoInfo();
+        std::string sidecarPath = GetStringParam(info, 0, "sidecarPath");
+        Napi::Value onProgress = info.Length() > 1 ? info[1] : env.Undefined();
+        bool forceRecompute = info.Length() > 2 && info[2].ToBoolean();
+        
+        FrameStatsWorker* worker = new FrameStatsWorker(env, slot, sidecarPath, forceRecompute, onProgress);
+        Napi::Promise promise = worker->GetPromise();
+        slot->Submit(worker);
+        
+        return promise;
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error computing frame statistics: ") + e.what());
+    }
+}
+
+// Load per-frame statistics from an up-to-date sidecar
+// Returns Promise of the series, or null if the sidecar is missing or stale
+Napi::Value ThermalEngineObject::LoadFrameStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::string sidecarPath = GetStringParam(info, 0, "sidecarPath");
+        
+        struct Loaded { bool success; FrameStatsSeries series; };
+        return Run<Loaded>(env, "ThermalLoadFrameStats",
+            [sidecarPath](ThermalEngine& engine, Loaded& result) {
+                result.success = engine.isVideoLoaded() && engine.loadFrameStats(sidecarPath, result.series);
+            },
+            [](Napi::Env env, Loaded& result) -> Napi::Value {
+                if (!result.success) {
+                    return env.Null();
+                }
+                
+                Napi::Object object = FrameStatsToObject(env, result.series);
+                object.Set("fromSidecar", Napi::Boolean::New(env, true));
+                return object;
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error loading frame statistics: ") + e.what());
+    }
+}
+
+// Background worker for analyzeLineOverTime: decodes the frame range on a pool
+// of decoders and streams completed row blocks to the optional onChunk callback
+class LineOverTimeWorker : public Napi::AsyncProgressQueueWorker<LineChunk> {
+public:
+    LineOverTimeWorker(Napi::Env env, std::shared_ptr<EngineSlot> slot, int x1, int y1, int x2, int y2,
+                       int startFrame, int endFrame, int step, Napi::Value onChunk)
+        : Napi::AsyncProgressQueueWorker<LineChunk>(env, "ThermalLineOverTime"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          lease(std::move(slot)),
+          x1(x1), y1(y1), x2(x2), y2(y2),
+          startFrame(startFrame), endFrame(endFrame), step(step), pixelCount(0) {
+        if (onChunk.IsFunction()) {
+            chunkCallback = Napi::Persistent(onChunk.As<Napi::Function>());
+        }
+    }
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute(const ExecutionProgress& progress) override {
+        ThermalEngine& engine = lease.engine();
+        if (!engine.isVideoLoaded() || startFrame < 0 || endFrame >= engine.getTotalFrames()) {
+            SetError("Frame range out of range");
+            return;
+        }
+        
+        bool success = engine.analyzeLineOverTime(
+            x1, y1, x2, y2, startFrame, endFrame, step, ROWS_PER_CHUNK, matrix, pixelCount,
+            [&progress](size_t firstRow, size_t rowCount) {
+                LineChunk chunk = { firstRow, rowCount };
+                progress.Send(&chunk, 1);
+            });
+        
+        if (!success) {
+            SetError("Could not decode frame range for line analysis");
+        }
+    }
+
+    void OnProgress(const LineChunk* chunks, size_t count) override {
+        if (chunkCallback.IsEmpty()) return;
+        
+        Napi::Env env = Env();
+        Napi::HandleScope scope(env);
+        
+        for (size_t i = 0; i < count; i++) {
+            const LineChunk& chunk = chunks[i];
+            const float* rows = matrix.data() + chunk.firstRow * pixelCount;
+            
+            Napi::Float32Array data = Napi::Float32Array::New(env, chunk.rowCount * pixelCount);
+            std::copy(rows, rows + chunk.rowCount * pixelCount, data.Data());
+            
+            Napi::Object message = Napi::Object::New(env);
+            message.Set("firstRow", Napi::Number::New(env, static_cast<double>(chunk.firstRow)));
+            message.Set("rowCount", Napi::Number::New(env, static_cast<double>(chunk.rowCount)));
+            message.Set("firstFrame", Napi::Number::New(env, startFrame + static_cast<double>(chunk.firstRow) * step));
+            message.Set("pixelCount", Napi::Number::New(env, static_cast<double>(pixelCount)));
+            message.Set("data", data);
+            
+            chunkCallback.Call({ message });
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        
+        Napi::Float32Array data = Napi::Float32Array::New(env, matrix.size());
+        std::copy(matrix.begin(), matrix.end(), data.Data());
+        
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("startFrame", Napi::Number::New(env, startFrame));
+        result.Set("endFrame", Napi::Number::New(env, endFrame));
+        result.Set("step", Napi::Number::New(env, step));
+        result.Set("frameCount", Napi::Number::New(env, pixelCount > 0 ? static_cast<double>(matrix.size() / pixelCount) : 0));
+        result.Set("pixelCount", Napi::Number::New(env, static_cast<double>(pixelCount)));
+        result.Set("data", data);
+        
+        deferred.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred.Reject(error.Value());
+    }
+
+private:
+    static constexpr size_t ROWS_PER_CHUNK = 32;
+
+    Napi::Promise::Deferred deferred;
+    EngineLease lease;
+    Napi::FunctionReference chunkCallback;
+    int x1, y1, x2, y2;
+    int startFrame, endFrame, step;
+    std::vector<float> matrix;
+    size_t pixelCount;
+};
+
+// Sample a line over a frame range (kymograph)
+// Args: x1, y1, x2, y2, startFrame, endFrame, step, [onChunk]
+// Returns Promise<{ startFrame, endFrame, step, frameCount, pixelCount, data: Float32Array }>
+Napi::Value ThermalEngineObject::AnalyzeLineOverTime(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 7) {
+            throw Napi::TypeError::New(env, "Expected 7 arguments: x1, y1, x2, y2, startFrame, endFrame, step");
+        }
+        
+        int x1 = static_cast<int>(GetNumberParam(info, 0, "x1"));
+        int y1 = static_cast<int>(GetNumberParam(info, 1, "y1"));
+        int x2 = static_cast<int>(GetNumberParam(info, 2, "x2"));
+        int y2 = static_cast<int>(GetNumberParam(info, 3, "y2"));
+        int startFrame = static_cast<int>(GetNumberParam(info, 4, "startFrame"));
+        int endFrame = static_cast<int>(GetNumberParam(info, 5, "endFrame"));
+        int step = static_cast<int>(GetNumberParam(info, 6, "step"));
+        
+        if (step < 1) {
+            throw Napi::RangeError::New(env, "step must be at least 1");
+        }
+        
+        if (startFrame < 0 || startFrame > endFrame) {
+            throw Napi::RangeError::New(env, "Frame range out of range");
+        }
+        
+        Napi::Value onChunk = info.Length() > 7 ? info[7] : env.Undefined();
+        
+        LineOverTimeWorker* worker = new LineOverTimeWorker(
+            env, slot, x1, y1, x2, y2, startFrame, endFrame, step, onChunk);
+        Napi::Promise promise = worker->GetPromise();
+        slot->Submit(worker);
+        
+        return promise;
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error analyzing line over time: ") + e.what());
+    }
+}
+
+// Get video information (as of the last completed loadVideo)
+Napi::Value ThermalEngineObject::GetVideoInfo(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        const ThermalEngine::VideoInfo& videoInfo = slot->info;
         
         // Create JavaScript object with video properties
         Napi::Object result = Napi::Object::New(env);
@@ -139,7 +1223,8 @@ Napi::Value GetVideoInfo(const Napi::CallbackInfo& info) {
 }
 
 // Get temperature for a specific pixel
-Napi::Value GetPixelTemperature(const Napi::CallbackInfo& info) {
+// Returns Promise<number|null>
+Napi::Value ThermalEngineObject::GetPixelTemperature(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -157,13 +1242,16 @@ Napi::Value GetPixelTemperature(const Napi::CallbackInfo& info) {
             throw Napi::RangeError::New(env, "RGB values must be between 0 and 255");
         }
         
-        float temperature = engine.getPixelTemperature(r, g, b);
-        
-        if (temperature < 0) {
-            return env.Null();  // Return null if no temperature found
-        }
-        
-        return Napi::Number::New(env, temperature);
+        return Run<float>(env, "ThermalPixelTemperature",
+            [r, g, b](ThermalEngine& engine, float& temperature) {
+                temperature = engine.lookupTemperature(r, g, b);
+            },
+            [](Napi::Env env, float& temperature) -> Napi::Value {
+                if (temperature < 0) {
+                    return env.Null();  // Return null if no temperature found
+                }
+                return Napi::Number::New(env, temperature);
+            });
         
     } catch (const std::exception& e) {
         throw Napi::Error::New(env, std::string("Error getting pixel temperature: ") + e.what());
@@ -171,11 +1259,11 @@ Napi::Value GetPixelTemperature(const Napi::CallbackInfo& info) {
 }
 
 // Check if engine is ready (video and mapping loaded)
-Napi::Value IsReady(const Napi::CallbackInfo& info) {
+Napi::Value ThermalEngineObject::IsReady(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        bool ready = engine.isVideoLoaded() && engine.getTotalFrames() > 0;
+        bool ready = slot->info.loaded && slot->info.frames > 0;
         return Napi::Boolean::New(env, ready);
         
     } catch (const std::exception& e) {
@@ -183,71 +1271,441 @@ Napi::Value IsReady(const Napi::CallbackInfo& info) {
     }
 }
 
-// Get frame data as base64 (optional - for debugging)
-Napi::Value GetFrameBase64(const Napi::CallbackInfo& info) {
+// Parse { format: 'jpeg' | 'png' | 'webp', quality, width, height }
+FrameEncodeOptions GetEncodeOptionsParam(const Napi::CallbackInfo& info, int index,
+                                         FrameEncodeOptions options = FrameEncodeOptions()) {
+    Napi::Env env = info.Env();
+    if (info.Length() <= static_cast<size_t>(index) || !info[index].IsObject()) {
+        return options;
+    }
+    
+    Napi::Object obj = info[index].As<Napi::Object>();
+    
+    Napi::Value format = obj.Get("format");
+    if (format.IsString()) {
+        std::string name = format.As<Napi::String>().Utf8Value();
+        if (name == "jpeg" || name == "jpg") {
+            options.codec = FrameEncodeOptions::JPEG;
+        } else if (name == "png") {
+            options.codec = FrameEncodeOptions::PNG;
+        } else if (name == "webp") {
+            options.codec = FrameEncodeOptions::WEBP;
+        } else {
+            throw Napi::TypeError::New(env, "format must be 'jpeg', 'png' or 'webp'");
+        }
+    }
+    
+    auto getInt = [&](const char* key, int fallback) {
+        Napi::Value v = obj.Get(key);
+        if (v.IsUndefined() || v.IsNull()) {
+            return fallback;
+        }
+        if (!v.IsNumber()) {
+            throw Napi::TypeError::New(env, std::string(key) + " must be a number");
+        }
+        return v.As<Napi::Number>().Int32Value();
+    };
+    
+    options.quality = getInt("quality", options.quality);
+    options.width = getInt("width", options.width);
+    options.height = getInt("height", options.height);
+    
+    if (options.quality < 1 || options.quality > 100) {
+        throw Napi::RangeError::New(env, "quality must be between 1 and 100");
+    }
+    if (options.width < 0 || options.height < 0) {
+        throw Napi::RangeError::New(env, "width and height must not be negative");
+    }
+    
+    return options;
+}
+
+// Encode a frame as JPEG/PNG/WebP, optionally downscaled
+// Args: frameNum, [options { format, quality, width, height }]
+// Returns Promise<Buffer> of encoded bytes
+Napi::Value ThermalEngineObject::ExportFrame(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
         if (info.Length() < 1) {
-            throw Napi::TypeError::New(env, "Expected 1 argument: frameNum");
+            throw Napi::TypeError::New(env, "Expected at least 1 argument: frameNum");
         }
         
         int frameNum = static_cast<int>(GetNumberParam(info, 0, "frameNum"));
+        FrameEncodeOptions options = GetEncodeOptionsParam(info, 1);
         
-        cv::Mat frame = engine.getFrame(frameNum);
-        if (frame.empty()) {
-            return env.Null();
+        struct Encoded { bool success; std::vector<uchar> bytes; };
+        return Run<Encoded>(env, "ThermalExportFrame",
+            [frameNum, options](ThermalEngine& engine, Encoded& result) {
+                RequireFrame(engine, frameNum);
+                result.success = engine.exportFrame(frameNum, options, result.bytes);
+            },
+            [](Napi::Env env, Encoded& result) -> Napi::Value {
+                if (!result.success) {
+                    return env.Null();
+                }
+                // Copied onto the JS heap (external buffers are not allowed in Electron)
+                return Napi::Buffer<uchar>::Copy(env, result.bytes.data(), result.bytes.size());
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error exporting frame: ") + e.what());
+    }
+}
+
+// Background job: preview sprite sheet plus the per-frame statistics series
+// from one decode pass. The series is also saved as the frame statistics
+// sidecar when a path is given.
+class ThumbnailWorker : public Napi::AsyncWorker {
+public:
+    ThumbnailWorker(Napi::Env env, std::shared_ptr<EngineSlot> slot, const ThumbnailOptions& options,
+                    const std::string& statsSidecarPath, Napi::Value onProgress)
+        : Napi::AsyncWorker(env, "ThermalThumbnails"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          lease(std::move(slot)),
+          progress(env, onProgress, "ThermalThumbnailsProgress"),
+          options(options), statsSidecarPath(statsSidecarPath) {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        ThermalEngine& engine = lease.engine();
+        if (!engine.isVideoLoaded()) {
+            SetError("Video not loaded");
+            return;
         }
         
-        // Encode frame to JPEG
-        std::vector<uchar> buffer;
-        std::vector<int> params;
-        params.push_back(cv::IMWRITE_JPEG_QUALITY);
-        params.push_back(90);
+        if (!engine.buildThumbnailSheet(options, sheet, series,
+                [this](int done, int total) { progress.Report(done, total); })) {
+            SetError("Could not build thumbnail sheet");
+            return;
+        }
         
-        cv::imencode(".jpg", frame, buffer, params);
+        if (!statsSidecarPath.empty() && !engine.saveFrameStats(statsSidecarPath, series)) {
+            std::cerr << "Warning: frame statistics computed but sidecar not written: " << statsSidecarPath << std::endl;
+        }
+    }
+
+    void OnOK() override {
+        progress.Release();
         
-        // Convert to base64
-        std::string encoded = "data:image/jpeg;base64,";
+        Napi::Env env = Env();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("every", Napi::Number::New(env, sheet.every));
+        result.Set("thumbWidth", Napi::Number::New(env, sheet.thumbWidth));
+        result.Set("thumbHeight", Napi::Number::New(env, sheet.thumbHeight));
+        result.Set("columns", Napi::Number::New(env, sheet.columns));
+        result.Set("rows", Napi::Number::New(env, sheet.rows));
+        result.Set("count", Napi::Number::New(env, sheet.count));
+        result.Set("image", Napi::Buffer<uchar>::Copy(env, sheet.image.data(), sheet.image.size()));
+        result.Set("frameStats", FrameStatsToObject(env, series));
         
-        const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-        size_t len = buffer.size();
+        deferred.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        progress.Release();
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    EngineLease lease;
+    ProgressReporter progress;
+    ThumbnailOptions options;
+    std::string statsSidecarPath;
+    ThumbnailSheet sheet;
+    FrameStatsSeries series;
+};
+
+// Build a preview sprite sheet of every Nth frame and the per-frame statistics
+// Args: options { every, thumbWidth, columns, format, quality }, [statsSidecarPath], [onProgress(done, total)]
+// Returns Promise<{ every, thumbWidth, thumbHeight, columns, rows, count, image: Buffer, frameStats }>
+Napi::Value ThermalEngineObject::BuildThumbnails(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        ThumbnailOptions options;
+        options.encode.quality = 80;
+        options.encode = GetEncodeOptionsParam(info, 0, options.encode);
         
-        for (size_t i = 0; i < len; i += 3) {
-            uint32_t val = 0;
-            for (int j = 0; j < 3 && i + j < len; j++) {
-                val |= buffer[i + j] << (16 - 8 * j);
-            }
-            
-            for (int j = 0; j < 4; j++) {
-                if (i * 4 / 3 + j < (len * 4 + 2) / 3) {
-                    encoded += chars[(val >> (18 - 6 * j)) & 0x3F];
-                } else {
-                    encoded += '=';
+        if (info.Length() > 0 && info[0].IsObject()) {
+            Napi::Object obj = info[0].As<Napi::Object>();
+            auto getInt = [&](const char* key, int fallback) {
+                Napi::Value v = obj.Get(key);
+                if (v.IsUndefined() || v.IsNull()) {
+                    return fallback;
+                }
+                if (!v.IsNumber()) {
+                    throw Napi::TypeError::New(env, std::string(key) + " must be a number");
                 }
+                return v.As<Napi::Number>().Int32Value();
+            };
+            options.every = getInt("every", options.every);
+            options.thumbWidth = getInt("thumbWidth", options.thumbWidth);
+            options.columns = getInt("columns", options.columns);
+        }
+        
+        if (options.every < 1 || options.thumbWidth < 1 || options.columns < 1) {
+            throw Napi::RangeError::New(env, "every, thumbWidth and columns must be at least 1");
+        }
+        
+        std::string statsSidecarPath = info.Length() > 1 && info[1].IsString()
+            ? info[1].As<Napi::String>().Utf8Value() : "";
+        Napi::Value onProgress = info.Length() > 2 ? info[2] : env.Undefined();
+        
+        ThumbnailWorker* worker = new ThumbnailWorker(env, slot, options, statsSidecarPath, onProgress);
+        Napi::Promise promise = worker->GetPromise();
+        slot->Submit(worker);
+        
+        return promise;
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error building thumbnails: ") + e.what());
+    }
+}
+
+// Background worker for buildTemperatureVolume: decodes every frame once on
+// the decoder pool and writes the compressed temperature volume
+class TemperatureVolumeWorker : public Napi::AsyncWorker {
+public:
+    TemperatureVolumeWorker(Napi::Env env, std::shared_ptr<EngineSlot> slot, const std::string& volumePath,
+                            int tileSize, Napi::Value onProgress)
+        : Napi::AsyncWorker(env, "ThermalTemperatureVolume"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          lease(std::move(slot)),
+          progress(env, onProgress, "ThermalTemperatureVolumeProgress"),
+          volumePath(volumePath), tileSize(tileSize), byteSize(0) {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        ThermalEngine& engine = lease.engine();
+        if (!engine.isVideoLoaded()) {
+            SetError("Video not loaded");
+            return;
+        }
+        
+        info = engine.getVideoInfo();
+        if (!engine.buildTemperatureVolume(volumePath, tileSize, byteSize,
+                [this](int done, int total) { progress.Report(done, total); })) {
+            SetError("Could not build temperature volume");
+        }
+    }
+
+    void OnOK() override {
+        progress.Release();
+        
+        Napi::Env env = Env();
+        double rawBytes = static_cast<double>(info.frames) * info.width * info.height * sizeof(uint16_t);
+        
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("path", Napi::String::New(env, volumePath));
+        result.Set("frames", Napi::Number::New(env, info.frames));
+        result.Set("width", Napi::Number::New(env, info.width));
+        result.Set("height", Napi::Number::New(env, info.height));
+        result.Set("tileSize", Napi::Number::New(env, tileSize));
+        result.Set("byteSize", Napi::Number::New(env, static_cast<double>(byteSize)));
+        result.Set("compressionRatio", Napi::Number::New(env, byteSize > 0 ? rawBytes / byteSize : 0.0));
+        result.Set("temperatureScale", Napi::Number::New(env, ThermalEngine::TEMPERATURE_QUANT_SCALE));
+        
+        deferred.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        progress.Release();
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    EngineLease lease;
+    ProgressReporter progress;
+    std::string volumePath;
+    int tileSize;
+    uint64_t byteSize;
+    ThermalEngine::VideoInfo info = { 0, 0.0, 0, 0, false };
+};
+
+// Build the precomputed temperature volume of the loaded video
+// Args: volumePath, [options { tileSize }], [onProgress(done, total)]
+// Returns Promise<{ path, frames, width, height, tileSize, byteSize, compressionRatio, temperatureScale }>
+Napi::Value ThermalEngineObject::BuildTemperatureVolume(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::string volumePath = GetStringParam(info, 0, "volumePath");
+        
+        int tileSize = TemperatureVolume::DEFAULT_TILE_SIZE;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            Napi::Value value = info[1].As<Napi::Object>().Get("tileSize");
+            if (value.IsNumber()) {
+                tileSize = value.As<Napi::Number>().Int32Value();
             }
         }
+        if (tileSize < 4 || tileSize > 256) {
+            throw Napi::RangeError::New(env, "tileSize must be between 4 and 256");
+        }
+        
+        Napi::Value onProgress = info.Length() > 2 ? info[2] : env.Undefined();
+        
+        TemperatureVolumeWorker* worker = new TemperatureVolumeWorker(env, slot, volumePath, tileSize, onProgress);
+        Napi::Promise promise = worker->GetPromise();
+        slot->Submit(worker);
         
-        return Napi::String::New(env, encoded);
+        return promise;
         
     } catch (const std::exception& e) {
-        throw Napi::Error::New(env, std::string("Error getting frame as base64: ") + e.what());
+        throw Napi::Error::New(env, std::string("Error building temperature volume: ") + e.what());
     }
 }
 
-// Module initialization - export all functions to Node.js
-Napi::Object Init(Napi::Env env, Napi::Object exports) {
+// Serve later temperature queries from a volume file built for this video
+// Returns Promise<boolean> (false if the file is missing or stale)
+Napi::Value ThermalEngineObject::AttachTemperatureVolume(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::string volumePath = GetStringParam(info, 0, "volumePath");
+        
+        return Run<bool>(env, "ThermalAttachTemperatureVolume",
+            [volumePath](ThermalEngine& engine, bool& attached) {
+                RequireVideo(engine);
+                attached = engine.attachTemperatureVolume(volumePath);
+            },
+            [](Napi::Env env, bool& attached) -> Napi::Value {
+                return Napi::Boolean::New(env, attached);
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error attaching temperature volume: ") + e.what());
+    }
+}
+
+// Go back to decoding the video for temperature queries (unmaps the volume)
+// Returns Promise<boolean>: whether a volume was attached
+Napi::Value ThermalEngineObject::DetachTemperatureVolume(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        return Run<bool>(env, "ThermalDetachTemperatureVolume",
+            [](ThermalEngine& engine, bool& wasAttached) {
+                wasAttached = engine.hasTemperatureVolume();
+                engine.detachTemperatureVolume();
+            },
+            [](Napi::Env env, bool& wasAttached) -> Napi::Value {
+                return Napi::Boolean::New(env, wasAttached);
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error detaching temperature volume: ") + e.what());
+    }
+}
+
+// Release the video and mapping. Runs after the jobs queued before it, so
+// they finish normally; the engine can be loaded again afterwards.
+Napi::Value ThermalEngineObject::Close(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        EngineSlot* owner = slot.get();
+        
+        return Run<bool>(env, "ThermalClose",
+            [](ThermalEngine& engine, bool& closed) {
+                engine.close();
+                closed = true;
+            },
+            [owner](Napi::Env env, bool& closed) -> Napi::Value {
+                owner->info = { 0, 0.0, 0, 0, false };
+                return Napi::Boolean::New(env, closed);
+            });
+        
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error closing engine: ") + e.what());
+    }
+}
+
+// Transcodes a source video to MP4 off the main thread. Not tied to an engine
+// instance, so it never waits behind (or blocks) analysis jobs.
+class TranscodeWorker : public Napi::AsyncWorker {
+public:
+    TranscodeWorker(Napi::Env env, const std::string& inputPath, const std::string& outputPath,
+                    Napi::Value onProgress)
+        : Napi::AsyncWorker(env, "ThermalTranscode"),
+          deferred(Napi::Promise::Deferred::New(env)),
+          progress(env, onProgress, "ThermalTranscodeProgress"),
+          inputPath(inputPath), outputPath(outputPath) {}
+
+    Napi::Promise GetPromise() const { return deferred.Promise(); }
+
+protected:
+    void Execute() override {
+        if (!VideoTranscoder::transcode(inputPath, outputPath, result,
+                [this](int done, int total) { progress.Report(done, total); })) {
+            SetError("Could not transcode video: " + inputPath);
+        }
+    }
+
+    void OnOK() override {
+        progress.Release();
+        
+        Napi::Env env = Env();
+        Napi::Float64Array sourceTimes = Napi::Float64Array::New(env, result.sourceTimes.size());
+        std::copy(result.sourceTimes.begin(), result.sourceTimes.end(), sourceTimes.Data());
+        
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("frames", Napi::Number::New(env, result.frames));
+        obj.Set("fps", Napi::Number::New(env, result.fps));
+        obj.Set("width", Napi::Number::New(env, result.width));
+        obj.Set("height", Napi::Number::New(env, result.height));
+        obj.Set("codec", Napi::String::New(env, result.codec));
+        obj.Set("sourceTimes", sourceTimes);
+        
+        deferred.Resolve(obj);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        progress.Release();
+        deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred;
+    ProgressReporter progress;
+    std::string inputPath;
+    std::string outputPath;
+    TranscodeResult result;
+};
+
+// Transcode a video to H.264 MP4 with one output frame per source frame
+// Args: inputPath, outputPath, [onProgress(done, total)]
+// Returns Promise<{ frames, fps, width, height, codec, sourceTimes: Float64Array (ms) }>
+Napi::Value TranscodeVideo(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
     try {
-        // Core functions
-        exports.Set("loadVideo", Napi::Function::New(env, LoadVideo));
-        exports.Set("loadTempMapping", Napi::Function::New(env, LoadTempMapping));
-        exports.Set("analyzeLine", Napi::Function::New(env, AnalyzeLine));
-        exports.Set("getVideoInfo", Napi::Function::New(env, GetVideoInfo));
+        std::string inputPath = GetStringParam(info, 0, "inputPath");
+        std::string outputPath = GetStringParam(info, 1, "outputPath");
+        Napi::Value onProgress = info.Length() > 2 ? info[2] : env.Undefined();
+        
+        TranscodeWorker* worker = new TranscodeWorker(env, inputPath, outputPath, onProgress);
+        Napi::Promise promise = worker->GetPromise();
+        worker->Queue();
+        
+        return promise;
         
-        // Utility functions
-        exports.Set("getPixelTemperature", Napi::Function::New(env, GetPixelTemperature));
-        exports.Set("isReady", Napi::Function::New(env, IsReady));
-        exports.Set("getFrameBase64", Napi::Function::New(env, GetFrameBase64));
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("Error transcoding video: ") + e.what());
+    }
+}
+
+// Module initialization - export the ThermalEngine class to Node.js
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    try {
+        exports.Set("ThermalEngine", ThermalEngineObject::Define(env));
+        exports.Set("transcodeVideo", Napi::Function::New(env, TranscodeVideo, "transcodeVideo"));
         
         std::cout << "Thermal Engine Node.js binding initialized successfully" << std::endl;
         
@@ -260,4 +1718,4 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
 }
 
 // Register the module
-NODE_API_MODULE(thermal_engine, Init)
\ No newline at end of file
+NODE_API_MODULE(thermal_engine, Init)
@@ -0,0 +1,513 @@
+// Parallel decoding of one video file with several cv::VideoCapture instances.
+// A frame range is cut into keyframe-aligned segments that the decoders take
+// from per-decoder queues, stealing from each other when their own runs dry.
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mapped_file.h"
+
+// Keyframe positions of an AVI's video stream, read from the OpenDML 'indx'
+// super index when present, otherwise from the legacy 'idx1' index.
+// Used to place segment boundaries and to know which frames are dropped
+// (zero-size) chunks; decoders still seek by frame number, so a missing index
+// costs decode time, and on files that drop frames, the repeated pictures.
+class AviKeyframeIndex {
+public:
+    // False if path is not an AVI with a usable video index
+    bool load(const std::string& path) {
+        keyframeList.clear();
+        emptyList.clear();
+        frames = 0;
+
+        MappedFile file;
+        if (!file.open(path) || file.size() < 12) {
+            return false;
+        }
+
+        const uint8_t* data = file.data();
+        size_t size = file.size();
+        if (!isFourcc(data, "RIFF") || !isFourcc(data + 8, "AVI ")) {
+            return false;
+        }
+
+        int videoStream = -1;
+        std::vector<uint64_t> standardIndexes;
+        const uint8_t* legacyIndex = nullptr;
+        size_t legacyIndexSize = 0;
+
+        size_t riffEnd = std::min(size, static_cast<size_t>(readU32(data + 4)) + 8);
+        forEachChunk(data, 12, riffEnd, size, [&](const uint8_t* chunk, size_t body, size_t length) {
+            if (isFourcc(chunk, "LIST") && length >= 4 && isFourcc(data + body, "hdrl")) {
+                readHeaderList(data, body + 4, body + length, size, videoStream, standardIndexes);
+            } else if (isFourcc(chunk, "idx1")) {
+                legacyIndex = data + body;
+                legacyIndexSize = length;
+            }
+        });
+
+        if (videoStream < 0) {
+            return false;
+        }
+
+        if (!standardIndexes.empty()) {
+            readStandardIndexes(data, size, standardIndexes);
+        } else if (legacyIndex) {
+            readLegacyIndex(legacyIndex, legacyIndexSize, videoStream);
+        }
+
+        if (keyframeList.empty() || keyframeList.front() != 0) {
+            keyframeList.clear();
+            emptyList.clear();
+            frames = 0;
+            return false;
+        }
+        return true;
+    }
+
+    // Ascending frame numbers of the keyframes (empty if load failed)
+    const std::vector<int>& keyframes() const { return keyframeList; }
+    int frameCount() const { return frames; }
+
+    // Whether frame is a zero-size (dropped) chunk. FFmpeg leaves these out
+    // of its index but still counts them in the timestamps, so reading never
+    // returns them and seeking to one lands on the next coded frame.
+    bool isEmpty(int frame) const {
+        return std::binary_search(emptyList.begin(), emptyList.end(), frame);
+    }
+
+private:
+    static constexpr uint32_t AVIIF_KEYFRAME = 0x10;            // idx1 entry flag
+    static constexpr uint32_t AVI_INDEX_DELTAFRAME = 0x80000000u; // standard index size bit
+    static constexpr uint8_t AVI_INDEX_OF_INDEXES = 0x00;
+    static constexpr uint8_t AVI_INDEX_OF_CHUNKS = 0x01;
+
+    static bool isFourcc(const uint8_t* p, const char* code) {
+        return std::memcmp(p, code, 4) == 0;
+    }
+
+    static uint16_t readU16(const uint8_t* p) { uint16_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    static uint32_t readU32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    static uint64_t readU64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+
+    // Call visit(chunkHeader, bodyOffset, bodyLength) for the chunks in
+    // [begin, end); lengths are cut at the end of the file
+    template <typename Visit>
+    static void forEachChunk(const uint8_t* data, size_t begin, size_t end, size_t fileSize, Visit visit) {
+        size_t pos = begin;
+        while (pos + 8 <= end) {
+            size_t body = pos + 8;
+            size_t length = std::min(static_cast<size_t>(readU32(data + pos + 4)), fileSize - body);
+            visit(data + pos, body, length);
+            pos = body + length + (length & 1);  // chunks are word aligned
+        }
+    }
+
+    // Find the first video stream in 'hdrl' and its super index, if any
+    void readHeaderList(const uint8_t* data, size_t begin, size_t end, size_t fileSize,
+                        int& videoStream, std::vector<uint64_t>& standardIndexes) {
+        int stream = 0;
+        forEachChunk(data, begin, end, fileSize, [&](const uint8_t* chunk, size_t body, size_t length) {
+            if (!isFourcc(chunk, "LIST") || length < 4 || !isFourcc(data + body, "strl")) {
+                return;
+            }
+
+            bool isVideo = false;
+            forEachChunk(data, body + 4, body + length, fileSize, [&](const uint8_t* sub, size_t subBody, size_t subLength) {
+                if (isFourcc(sub, "strh") && subLength >= 4) {
+                    isVideo = videoStream < 0 && isFourcc(data + subBody, "vids");
+                    if (isVideo) {
+                        videoStream = stream;
+                    }
+                } else if (isFourcc(sub, "indx") && isVideo && subLength >= 24) {
+                    const uint8_t* index = data + subBody;
+                    uint16_t longsPerEntry = readU16(index);
+                    uint32_t entries = readU32(index + 4);
+                    if (index[3] != AVI_INDEX_OF_INDEXES || longsPerEntry != 4) {
+                        return;
+                    }
+                    entries = std::min<uint32_t>(entries, static_cast<uint32_t>((subLength - 24) / 16));
+                    for (uint32_t i = 0; i < entries; i++) {
+                        standardIndexes.push_back(readU64(index + 24 + i * 16));
+                    }
+                }
+            });
+            stream++;
+        });
+    }
+
+    // OpenDML 'ix##' chunks: one 8-byte entry per frame, delta frames flagged
+    void readStandardIndexes(const uint8_t* data, size_t fileSize, const std::vector<uint64_t>& offsets) {
+        for (uint64_t offset : offsets) {
+            if (offset + 8 + 24 > fileSize) {
+                return;
+            }
+            const uint8_t* index = data + offset + 8;
+            size_t length = std::min(static_cast<size_t>(readU32(data + offset + 4)), static_cast<size_t>(fileSize - offset - 8));
+            if (length < 24 || index[3] != AVI_INDEX_OF_CHUNKS || readU16(index) != 2) {
+                return;
+            }
+
+            uint32_t entries = std::min<uint32_t>(readU32(index + 4), static_cast<uint32_t>((length - 24) / 8));
+            for (uint32_t i = 0; i < entries; i++) {
+                uint32_t chunkSize = readU32(index + 24 + i * 8 + 4);
+                if ((chunkSize & ~AVI_INDEX_DELTAFRAME) == 0) {
+                    emptyList.push_back(frames);
+                } else if (!(chunkSize & AVI_INDEX_DELTAFRAME)) {
+                    keyframeList.push_back(frames);
+                }
+                frames++;
+            }
+        }
+    }
+
+    // Legacy 'idx1': 16-byte entries for every chunk of every stream
+    void readLegacyIndex(const uint8_t* index, size_t length, int videoStream) {
+        char digits[2] = { static_cast<char>('0' + videoStream / 10), static_cast<char>('0' + videoStream % 10) };
+
+        for (size_t pos = 0; pos + 16 <= length; pos += 16) {
+            const uint8_t* entry = index + pos;
+            bool isVideoChunk = entry[0] == digits[0] && entry[1] == digits[1] &&
+                                entry[2] == 'd' && (entry[3] == 'c' || entry[3] == 'b');
+            if (!isVideoChunk) {
+                continue;
+            }
+            if (readU32(entry + 12) == 0) {
+                emptyList.push_back(frames);
+            } else if (readU32(entry + 4) & AVIIF_KEYFRAME) {
+                keyframeList.push_back(frames);
+            }
+            frames++;
+        }
+    }
+
+    std::vector<int> keyframeList;
+    std::vector<int> emptyList;     // ascending frame numbers of zero-size chunks
+    int frames = 0;
+};
+
+class FrameDecoderPool {
+public:
+    // Use path for later passes and read its keyframe index
+    void open(const std::string& path) {
+        videoPath = path;
+        if (!keyframeIndex.load(path)) {
+            std::cout << "No keyframe index for " << path << "; decoder segments are evenly spaced" << std::endl;
+        }
+    }
+
+    const std::string& path() const { return videoPath; }
+
+    // Frame count from the keyframe index, 0 if the file has none. Includes
+    // dropped (zero-size) frames, which the passes below deliver as repeats
+    // of the frame before them, so frame numbers keep matching the timeline.
+    int indexedFrameCount() const { return keyframeIndex.frameCount(); }
+
+    // Decode every step-th frame of [startFrame, endFrame] with up to
+    // maxDecoders captures, each decoding its segments sequentially. A dropped
+    // frame is visited with the picture of the coded frame before it.
+    // visit(sampleIndex, frameNumber, frame) runs concurrently on the decoder
+    // threads (the calling thread is one of them); samples of one segment
+    // arrive in order.
+    template <typename Visit>
+    bool forEach(int startFrame, int endFrame, int step, int maxDecoders, Visit visit) {
+        return run(startFrame, endFrame, step, maxDecoders, SEGMENTS_PER_DECODER,
+            [&](int sample, int frameNumber, const cv::Mat& frame, double) {
+                visit(sample, frameNumber, frame);
+                return true;
+            },
+            [] {});
+    }
+
+    // Like forEach, but merges the results in frame order:
+    // produce(sampleIndex, frameNumber, frame, positionMs) runs on the decoder
+    // threads and returns a Result; consume(sampleIndex, frameNumber, result)
+    // is called for every sample in ascending order, one call at a time.
+    // At most `window` produced results wait for their turn; decoders that get
+    // further ahead block until the consumer catches up.
+    template <typename Result, typename Produce, typename Consume>
+    bool forEachInOrder(int startFrame, int endFrame, int step, int maxDecoders, int window,
+                        Produce produce, Consume consume) {
+        std::mutex mutex;
+        std::condition_variable turnChanged;
+        std::map<int, std::pair<int, Result>> pending;
+        int nextSample = 0;
+        bool draining = false;
+        bool stopped = false;
+        window = std::max(1, window);
+
+        // Segments about half a window long keep every decoder busy without
+        // overrunning the window
+        int sampleCount = step >= 1 && startFrame <= endFrame ? (endFrame - startFrame) / step + 1 : 0;
+        int segmentsPerDecoder = std::max(SEGMENTS_PER_DECODER, sampleCount / std::max(1, window / 2) / std::max(1, maxDecoders));
+
+        bool success = run(startFrame, endFrame, step, maxDecoders, segmentsPerDecoder,
+            [&](int sample, int frameNumber, const cv::Mat& frame, double positionMs) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    turnChanged.wait(lock, [&] { return stopped || sample < nextSample + window; });
+                    if (stopped) {
+                        return false;
+                    }
+                }
+
+                Result result = produce(sample, frameNumber, frame, positionMs);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                pending.emplace(sample, std::make_pair(frameNumber, std::move(result)));
+                if (draining) {
+                    return true;
+                }
+
+                // One thread at a time drains the run of results that is ready;
+                // consume runs unlocked so the other decoders can hand in theirs
+                draining = true;
+                while (!pending.empty() && pending.begin()->first == nextSample) {
+                    std::pair<int, Result> ready = std::move(pending.begin()->second);
+                    pending.erase(pending.begin());
+                    lock.unlock();
+                    consume(nextSample, ready.first, ready.second);
+                    lock.lock();
+                    nextSample++;
+                    turnChanged.notify_all();
+                }
+                draining = false;
+                return true;
+            },
+            [&] {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopped = true;
+                turnChanged.notify_all();
+            });
+
+        return success && nextSample == sampleCount;
+    }
+
+private:
+    // More segments than decoders so that uneven segments (or slow frames)
+    // can be balanced by stealing
+    static constexpr int SEGMENTS_PER_DECODER = 4;
+
+    // Samples [first, last) of a range
+    struct Segment {
+        int first;
+        int last;
+    };
+
+    // Segment queue of one decoder. The owner takes from the front and so
+    // decodes its share front to back; thieves take from the back.
+    struct SegmentQueue {
+        std::mutex mutex;
+        std::deque<Segment> segments;
+    };
+
+    // Cut [0, sampleCount) into about targetSegments segments whose first
+    // frames sit at (or just after) keyframes, so no decoder starts mid-GOP
+    std::vector<Segment> planSegments(int startFrame, int step, int sampleCount, int targetSegments) const {
+        const std::vector<int>& keyframes = keyframeIndex.keyframes();
+        std::vector<Segment> segments;
+        int begin = 0;
+
+        for (int s = 1; s < targetSegments; s++) {
+            int cut = static_cast<int>(static_cast<int64_t>(sampleCount) * s / targetSegments);
+
+            if (!keyframes.empty()) {
+                // First sample at or after the last keyframe before the cut
+                int frame = startFrame + cut * step;
+                auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(), frame);
+                int snapped = *std::prev(keyframe);
+                cut = (snapped - startFrame + step - 1) / step;
+            }
+
+            if (cut > begin && cut < sampleCount) {
+                segments.push_back({ begin, cut });
+                begin = cut;
+            }
+        }
+        segments.push_back({ begin, sampleCount });
+        return segments;
+    }
+
+    // Coded frame whose picture stands for frameNumber: itself, or for a
+    // dropped frame the nearest coded frame before it (after it at the start)
+    int sourceFrame(int frameNumber) const {
+        if (!keyframeIndex.isEmpty(frameNumber)) {
+            return frameNumber;
+        }
+        for (int frame = frameNumber - 1; frame >= 0; frame--) {
+            if (!keyframeIndex.isEmpty(frame)) {
+                return frame;
+            }
+        }
+        int frame = frameNumber + 1;
+        while (keyframeIndex.isEmpty(frame)) {
+            frame++;
+        }
+        return frame;
+    }
+
+    // Open a capture for a decoder thread; FFmpeg's own threads are split
+    // between the decoders so they do not oversubscribe the cores
+    bool openCapture(cv::VideoCapture& capture, int decoders) const {
+        int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / static_cast<unsigned>(decoders)));
+        if (decoders > 1 && capture.open(videoPath, cv::CAP_ANY, { cv::CAP_PROP_N_THREADS, threads })) {
+            return true;
+        }
+        // Backends without the thread parameter refuse it; open plainly
+        return capture.open(videoPath);
+    }
+
+    // Shared driver: visit(sample, frameNumber, frame, positionMs) returns
+    // false to stop all decoders; onStop is called when a decoder fails
+    template <typename Visit, typename OnStop>
+    bool run(int startFrame, int endFrame, int step, int maxDecoders, int segmentsPerDecoder,
+             Visit visit, OnStop onStop) {
+        if (videoPath.empty() || step < 1 || startFrame > endFrame) {
+            return false;
+        }
+
+        int sampleCount = (endFrame - startFrame) / step + 1;
+        int decoders = std::max(1, std::min(maxDecoders, sampleCount));
+        std::vector<Segment> segments = planSegments(startFrame, step, sampleCount,
+                                                     std::min(sampleCount, decoders * segmentsPerDecoder));
+        decoders = std::min(decoders, static_cast<int>(segments.size()));
+
+        // Contiguous runs of segments per decoder, so owners rarely seek
+        std::vector<SegmentQueue> queues(static_cast<size_t>(decoders));
+        for (size_t i = 0; i < segments.size(); i++) {
+            queues[i * decoders / segments.size()].segments.push_back(segments[i]);
+        }
+
+        std::atomic<bool> failed(false);
+        auto fail = [&] {
+            if (!failed.exchange(true)) {
+                onStop();
+            }
+        };
+
+        auto takeSegment = [&](int self, Segment& segment) {
+            {
+                std::lock_guard<std::mutex> lock(queues[self].mutex);
+                if (!queues[self].segments.empty()) {
+                    segment = queues[self].segments.front();
+                    queues[self].segments.pop_front();
+                    return true;
+                }
+            }
+
+            // Steal the last segment of the decoder with the most work left
+            for (;;) {
+                int victim = -1;
+                size_t most = 0;
+                for (int d = 0; d < decoders; d++) {
+                    std::lock_guard<std::mutex> lock(queues[d].mutex);
+                    if (queues[d].segments.size() > most) {
+                        most = queues[d].segments.size();
+                        victim = d;
+                    }
+                }
+                if (victim < 0) {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(queues[victim].mutex);
+                if (!queues[victim].segments.empty()) {
+                    segment = queues[victim].segments.back();
+                    queues[victim].segments.pop_back();
+                    return true;
+                }
+            }
+        };
+
+        auto decode = [&](int self) {
+            try {
+                cv::VideoCapture capture;
+                if (!openCapture(capture, decoders)) {
+                    std::cerr << "Error: Decoder could not open video file: " << videoPath << std::endl;
+                    fail();
+                    return;
+                }
+
+                double fps = capture.get(cv::CAP_PROP_FPS);
+                double frameMs = fps > 0.0 ? 1000.0 / fps : 0.0;
+
+                int position = -1;      // next frame the capture will read
+                int decodedFrame = -1;  // coded frame held in `frame`
+                double decodedMs = 0.0;
+                cv::Mat frame;
+                Segment segment;
+
+                while (!failed && takeSegment(self, segment)) {
+                    for (int sample = segment.first; sample < segment.last && !failed; sample++) {
+                        int frameNumber = startFrame + sample * step;
+                        int source = sourceFrame(frameNumber);
+
+                        if (source != decodedFrame) {
+                            // Skip short gaps without converting; seek otherwise.
+                            // Dropped frames in the gap are never returned by the capture.
+                            if (position >= 0 && source >= position && source - position < MAX_GRAB_GAP) {
+                                for (; position < source; position++) {
+                                    if (!keyframeIndex.isEmpty(position)) {
+                                        capture.grab();
+                                    }
+                                }
+                            } else if (position != source) {
+                                capture.set(cv::CAP_PROP_POS_FRAMES, source);
+                            }
+
+                            if (!capture.read(frame)) {
+                                std::cerr << "Error: Could not read frame " << source << std::endl;
+                                fail();
+                                return;
+                            }
+                            position = source + 1;
+                            decodedFrame = source;
+                            decodedMs = capture.get(cv::CAP_PROP_POS_MSEC);
+                        }
+
+                        // A repeated picture is reported at its own frame's time
+                        double positionMs = decodedMs + (frameNumber - source) * frameMs;
+                        if (!visit(sample, frameNumber, frame, positionMs)) {
+                            return;
+                        }
+                    }
+                }
+
+            } catch (const std::exception& e) {
+                std::cerr << "Exception in decoder thread: " << e.what() << std::endl;
+                fail();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int d = 1; d < decoders; d++) {
+            threads.emplace_back(decode, d);
+        }
+
+        // The calling thread is decoder 0
+        decode(0);
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        return !failed;
+    }
+
+    // Frame gaps up to this size are grabbed through instead of seeking
+    static constexpr int MAX_GRAB_GAP = 32;
+
+    std::string videoPath;
+    AviKeyframeIndex keyframeIndex;
+};
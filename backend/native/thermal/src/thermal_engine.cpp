@@ -6,10 +6,503 @@
 #include <sstream>
 #include <iostream>
 #include <cmath>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include "mapped_file.h"
+#include "frame_decoder_pool.h"
+
+// Per-frame temperature summary of a whole video
+struct FrameStatsSeries {
+    std::vector<float> maxTemp;
+    std::vector<float> minTemp;
+    std::vector<float> meanTemp;
+    std::vector<uint16_t> hotspotX;
+    std::vector<uint16_t> hotspotY;
+
+    void resize(size_t frames) {
+        maxTemp.assign(frames, 0.0f);
+        minTemp.assign(frames, 0.0f);
+        meanTemp.assign(frames, 0.0f);
+        hotspotX.assign(frames, 0);
+        hotspotY.assign(frames, 0);
+    }
+
+    size_t size() const { return maxTemp.size(); }
+};
+
+// Region of interest as given by the caller, rasterized once by buildRoiMask
+struct RoiShape {
+    enum Type { RECT, POLYGON, MASK } type = RECT;
+    cv::Rect rect;                       // RECT
+    std::vector<cv::Point> points;       // POLYGON
+    std::vector<uint8_t> mask;           // MASK, frame-sized, non-zero = inside
+};
+
+// Rasterized ROI: 8-bit mask cropped to the ROI bounding box
+struct RoiMask {
+    cv::Rect bounds;
+    cv::Mat mask;
+    size_t pixelCount = 0;
+};
+
+struct RoiOptions {
+    std::vector<float> percentiles;      // 0-100
+    std::vector<float> thresholds;       // °C, area counted strictly above
+};
+
+struct RoiStats {
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+    std::vector<float> percentiles;      // one per RoiOptions::percentiles
+    std::vector<uint32_t> areaAbove;     // pixels above each threshold
+};
+
+// Isotherm analysis: pixels strictly above each threshold, compared at the
+// volume's 0.1 °C resolution whether or not a volume is attached
+struct IsothermOptions {
+    std::vector<float> thresholds;       // °C
+    bool contours = false;               // also trace the outer outlines
+    double simplify = 1.0;               // outline tolerance (px), 0 keeps every point
+};
+
+struct IsothermLevel {
+    uint32_t area = 0;                   // pixels above the threshold
+    cv::Rect bounds;                     // bounding box of those pixels, empty if none
+    std::vector<std::vector<cv::Point>> contours;  // IsothermOptions::contours only
+};
+
+// How analyzeLines samples each line
+struct LineSampling {
+    enum Mode {
+        PIXELS,                          // every pixel Bresenham visits; count depends on the angle
+        BILINEAR                         // evenly spaced sub-pixel samples, bilinear interpolation
+    } mode = PIXELS;
+    int samples = 0;                     // BILINEAR: samples per line, 0 = one per pixel of length
+    float width = 1.0f;                  // BILINEAR: averaging width across the line (px)
+
+    static constexpr int MAX_SAMPLES = 8192;
+    static constexpr float MAX_WIDTH = 64.0f;
+};
+
+// Encoded image export (frame previews, sprite sheets)
+struct FrameEncodeOptions {
+    enum Codec { JPEG, PNG, WEBP } codec = JPEG;
+    int quality = 90;                    // JPEG/WebP 1-100 (PNG is always lossless)
+    int width = 0;                       // target size; 0 keeps the aspect ratio,
+    int height = 0;                      // both 0 keeps the original size
+};
+
+// Preview sprite sheet request and result
+struct ThumbnailOptions {
+    int every = 30;                      // one tile per every-th frame
+    int thumbWidth = 160;                // tile width in px, height keeps the aspect ratio
+    int columns = 10;                    // tiles per sheet row
+    FrameEncodeOptions encode;           // sheet image codec/quality
+};
+
+struct ThumbnailSheet {
+    int every = 0;
+    int thumbWidth = 0;
+    int thumbHeight = 0;
+    int columns = 0;
+    int rows = 0;
+    int count = 0;
+    std::vector<uchar> image;            // encoded sheet
+};
+
+// Precomputed temperatures of a whole video, memory-mapped from disk.
+//
+// File layout (little-endian):
+//   Header (56 bytes, see below), then one block per frame, then
+//   uint64 frameOffsets[frames] at header.indexOffset.
+//   Frame block: uint32 tileOffsets[tiles], uint16 base[tiles], uint8 bits[tiles],
+//   then the tiles' bit-packed values, 4 bytes of padding at the end.
+//
+// Values are quantized temperatures (ThermalEngine::TEMPERATURE_QUANT_SCALE
+// steps per °C). Each tileSize x tileSize tile stores its minimum (base) and
+// every pixel as value - base in the fewest bits that fit the tile's range
+// (frame-of-reference packing), row-major within the tile. Any single pixel
+// can be read in O(1) without unpacking its tile.
+class TemperatureVolume {
+public:
+    struct Header {
+        char magic[4];
+        uint32_t frames;
+        uint32_t width;
+        uint32_t height;
+        uint32_t tileSize;
+        uint32_t mappingHash;            // ThermalEngine::getMappingHash of the colour mapping used
+        uint64_t sourceSize;
+        int64_t sourceMtime;
+        float scale;
+        uint32_t padding;
+        uint64_t indexOffset;
+    };
+    static_assert(sizeof(Header) == 56, "TemperatureVolume::Header must not be padded");
+
+    static constexpr const char* MAGIC = "TVC1";
+    static constexpr int DEFAULT_TILE_SIZE = 16;
+
+    // Map a volume file and check it belongs to the given video and mapping.
+    // Returns false if it is missing, truncated or stale.
+    bool open(const std::string& path, int frames, int width, int height,
+              uint64_t sourceSize, int64_t sourceMtime, uint32_t mappingHash, float scale) {
+        close();
+        
+        if (!file.open(path)) {
+            return false;
+        }
+        
+        if (file.size() < sizeof(Header)) {
+            close();
+            return false;
+        }
+        std::memcpy(&header, file.data(), sizeof(Header));
+        
+        bool matches = std::memcmp(header.magic, MAGIC, 4) == 0 &&
+            header.frames == static_cast<uint32_t>(frames) &&
+            header.width == static_cast<uint32_t>(width) &&
+            header.height == static_cast<uint32_t>(height) &&
+            header.tileSize > 0 && header.tileSize <= 256 &&
+            header.sourceSize == sourceSize && header.sourceMtime == sourceMtime &&
+            header.mappingHash == mappingHash && header.scale == scale &&
+            header.indexOffset <= file.size() &&
+            (file.size() - header.indexOffset) / sizeof(uint64_t) >= header.frames;
+        if (!matches) {
+            std::cout << "Temperature volume is stale: " << path << std::endl;
+            close();
+            return false;
+        }
+        
+        tileSize = static_cast<int>(header.tileSize);
+        tilesX = (width + tileSize - 1) / tileSize;
+        tilesY = (height + tileSize - 1) / tileSize;
+        
+        const size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+        frameOffsets.resize(header.frames);
+        std::memcpy(frameOffsets.data(), file.data() + header.indexOffset, header.frames * sizeof(uint64_t));
+        for (uint64_t offset : frameOffsets) {
+            if (offset < sizeof(Header) || offset + tiles * 7 > header.indexOffset ||
+                !tilesFit(offset, tiles)) {
+                std::cerr << "Error: Temperature volume index is corrupt: " << path << std::endl;
+                close();
+                return false;
+            }
+        }
+        
+        return true;
+    }
+
+    void close() {
+        file.close();
+        frameOffsets.clear();
+    }
+
+    bool isOpen() const { return file.isOpen(); }
+    int frames() const { return static_cast<int>(header.frames); }
+    size_t byteSize() const { return file.size(); }
+
+    // Quantized value of one pixel
+    uint16_t valueAt(int frameNumber, int x, int y) const {
+        const uint8_t* block = file.data() + frameOffsets[frameNumber];
+        const size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+        
+        int tx = x / tileSize;
+        int ty = y / tileSize;
+        size_t tile = static_cast<size_t>(ty) * tilesX + tx;
+        
+        uint16_t base;
+        std::memcpy(&base, block + tiles * 4 + tile * 2, sizeof(base));
+        int bits = block[tiles * 6 + tile];
+        if (bits == 0) {
+            return base;
+        }
+        
+        uint32_t tileOffset;
+        std::memcpy(&tileOffset, block + tile * 4, sizeof(tileOffset));
+        
+        int tileWidth = std::min(tileSize, static_cast<int>(header.width) - tx * tileSize);
+        size_t bitPos = static_cast<size_t>((y - ty * tileSize) * tileWidth + (x - tx * tileSize)) * bits;
+        
+        // bits <= 16 and the shift <= 7, so one 32-bit read covers the value
+        uint32_t word;
+        std::memcpy(&word, block + tiles * 7 + tileOffset + (bitPos >> 3), sizeof(word));
+        return static_cast<uint16_t>(base + ((word >> (bitPos & 7)) & ((1u << bits) - 1)));
+    }
+
+    float temperatureAt(int frameNumber, int x, int y) const {
+        return valueAt(frameNumber, x, y) / header.scale;
+    }
+
+    // Unpack a whole frame (width * height, row-major), converting each
+    // quantized value with convert(uint16_t) -> T
+    template <typename T, typename Convert>
+    void decodeFrame(int frameNumber, T* out, Convert convert) const {
+        const uint8_t* block = file.data() + frameOffsets[frameNumber];
+        const size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+        const uint8_t* payload = block + tiles * 7;
+        const int width = static_cast<int>(header.width);
+        const int height = static_cast<int>(header.height);
+        
+        cv::parallel_for_(cv::Range(0, tilesY), [&](const cv::Range& range) {
+            for (int ty = range.start; ty < range.end; ty++) {
+                int tileHeight = std::min(tileSize, height - ty * tileSize);
+                
+                for (int tx = 0; tx < tilesX; tx++) {
+                    size_t tile = static_cast<size_t>(ty) * tilesX + tx;
+                    int tileWidth = std::min(tileSize, width - tx * tileSize);
+                    
+                    uint16_t base;
+                    uint32_t tileOffset;
+                    std::memcpy(&base, block + tiles * 4 + tile * 2, sizeof(base));
+                    std::memcpy(&tileOffset, block + tile * 4, sizeof(tileOffset));
+                    int bits = block[tiles * 6 + tile];
+                    uint32_t mask = (1u << bits) - 1;
+                    
+                    const uint8_t* src = payload + tileOffset;
+                    uint64_t buffer = 0;
+                    int buffered = 0;
+                    
+                    for (int y = 0; y < tileHeight; y++) {
+                        T* dst = out + static_cast<size_t>(ty * tileSize + y) * width + tx * tileSize;
+                        for (int x = 0; x < tileWidth; x++) {
+                            if (buffered < bits) {
+                                buffer |= static_cast<uint64_t>(*src++) << buffered;
+                                buffered += 8;
+                                if (buffered < bits) {
+                                    buffer |= static_cast<uint64_t>(*src++) << buffered;
+                                    buffered += 8;
+                                }
+                            }
+                            dst[x] = convert(static_cast<uint16_t>(base + (buffer & mask)));
+                            buffer >>= bits;
+                            buffered -= bits;
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // Compress one frame of quantized values into a frame block
+    static void encodeFrame(const uint16_t* values, int width, int height, int tileSize,
+                            std::vector<uint8_t>& block) {
+        const int tilesX = (width + tileSize - 1) / tileSize;
+        const int tilesY = (height + tileSize - 1) / tileSize;
+        const size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+        
+        block.assign(tiles * 7, 0);
+        
+        for (int ty = 0; ty < tilesY; ty++) {
+            int tileHeight = std::min(tileSize, height - ty * tileSize);
+            
+            for (int tx = 0; tx < tilesX; tx++) {
+                size_t tile = static_cast<size_t>(ty) * tilesX + tx;
+                int tileWidth = std::min(tileSize, width - tx * tileSize);
+                
+                uint16_t minValue = 0xFFFF, maxValue = 0;
+                for (int y = 0; y < tileHeight; y++) {
+                    const uint16_t* row = values + static_cast<size_t>(ty * tileSize + y) * width + tx * tileSize;
+                    for (int x = 0; x < tileWidth; x++) {
+                        minValue = std::min(minValue, row[x]);
+                        maxValue = std::max(maxValue, row[x]);
+                    }
+                }
+                
+                int bits = 0;
+                while (bits < 16 && (static_cast<uint32_t>(maxValue - minValue) >> bits) != 0) {
+                    bits++;
+                }
+                
+                uint32_t tileOffset = static_cast<uint32_t>(block.size() - tiles * 7);
+                std::memcpy(block.data() + tile * 4, &tileOffset, sizeof(tileOffset));
+                std::memcpy(block.data() + tiles * 4 + tile * 2, &minValue, sizeof(minValue));
+                block[tiles * 6 + tile] = static_cast<uint8_t>(bits);
+                
+                if (bits == 0) {
+                    continue;
+                }
+                
+                uint64_t buffer = 0;
+                int buffered = 0;
+                for (int y = 0; y < tileHeight; y++) {
+                    const uint16_t* row = values + static_cast<size_t>(ty * tileSize + y) * width + tx * tileSize;
+                    for (int x = 0; x < tileWidth; x++) {
+                        buffer |= static_cast<uint64_t>(row[x] - minValue) << buffered;
+                        buffered += bits;
+                        while (buffered >= 8) {
+                            block.push_back(static_cast<uint8_t>(buffer));
+                            buffer >>= 8;
+                            buffered -= 8;
+                        }
+                    }
+                }
+                if (buffered > 0) {
+                    block.push_back(static_cast<uint8_t>(buffer));
+                }
+            }
+        }
+        
+        // valueAt reads 32 bits at a time
+        block.insert(block.end(), 4, 0);
+    }
+
+private:
+    // Whether every tile of the frame block at offset has a valid bit width
+    // and its packed values (plus the 32-bit read of valueAt) end before the
+    // frame index
+    bool tilesFit(uint64_t offset, size_t tiles) const {
+        const uint8_t* block = file.data() + offset;
+        const uint64_t payload = offset + tiles * 7;
+        const int width = static_cast<int>(header.width);
+        const int height = static_cast<int>(header.height);
+
+        for (size_t tile = 0; tile < tiles; tile++) {
+            int bits = block[tiles * 6 + tile];
+            if (bits > 16) {
+                return false;
+            }
+            if (bits == 0) {
+                continue;
+            }
+
+            uint32_t tileOffset;
+            std::memcpy(&tileOffset, block + tile * 4, sizeof(tileOffset));
+
+            int tx = static_cast<int>(tile % tilesX);
+            int ty = static_cast<int>(tile / tilesX);
+            uint64_t pixels = static_cast<uint64_t>(std::min(tileSize, width - tx * tileSize)) *
+                              std::min(tileSize, height - ty * tileSize);
+            uint64_t length = (pixels * bits + 7) / 8;
+            if (payload + tileOffset + length + sizeof(uint32_t) > header.indexOffset) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    MappedFile file;
+    Header header = {};
+    std::vector<uint64_t> frameOffsets;
+    int tileSize = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+};
+
+// Packed 24-bit RGB key of the temperature mapping
+static inline uint32_t packColor(int r, int g, int b) {
+    return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | static_cast<uint32_t>(b);
+}
+
+// Nearest mapped temperature of an RGB colour: the exact entry when there is
+// one, otherwise the closest colour in RGB space (-1 for an empty mapping)
+static float resolveMappedTemperature(const std::unordered_map<uint32_t, float>& mapping,
+                                      int r, int g, int b) {
+    auto it = mapping.find(packColor(r, g, b));
+    
+    if (it != mapping.end()) {
+        return it->second;
+    }
+    
+    // If exact match not found, find closest RGB match
+    float minDistance = std::numeric_limits<float>::max();
+    float closestTemp = -1.0f;
+    
+    for (const auto& pair : mapping) {
+        uint32_t mapKey = pair.first;
+        int mapR = (mapKey >> 16) & 0xFF;
+        int mapG = (mapKey >> 8) & 0xFF;
+        int mapB = mapKey & 0xFF;
+        
+        // Calculate Euclidean distance in RGB space
+        float distance = std::sqrt(
+            std::pow(r - mapR, 2) + 
+            std::pow(g - mapG, 2) + 
+            std::pow(b - mapB, 2)
+        );
+        
+        if (distance < minDistance) {
+            minDistance = distance;
+            closestTemp = pair.second;
+            
+            // If very close, use it immediately
+            if (distance < 10.0f) {
+                break;
+            }
+        }
+    }
+    
+    return closestTemp;
+}
+
+// Dense RGB -> temperature lookup table indexed by the packed 24-bit colour,
+// shared by every engine that loaded the same mapping (64 MB per distinct
+// mapping rather than per engine). Entries start unresolved (NaN) and are
+// filled on first use from the table's own copy of the mapping, so the hash
+// lookup and nearest-colour search run at most once per distinct colour in
+// the process. Atomic so frame passes can fill it from several threads at once.
+class ColorLut {
+public:
+    static constexpr size_t SIZE = size_t(1) << 24;
+
+    // Table for a mapping, reused while any engine still holds one built
+    // from equal mapping contents
+    static std::shared_ptr<ColorLut> forMapping(const std::unordered_map<uint32_t, float>& mapping,
+                                                uint32_t hash) {
+        static std::mutex registryMutex;
+        static std::unordered_map<uint32_t, std::weak_ptr<ColorLut>> registry;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::weak_ptr<ColorLut>& slot = registry[hash];
+        std::shared_ptr<ColorLut> lut = slot.lock();
+        if (lut && lut->mapping == mapping) {
+            return lut;
+        }
+
+        lut = std::make_shared<ColorLut>(mapping);
+        if (slot.expired()) {
+            slot = lut;   // a live table with other contents keeps its slot
+        }
+        return lut;
+    }
+
+    explicit ColorLut(const std::unordered_map<uint32_t, float>& mapping)
+        : mapping(mapping), entries(new std::atomic<float>[SIZE]) {
+        const float unresolved = std::numeric_limits<float>::quiet_NaN();
+        for (size_t i = 0; i < SIZE; i++) {
+            entries[i].store(unresolved, std::memory_order_relaxed);
+        }
+    }
+
+    float lookup(int r, int g, int b) {
+        std::atomic<float>& entry = entries[packColor(r, g, b)];
+        float temp = entry.load(std::memory_order_relaxed);
+        
+        if (std::isnan(temp)) {
+            temp = resolveMappedTemperature(mapping, r, g, b);
+            entry.store(temp, std::memory_order_relaxed);
+        }
+        
+        return temp;
+    }
+
+private:
+    const std::unordered_map<uint32_t, float> mapping;
+    std::unique_ptr<std::atomic<float>[]> entries;
+};
 
 class ThermalEngine {
 private:
     cv::VideoCapture cap;
+    FrameDecoderPool decoderPool;         // extra captures for whole-range passes
     std::unordered_map<uint32_t, float> tempMapping;
     cv::Mat currentFrame;
     int totalFrames;
@@ -17,18 +510,59 @@ private:
     int frameWidth;
     int frameHeight;
     int lastFrameNumber = -1;
+    std::string videoPath;
+    uint32_t mappingHash = 0;            // FNV-1a of the loaded mapping entries
+
+    // Colour lookup table of the loaded mapping, shared with other engines
+    std::shared_ptr<ColorLut> colorLut;
+
+    // Optional precomputed temperatures; when attached, temperature queries
+    // read from it instead of decoding and colour-mapping the video
+    std::unique_ptr<TemperatureVolume> volume;
+
+    // Temperatures of one frame, read from the attached volume or mapped
+    // from a decoded video frame (unmapped pixels become 0)
+    class FrameTemperatures {
+    public:
+        FrameTemperatures(ThermalEngine& engine, const cv::Mat& frame)
+            : engine(&engine), frame(&frame), volume(nullptr), frameNumber(0) {}
+        FrameTemperatures(const TemperatureVolume& volume, int frameNumber)
+            : engine(nullptr), frame(nullptr), volume(&volume), frameNumber(frameNumber) {}
+
+        float at(int x, int y) const {
+            if (volume) {
+                return volume->temperatureAt(frameNumber, x, y);
+            }
+            // OpenCV uses BGR, not RGB
+            const cv::Vec3b& bgr = frame->at<cv::Vec3b>(y, x);
+            float temp = engine->lookupTemperature(bgr[2], bgr[1], bgr[0]);
+            return temp >= 0 ? temp : 0.0f;
+        }
+
+        // Whole frame as quantized temperatures (width * height, row-major)
+        void quantized(uint16_t* out) const {
+            if (volume) {
+                volume->decodeFrame(frameNumber, out, [](uint16_t value) { return value; });
+            } else {
+                engine->mapFrameTemperatures(*frame, out, quantizeTemperature);
+            }
+        }
+
+    private:
+        ThermalEngine* engine;
+        const cv::Mat* frame;
+        const TemperatureVolume* volume;
+        int frameNumber;
+    };
 
     // Pack RGB values into a single uint32_t for hash map key
     uint32_t packRGB(int r, int g, int b) {
-        return (static_cast<uint32_t>(r) << 16) | 
-               (static_cast<uint32_t>(g) << 8) | 
-               static_cast<uint32_t>(b);
+        return packColor(r, g, b);
     }
 
-    // Bresenham's line algorithm for pixel interpolation
-    std::vector<std::pair<int, int>> getLinePixels(int x1, int y1, int x2, int y2) {
-        std::vector<std::pair<int, int>> pixels;
-        
+    // Bresenham's line algorithm, calling visit(x, y) for every in-bounds pixel
+    template <typename Visit>
+    void forEachLinePixel(int x1, int y1, int x2, int y2, Visit visit) const {
         int dx = abs(x2 - x1);
         int dy = abs(y2 - y1);
         int sx = (x1 < x2) ? 1 : -1;
@@ -40,7 +574,7 @@ private:
         while (true) {
             // Ensure pixel is within frame bounds
             if (x >= 0 && x < frameWidth && y >= 0 && y < frameHeight) {
-                pixels.push_back({x, y});
+                visit(x, y);
             }
             
             if (x == x2 && y == y2) break;
@@ -55,10 +589,211 @@ private:
                 y += sy;
             }
         }
-        
+    }
+
+    // Bresenham's line algorithm for pixel interpolation
+    std::vector<std::pair<int, int>> getLinePixels(int x1, int y1, int x2, int y2) {
+        std::vector<std::pair<int, int>> pixels;
+        forEachLinePixel(x1, y1, x2, y2, [&](int x, int y) {
+            pixels.push_back({x, y});
+        });
         return pixels;
     }
 
+    // Append temperatures along a line to out (unmapped pixels become 0)
+    void sampleLine(const FrameTemperatures& temps, int x1, int y1, int x2, int y2, std::vector<float>& out) {
+        forEachLinePixel(x1, y1, x2, y2, [&](int x, int y) {
+            out.push_back(temps.at(x, y));
+        });
+    }
+
+    // Append sampling.samples evenly spaced temperatures from (x1, y1) to
+    // (x2, y2), bilinearly interpolated. With a width > 1 each sample is the
+    // mean of round(width) samples 1 px apart across the line. Temperatures
+    // are mapped once for the covered region; interpolation and averaging
+    // run on OpenCV's vectorized remap/reduce kernels.
+    void sampleLineBilinear(const FrameTemperatures& temps, float x1, float y1, float x2, float y2,
+                            const LineSampling& sampling, std::vector<float>& out) {
+        float dx = x2 - x1;
+        float dy = y2 - y1;
+        float length = std::sqrt(dx * dx + dy * dy);
+        int count = sampling.samples > 0 ? sampling.samples : static_cast<int>(std::floor(length)) + 1;
+        int lanes = std::max(1, static_cast<int>(std::lround(sampling.width)));
+        
+        // Unit normal of the line; lanes are centred on it
+        float nx = length > 0 ? -dy / length : 0.0f;
+        float ny = length > 0 ? dx / length : 0.0f;
+        float firstLane = -(lanes - 1) * 0.5f;
+        
+        const float maxX = static_cast<float>(frameWidth - 1);
+        const float maxY = static_cast<float>(frameHeight - 1);
+        cv::Mat mapX(lanes, count, CV_32F);
+        cv::Mat mapY(lanes, count, CV_32F);
+        float minPx = maxX, maxPx = 0.0f, minPy = maxY, maxPy = 0.0f;
+        
+        for (int lane = 0; lane < lanes; lane++) {
+            float offset = firstLane + lane;
+            float* px = mapX.ptr<float>(lane);
+            float* py = mapY.ptr<float>(lane);
+            for (int i = 0; i < count; i++) {
+                float t = count > 1 ? static_cast<float>(i) / (count - 1) : 0.5f;
+                px[i] = std::max(0.0f, std::min(x1 + t * dx + offset * nx, maxX));
+                py[i] = std::max(0.0f, std::min(y1 + t * dy + offset * ny, maxY));
+                minPx = std::min(minPx, px[i]);
+                maxPx = std::max(maxPx, px[i]);
+                minPy = std::min(minPy, py[i]);
+                maxPy = std::max(maxPy, py[i]);
+            }
+        }
+        
+        // Covered pixels plus the right/bottom interpolation neighbours
+        cv::Rect region(cv::Point(static_cast<int>(minPx), static_cast<int>(minPy)),
+                        cv::Point(static_cast<int>(maxPx) + 2, static_cast<int>(maxPy) + 2));
+        region &= cv::Rect(0, 0, frameWidth, frameHeight);
+        
+        cv::Mat field(region.height, region.width, CV_32F);
+        for (int y = 0; y < region.height; y++) {
+            float* row = field.ptr<float>(y);
+            for (int x = 0; x < region.width; x++) {
+                row[x] = temps.at(region.x + x, region.y + y);
+            }
+        }
+        
+        mapX -= static_cast<float>(region.x);
+        mapY -= static_cast<float>(region.y);
+        
+        cv::Mat sampled;
+        cv::remap(field, sampled, mapX, mapY, cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+        
+        cv::Mat profile;
+        if (lanes > 1) {
+            cv::reduce(sampled, profile, 0, cv::REDUCE_AVG, CV_32F);
+        } else {
+            profile = sampled;
+        }
+        
+        const float* values = profile.ptr<float>(0);
+        out.insert(out.end(), values, values + count);
+    }
+
+    // Call use(temps) with the temperatures of one frame (clamped to the
+    // video), from the volume when attached. False if the frame is unavailable.
+    template <typename Use>
+    bool withFrameTemperatures(int frameNumber, Use use) {
+        if (volume) {
+            use(FrameTemperatures(*volume, std::max(0, std::min(frameNumber, totalFrames - 1))));
+            return true;
+        }
+        
+        cv::Mat frame = getFrame(frameNumber);
+        if (frame.empty()) {
+            return false;
+        }
+        use(FrameTemperatures(*this, frame));
+        return true;
+    }
+
+    // Visit the temperatures of every step-th frame of [startFrame, endFrame].
+    // With a volume attached the samples are spread over OpenCV's thread pool,
+    // otherwise over the decoder pool. visit(sampleIndex, frameNumber, temps)
+    // runs concurrently on several threads.
+    template <typename Visit>
+    bool forEachFrameTemperatures(int startFrame, int endFrame, int step, Visit visit) {
+        if (!volume) {
+            return forEachFrameParallel(startFrame, endFrame, step, defaultDecoderCount(),
+                [&](int sample, int frameNumber, const cv::Mat& frame) {
+                    visit(sample, frameNumber, FrameTemperatures(*this, frame));
+                });
+        }
+        
+        if (step < 1 || startFrame > endFrame) {
+            return false;
+        }
+        
+        int sampleCount = (endFrame - startFrame) / step + 1;
+        cv::parallel_for_(cv::Range(0, sampleCount), [&](const cv::Range& range) {
+            for (int sample = range.start; sample < range.end; sample++) {
+                int frameNumber = startFrame + sample * step;
+                visit(sample, frameNumber, FrameTemperatures(*volume, frameNumber));
+            }
+        });
+        return true;
+    }
+
+    // Temperature in TEMPERATURE_QUANT_SCALE steps, saturated to uint16
+    static uint16_t quantizeTemperature(float temp) {
+        float scaled = std::round(temp * TEMPERATURE_QUANT_SCALE);
+        return static_cast<uint16_t>(std::min(scaled, 65535.0f));
+    }
+
+    static constexpr const char* FRAME_STATS_MAGIC = "TFS1";
+
+    // Size and modification time of the loaded video, used to validate sidecars
+    bool getSourceFileStamp(uint64_t& size, int64_t& mtime) const {
+        std::error_code ec;
+        size = static_cast<uint64_t>(std::filesystem::file_size(videoPath, ec));
+        if (ec) return false;
+        mtime = static_cast<int64_t>(std::filesystem::last_write_time(videoPath, ec).time_since_epoch().count());
+        return !ec;
+    }
+
+    // Convert a BGR frame to temperatures row by row, rows spread over OpenCV's
+    // thread pool. Runs of identical colours reuse the previous lookup.
+    template <typename T, typename Convert>
+    void mapFrameTemperatures(const cv::Mat& frame, T* out, Convert convert) {
+        cv::parallel_for_(cv::Range(0, frame.rows), [&](const cv::Range& range) {
+            for (int y = range.start; y < range.end; y++) {
+                const cv::Vec3b* row = frame.ptr<cv::Vec3b>(y);
+                T* dst = out + static_cast<size_t>(y) * frame.cols;
+
+                uint32_t lastKey = 0xFFFFFFFFu;
+                T lastValue = T();
+
+                for (int x = 0; x < frame.cols; x++) {
+                    uint32_t key = packRGB(row[x][2], row[x][1], row[x][0]);
+                    if (key != lastKey) {
+                        float temp = lookupTemperature(row[x][2], row[x][1], row[x][0]);
+                        lastValue = convert(temp >= 0 ? temp : 0.0f);
+                        lastKey = key;
+                    }
+                    dst[x] = lastValue;
+                }
+            }
+        });
+    }
+
+    // Largest sprite sheet side length (JPEG limit is 65535)
+    static constexpr int MAX_SHEET_EXTENT = 65000;
+
+    // Max/min/mean temperature and hotspot of one frame into series[index]
+    void measureFrame(const FrameTemperatures& temps, size_t index, FrameStatsSeries& series) {
+        float maxT = std::numeric_limits<float>::lowest();
+        float minT = std::numeric_limits<float>::max();
+        double sum = 0.0;
+        int hotX = 0, hotY = 0;
+        
+        for (int y = 0; y < frameHeight; y++) {
+            for (int x = 0; x < frameWidth; x++) {
+                float temp = temps.at(x, y);
+                
+                sum += temp;
+                minT = std::min(minT, temp);
+                if (temp > maxT) {
+                    maxT = temp;
+                    hotX = x;
+                    hotY = y;
+                }
+            }
+        }
+        
+        size_t pixels = static_cast<size_t>(frameHeight) * frameWidth;
+        series.maxTemp[index] = maxT;
+        series.minTemp[index] = minT;
+        series.meanTemp[index] = pixels > 0 ? static_cast<float>(sum / pixels) : 0.0f;
+        series.hotspotX[index] = static_cast<uint16_t>(hotX);
+        series.hotspotY[index] = static_cast<uint16_t>(hotY);
+    }
+
 public:
     ThermalEngine() : totalFrames(0), fps(0), frameWidth(0), frameHeight(0) {}
     
@@ -77,6 +812,10 @@ public:
                 return false;
             }
             
+            videoPath = path;
+            decoderPool.open(path);
+            lastFrameNumber = -1;
+            volume.reset();
             totalFrames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));
             fps = cap.get(cv::CAP_PROP_FPS);
             frameWidth = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));
@@ -107,6 +846,7 @@ public:
             std::getline(file, line); // Skip header line
             
             int count = 0;
+            uint32_t hash = 2166136261u;
             while (std::getline(file, line)) {
                 std::stringstream ss(line);
                 std::string cell;
@@ -129,6 +869,11 @@ public:
                             uint32_t key = packRGB(r, g, b);
                             tempMapping[key] = temp;
                             count++;
+                            
+                            uint32_t bits;
+                            std::memcpy(&bits, &temp, sizeof(bits));
+                            hash = (hash ^ key) * 16777619u;
+                            hash = (hash ^ bits) * 16777619u;
                         }
                     } catch (const std::exception& e) {
                         // Skip invalid lines
@@ -139,6 +884,11 @@ public:
             
             file.close();
             
+            // Mapping changed, previously resolved colours and temperatures are stale
+            colorLut = ColorLut::forMapping(tempMapping, hash);
+            volume.reset();
+            mappingHash = hash;
+            
             std::cout << "Temperature mapping loaded: " << count << " entries" << std::endl;
             return count > 0;
             
@@ -179,102 +929,873 @@ public:
     }
 
     float getPixelTemperature(int r, int g, int b) {
-        uint32_t key = packRGB(r, g, b);
-        auto it = tempMapping.find(key);
-        
-        if (it != tempMapping.end()) {
-            return it->second;
-        }
-        
-        // If exact match not found, find closest RGB match
-        float minDistance = std::numeric_limits<float>::max();
-        float closestTemp = -1.0f;
-        
-        for (const auto& pair : tempMapping) {
-            uint32_t mapKey = pair.first;
-            int mapR = (mapKey >> 16) & 0xFF;
-            int mapG = (mapKey >> 8) & 0xFF;
-            int mapB = mapKey & 0xFF;
-            
-            // Calculate Euclidean distance in RGB space
-            float distance = std::sqrt(
-                std::pow(r - mapR, 2) + 
-                std::pow(g - mapG, 2) + 
-                std::pow(b - mapB, 2)
-            );
-            
-            if (distance < minDistance) {
-                minDistance = distance;
-                closestTemp = pair.second;
-                
-                // If very close, use it immediately
-                if (distance < 10.0f) {
-                    break;
-                }
-            }
+        return resolveMappedTemperature(tempMapping, r, g, b);
+    }
+
+    // Cached variant of getPixelTemperature backed by the shared colour LUT
+    float lookupTemperature(int r, int g, int b) {
+        if (!colorLut) {
+            return getPixelTemperature(r, g, b);
         }
-        
-        return closestTemp;
+        return colorLut->lookup(r, g, b);
     }
 
     std::vector<float> analyzeLine(int frameNumber, int x1, int y1, int x2, int y2) {
         std::vector<float> temperatures;
         
         try {
-            cv::Mat frame = getFrame(frameNumber);
-            if (frame.empty()) {
+            bool found = withFrameTemperatures(frameNumber, [&](const FrameTemperatures& temps) {
+                sampleLine(temps, x1, y1, x2, y2, temperatures);
+            });
+            if (!found) {
                 std::cerr << "Error: Could not get frame for analysis" << std::endl;
-                return temperatures;
             }
             
-            // Get pixels along the line
+        } catch (const std::exception& e) {
+            std::cerr << "Exception analyzing line: " << e.what() << std::endl;
+        }
+        
+        return temperatures;
+    }
+
+    // Decode every step-th frame of [startFrame, endFrame] using up to maxDecoders
+    // captures opened on the same file (see FrameDecoderPool). The range is
+    // decoded once in total, in keyframe-aligned segments balanced by work
+    // stealing. visit(sampleIndex, frameNumber, frame) runs on the decoder
+    // threads; samples of one segment arrive in order.
+    template <typename Visit>
+    bool forEachFrameParallel(int startFrame, int endFrame, int step, int maxDecoders, Visit visit) {
+        return decoderPool.forEach(startFrame, endFrame, step, maxDecoders, visit);
+    }
+
+    // Number of decoders used for whole-range passes
+    static int defaultDecoderCount() {
+        unsigned int cores = std::thread::hardware_concurrency();
+        return static_cast<int>(std::max(1u, std::min(cores, 8u)));
+    }
+
+    // Sample one line on every step-th frame of [startFrame, endFrame].
+    // Fills matrix with sampleCount rows of pixelCount temperatures (row-major).
+    // onRows(firstRow, rowCount) is called from decoder threads whenever a block
+    // of rowsPerChunk consecutive rows is complete, so callers can stream partial
+    // results. Blocks may complete out of order.
+    template <typename OnRows>
+    bool analyzeLineOverTime(int x1, int y1, int x2, int y2, int startFrame, int endFrame, int step,
+                             size_t rowsPerChunk, std::vector<float>& matrix, size_t& pixelCount,
+                             OnRows onRows) {
+        try {
+            startFrame = std::max(0, std::min(startFrame, totalFrames - 1));
+            endFrame = std::max(startFrame, std::min(endFrame, totalFrames - 1));
+            
             std::vector<std::pair<int, int>> linePixels = getLinePixels(x1, y1, x2, y2);
+            pixelCount = linePixels.size();
             
-            // Analyze each pixel
-            for (const auto& pixel : linePixels) {
-                int x = pixel.first;
-                int y = pixel.second;
-                
-                // Get BGR values (OpenCV uses BGR, not RGB)
-                cv::Vec3b bgr = frame.at<cv::Vec3b>(y, x);
-                int b = bgr[0];
-                int g = bgr[1];
-                int r = bgr[2];
-                
-                float temp = getPixelTemperature(r, g, b);
-                
-                if (temp >= 0) {
-                    temperatures.push_back(temp);
-                } else {
-                    // Use interpolated value or skip
-                    temperatures.push_back(0.0f);
-                }
+            size_t sampleCount = static_cast<size_t>((endFrame - startFrame) / step + 1);
+            matrix.assign(sampleCount * pixelCount, 0.0f);
+            
+            if (pixelCount == 0) {
+                return true;
+            }
+            
+            rowsPerChunk = std::max<size_t>(1, rowsPerChunk);
+            size_t blockCount = (sampleCount + rowsPerChunk - 1) / rowsPerChunk;
+            std::unique_ptr<std::atomic<size_t>[]> rowsDone(new std::atomic<size_t>[blockCount]);
+            for (size_t b = 0; b < blockCount; b++) {
+                rowsDone[b].store(0);
             }
             
+            return forEachFrameTemperatures(startFrame, endFrame, step,
+                [&](int sample, int, const FrameTemperatures& temps) {
+                    float* row = matrix.data() + static_cast<size_t>(sample) * pixelCount;
+                    
+                    for (size_t i = 0; i < pixelCount; i++) {
+                        row[i] = temps.at(linePixels[i].first, linePixels[i].second);
+                    }
+                    
+                    // Whichever decoder finishes the last row of a block reports it
+                    size_t block = static_cast<size_t>(sample) / rowsPerChunk;
+                    size_t first = block * rowsPerChunk;
+                    size_t rows = std::min(rowsPerChunk, sampleCount - first);
+                    if (rowsDone[block].fetch_add(1) + 1 == rows) {
+                        onRows(first, rows);
+                    }
+                });
+            
         } catch (const std::exception& e) {
-            std::cerr << "Exception analyzing line: " << e.what() << std::endl;
+            std::cerr << "Exception analyzing line over time: " << e.what() << std::endl;
+            return false;
         }
-        
-        return temperatures;
     }
 
-    // Getter functions for video properties
-    int getTotalFrames() const { return totalFrames; }
-    double getFPS() const { return fps; }
-    int getFrameWidth() const { return frameWidth; }
-    int getFrameHeight() const { return frameHeight; }
-    bool isVideoLoaded() const { return cap.isOpened(); }
-    
-    // Get video info as a structure
-    struct VideoInfo {
-        int frames;
-        double fps;
-        int width;
-        int height;
-        bool loaded;
-    };
-    
-    VideoInfo getVideoInfo() const {
+    // Decode every frame once on the decoder pool and compute per-frame
+    // max/min/mean temperature and the hotspot (location of the maximum).
+    // onProgress(framesDone, totalFrames) is called from decoder threads
+    // roughly once per percent.
+    template <typename OnProgress>
+    bool computeFrameStats(FrameStatsSeries& series, OnProgress onProgress) {
+        try {
+            if (totalFrames <= 0) {
+                std::cerr << "Error: Video not loaded" << std::endl;
+                return false;
+            }
+            
+            series.resize(static_cast<size_t>(totalFrames));
+            std::atomic<int> framesDone(0);
+            int reportEvery = std::max(1, totalFrames / 100);
+            
+            bool success = forEachFrameTemperatures(0, totalFrames - 1, 1,
+                [&](int, int frameNumber, const FrameTemperatures& temps) {
+                    measureFrame(temps, static_cast<size_t>(frameNumber), series);
+                    
+                    int done = ++framesDone;
+                    if (done % reportEvery == 0 || done == totalFrames) {
+                        onProgress(done, totalFrames);
+                    }
+                });
+            
+            return success;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception computing frame statistics: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Build a sprite sheet of every options.every-th frame (row-major tiles of
+    // thumbWidth px, aspect kept) while collecting the full per-frame statistics
+    // series, so one decode pass serves both the previews and the sparkline
+    template <typename OnProgress>
+    bool buildThumbnailSheet(const ThumbnailOptions& options, ThumbnailSheet& sheet,
+                             FrameStatsSeries& series, OnProgress onProgress) {
+        try {
+            if (totalFrames <= 0 || frameWidth <= 0 || frameHeight <= 0) {
+                std::cerr << "Error: Video not loaded" << std::endl;
+                return false;
+            }
+            
+            sheet.every = std::max(1, options.every);
+            sheet.thumbWidth = std::max(1, std::min(options.thumbWidth, frameWidth));
+            sheet.thumbHeight = std::max(1, static_cast<int>(std::lround(
+                static_cast<double>(frameHeight) * sheet.thumbWidth / frameWidth)));
+            sheet.count = (totalFrames + sheet.every - 1) / sheet.every;
+            sheet.columns = std::max(1, std::min(options.columns, sheet.count));
+            sheet.rows = (sheet.count + sheet.columns - 1) / sheet.columns;
+            
+            // Stay within what JPEG/WebP can encode
+            if (sheet.rows * sheet.thumbHeight > MAX_SHEET_EXTENT || sheet.columns * sheet.thumbWidth > MAX_SHEET_EXTENT) {
+                std::cerr << "Error: Thumbnail sheet too large; increase the frame interval" << std::endl;
+                return false;
+            }
+            
+            cv::Mat image = cv::Mat::zeros(sheet.rows * sheet.thumbHeight, sheet.columns * sheet.thumbWidth, CV_8UC3);
+            series.resize(static_cast<size_t>(totalFrames));
+            std::atomic<int> framesDone(0);
+            int reportEvery = std::max(1, totalFrames / 100);
+            
+            bool success = forEachFrameParallel(0, totalFrames - 1, 1, defaultDecoderCount(),
+                [&](int, int frameNumber, const cv::Mat& frame) {
+                    measureFrame(FrameTemperatures(*this, frame), static_cast<size_t>(frameNumber), series);
+                    
+                    // Tiles are disjoint, so decoder threads can write them concurrently
+                    if (frameNumber % sheet.every == 0) {
+                        int tile = frameNumber / sheet.every;
+                        cv::Rect cell((tile % sheet.columns) * sheet.thumbWidth, (tile / sheet.columns) * sheet.thumbHeight,
+                                      sheet.thumbWidth, sheet.thumbHeight);
+                        cv::Mat target = image(cell);
+                        cv::resize(frame, target, target.size(), 0, 0, cv::INTER_AREA);
+                    }
+                    
+                    int done = ++framesDone;
+                    if (done % reportEvery == 0 || done == totalFrames) {
+                        onProgress(done, totalFrames);
+                    }
+                });
+            
+            if (!success) {
+                return false;
+            }
+            
+            FrameEncodeOptions encode = options.encode;
+            encode.width = 0;
+            encode.height = 0;
+            return encodeImage(image, encode, sheet.image);
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception building thumbnail sheet: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Frame statistics sidecar file:
+    //   char magic[4] = "TFS1", uint32 frames, uint64 sourceSize, int64 sourceMtime,
+    //   float maxTemp[frames], minTemp[frames], meanTemp[frames],
+    //   uint16 hotspotX[frames], hotspotY[frames]
+    // The source size and modification time tie the sidecar to the loaded video.
+    bool saveFrameStats(const std::string& sidecarPath, const FrameStatsSeries& series) {
+        try {
+            uint64_t sourceSize = 0;
+            int64_t sourceMtime = 0;
+            if (!getSourceFileStamp(sourceSize, sourceMtime)) {
+                return false;
+            }
+            
+            // Write to a temporary file first so readers never see a partial sidecar
+            std::string tempPath = sidecarPath + ".tmp";
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "Error: Could not create frame statistics file: " << tempPath << std::endl;
+                return false;
+            }
+            
+            uint32_t frames = static_cast<uint32_t>(series.size());
+            file.write(FRAME_STATS_MAGIC, 4);
+            file.write(reinterpret_cast<const char*>(&frames), sizeof(frames));
+            file.write(reinterpret_cast<const char*>(&sourceSize), sizeof(sourceSize));
+            file.write(reinterpret_cast<const char*>(&sourceMtime), sizeof(sourceMtime));
+            file.write(reinterpret_cast<const char*>(series.maxTemp.data()), frames * sizeof(float));
+            file.write(reinterpret_cast<const char*>(series.minTemp.data()), frames * sizeof(float));
+            file.write(reinterpret_cast<const char*>(series.meanTemp.data()), frames * sizeof(float));
+            file.write(reinterpret_cast<const char*>(series.hotspotX.data()), frames * sizeof(uint16_t));
+            file.write(reinterpret_cast<const char*>(series.hotspotY.data()), frames * sizeof(uint16_t));
+            file.close();
+            
+            if (!file) {
+                std::cerr << "Error: Could not write frame statistics file: " << tempPath << std::endl;
+                return false;
+            }
+            
+            std::filesystem::rename(tempPath, sidecarPath);
+            return true;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception saving frame statistics: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Load a sidecar written by saveFrameStats. Fails if it belongs to a
+    // different or modified video.
+    bool loadFrameStats(const std::string& sidecarPath, FrameStatsSeries& series) {
+        try {
+            std::ifstream file(sidecarPath, std::ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            
+            char magic[4];
+            uint32_t frames = 0;
+            uint64_t sourceSize = 0;
+            int64_t sourceMtime = 0;
+            file.read(magic, 4);
+            file.read(reinterpret_cast<char*>(&frames), sizeof(frames));
+            file.read(reinterpret_cast<char*>(&sourceSize), sizeof(sourceSize));
+            file.read(reinterpret_cast<char*>(&sourceMtime), sizeof(sourceMtime));
+            
+            uint64_t currentSize = 0;
+            int64_t currentMtime = 0;
+            if (!file || std::memcmp(magic, FRAME_STATS_MAGIC, 4) != 0 ||
+                !getSourceFileStamp(currentSize, currentMtime) ||
+                sourceSize != currentSize || sourceMtime != currentMtime ||
+                frames != static_cast<uint32_t>(totalFrames)) {
+                std::cout << "Frame statistics sidecar is stale: " << sidecarPath << std::endl;
+                return false;
+            }
+            
+            series.resize(frames);
+            file.read(reinterpret_cast<char*>(series.maxTemp.data()), frames * sizeof(float));
+            file.read(reinterpret_cast<char*>(series.minTemp.data()), frames * sizeof(float));
+            file.read(reinterpret_cast<char*>(series.meanTemp.data()), frames * sizeof(float));
+            file.read(reinterpret_cast<char*>(series.hotspotX.data()), frames * sizeof(uint16_t));
+            file.read(reinterpret_cast<char*>(series.hotspotY.data()), frames * sizeof(uint16_t));
+            
+            return static_cast<bool>(file);
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception loading frame statistics: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Rasterize an ROI against the frame size. Returns false if it is empty.
+    bool buildRoiMask(const RoiShape& shape, RoiMask& roi) const {
+        cv::Rect frameRect(0, 0, frameWidth, frameHeight);
+        cv::Mat full = cv::Mat::zeros(frameHeight, frameWidth, CV_8UC1);
+        
+        switch (shape.type) {
+            case RoiShape::RECT:
+                full(shape.rect & frameRect).setTo(cv::Scalar(255));
+                break;
+            case RoiShape::POLYGON: {
+                std::vector<std::vector<cv::Point>> polygons = { shape.points };
+                cv::fillPoly(full, polygons, cv::Scalar(255));
+                break;
+            }
+            case RoiShape::MASK:
+                if (shape.mask.size() != static_cast<size_t>(frameWidth) * frameHeight) {
+                    return false;
+                }
+                for (int y = 0; y < frameHeight; y++) {
+                    const uint8_t* src = shape.mask.data() + static_cast<size_t>(y) * frameWidth;
+                    uint8_t* dst = full.ptr<uint8_t>(y);
+                    for (int x = 0; x < frameWidth; x++) {
+                        dst[x] = src[x] ? 255 : 0;
+                    }
+                }
+                break;
+        }
+        
+        roi.pixelCount = static_cast<size_t>(cv::countNonZero(full));
+        if (roi.pixelCount == 0) {
+            return false;
+        }
+        
+        roi.bounds = cv::boundingRect(full);
+        roi.mask = full(roi.bounds).clone();
+        return true;
+    }
+
+    // Statistics of one frame inside a rasterized ROI. Temperatures are mapped
+    // only for the ROI's bounding box; the reductions run on OpenCV's
+    // vectorized masked kernels.
+    void computeRoiStats(const FrameTemperatures& frame, const RoiMask& roi, const RoiOptions& options,
+                         cv::Mat& temps, std::vector<float>& values, RoiStats& stats) {
+        temps.create(roi.bounds.height, roi.bounds.width, CV_32FC1);
+        values.clear();
+        values.reserve(roi.pixelCount);
+        
+        for (int y = 0; y < roi.bounds.height; y++) {
+            const uint8_t* inside = roi.mask.ptr<uint8_t>(y);
+            float* dst = temps.ptr<float>(y);
+            
+            for (int x = 0; x < roi.bounds.width; x++) {
+                if (!inside[x]) {
+                    dst[x] = 0.0f;
+                    continue;
+                }
+                dst[x] = frame.at(roi.bounds.x + x, roi.bounds.y + y);
+                values.push_back(dst[x]);
+            }
+        }
+        
+        double minVal = 0.0, maxVal = 0.0;
+        cv::minMaxLoc(temps, &minVal, &maxVal, nullptr, nullptr, roi.mask);
+        stats.min = static_cast<float>(minVal);
+        stats.max = static_cast<float>(maxVal);
+        stats.mean = static_cast<float>(cv::mean(temps, roi.mask)[0]);
+        
+        stats.areaAbove.resize(options.thresholds.size());
+        for (size_t i = 0; i < options.thresholds.size(); i++) {
+            cv::Mat above = (temps > options.thresholds[i]) & roi.mask;
+            stats.areaAbove[i] = static_cast<uint32_t>(cv::countNonZero(above));
+        }
+        
+        // Nearest-rank percentiles; levels are processed in ascending order so
+        // each nth_element only partitions the part above the previous rank
+        stats.percentiles.assign(options.percentiles.size(), 0.0f);
+        std::vector<size_t> order(options.percentiles.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return options.percentiles[a] < options.percentiles[b];
+        });
+        
+        auto begin = values.begin();
+        for (size_t i : order) {
+            float p = std::max(0.0f, std::min(100.0f, options.percentiles[i]));
+            size_t rank = static_cast<size_t>(std::ceil(p / 100.0f * values.size()));
+            rank = rank > 0 ? rank - 1 : 0;
+            auto nth = values.begin() + rank;
+            std::nth_element(begin, nth, values.end());
+            stats.percentiles[i] = *nth;
+            begin = nth;
+        }
+    }
+
+    // ROI statistics for a single frame
+    bool analyzeRoi(int frameNumber, const RoiShape& shape, const RoiOptions& options,
+                    RoiMask& roi, RoiStats& stats) {
+        try {
+            if (!buildRoiMask(shape, roi)) {
+                std::cerr << "Error: ROI is empty or does not match the frame size" << std::endl;
+                return false;
+            }
+            
+            cv::Mat temps;
+            std::vector<float> values;
+            bool found = withFrameTemperatures(frameNumber, [&](const FrameTemperatures& frame) {
+                computeRoiStats(frame, roi, options, temps, values, stats);
+            });
+            if (!found) {
+                std::cerr << "Error: Could not get frame for ROI analysis" << std::endl;
+            }
+            return found;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception analyzing ROI: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // ROI statistics for every step-th frame of [startFrame, endFrame]. The mask
+    // is rasterized once and shared by all decoder threads.
+    bool analyzeRoiOverTime(const RoiShape& shape, const RoiOptions& options,
+                            int startFrame, int endFrame, int step,
+                            RoiMask& roi, std::vector<RoiStats>& series) {
+        try {
+            if (!buildRoiMask(shape, roi)) {
+                std::cerr << "Error: ROI is empty or does not match the frame size" << std::endl;
+                return false;
+            }
+            
+            startFrame = std::max(0, std::min(startFrame, totalFrames - 1));
+            endFrame = std::max(startFrame, std::min(endFrame, totalFrames - 1));
+            series.assign(static_cast<size_t>((endFrame - startFrame) / step + 1), RoiStats());
+            
+            return forEachFrameTemperatures(startFrame, endFrame, step,
+                [&](int sample, int, const FrameTemperatures& frame) {
+                    // Scratch buffers per worker thread
+                    thread_local cv::Mat temps;
+                    thread_local std::vector<float> values;
+                    computeRoiStats(frame, roi, options, temps, values, series[sample]);
+                });
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception analyzing ROI over time: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Isotherms of one frame. Thresholds are visited in ascending order and
+    // each one only searches the bounding box of the one below it, since a
+    // hotter isotherm always lies inside a cooler one.
+    void computeIsotherms(const FrameTemperatures& frame, const IsothermOptions& options,
+                          cv::Mat& temps, cv::Mat& mask, std::vector<IsothermLevel>& levels) {
+        temps.create(frameHeight, frameWidth, CV_16UC1);
+        frame.quantized(temps.ptr<uint16_t>());
+        levels.assign(options.thresholds.size(), IsothermLevel());
+        
+        std::vector<size_t> order(options.thresholds.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return options.thresholds[a] < options.thresholds[b];
+        });
+        
+        cv::Rect search(0, 0, frameWidth, frameHeight);
+        for (size_t i : order) {
+            IsothermLevel& level = levels[i];
+            if (search.empty()) {
+                continue;
+            }
+            
+            // Quantized values are integers: q > T * scale  <=>  q > floor(T * scale)
+            double limit = std::floor(static_cast<double>(options.thresholds[i]) * TEMPERATURE_QUANT_SCALE);
+            cv::compare(temps(search), limit, mask, cv::CMP_GT);
+            level.area = static_cast<uint32_t>(cv::countNonZero(mask));
+            if (level.area == 0) {
+                search = cv::Rect();
+                continue;
+            }
+            
+            cv::Rect bounds = cv::boundingRect(mask);
+            level.bounds = cv::Rect(bounds.x + search.x, bounds.y + search.y, bounds.width, bounds.height);
+            
+            if (options.contours) {
+                cv::findContours(mask(bounds), level.contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE,
+                                 cv::Point(level.bounds.x, level.bounds.y));
+                if (options.simplify > 0) {
+                    std::vector<cv::Point> simplified;
+                    for (std::vector<cv::Point>& contour : level.contours) {
+                        cv::approxPolyDP(contour, simplified, options.simplify, true);
+                        contour.swap(simplified);
+                    }
+                }
+            }
+            
+            search = level.bounds;
+        }
+    }
+
+    // Isotherms for a single frame
+    bool analyzeIsotherms(int frameNumber, const IsothermOptions& options, std::vector<IsothermLevel>& levels) {
+        try {
+            cv::Mat temps, mask;
+            bool found = withFrameTemperatures(frameNumber, [&](const FrameTemperatures& frame) {
+                computeIsotherms(frame, options, temps, mask, levels);
+            });
+            if (!found) {
+                std::cerr << "Error: Could not get frame for isotherm analysis" << std::endl;
+            }
+            return found;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception analyzing isotherms: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Isotherms for every step-th frame of [startFrame, endFrame], frames
+    // spread over the decoder pool (or OpenCV's pool with a volume attached,
+    // which makes re-running with new thresholds cheap)
+    bool analyzeIsothermsOverTime(const IsothermOptions& options, int startFrame, int endFrame, int step,
+                                  std::vector<std::vector<IsothermLevel>>& series) {
+        try {
+            startFrame = std::max(0, std::min(startFrame, totalFrames - 1));
+            endFrame = std::max(startFrame, std::min(endFrame, totalFrames - 1));
+            series.assign(static_cast<size_t>((endFrame - startFrame) / step + 1), std::vector<IsothermLevel>());
+            
+            return forEachFrameTemperatures(startFrame, endFrame, step,
+                [&](int sample, int, const FrameTemperatures& frame) {
+                    // Scratch buffers per worker thread
+                    thread_local cv::Mat temps;
+                    thread_local cv::Mat mask;
+                    computeIsotherms(frame, options, temps, mask, series[sample]);
+                });
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception analyzing isotherms over time: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Layout of the packed multi-line result (all values stored as float32):
+    //   [lineCount, frameNumber, totalSamples]                 header
+    //   offsets[lineCount + 1]                                 sample offsets per line
+    //   stats[lineCount * 3]                                   min, max, mean per line (NaN if empty)
+    //   temperatures[totalSamples]                             samples of all lines back to back
+    static constexpr size_t PACKED_LINES_HEADER = 3;
+    static constexpr size_t PACKED_LINES_STATS = 3;
+
+    // Analyze several lines against one decoded frame.
+    // coords holds lineCount * 4 values (x1, y1, x2, y2 per line); PIXELS
+    // sampling rounds them to whole pixels.
+    std::vector<float> analyzeLines(int frameNumber, const float* coords, size_t lineCount,
+                                    const LineSampling& sampling = LineSampling()) {
+        std::vector<float> packed;
+        
+        try {
+            std::vector<float> samples;
+            std::vector<uint32_t> offsets(lineCount + 1, 0);
+            std::vector<float> stats(lineCount * PACKED_LINES_STATS, std::numeric_limits<float>::quiet_NaN());
+            
+            bool found = withFrameTemperatures(frameNumber, [&](const FrameTemperatures& temps) {
+                for (size_t i = 0; i < lineCount; i++) {
+                    const float* c = coords + i * 4;
+                    if (sampling.mode == LineSampling::BILINEAR) {
+                        sampleLineBilinear(temps, c[0], c[1], c[2], c[3], sampling, samples);
+                    } else {
+                        sampleLine(temps, static_cast<int>(std::lround(c[0])), static_cast<int>(std::lround(c[1])),
+                                   static_cast<int>(std::lround(c[2])), static_cast<int>(std::lround(c[3])), samples);
+                    }
+                    offsets[i + 1] = static_cast<uint32_t>(samples.size());
+                }
+            });
+            if (!found) {
+                std::cerr << "Error: Could not get frame for analysis" << std::endl;
+                return packed;
+            }
+            
+            for (size_t i = 0; i < lineCount; i++) {
+                // Same validity rule as the JS statistics (t >= 0)
+                float minTemp = std::numeric_limits<float>::max();
+                float maxTemp = std::numeric_limits<float>::lowest();
+                double sum = 0.0;
+                size_t validCount = 0;
+                
+                for (size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+                    float t = samples[j];
+                    if (t < 0) continue;
+                    minTemp = std::min(minTemp, t);
+                    maxTemp = std::max(maxTemp, t);
+                    sum += t;
+                    validCount++;
+                }
+                
+                if (validCount > 0) {
+                    stats[i * PACKED_LINES_STATS + 0] = minTemp;
+                    stats[i * PACKED_LINES_STATS + 1] = maxTemp;
+                    stats[i * PACKED_LINES_STATS + 2] = static_cast<float>(sum / validCount);
+                }
+            }
+            
+            packed.reserve(PACKED_LINES_HEADER + offsets.size() + stats.size() + samples.size());
+            packed.push_back(static_cast<float>(lineCount));
+            packed.push_back(static_cast<float>(frameNumber));
+            packed.push_back(static_cast<float>(samples.size()));
+            for (uint32_t offset : offsets) {
+                packed.push_back(static_cast<float>(offset));
+            }
+            packed.insert(packed.end(), stats.begin(), stats.end());
+            packed.insert(packed.end(), samples.begin(), samples.end());
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception analyzing lines: " << e.what() << std::endl;
+            packed.clear();
+        }
+        
+        return packed;
+    }
+
+    // Convert a whole frame to temperatures (width * height floats, row-major).
+    // Unmapped pixels are written as 0, matching analyzeLine.
+    bool getTemperatureFrame(int frameNumber, float* out) {
+        try {
+            if (volume) {
+                volume->decodeFrame(std::max(0, std::min(frameNumber, totalFrames - 1)), out,
+                    [](uint16_t value) { return value / TEMPERATURE_QUANT_SCALE; });
+                return true;
+            }
+            
+            cv::Mat frame = getFrame(frameNumber);
+            if (frame.empty()) {
+                std::cerr << "Error: Could not get frame for temperature map" << std::endl;
+                return false;
+            }
+            
+            mapFrameTemperatures(frame, out, [](float temp) { return temp; });
+            return true;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception building temperature frame: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Quantized variant: temperatures in 0.1 °C steps, saturated to uint16
+    bool getTemperatureFrameQuantized(int frameNumber, uint16_t* out) {
+        try {
+            if (volume) {
+                volume->decodeFrame(std::max(0, std::min(frameNumber, totalFrames - 1)), out,
+                    [](uint16_t value) { return value; });
+                return true;
+            }
+            
+            cv::Mat frame = getFrame(frameNumber);
+            if (frame.empty()) {
+                std::cerr << "Error: Could not get frame for temperature map" << std::endl;
+                return false;
+            }
+            
+            mapFrameTemperatures(frame, out, quantizeTemperature);
+            return true;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception building temperature frame: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Decode the whole video once on the decoder pool and write its quantized
+    // temperatures as a TemperatureVolume to volumePath. Frame blocks are
+    // appended as decoders finish them; the index at the end restores the
+    // order. onProgress(framesDone, totalFrames) is called from decoder
+    // threads roughly once per percent. Does not attach the result.
+    template <typename OnProgress>
+    bool buildTemperatureVolume(const std::string& volumePath, int tileSize, uint64_t& byteSize,
+                                OnProgress onProgress) {
+        std::string tempPath = volumePath + ".tmp";
+        
+        try {
+            if (totalFrames <= 0 || frameWidth <= 0 || frameHeight <= 0) {
+                std::cerr << "Error: Video not loaded" << std::endl;
+                return false;
+            }
+            
+            TemperatureVolume::Header header = {};
+            std::memcpy(header.magic, TemperatureVolume::MAGIC, 4);
+            header.frames = static_cast<uint32_t>(totalFrames);
+            header.width = static_cast<uint32_t>(frameWidth);
+            header.height = static_cast<uint32_t>(frameHeight);
+            header.tileSize = static_cast<uint32_t>(std::max(1, std::min(tileSize, 256)));
+            header.mappingHash = mappingHash;
+            header.scale = TEMPERATURE_QUANT_SCALE;
+            if (!getSourceFileStamp(header.sourceSize, header.sourceMtime)) {
+                return false;
+            }
+            
+            // Write to a temporary file first so readers never see a partial volume
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "Error: Could not create temperature volume: " << tempPath << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            
+            std::vector<uint64_t> frameOffsets(static_cast<size_t>(totalFrames), 0);
+            uint64_t writeOffset = sizeof(header);
+            std::mutex writeMutex;
+            std::atomic<int> framesDone(0);
+            int reportEvery = std::max(1, totalFrames / 100);
+            
+            bool success = forEachFrameParallel(0, totalFrames - 1, 1, defaultDecoderCount(),
+                [&](int, int frameNumber, const cv::Mat& frame) {
+                    // Scratch buffers per decoder thread
+                    thread_local std::vector<uint16_t> values;
+                    thread_local std::vector<uint8_t> block;
+                    values.resize(static_cast<size_t>(frameWidth) * frameHeight);
+                    mapFrameTemperatures(frame, values.data(), quantizeTemperature);
+                    TemperatureVolume::encodeFrame(values.data(), frameWidth, frameHeight,
+                                                   static_cast<int>(header.tileSize), block);
+                    
+                    {
+                        std::lock_guard<std::mutex> lock(writeMutex);
+                        frameOffsets[static_cast<size_t>(frameNumber)] = writeOffset;
+                        file.write(reinterpret_cast<const char*>(block.data()), block.size());
+                        writeOffset += block.size();
+                    }
+                    
+                    int done = ++framesDone;
+                    if (done % reportEvery == 0 || done == totalFrames) {
+                        onProgress(done, totalFrames);
+                    }
+                });
+            
+            if (!success) {
+                file.close();
+                std::filesystem::remove(tempPath);
+                return false;
+            }
+            
+            header.indexOffset = writeOffset;
+            file.write(reinterpret_cast<const char*>(frameOffsets.data()), frameOffsets.size() * sizeof(uint64_t));
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.close();
+            
+            if (!file) {
+                std::cerr << "Error: Could not write temperature volume: " << tempPath << std::endl;
+                std::filesystem::remove(tempPath);
+                return false;
+            }
+            
+            byteSize = writeOffset + frameOffsets.size() * sizeof(uint64_t);
+            std::filesystem::rename(tempPath, volumePath);
+            return true;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception building temperature volume: " << e.what() << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    // Serve temperature queries from a volume built for the loaded video and
+    // mapping. Returns false (and keeps decoding video) if it is missing or stale.
+    bool attachTemperatureVolume(const std::string& volumePath) {
+        uint64_t sourceSize = 0;
+        int64_t sourceMtime = 0;
+        if (!getSourceFileStamp(sourceSize, sourceMtime)) {
+            return false;
+        }
+        
+        std::unique_ptr<TemperatureVolume> candidate(new TemperatureVolume());
+        if (!candidate->open(volumePath, totalFrames, frameWidth, frameHeight,
+                             sourceSize, sourceMtime, mappingHash, TEMPERATURE_QUANT_SCALE)) {
+            return false;
+        }
+        
+        volume = std::move(candidate);
+        std::cout << "Temperature volume attached: " << volumePath
+                  << " (" << (volume->byteSize() / (1024 * 1024)) << " MB)" << std::endl;
+        return true;
+    }
+
+    void detachTemperatureVolume() { volume.reset(); }
+    bool hasTemperatureVolume() const { return volume != nullptr; }
+
+    // Release the video, the last decoded frame, the volume and the mapping
+    // (with its share of the colour LUT). loadVideo and loadTempMapping can
+    // be called again afterwards.
+    void close() {
+        if (cap.isOpened()) {
+            cap.release();
+        }
+        currentFrame.release();
+        lastFrameNumber = -1;
+        volume.reset();
+        tempMapping.clear();
+        colorLut.reset();
+        mappingHash = 0;
+        totalFrames = 0;
+        fps = 0;
+        frameWidth = 0;
+        frameHeight = 0;
+    }
+
+    // Downscale (INTER_AREA) and encode an image. Upscaling is not done.
+    static bool encodeImage(const cv::Mat& image, const FrameEncodeOptions& options, std::vector<uchar>& out) {
+        int width = options.width;
+        int height = options.height;
+        if (width <= 0 && height > 0) {
+            width = std::max(1, static_cast<int>(std::lround(static_cast<double>(image.cols) * height / image.rows)));
+        } else if (height <= 0 && width > 0) {
+            height = std::max(1, static_cast<int>(std::lround(static_cast<double>(image.rows) * width / image.cols)));
+        }
+        
+        const cv::Mat* source = &image;
+        cv::Mat scaled;
+        if (width > 0 && height > 0 && width < image.cols && height < image.rows) {
+            cv::resize(image, scaled, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+            source = &scaled;
+        }
+        
+        int quality = std::max(1, std::min(options.quality, 100));
+        std::vector<int> params;
+        const char* extension = ".jpg";
+        switch (options.codec) {
+            case FrameEncodeOptions::JPEG:
+                params = { cv::IMWRITE_JPEG_QUALITY, quality };
+                break;
+            case FrameEncodeOptions::PNG:
+                // Favour speed; thermal frames compress well even at level 1
+                extension = ".png";
+                params = { cv::IMWRITE_PNG_COMPRESSION, 1 };
+                break;
+            case FrameEncodeOptions::WEBP:
+                extension = ".webp";
+                params = { cv::IMWRITE_WEBP_QUALITY, quality };
+                break;
+        }
+        
+        return cv::imencode(extension, *source, out, params);
+    }
+
+    // Encode one video frame (optionally downscaled) into out
+    bool exportFrame(int frameNumber, const FrameEncodeOptions& options, std::vector<uchar>& out) {
+        try {
+            cv::Mat frame = getFrame(frameNumber);
+            if (frame.empty()) {
+                std::cerr << "Error: Could not get frame for export" << std::endl;
+                return false;
+            }
+            
+            return encodeImage(frame, options, out);
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception exporting frame: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Steps per °C used by quantized temperature output (0.1 °C resolution)
+    static constexpr float TEMPERATURE_QUANT_SCALE = 10.0f;
+
+    // Getter functions for video properties
+    int getTotalFrames() const { return totalFrames; }
+    double getFPS() const { return fps; }
+    int getFrameWidth() const { return frameWidth; }
+    int getFrameHeight() const { return frameHeight; }
+    bool isVideoLoaded() const { return cap.isOpened(); }
+    
+    // Get video info as a structure
+    struct VideoInfo {
+        int frames;
+        double fps;
+        int width;
+        int height;
+        bool loaded;
+    };
+    
+    VideoInfo getVideoInfo() const {
         return {
             totalFrames,
             fps,
@@ -283,4 +1804,153 @@ public:
             cap.isOpened()
         };
     }
-};
\ No newline at end of file
+};
+// Result of VideoTranscoder::transcode
+struct TranscodeResult {
+    int frames = 0;
+    double fps = 0.0;
+    int width = 0;
+    int height = 0;
+    std::string codec;                   // fourcc that opened
+    std::vector<double> sourceTimes;     // source timestamp (ms) of every written frame
+};
+
+// AVI -> browser-playable H.264 MP4 through OpenCV's video I/O. Every source
+// frame is written exactly once at the source frame rate, so MP4 frame i is
+// presented at i / fps and is source frame i (timestamps in sourceTimes).
+class VideoTranscoder {
+public:
+    template <typename OnProgress>
+    static bool transcode(const std::string& inputPath, const std::string& outputPath,
+                          TranscodeResult& result, OnProgress onProgress) {
+        // The container is picked from the extension, so the partial file keeps .mp4
+        std::string partPath = outputPath + ".part.mp4";
+        
+        try {
+            cv::VideoCapture input(inputPath);
+            if (!input.isOpened()) {
+                std::cerr << "Error: Could not open video for transcoding: " << inputPath << std::endl;
+                return false;
+            }
+            
+            result.fps = input.get(cv::CAP_PROP_FPS);
+            if (!(result.fps > 0.0) || !std::isfinite(result.fps)) {
+                std::cerr << "Error: Source video has no frame rate: " << inputPath << std::endl;
+                return false;
+            }
+            
+            int total = static_cast<int>(input.get(cv::CAP_PROP_FRAME_COUNT));
+            
+            // yuv420p needs even dimensions; drop an odd last row/column
+            result.width = static_cast<int>(input.get(cv::CAP_PROP_FRAME_WIDTH)) & ~1;
+            result.height = static_cast<int>(input.get(cv::CAP_PROP_FRAME_HEIGHT)) & ~1;
+            cv::Size size(result.width, result.height);
+            
+            cv::VideoWriter writer;
+            if (!openH264Writer(writer, partPath, result.fps, size, result.codec)) {
+                std::cerr << "Error: No H.264 encoder available for " << outputPath << std::endl;
+                return false;
+            }
+            
+            result.sourceTimes.clear();
+            
+            // With an exact frame count from the AVI index, decode on several
+            // captures and hand frames to the encoder in order; otherwise read
+            // sequentially until the stream ends
+            FrameDecoderPool pool;
+            pool.open(inputPath);
+            
+            if (pool.indexedFrameCount() > 0) {
+                total = pool.indexedFrameCount();
+                input.release();
+                result.sourceTimes.reserve(static_cast<size_t>(total));
+                int reportEvery = std::max(1, total / 100);
+                
+                struct DecodedFrame { cv::Mat image; double timeMs; };
+                bool success = pool.forEachInOrder<DecodedFrame>(0, total - 1, 1, ThermalEngine::defaultDecoderCount(),
+                    ORDERED_WINDOW,
+                    [&](int, int, const cv::Mat& frame, double positionMs) {
+                        // Decoders reuse their buffers, so keep a copy until it is written
+                        return DecodedFrame{ frame(cv::Rect(0, 0, size.width, size.height)).clone(), positionMs };
+                    },
+                    [&](int, int, DecodedFrame& decoded) {
+                        result.sourceTimes.push_back(decoded.timeMs);
+                        writer.write(decoded.image);
+                        
+                        int done = static_cast<int>(result.sourceTimes.size());
+                        if (done % reportEvery == 0) {
+                            onProgress(done, total);
+                        }
+                    });
+                
+                if (!success) {
+                    writer.release();
+                    std::filesystem::remove(partPath);
+                    return false;
+                }
+            } else {
+                cv::Mat frame;
+                int reportEvery = std::max(1, total / 100);
+                result.sourceTimes.reserve(total > 0 ? static_cast<size_t>(total) : 0);
+                
+                while (input.read(frame)) {
+                    result.sourceTimes.push_back(input.get(cv::CAP_PROP_POS_MSEC));
+                    
+                    if (frame.cols != size.width || frame.rows != size.height) {
+                        frame = frame(cv::Rect(0, 0, size.width, size.height));
+                    }
+                    writer.write(frame);
+                    
+                    int done = static_cast<int>(result.sourceTimes.size());
+                    if (done % reportEvery == 0) {
+                        onProgress(done, std::max(total, done));
+                    }
+                }
+            }
+            
+            writer.release();
+            result.frames = static_cast<int>(result.sourceTimes.size());
+            onProgress(result.frames, result.frames);
+            
+            if (result.frames == 0) {
+                std::cerr << "Error: No frames decoded from " << inputPath << std::endl;
+                std::filesystem::remove(partPath);
+                return false;
+            }
+            
+            std::filesystem::rename(partPath, outputPath);
+            return true;
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Exception transcoding video: " << e.what() << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(partPath, ec);
+            return false;
+        }
+    }
+
+private:
+    // Decoded frames waiting for the encoder during parallel decoding
+    static constexpr int ORDERED_WINDOW = 64;
+
+    // Try the backends that can encode H.264 into MP4: OpenCV's FFmpeg plugin
+    // (when built with an H.264 encoder), then Media Foundation on Windows
+    static bool openH264Writer(cv::VideoWriter& writer, const std::string& path, double fps,
+                               cv::Size size, std::string& codec) {
+        struct Candidate { int api; const char* fourcc; };
+        const Candidate candidates[] = {
+            { cv::CAP_FFMPEG, "avc1" },
+            { cv::CAP_MSMF, "H264" },
+            { cv::CAP_FFMPEG, "H264" }
+        };
+        
+        for (const Candidate& candidate : candidates) {
+            const char* f = candidate.fourcc;
+            if (writer.open(path, candidate.api, cv::VideoWriter::fourcc(f[0], f[1], f[2], f[3]), fps, size, true)) {
+                codec = f;
+                return true;
+            }
+        }
+        return false;
+    }
+};
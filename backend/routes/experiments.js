@@ -730,6 +730,52 @@ router.get('/:experimentId/temp-metadata', async (req, res) => {
     }
 });
 
+/**
+ * GET /api/experiments/:experimentId/temp-preview
+ * Start (or join) parsing the temperature CSV and report how far it got
+ * Returns 202 with a coarse min/max overview of the rows parsed so far while
+ * parsing, status 'ready' once temp-metadata and temp-data answer from cache
+ */
+router.get('/:experimentId/temp-preview', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+
+        const hasTemperature = await temperatureService.hasTemperatureFile(experimentId);
+        if (!hasTemperature) {
+            return res.error(`No temperature CSV file found for experiment ${experimentId}`, 404);
+        }
+
+        const parsePromise = temperatureService.parseExperimentTemperatureFile(experimentId);
+
+        // Cached data and small files finish within a moment
+        const quick = await Promise.race([
+            parsePromise,
+            new Promise(resolve => setTimeout(() => resolve(null), 50))
+        ]);
+
+        if (!quick) {
+            return res.status(202).success({
+                experimentId: experimentId,
+                status: 'parsing',
+                preview: temperatureService.getTemperaturePreview(experimentId)
+            });
+        }
+
+        if (!quick.success) {
+            return res.error(quick.message, 500);
+        }
+
+        res.success({
+            experimentId: experimentId,
+            status: 'ready'
+        });
+
+    } catch (error) {
+        console.error(`Error getting temperature preview for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get temperature preview: ${error.message}`, 500);
+    }
+});
+
 /**
  * GET /api/experiments/:experimentId/temp-data/:channelId
  * Get single temperature channel data with resampling
@@ -1436,6 +1482,52 @@ router.get('/:experimentId/acc-metadata', async (req, res) => {
     }
 });
 
+/**
+ * GET /api/experiments/:experimentId/acc-preview
+ * Start (or join) parsing the acceleration CSV and report how far it got
+ * Returns 202 with a coarse min/max overview of the rows parsed so far while
+ * parsing, status 'ready' once acc-metadata and acc-data answer from cache
+ */
+router.get('/:experimentId/acc-preview', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+
+        const hasAcceleration = await accelerationService.hasAccelerationFile(experimentId);
+        if (!hasAcceleration) {
+            return res.error(`No acceleration CSV file found for experiment ${experimentId}`, 404);
+        }
+
+        const parsePromise = accelerationService.parseExperimentAccelerationFile(experimentId);
+
+        // Cached data and small files finish within a moment
+        const quick = await Promise.race([
+            parsePromise,
+            new Promise(resolve => setTimeout(() => resolve(null), 50))
+        ]);
+
+        if (!quick) {
+            return res.status(202).success({
+                experimentId: experimentId,
+                status: 'parsing',
+                preview: accelerationService.getAccelerationPreview(experimentId)
+            });
+        }
+
+        if (!quick.success) {
+            return res.error(quick.message, 500);
+        }
+
+        res.success({
+            experimentId: experimentId,
+            status: 'ready'
+        });
+
+    } catch (error) {
+        console.error(`Error getting acceleration preview for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get acceleration preview: ${error.message}`, 500);
+    }
+});
+
 /**
  * GET /api/experiments/:experimentId/acc-data/:channelId
  * Get single acceleration channel data with resampling
@@ -3524,13 +3616,16 @@ router.get('/:experimentId/thermal-metadata', async (req, res) => {
 /**
  * POST /api/experiments/:experimentId/thermal/analyze
  * Analyze temperature along multiple lines for a specific frame
+ * Optional body.sampling: { mode: 'bilinear', samples, width } for sub-pixel,
+ * fixed-count profiles averaged across a band of the given width
  */
 router.post('/:experimentId/thermal/analyze', async (req, res) => {
     try {
         const { experimentId } = req.params;
         const { 
             frameNum, 
-            lines 
+            lines,
+            sampling
         } = req.body;
 
         // Validate request body
@@ -3558,7 +3653,7 @@ router.post('/:experimentId/thermal/analyze', async (req, res) => {
         console.log(`Analyzing ${lines.length} lines for ${experimentId} frame ${frameNum}`);
 
         // Perform analysis
-        const analysisResult = await thermalService.analyzeLines(experimentId, frameNum, lines);
+        const analysisResult = await thermalService.analyzeLines(experimentId, frameNum, lines, { sampling });
 
         if (!analysisResult.success) {
             return res.error(analysisResult.error, 500);
@@ -3605,6 +3700,504 @@ router.post('/:experimentId/thermal/pixel-temperature', async (req, res) => {
     }
 });
 
+/**
+ * GET /api/experiments/:experimentId/thermal/frame-stats
+ * Per-frame max/min/mean temperature and hotspot location for the whole video
+ * Query: wait=false returns 202 with job progress instead of waiting for the first computation
+ *        forceRefresh=true recomputes and rewrites the sidecar
+ */
+router.get('/:experimentId/thermal/frame-stats', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const { wait = 'true', forceRefresh = false } = req.query;
+        const forceRefreshBool = forceRefresh === 'true' || forceRefresh === true;
+
+        const hasThermal = await thermalService.hasThermalFile(experimentId);
+        if (!hasThermal.exists) {
+            return res.error(`No thermal file found for experiment ${experimentId}`, 404);
+        }
+
+        const statsPromise = thermalService.getFrameStats(experimentId, { forceRecompute: forceRefreshBool });
+
+        if (wait === 'false') {
+            // Give an existing sidecar a moment to load before reporting progress
+            const quick = await Promise.race([
+                statsPromise,
+                new Promise(resolve => setTimeout(() => resolve(null), 200))
+            ]);
+
+            if (!quick) {
+                return res.status(202).success({
+                    experimentId: experimentId,
+                    status: 'computing',
+                    job: thermalService.getFrameStatsStatus(experimentId)
+                });
+            }
+        }
+
+        const result = await statsPromise;
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        res.success({
+            experimentId: experimentId,
+            status: 'ready',
+            frames: result.frames,
+            fps: result.fps,
+            maxTemp: Array.from(result.maxTemp),
+            minTemp: Array.from(result.minTemp),
+            meanTemp: Array.from(result.meanTemp),
+            hotspotX: Array.from(result.hotspotX),
+            hotspotY: Array.from(result.hotspotY),
+            metadata: result.metadata
+        });
+
+    } catch (error) {
+        console.error(`Error getting thermal frame stats for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get thermal frame stats: ${error.message}`, 500);
+    }
+});
+
+/**
+ * GET /api/experiments/:experimentId/thermal/preview
+ * Timeline preview: sprite sheet layout plus per-frame max-temperature sparkline
+ * Query: every, thumbWidth, columns (sheet layout), forceRefresh=true rebuilds the cache,
+ *        wait=false returns 202 with job progress instead of waiting for the first build
+ */
+router.get('/:experimentId/thermal/preview', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const { wait = 'true', forceRefresh = false } = req.query;
+        const forceRefreshBool = forceRefresh === 'true' || forceRefresh === true;
+
+        const options = { forceRefresh: forceRefreshBool };
+        for (const key of ['every', 'thumbWidth', 'columns']) {
+            if (req.query[key] !== undefined) {
+                const parsed = parseInt(req.query[key], 10);
+                if (isNaN(parsed) || parsed < 1) {
+                    return res.error(`${key} must be a positive number`, 400);
+                }
+                options[key] = parsed;
+            }
+        }
+
+        const hasThermal = await thermalService.hasThermalFile(experimentId);
+        if (!hasThermal.exists) {
+            return res.error(`No thermal file found for experiment ${experimentId}`, 404);
+        }
+
+        const previewPromise = thermalService.getThumbnailPreview(experimentId, options);
+
+        if (wait === 'false') {
+            // Give a cached preview a moment to load before reporting progress
+            const quick = await Promise.race([
+                previewPromise,
+                new Promise(resolve => setTimeout(() => resolve(null), 200))
+            ]);
+
+            if (!quick) {
+                return res.status(202).success({
+                    experimentId: experimentId,
+                    status: 'building',
+                    job: thermalService.getThumbnailStatus(experimentId)
+                });
+            }
+        }
+
+        const result = await previewPromise;
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        const query = new URLSearchParams({
+            every: result.index.request.every,
+            thumbWidth: result.index.request.thumbWidth,
+            columns: result.index.request.columns
+        });
+
+        res.success({
+            experimentId: experimentId,
+            status: 'ready',
+            ...result.index,
+            spriteUrl: `/api/experiments/${encodeURIComponent(experimentId)}/thermal/preview/sprite?${query}`,
+            sparkline: Array.from(result.sparkline)
+        }, { fromCache: result.fromCache });
+
+    } catch (error) {
+        console.error(`Error getting thermal preview for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get thermal preview: ${error.message}`, 500);
+    }
+});
+
+/**
+ * GET /api/experiments/:experimentId/thermal/preview/sprite
+ * Sprite sheet image of the timeline preview (same query as /thermal/preview)
+ */
+router.get('/:experimentId/thermal/preview/sprite', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+
+        const options = {};
+        for (const key of ['every', 'thumbWidth', 'columns']) {
+            if (req.query[key] !== undefined) {
+                const parsed = parseInt(req.query[key], 10);
+                if (isNaN(parsed) || parsed < 1) {
+                    return res.error(`${key} must be a positive number`, 400);
+                }
+                options[key] = parsed;
+            }
+        }
+
+        const result = await thermalService.getThumbnailPreview(experimentId, options);
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        res.set('Cache-Control', 'private, max-age=3600');
+        res.type(result.index.mimeType);
+        res.sendFile(result.spritePath);
+
+    } catch (error) {
+        console.error(`Error getting thermal sprite for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get thermal sprite: ${error.message}`, 500);
+    }
+});
+
+/**
+ * POST /api/experiments/:experimentId/thermal/volume
+ * Build (or attach an existing) precomputed temperature volume so later
+ * temperature queries skip video decoding
+ * Body: { tileSize, forceRebuild, wait } - wait=false (default) returns 202 with job progress
+ */
+router.post('/:experimentId/thermal/volume', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const { tileSize, forceRebuild = false, wait = false } = req.body || {};
+
+        if (tileSize !== undefined && (!Number.isInteger(tileSize) || tileSize < 4 || tileSize > 256)) {
+            return res.error('tileSize must be an integer between 4 and 256', 400);
+        }
+
+        const hasThermal = await thermalService.hasThermalFile(experimentId);
+        if (!hasThermal.exists) {
+            return res.error(`No thermal file found for experiment ${experimentId}`, 404);
+        }
+
+        const volumePromise = thermalService.getTemperatureVolume(experimentId, {
+            tileSize: tileSize,
+            forceRebuild: forceRebuild === true
+        });
+
+        if (wait !== true) {
+            // Give an existing volume a moment to attach before reporting progress
+            const quick = await Promise.race([
+                volumePromise,
+                new Promise(resolve => setTimeout(() => resolve(null), 200))
+            ]);
+
+            if (!quick) {
+                return res.status(202).success({
+                    experimentId: experimentId,
+                    status: 'building',
+                    ...thermalService.getTemperatureVolumeStatus(experimentId)
+                });
+            }
+        }
+
+        const result = await volumePromise;
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        res.success({
+            ...result,
+            status: 'ready'
+        });
+
+    } catch (error) {
+        console.error(`Error preparing temperature volume for ${req.params.experimentId}:`, error);
+        res.error(`Failed to prepare temperature volume: ${error.message}`, 500);
+    }
+});
+
+/**
+ * GET /api/experiments/:experimentId/thermal/volume
+ * Temperature volume state: attached or not, progress of a running build
+ */
+router.get('/:experimentId/thermal/volume', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const status = thermalService.getTemperatureVolumeStatus(experimentId);
+
+        res.success({
+            experimentId: experimentId,
+            status: status.job ? 'building' : (status.attached ? 'ready' : 'none'),
+            ...status
+        });
+
+    } catch (error) {
+        console.error(`Error getting temperature volume status for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get temperature volume status: ${error.message}`, 500);
+    }
+});
+
+/**
+ * POST /api/experiments/:experimentId/thermal/line-over-time
+ * Sample one line over a frame range (kymograph)
+ * Body: { line: {x1, y1, x2, y2}, startFrame, endFrame, step }
+ * Response: raw Float32 matrix (frameCount rows x pixelCount columns)
+ */
+router.post('/:experimentId/thermal/line-over-time', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const { line, startFrame, endFrame, step = 1 } = req.body;
+
+        if (!line || typeof line.x1 !== 'number' || typeof line.y1 !== 'number' ||
+            typeof line.x2 !== 'number' || typeof line.y2 !== 'number') {
+            return res.error('line must have valid x1, y1, x2, y2 coordinates', 400);
+        }
+
+        if (typeof startFrame !== 'number' || typeof endFrame !== 'number' || typeof step !== 'number') {
+            return res.error('startFrame, endFrame and step must be valid numbers', 400);
+        }
+
+        console.log(`Analyzing line over time for ${experimentId} frames ${startFrame}-${endFrame}`);
+
+        const result = await thermalService.analyzeLineOverTime(experimentId, line, {
+            startFrame, endFrame, step
+        });
+
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        const { data } = result;
+
+        res.set({
+            'Content-Type': 'application/octet-stream',
+            'Content-Length': data.byteLength,
+            'X-Start-Frame': result.startFrame,
+            'X-Frame-Step': result.step,
+            'X-Frame-Count': result.frameCount,
+            'X-Pixel-Count': result.pixelCount,
+            'Access-Control-Expose-Headers': 'X-Start-Frame, X-Frame-Step, X-Frame-Count, X-Pixel-Count'
+        });
+
+        res.end(Buffer.from(data.buffer, data.byteOffset, data.byteLength));
+
+    } catch (error) {
+        console.error(`Error analyzing line over time for ${req.params.experimentId}:`, error);
+        res.error(`Failed to analyze line over time: ${error.message}`, 500);
+    }
+});
+
+/**
+ * POST /api/experiments/:experimentId/thermal/roi
+ * Region-of-interest statistics for a single frame or a frame range
+ * Body: { roi: { type: 'rect' | 'polygon' | 'mask', ... }, frameNum }
+ *    or { roi, startFrame, endFrame, step }, plus optional { percentiles, thresholds }
+ */
+router.post('/:experimentId/thermal/roi', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const { roi, frameNum, startFrame, endFrame, step = 1, percentiles = [], thresholds = [] } = req.body;
+
+        if (!roi || typeof roi.type !== 'string') {
+            return res.error('roi must be an object with a type', 400);
+        }
+
+        if (!Array.isArray(percentiles) || !Array.isArray(thresholds)) {
+            return res.error('percentiles and thresholds must be arrays', 400);
+        }
+
+        const options = { percentiles, thresholds };
+        if (frameNum !== undefined) {
+            if (typeof frameNum !== 'number') {
+                return res.error('frameNum must be a valid number', 400);
+            }
+            options.frameNum = frameNum;
+        } else {
+            if (typeof startFrame !== 'number' || typeof endFrame !== 'number' || typeof step !== 'number') {
+                return res.error('Either frameNum or startFrame, endFrame and step must be valid numbers', 400);
+            }
+            Object.assign(options, { startFrame, endFrame, step });
+        }
+
+        const result = await thermalService.analyzeRoi(experimentId, roi, options);
+
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        const { success, roi: resultRoi, metadata, ...stats } = result;
+
+        // Typed array series to plain arrays for JSON
+        for (const key of ['min', 'max', 'mean', 'percentileLevels', 'percentiles', 'thresholds', 'areaAbove']) {
+            if (ArrayBuffer.isView(stats[key])) {
+                stats[key] = Array.from(stats[key]);
+            }
+        }
+
+        res.success({ ...stats, roiType: resultRoi.type }, metadata);
+
+    } catch (error) {
+        console.error(`Error analyzing ROI for ${req.params.experimentId}:`, error);
+        res.error(`Failed to analyze ROI: ${error.message}`, 500);
+    }
+});
+
+/**
+ * POST /api/experiments/:experimentId/thermal/isotherms
+ * Area, bounding box and optional outlines of the pixels above each threshold
+ * Body: { thresholds: [°C, ...], frameNum } or { thresholds, startFrame, endFrame, step },
+ *    plus optional { contours: boolean, simplify: px }
+ */
+router.post('/:experimentId/thermal/isotherms', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const { thresholds, frameNum, startFrame, endFrame, step = 1, contours = false, simplify } = req.body;
+
+        if (!Array.isArray(thresholds) || thresholds.length === 0) {
+            return res.error('thresholds must be a non-empty array', 400);
+        }
+
+        const options = { thresholds, contours, simplify };
+        if (frameNum !== undefined) {
+            if (typeof frameNum !== 'number') {
+                return res.error('frameNum must be a valid number', 400);
+            }
+            options.frameNum = frameNum;
+        } else {
+            if (typeof startFrame !== 'number' || typeof endFrame !== 'number' || typeof step !== 'number') {
+                return res.error('Either frameNum or startFrame, endFrame and step must be valid numbers', 400);
+            }
+            Object.assign(options, { startFrame, endFrame, step });
+        }
+
+        const result = await thermalService.analyzeIsotherms(experimentId, options);
+
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        const { success, metadata, ...isotherms } = result;
+
+        // Typed arrays to plain arrays for JSON
+        for (const key of ['thresholds', 'area', 'bounds', 'contourCounts', 'contourLengths', 'contourPoints']) {
+            if (ArrayBuffer.isView(isotherms[key])) {
+                isotherms[key] = Array.from(isotherms[key]);
+            }
+        }
+        for (const level of isotherms.levels || []) {
+            if (level.contours) {
+                level.contours = level.contours.map(points => Array.from(points));
+            }
+        }
+
+        res.success(isotherms, metadata);
+
+    } catch (error) {
+        console.error(`Error analyzing isotherms for ${req.params.experimentId}:`, error);
+        res.error(`Failed to analyze isotherms: ${error.message}`, 500);
+    }
+});
+
+/**
+ * GET /api/experiments/:experimentId/thermal/frame-image/:frameNum
+ * Encoded video frame for previews and scrubbing
+ * Query: format=jpeg (default) | png | webp, quality=1-100, width, height (downscale only)
+ */
+router.get('/:experimentId/thermal/frame-image/:frameNum', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const frameNum = parseInt(req.params.frameNum, 10);
+        const { format = 'jpeg', quality, width, height } = req.query;
+
+        if (isNaN(frameNum)) {
+            return res.error('frameNum must be a valid number', 400);
+        }
+
+        const options = { format };
+        for (const [key, value] of Object.entries({ quality, width, height })) {
+            if (value !== undefined) {
+                const parsed = parseInt(value, 10);
+                if (isNaN(parsed)) {
+                    return res.error(`${key} must be a valid number`, 400);
+                }
+                options[key] = parsed;
+            }
+        }
+
+        const result = await thermalService.exportFrame(experimentId, frameNum, options);
+
+        if (!result.success) {
+            return res.error(result.error, 500);
+        }
+
+        res.set({
+            'Content-Type': result.mimeType,
+            'Content-Length': result.data.length,
+            'Cache-Control': 'private, max-age=3600'
+        });
+
+        res.end(result.data);
+
+    } catch (error) {
+        console.error(`Error exporting frame for ${req.params.experimentId}:`, error);
+        res.error(`Failed to export frame: ${error.message}`, 500);
+    }
+});
+
+/**
+ * GET /api/experiments/:experimentId/thermal/temperature-frame/:frameNum
+ * Full-frame temperature map as raw little-endian binary
+ * Query: format=float32 (°C, default) | uint16 (0.1 °C steps)
+ */
+router.get('/:experimentId/thermal/temperature-frame/:frameNum', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+        const frameNum = parseInt(req.params.frameNum, 10);
+        const { format = 'float32' } = req.query;
+
+        if (isNaN(frameNum)) {
+            return res.error('frameNum must be a valid number', 400);
+        }
+
+        if (format !== 'float32' && format !== 'uint16') {
+            return res.error('format must be float32 or uint16', 400);
+        }
+
+        const frameResult = await thermalService.getTemperatureFrame(experimentId, frameNum, {
+            quantized: format === 'uint16'
+        });
+
+        if (!frameResult.success) {
+            return res.error(frameResult.error, 500);
+        }
+
+        const { data } = frameResult;
+
+        res.set({
+            'Content-Type': 'application/octet-stream',
+            'Content-Length': data.byteLength,
+            'X-Frame-Number': frameResult.frameNumber,
+            'X-Frame-Width': frameResult.width,
+            'X-Frame-Height': frameResult.height,
+            'X-Temperature-Format': frameResult.format,
+            'X-Temperature-Scale': frameResult.scale,
+            'Access-Control-Expose-Headers': 'X-Frame-Number, X-Frame-Width, X-Frame-Height, X-Temperature-Format, X-Temperature-Scale'
+        });
+
+        // Send the typed array's bytes without copying
+        res.end(Buffer.from(data.buffer, data.byteOffset, data.byteLength));
+
+    } catch (error) {
+        console.error(`Error getting temperature frame for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get temperature frame: ${error.message}`, 500);
+    }
+});
+
 /**
  * GET /api/experiments/:experimentId/thermal/video
  * Serve MP4 video file via Express static serving (redirect)
@@ -3655,6 +4248,38 @@ router.get('/:experimentId/thermal/video', async (req, res) => {
     }
 });
 
+/**
+ * GET /api/experiments/:experimentId/thermal/video-timestamps
+ * Frame timestamp map of the converted MP4 (converts the video first if needed)
+ */
+router.get('/:experimentId/thermal/video-timestamps', async (req, res) => {
+    try {
+        const { experimentId } = req.params;
+
+        const hasThermal = await thermalService.hasThermalFile(experimentId);
+        if (!hasThermal.exists) {
+            return res.error(`No thermal file found for experiment ${experimentId}`, 404);
+        }
+
+        const VideoConversionService = require('../services/VideoConversionService');
+        const conversionService = new VideoConversionService();
+
+        const mapResult = await conversionService.getTimestampMap(experimentId, hasThermal.filePath);
+        if (!mapResult.success) {
+            return res.error(`Video timestamps unavailable: ${mapResult.message}`, 500);
+        }
+
+        res.success({
+            experimentId: experimentId,
+            ...mapResult.data
+        });
+
+    } catch (error) {
+        console.error(`Error getting video timestamps for ${req.params.experimentId}:`, error);
+        res.error(`Failed to get video timestamps: ${error.message}`, 500);
+    }
+});
+
 /**
  * GET /api/experiments/:experimentId/thermal/conversion-status
  * Get video conversion status
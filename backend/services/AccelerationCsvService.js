@@ -9,6 +9,7 @@ const path = require('path');
 const fs = require('fs').promises;
 const AccelerationCsvReader = require('../utils/AccelerationCsvReader');
 const AccelerationDataProcessor = require('../utils/AccelerationDataProcessor');
+const CsvParseJobs = require('../utils/CsvParseJobs');
 const config = require('../config/config');
 const { createServiceResult } = require('../models/ApiResponse');
 
@@ -19,6 +20,9 @@ class AccelerationCsvService {
         this.dataCache = new Map();
         this.cacheTimeout = 10 * 60 * 1000; // 10 minutes TTL (same as other services)
         
+        // Running parses, joined by later requests
+        this.parseJobs = new CsvParseJobs();
+        
         console.log(`${this.serviceName} initialized`);
     }
 
@@ -31,18 +35,37 @@ class AccelerationCsvService {
     async parseExperimentAccelerationFile(experimentId, forceRefresh = false) {
         const startTime = Date.now();
         
+        // Check cache first (unless forcing refresh)
+        if (!forceRefresh) {
+            const cachedData = this._getCachedData(experimentId);
+            if (cachedData) {
+                console.log(`Using cached acceleration data for ${experimentId}`);
+                return createServiceResult(true, 'Acceleration data loaded from cache', 1, 0, Date.now() - startTime);
+            }
+        }
+
+        // Join a parse that is already running, or start one
+        return await this.parseJobs.run(experimentId, job => this._parseAccelerationFile(experimentId, job, startTime));
+    }
+
+    /**
+     * Overview of a running parse, for a rough plot before the data is ready
+     * @param {string} experimentId - Experiment ID
+     * @returns {Object|null} { rows, bytesParsed, fileSize, progress, rowsPerBucket, time (µs),
+     *          channels: { acc_x: { min, max }, ... }, startedAt } or null when there is none yet
+     */
+    getAccelerationPreview(experimentId) {
+        return this.parseJobs.getPreview(experimentId);
+    }
+
+    /**
+     * Parse and cache the acceleration CSV file; job.reader is set as soon as
+     * the reader exists so its preview can be served while it parses
+     */
+    async _parseAccelerationFile(experimentId, job, startTime) {
         try {
             console.log(`${this.serviceName}: Parsing acceleration CSV for experiment ${experimentId}`);
             
-            // Check cache first (unless forcing refresh)
-            if (!forceRefresh) {
-                const cachedData = this._getCachedData(experimentId);
-                if (cachedData) {
-                    console.log(`Using cached acceleration data for ${experimentId}`);
-                    return createServiceResult(true, 'Acceleration data loaded from cache', 1, 0, Date.now() - startTime);
-                }
-            }
-
             // Resolve actual file path by scanning directory
             const accelerationFilePath = await this.getActualAccelerationFilePath(experimentId);
             
@@ -60,6 +83,7 @@ class AccelerationCsvService {
 
             // Parse CSV file
             const csvReader = new AccelerationCsvReader(accelerationFilePath);
+            job.reader = csvReader;
             await csvReader.readFile();
 
             // Create data processor
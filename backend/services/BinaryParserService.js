@@ -8,15 +8,66 @@ const path = require('path');
 const fs = require('fs').promises;
 const BinaryReader = require('../utils/BinaryReader');
 const BinaryDataProcessor = require('../utils/BinaryDataProcessor');
+const BinaryStreamProcessor = require('../utils/BinaryStreamProcessor');
 const config = require('../config/config');
 const { createServiceResult } = require('../models/ApiResponse');
 
+// Several services and routes create their own instance, so the column cache
+// state lives at module level
+const cacheBuilds = new Map(); // experimentId → build promise
+const mappedColumnCaches = new Map(); // cache path → Set<WeakRef<BinaryReader>>
+let pruning = null; // running prune, later requests wait for it
+let startupPruned = false;
+
+// Column cache files and the temporary files of their writes
+const COLUMN_CACHE_PATTERN = /_columns\.bin$/;
+const COLUMN_CACHE_TEMP_PATTERN = /_columns\.bin(\.[0-9a-f]+)?\.tmp$/;
+
+/**
+ * Record that reader maps the column cache at cachePath
+ */
+function registerMappedCache(cachePath, reader) {
+    if (!mappedColumnCaches.has(cachePath)) {
+        mappedColumnCaches.set(cachePath, new Set());
+    }
+    mappedColumnCaches.get(cachePath).add(new WeakRef(reader));
+}
+
+/**
+ * Whether any live reader still maps the column cache at cachePath
+ * (readers that were closed or collected are dropped)
+ */
+function isCacheMapped(cachePath) {
+    const readers = mappedColumnCaches.get(cachePath);
+    if (!readers) return false;
+
+    for (const ref of readers) {
+        const reader = ref.deref();
+        if (!reader || !reader.isStreamCached()) {
+            readers.delete(ref);
+        }
+    }
+    if (readers.size === 0) {
+        mappedColumnCaches.delete(cachePath);
+        return false;
+    }
+    return true;
+}
+
 class BinaryParserService {
     constructor() {
         this.serviceName = 'Binary Parser Service';
         // In-memory cache for parsed binary data (with TTL)
         this.dataCache = new Map();
         this.cacheTimeout = 10 * 60 * 1000; // 10 minutes TTL
+        // Column cache files being written in the background (shared)
+        this.cacheBuilds = cacheBuilds;
+        
+        // Drop column caches that expired while the app was closed
+        if (config.binary.persistentCache && !startupPruned) {
+            startupPruned = true;
+            this._pruneColumnCaches();
+        }
         
         console.log(`${this.serviceName} initialized`);
     }
@@ -58,16 +109,48 @@ class BinaryParserService {
             const fileSizeMB = (fileStats.size / 1024 / 1024).toFixed(1);
             console.log(`Processing binary file: ${fileSizeMB} MB`);
 
-            // Parse binary file
+            // Large files are decoded on demand instead of loaded whole
+            const nativeAvailable = BinaryReader.isNativeAvailable();
+            let streaming = fileStats.size >= config.binary.streamingThresholdMB * 1024 * 1024 &&
+                nativeAvailable;
+
+            // Parse binary file and create data processor
             const binaryReader = new BinaryReader(binaryFilePath);
-            await binaryReader.readFile();
 
-            // Create data processor
-            const processor = new BinaryDataProcessor(
-                binaryReader.getRawData(),
-                binaryReader.getCalculatedData(),
-                binaryReader.getMetadata()
-            );
+            // Streamed files map their column cache when a valid one exists:
+            // nothing is decoded and the heap holds only the overviews.
+            // Smaller files load whole and are never cached on disk.
+            const columnCachePath = config.binary.persistentCache && streaming
+                ? this._getColumnCachePath(experimentId)
+                : null;
+            let columnCache = false;
+            if (columnCachePath) {
+                try {
+                    await binaryReader.openStream(columnCachePath);
+                    columnCache = binaryReader.isStreamCached();
+                } catch (error) {
+                    console.warn(`Could not open ${experimentId} with its column cache: ${error.message}`);
+                }
+                if (columnCache) {
+                    registerMappedCache(columnCachePath, binaryReader);
+                    this._touchColumnCache(columnCachePath);
+                }
+            }
+
+            let processor;
+            if (streaming) {
+                if (!binaryReader.isStreaming()) {
+                    await binaryReader.openStream();
+                }
+                processor = await BinaryStreamProcessor.create(binaryReader);
+            } else {
+                await binaryReader.readFile();
+                processor = new BinaryDataProcessor(
+                    binaryReader.getRawData(),
+                    binaryReader.getCalculatedData(),
+                    binaryReader.getMetadata()
+                );
+            }
 
             // Cache the processed data
             const processedData = {
@@ -76,12 +159,18 @@ class BinaryParserService {
                 metadata: binaryReader.getMetadata(),
                 filePath: binaryFilePath,
                 fileSize: fileStats.size,
+                streaming: streaming,
+                columnCache: columnCache,
                 processedAt: new Date(),
                 experimentId: experimentId
             };
 
             this._setCachedData(experimentId, processedData);
 
+            if (columnCachePath && !columnCache) {
+                this._buildColumnCache(experimentId, binaryFilePath, columnCachePath);
+            }
+
             const duration = Date.now() - startTime;
             console.log(`${this.serviceName}: Successfully parsed ${experimentId} in ${duration}ms`);
 
@@ -143,6 +232,8 @@ class BinaryParserService {
                 experimentId: experimentId,
                 filePath: cachedData.filePath,
                 fileSize: cachedData.fileSize,
+                streaming: cachedData.streaming,
+                columnCache: cachedData.columnCache,
                 processedAt: cachedData.processedAt,
                 
                 // Core metadata
@@ -230,7 +321,7 @@ class BinaryParserService {
             const actualEndTime = endTime || processor.getTimeRange().max;
 
             // Get resampled data
-            const data = processor.getResampledData(channelId, startTime, actualEndTime, maxPoints);
+            const data = await processor.getResampledData(channelId, startTime, actualEndTime, maxPoints);
             
             return {
                 success: true,
@@ -323,7 +414,7 @@ class BinaryParserService {
                     }
 
                     // Get resampled data
-                    const data = processor.getResampledData(channelId, startTime, actualEndTime, maxPoints);
+                    const data = await processor.getResampledData(channelId, startTime, actualEndTime, maxPoints);
                     
                     results[channelId] = {
                         success: true,
@@ -402,7 +493,7 @@ class BinaryParserService {
             }
 
             const processor = cachedData.processor;
-            const stats = processor.getChannelStatistics(channelId);
+            const stats = await processor.getChannelStatistics(channelId);
             
             if (!stats) {
                 return { 
@@ -462,6 +553,7 @@ class BinaryParserService {
      */
     clearCache(experimentId) {
         if (this.dataCache.has(experimentId)) {
+            this._releaseCachedData(this.dataCache.get(experimentId));
             this.dataCache.delete(experimentId);
             console.log(`Cleared cache for experiment ${experimentId}`);
         }
@@ -472,6 +564,9 @@ class BinaryParserService {
      */
     clearAllCache() {
         const count = this.dataCache.size;
+        for (const data of this.dataCache.values()) {
+            this._releaseCachedData(data);
+        }
         this.dataCache.clear();
         console.log(`Cleared all cached data (${count} experiments)`);
     }
@@ -488,12 +583,15 @@ class BinaryParserService {
                 experimentId: experimentId,
                 processedAt: data.processedAt,
                 fileSize: data.fileSize,
+                streaming: data.streaming,
+                columnCache: data.columnCache,
                 filePath: path.basename(data.filePath)
             });
         }
 
         return {
             totalCachedExperiments: this.dataCache.size,
+            columnCacheBuilds: Array.from(this.cacheBuilds.keys()),
             cacheTimeoutMs: this.cacheTimeout,
             entries: cacheEntries
         };
@@ -514,6 +612,7 @@ class BinaryParserService {
         const cacheAge = now - cached.processedAt.getTime();
         
         if (cacheAge > this.cacheTimeout) {
+            this._releaseCachedData(cached);
             this.dataCache.delete(experimentId);
             console.log(`Cache expired for experiment ${experimentId}`);
             return null;
@@ -527,10 +626,163 @@ class BinaryParserService {
      * @private
      */
     _setCachedData(experimentId, data) {
+        const previous = this.dataCache.get(experimentId);
+        if (previous && previous !== data) {
+            this._releaseCachedData(previous);
+        }
         this.dataCache.set(experimentId, data);
         console.log(`Cached data for experiment ${experimentId}`);
     }
 
+    /**
+     * Release resources held by a cache entry (the file mapping of a
+     * streaming reader)
+     * @private
+     */
+    _releaseCachedData(data) {
+        data.reader.closeStream();
+    }
+
+    /**
+     * Column cache file of an experiment
+     * @private
+     */
+    _getColumnCachePath(experimentId) {
+        return path.join(config.binary.cacheDir, `${experimentId}_columns.bin`);
+    }
+
+    /**
+     * Write the column cache of an experiment in the background (native
+     * worker threads) and move a live streaming entry onto it once done.
+     * Failures only cost the cache; the entry keeps working uncached.
+     * @private
+     */
+    _buildColumnCache(experimentId, filePath, cachePath) {
+        if (this.cacheBuilds.has(experimentId)) {
+            return this.cacheBuilds.get(experimentId);
+        }
+
+        const build = (async () => {
+            const startTime = Date.now();
+            try {
+                await fs.mkdir(path.dirname(cachePath), { recursive: true });
+                const result = await new BinaryReader(filePath).buildCache(cachePath);
+                console.log(`Wrote column cache for ${experimentId}: ` +
+                           `${(result.byteSize / 1024 / 1024).toFixed(1)} MB in ${Date.now() - startTime}ms`);
+
+                const cached = this.dataCache.get(experimentId);
+                if (cached && cached.streaming && cached.filePath === filePath && cached.reader.isStreaming()) {
+                    await cached.reader.openStream(cachePath);
+                    cached.columnCache = cached.reader.isStreamCached();
+                    if (cached.columnCache) {
+                        registerMappedCache(cachePath, cached.reader);
+                    }
+                }
+            } catch (error) {
+                console.warn(`Could not write column cache for ${experimentId}: ${error.message}`);
+            } finally {
+                this.cacheBuilds.delete(experimentId);
+            }
+
+            await this._pruneColumnCaches();
+        })();
+
+        this.cacheBuilds.set(experimentId, build);
+        return build;
+    }
+
+    /**
+     * Mark a column cache as used now (its mtime orders the pruning)
+     * @private
+     */
+    _touchColumnCache(cachePath) {
+        const now = new Date();
+        fs.utimes(cachePath, now, now).catch(() => {});
+    }
+
+    /**
+     * Delete column caches unused for cacheTimeoutHours, then the least
+     * recently used ones until the rest fit cacheMaxSizeMB. Caches mapped by
+     * a live reader of any service instance or still being written are kept;
+     * leftover temporary files of interrupted writes go with the expired
+     * caches. Prunes run one at a time.
+     * @private
+     */
+    _pruneColumnCaches() {
+        const previous = pruning || Promise.resolve();
+        const current = previous.then(() => this._pruneColumnCachesNow());
+        pruning = current;
+        current.finally(() => {
+            if (pruning === current) pruning = null;
+        });
+        return current;
+    }
+
+    /**
+     * @private
+     */
+    async _pruneColumnCachesNow() {
+        const cacheDir = config.binary.cacheDir;
+        const maxAge = config.binary.cacheTimeoutHours * 60 * 60 * 1000;
+        const maxBytes = config.binary.cacheMaxSizeMB * 1024 * 1024;
+
+        const building = new Set();
+        for (const experimentId of cacheBuilds.keys()) {
+            building.add(this._getColumnCachePath(experimentId));
+        }
+        const inUse = new Set(building);
+
+        try {
+            const now = Date.now();
+            const caches = [];
+            for (const name of await fs.readdir(cacheDir)) {
+                const filePath = path.join(cacheDir, name);
+                const isCache = COLUMN_CACHE_PATTERN.test(name);
+                if (!isCache && !COLUMN_CACHE_TEMP_PATTERN.test(name)) continue;
+                if (isCache && isCacheMapped(filePath)) inUse.add(filePath);
+                if (inUse.has(filePath)) continue;
+                if (!isCache && building.has(filePath.replace(/(\.[0-9a-f]+)?\.tmp$/, ''))) continue;
+
+                const stats = await fs.stat(filePath);
+                if (now - stats.mtimeMs > maxAge) {
+                    await this._removeColumnCache(filePath, 'expired');
+                } else if (isCache) {
+                    caches.push({ filePath, size: stats.size, mtimeMs: stats.mtimeMs });
+                }
+            }
+
+            // Most recently used first; in-use caches count towards the limit
+            let total = 0;
+            for (const cachePath of inUse) {
+                total += await fs.stat(cachePath).then(s => s.size, () => 0);
+            }
+            caches.sort((a, b) => b.mtimeMs - a.mtimeMs);
+            for (const cache of caches) {
+                total += cache.size;
+                if (total > maxBytes) {
+                    await this._removeColumnCache(cache.filePath, 'over the size limit');
+                    total -= cache.size;
+                }
+            }
+        } catch (error) {
+            if (error.code !== 'ENOENT') {
+                console.warn(`Could not prune column caches: ${error.message}`);
+            }
+        }
+    }
+
+    /**
+     * @private
+     */
+    async _removeColumnCache(filePath, reason) {
+        try {
+            await fs.unlink(filePath);
+            console.log(`Removed column cache ${path.basename(filePath)} (${reason})`);
+        } catch (error) {
+            console.warn(`Could not remove column cache ${path.basename(filePath)}: ${error.message}`);
+        }
+    }
+
     /**
      * Validate channel ID format
      * @private
@@ -8,6 +8,7 @@ const path = require('path');
 const fs = require('fs').promises;
 const TemperatureCsvReader = require('../utils/TemperatureCsvReader');
 const TemperatureDataProcessor = require('../utils/TemperatureDataProcessor');
+const CsvParseJobs = require('../utils/CsvParseJobs');
 const config = require('../config/config');
 const { createServiceResult } = require('../models/ApiResponse');
 
@@ -18,6 +19,9 @@ class TemperatureCsvService {
         this.dataCache = new Map();
         this.cacheTimeout = 10 * 60 * 1000; // 10 minutes TTL (same as binary service)
         
+        // Running parses, joined by later requests
+        this.parseJobs = new CsvParseJobs();
+        
         console.log(`${this.serviceName} initialized`);
     }
 
@@ -30,18 +34,37 @@ class TemperatureCsvService {
     async parseExperimentTemperatureFile(experimentId, forceRefresh = false) {
         const startTime = Date.now();
         
+        // Check cache first (unless forcing refresh)
+        if (!forceRefresh) {
+            const cachedData = this._getCachedData(experimentId);
+            if (cachedData) {
+                console.log(`Using cached temperature data for ${experimentId}`);
+                return createServiceResult(true, 'Temperature data loaded from cache', 1, 0, Date.now() - startTime);
+            }
+        }
+
+        // Join a parse that is already running, or start one
+        return await this.parseJobs.run(experimentId, job => this._parseTemperatureFile(experimentId, job, startTime));
+    }
+
+    /**
+     * Overview of a running parse, for a rough plot before the data is ready
+     * @param {string} experimentId - Experiment ID
+     * @returns {Object|null} { rows, bytesParsed, fileSize, progress, rowsPerBucket, time (s),
+     *          channels: { temp_welding: { min, max }, ... }, startedAt } or null when there is none yet
+     */
+    getTemperaturePreview(experimentId) {
+        return this.parseJobs.getPreview(experimentId);
+    }
+
+    /**
+     * Parse and cache the temperature CSV file; job.reader is set as soon as
+     * the reader exists so its preview can be served while it parses
+     */
+    async _parseTemperatureFile(experimentId, job, startTime) {
         try {
             console.log(`${this.serviceName}: Parsing temperature CSV for experiment ${experimentId}`);
             
-            // Check cache first (unless forcing refresh)
-            if (!forceRefresh) {
-                const cachedData = this._getCachedData(experimentId);
-                if (cachedData) {
-                    console.log(`Using cached temperature data for ${experimentId}`);
-                    return createServiceResult(true, 'Temperature data loaded from cache', 1, 0, Date.now() - startTime);
-                }
-            }
-
             // Resolve actual file path by scanning directory
             const temperatureFilePath = await this.getActualTemperatureFilePath(experimentId);
             
@@ -59,6 +82,7 @@ class TemperatureCsvService {
 
             // Parse CSV file
             const csvReader = new TemperatureCsvReader(temperatureFilePath);
+            job.reader = csvReader;
             await csvReader.readFile();
 
             // Create data processor
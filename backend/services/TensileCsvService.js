@@ -8,6 +8,7 @@
 const path = require('path');
 const fs = require('fs').promises;
 const TensileCsvReader = require('../utils/TensileCsvReader');
+const Downsampler = require('../utils/Downsampler');
 const config = require('../config/config');
 const { createServiceResult } = require('../models/ApiResponse');
 
@@ -773,8 +774,7 @@ class TensileCsvService {
      * @private
      */
     _getTimeSeriesChannelData(channelId, channelData, startTime, endTime, maxPoints, experimentId) {
-        // For now, simple time range filtering and decimation
-        // This could be enhanced with the processor later
+        // Simple time range filtering, resampled by the shared downsampler
         
         const timeData = channelData.time;
         const valueData = channelData.values;
@@ -816,34 +816,27 @@ class TensileCsvService {
                 }
             };
         } else {
-            // Simple decimation for now
-            const step = Math.ceil(totalPoints / maxPoints);
-            const resampledTime = [];
-            const resampledValues = [];
-            
-            for (let i = startIdx; i <= endIdx; i += step) {
-                resampledTime.push(timeData[i]);
-                resampledValues.push(valueData[i]);
-            }
+            // MinMaxLTTB keeps the curve shape and the force peaks
+            const resampled = Downsampler.minMaxLttb(channelData, startIdx, totalPoints, maxPoints);
             
             return {
                 success: true,
                 experimentId: experimentId,
                 channelId: channelId,
                 data: {
-                    time: resampledTime,
-                    values: resampledValues
+                    time: resampled.time,
+                    values: resampled.values
                 },
                 metadata: {
                     label: channelData.label,
                     unit: channelData.unit,
                     type: 'time_series',
-                    actualPoints: resampledTime.length,
+                    actualPoints: resampled.time.length,
                     originalPoints: totalPoints,
                     requestedRange: { startTime, endTime },
                     maxPointsRequested: maxPoints,
                     resampled: true,
-                    resampleRatio: step
+                    resampleRatio: Math.ceil(totalPoints / maxPoints)
                 }
             };
         }
@@ -11,6 +11,10 @@ const ThermalDataProcessor = require('../utils/ThermalDataProcessor');
 const config = require('../config/config');
 const { createServiceResult } = require('../models/ApiResponse');
 
+// Analysis files kept per experiment in config.thermal.dataCacheDir, and the
+// temporary files of their writes
+const DATA_FILE_PATTERN = /_(framestats\.bin|thumbs\.json|thumbs\.jpg|tvol\.bin)(\.tmp)?$/;
+
 class ThermalParserService {
     constructor() {
         this.serviceName = 'Thermal Parser Service';
@@ -18,11 +22,26 @@ class ThermalParserService {
         this.dataCache = new Map();
         this.cacheTimeout = 10 * 60 * 1000; // 10 minutes TTL
         
+        // Running per-frame statistics jobs: experimentId → { promise, done, total, startedAt }
+        this.frameStatsJobs = new Map();
+        
+        // Running thumbnail sheet jobs: experimentId → { promise, done, total, startedAt }
+        this.thumbnailJobs = new Map();
+        
+        // Running temperature volume builds: experimentId → { promise, done, total, startedAt }
+        this.volumeJobs = new Map();
+        
+        // Running data cache prune, later requests wait for it
+        this.dataPrune = null;
+        
         // Global temperature mapping (loaded once, reused for all experiments)
         this.globalTempMappingPath = null;
         this.globalTempMappingLoaded = false;
         
         console.log(`${this.serviceName} initialized`);
+        
+        // Drop analysis files that expired while the app was closed
+        this._pruneDataCache();
     }
 
     /**
@@ -82,6 +101,18 @@ class ThermalParserService {
 
             this._setCachedData(experimentId, processedData);
 
+            // Reuse a temperature volume built earlier for this video; optionally
+            // build one in the background (opt-in, decodes the whole video once)
+            const volumePath = this._getVolumePath(experimentId);
+            const volumeAttach = await processor.attachTemperatureVolume(volumePath);
+            if (volumeAttach.attached) {
+                this._touchDataFiles(volumePath);
+            } else if (config.thermal?.temperatureVolume?.autoBuild) {
+                this.getTemperatureVolume(experimentId).catch(error => {
+                    console.error(`Background temperature volume build failed for ${experimentId}:`, error);
+                });
+            }
+
             const duration = Date.now() - startTime;
             console.log(`${this.serviceName}: Successfully parsed ${experimentId} in ${duration}ms`);
 
@@ -175,9 +206,10 @@ class ThermalParserService {
      * @param {string} experimentId - Experiment ID
      * @param {number} frameNum - Frame number
      * @param {Array} lines - Array of line objects {x1, y1, x2, y2}
+     * @param {Object} options - { sampling } (see ThermalDataProcessor.analyzeLines)
      * @returns {Promise<Object>} Line analysis results
      */
-    async analyzeLines(experimentId, frameNum, lines) {
+    async analyzeLines(experimentId, frameNum, lines, options = {}) {
         try {
             // Validate inputs
             if (typeof frameNum !== 'number' || isNaN(frameNum)) {
@@ -210,7 +242,7 @@ class ThermalParserService {
             console.log(`Analyzing ${lines.length} lines for ${experimentId} frame ${frameNum}`);
             
             // Perform line analysis
-            const analysisResult = processor.analyzeLines(frameNum, lines);
+            const analysisResult = await processor.analyzeLines(frameNum, lines, options);
             
             if (!analysisResult.success) {
                 return {
@@ -244,6 +276,48 @@ class ThermalParserService {
         }
     }
 
+    /**
+     * Analyze lines and return the native packed Float32Array (binary transport)
+     * @param {string} experimentId - Experiment ID
+     * @param {number} frameNum - Frame number
+     * @param {Array} lines - Array of line objects {x1, y1, x2, y2}
+     * @param {Object} options - { sampling } (see ThermalDataProcessor.analyzeLines)
+     * @returns {Promise<Object>} { success, frameNumber, packed: Float32Array }
+     */
+    async analyzeLinesPacked(experimentId, frameNum, lines, options = {}) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const result = await cachedData.processor.analyzeLinesPacked(frameNum, lines, options);
+            if (!result.success) {
+                return result;
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error analyzing packed lines for ${experimentId}:`, error);
+            return { 
+                success: false, 
+                error: `Failed to analyze lines: ${error.message}`,
+                experimentId: experimentId,
+                frameNumber: frameNum
+            };
+        }
+    }
+
     /**
      * Get temperature for specific RGB pixel values
      * @param {string} experimentId - Experiment ID
@@ -268,7 +342,7 @@ class ThermalParserService {
             const processor = cachedData.processor;
             
             // Get pixel temperature
-            const result = processor.getPixelTemperature(r, g, b);
+            const result = await processor.getPixelTemperature(r, g, b);
             
             if (!result.success) {
                 return result;
@@ -297,6 +371,347 @@ class ThermalParserService {
         }
     }
 
+    /**
+     * Get per-frame max/min/mean temperature and hotspot series
+     * Loads the sidecar instantly when available, otherwise runs (or joins) the
+     * background native job that decodes the whole video once
+     * @param {string} experimentId - Experiment ID
+     * @param {Object} options - { forceRecompute }
+     * @returns {Promise<Object>} Frame statistics series
+     */
+    async getFrameStats(experimentId, options = {}) {
+        const running = this.frameStatsJobs.get(experimentId);
+        if (running) {
+            return await running.promise;
+        }
+
+        const job = { promise: null, done: 0, total: 0, startedAt: new Date() };
+        job.promise = this._runFrameStatsJob(experimentId, job, options);
+        this.frameStatsJobs.set(experimentId, job);
+
+        try {
+            return await job.promise;
+        } finally {
+            this.frameStatsJobs.delete(experimentId);
+        }
+    }
+
+    /**
+     * Get progress of a running per-frame statistics job
+     * @param {string} experimentId - Experiment ID
+     * @returns {Object|null} { done, total, progress, startedAt } or null if none running
+     */
+    getFrameStatsStatus(experimentId) {
+        const job = this.frameStatsJobs.get(experimentId);
+        if (!job) return null;
+
+        return {
+            done: job.done,
+            total: job.total,
+            progress: job.total > 0 ? job.done / job.total : 0,
+            startedAt: job.startedAt
+        };
+    }
+
+    /**
+     * Get the timeline preview: sprite sheet of every Nth frame and the per-frame
+     * max-temperature sparkline. Served from the on-disk cache when it matches the
+     * AVI (size and modification time) and the requested layout; otherwise one
+     * native pass builds the sheet and the frame statistics sidecar.
+     * @param {string} experimentId - Experiment ID
+     * @param {Object} options - { every, thumbWidth, columns, forceRefresh }
+     * @returns {Promise<Object>} { index, spritePath, sparkline: Float32Array }
+     */
+    async getThumbnailPreview(experimentId, options = {}) {
+        const running = this.thumbnailJobs.get(experimentId);
+        if (running) {
+            return await running.promise;
+        }
+
+        const job = { promise: null, done: 0, total: 0, startedAt: new Date() };
+        job.promise = this._runThumbnailJob(experimentId, job, options);
+        this.thumbnailJobs.set(experimentId, job);
+
+        try {
+            return await job.promise;
+        } finally {
+            this.thumbnailJobs.delete(experimentId);
+        }
+    }
+
+    /**
+     * Get progress of a running thumbnail sheet job
+     * @param {string} experimentId - Experiment ID
+     * @returns {Object|null} { done, total, progress, startedAt } or null if none running
+     */
+    getThumbnailStatus(experimentId) {
+        const job = this.thumbnailJobs.get(experimentId);
+        if (!job) return null;
+
+        return {
+            done: job.done,
+            total: job.total,
+            progress: job.total > 0 ? job.done / job.total : 0,
+            startedAt: job.startedAt
+        };
+    }
+
+    /**
+     * Attach the precomputed temperature volume of an experiment, building it
+     * first (one native pass over the whole video) unless an up-to-date file
+     * exists. Once attached, line, ROI, frame and time-series queries read
+     * temperatures from the volume instead of decoding video.
+     * @param {string} experimentId - Experiment ID
+     * @param {Object} options - { tileSize, forceRebuild }
+     * @returns {Promise<Object>} Volume state
+     */
+    async getTemperatureVolume(experimentId, options = {}) {
+        const running = this.volumeJobs.get(experimentId);
+        if (running) {
+            return await running.promise;
+        }
+
+        const job = { promise: null, done: 0, total: 0, startedAt: new Date() };
+        job.promise = this._runTemperatureVolumeJob(experimentId, job, options);
+        this.volumeJobs.set(experimentId, job);
+
+        try {
+            return await job.promise;
+        } finally {
+            this.volumeJobs.delete(experimentId);
+        }
+    }
+
+    /**
+     * Get the temperature volume state of an experiment
+     * @param {string} experimentId - Experiment ID
+     * @returns {Object} { attached, path, job: { done, total, progress, startedAt } | null }
+     */
+    getTemperatureVolumeStatus(experimentId) {
+        const job = this.volumeJobs.get(experimentId);
+        const volume = this._getCachedData(experimentId)?.processor.temperatureVolume || null;
+
+        return {
+            attached: volume !== null,
+            path: volume ? volume.path : null,
+            attachedAt: volume ? volume.attachedAt : null,
+            job: job ? {
+                done: job.done,
+                total: job.total,
+                progress: job.total > 0 ? job.done / job.total : 0,
+                startedAt: job.startedAt
+            } : null
+        };
+    }
+
+    /**
+     * Sample one line over a frame range (kymograph)
+     * @param {string} experimentId - Experiment ID
+     * @param {Object} line - Line coordinates {x1, y1, x2, y2}
+     * @param {Object} options - { startFrame, endFrame, step, onChunk }
+     * @returns {Promise<Object>} Matrix result (frames x pixels, Float32Array)
+     */
+    async analyzeLineOverTime(experimentId, line, options = {}) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const result = await cachedData.processor.analyzeLineOverTime(line, options);
+            if (!result.success) {
+                return result;
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error analyzing line over time for ${experimentId}:`, error);
+            return { 
+                success: false, 
+                error: `Failed to analyze line over time: ${error.message}`,
+                experimentId: experimentId
+            };
+        }
+    }
+
+    /**
+     * Region-of-interest statistics for one frame or a frame range
+     * @param {string} experimentId - Experiment ID
+     * @param {Object} roi - ROI description (rect, polygon or mask)
+     * @param {Object} options - { frameNum } or { startFrame, endFrame, step }, plus { percentiles, thresholds }
+     * @returns {Promise<Object>} ROI statistics
+     */
+    async analyzeRoi(experimentId, roi, options = {}) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const result = await cachedData.processor.analyzeRoi(roi, options);
+            if (!result.success) {
+                return result;
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error analyzing ROI for ${experimentId}:`, error);
+            return { 
+                success: false, 
+                error: `Failed to analyze ROI: ${error.message}`,
+                experimentId: experimentId
+            };
+        }
+    }
+
+    /**
+     * Isotherm (threshold area) analysis for one frame or a frame range
+     * @param {string} experimentId - Experiment ID
+     * @param {Object} options - { thresholds, contours, simplify } plus { frameNum } or { startFrame, endFrame, step }
+     * @returns {Promise<Object>} Isotherm levels or series
+     */
+    async analyzeIsotherms(experimentId, options = {}) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const result = await cachedData.processor.analyzeIsotherms(options);
+            if (!result.success) {
+                return result;
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error analyzing isotherms for ${experimentId}:`, error);
+            return { 
+                success: false, 
+                error: `Failed to analyze isotherms: ${error.message}`,
+                experimentId: experimentId
+            };
+        }
+    }
+
+    /**
+     * Encode a frame as JPEG/PNG/WebP (optionally downscaled)
+     * @param {string} experimentId - Experiment ID
+     * @param {number} frameNum - Frame number
+     * @param {Object} options - { format, quality, width, height }
+     * @returns {Promise<Object>} { success, data: Buffer, mimeType }
+     */
+    async exportFrame(experimentId, frameNum, options = {}) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const result = await cachedData.processor.exportFrame(frameNum, options);
+            if (!result.success) {
+                return result;
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error exporting frame for ${experimentId}:`, error);
+            return { 
+                success: false, 
+                error: `Failed to export frame: ${error.message}`,
+                experimentId: experimentId,
+                frameNumber: frameNum
+            };
+        }
+    }
+
+    /**
+     * Get the full temperature map for a frame
+     * @param {string} experimentId - Experiment ID
+     * @param {number} frameNum - Frame number
+     * @param {Object} options - { quantized: boolean }
+     * @returns {Promise<Object>} Temperature frame with typed array data
+     */
+    async getTemperatureFrame(experimentId, frameNum, options = {}) {
+        try {
+            if (typeof frameNum !== 'number' || isNaN(frameNum)) {
+                return { 
+                    success: false, 
+                    error: 'Frame number must be a valid number' 
+                };
+            }
+
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const result = await cachedData.processor.getTemperatureFrame(frameNum, options);
+            if (!result.success) {
+                return result;
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error getting temperature frame for ${experimentId}:`, error);
+            return { 
+                success: false, 
+                error: `Failed to get temperature frame: ${error.message}`,
+                experimentId: experimentId,
+                frameNumber: frameNum
+            };
+        }
+    }
+
     /**
      * Check if experiment has thermal AVI file
      * @param {string} experimentId - Experiment ID
@@ -481,6 +896,14 @@ class ThermalParserService {
                 nativeEngineSupport: true,
                 lineAnalysis: true,
                 pixelTemperature: true,
+                temperatureFrame: true,
+                lineOverTime: true,
+                frameStats: true,
+                roiAnalysis: true,
+                isotherms: true,
+                frameExport: true,
+                thumbnails: true,
+                temperatureVolume: true,
                 frameNavigation: true,
                 realTimeAnalysis: true,
                 supportedFormats: ['.avi']
@@ -523,6 +946,369 @@ class ThermalParserService {
         }
     }
 
+    /**
+     * Run the per-frame statistics job for an experiment
+     * @private
+     */
+    async _runFrameStatsJob(experimentId, job, options) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const sidecarPath = this._getDataPath(experimentId, 'framestats.bin');
+            await fs.mkdir(path.dirname(sidecarPath), { recursive: true });
+
+            const result = await cachedData.processor.getFrameStats(sidecarPath, {
+                forceRecompute: options.forceRecompute === true,
+                onProgress: (done, total) => {
+                    job.done = done;
+                    job.total = total;
+                }
+            });
+
+            if (!result.success) {
+                return result;
+            }
+
+            if (result.metadata.fromSidecar) {
+                this._touchDataFiles(sidecarPath);
+            } else {
+                this._pruneDataCache();
+            }
+
+            return {
+                ...result,
+                experimentId: experimentId
+            };
+
+        } catch (error) {
+            console.error(`Error computing frame statistics for ${experimentId}:`, error);
+            return {
+                success: false,
+                error: `Failed to compute frame statistics: ${error.message}`,
+                experimentId: experimentId
+            };
+        }
+    }
+
+    /**
+     * Load or build the thumbnail sheet for an experiment
+     * @private
+     */
+    async _runThumbnailJob(experimentId, job, options) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const indexPath = this._getDataPath(experimentId, 'thumbs.json');
+            const spritePath = this._getDataPath(experimentId, 'thumbs.jpg');
+            const statsPath = this._getDataPath(experimentId, 'framestats.bin');
+            await fs.mkdir(path.dirname(indexPath), { recursive: true });
+
+            const frames = cachedData.processor.videoInfo.frames || 0;
+            const aviStats = await fs.stat(cachedData.filePaths.aviPath);
+            const layout = {
+                every: Math.max(1, Math.round(options.every ?? Math.ceil(frames / 500))),
+                thumbWidth: Math.max(1, Math.round(options.thumbWidth ?? 160)),
+                columns: Math.max(1, Math.round(options.columns ?? 10))
+            };
+            const source = { size: aviStats.size, mtimeMs: aviStats.mtimeMs };
+
+            // Cached sheet: index must match the source file and the requested layout
+            if (!options.forceRefresh) {
+                try {
+                    const index = JSON.parse(await fs.readFile(indexPath, 'utf8'));
+                    const matches = index.source?.size === source.size &&
+                        index.source?.mtimeMs === source.mtimeMs &&
+                        index.request?.every === layout.every &&
+                        index.request?.thumbWidth === layout.thumbWidth &&
+                        index.request?.columns === layout.columns;
+
+                    if (matches) {
+                        await fs.access(spritePath);
+                        const stats = await cachedData.processor.getFrameStats(statsPath);
+                        if (stats.success) {
+                            this._touchDataFiles(indexPath, spritePath, statsPath);
+                            return {
+                                success: true,
+                                experimentId: experimentId,
+                                index: index,
+                                spritePath: spritePath,
+                                sparkline: stats.maxTemp,
+                                fromCache: true
+                            };
+                        }
+                    }
+                } catch (error) {
+                    // No usable cache - build below
+                }
+            }
+
+            const sheet = await cachedData.processor.buildThumbnails({
+                ...layout,
+                format: 'jpeg',
+                statsSidecarPath: statsPath,
+                onProgress: (done, total) => {
+                    job.done = done;
+                    job.total = total;
+                }
+            });
+
+            if (!sheet.success) {
+                return sheet;
+            }
+
+            const index = {
+                source: source,
+                request: layout,
+                every: sheet.every,
+                thumbWidth: sheet.thumbWidth,
+                thumbHeight: sheet.thumbHeight,
+                columns: sheet.columns,
+                rows: sheet.rows,
+                count: sheet.count,
+                frames: frames,
+                fps: cachedData.processor.videoInfo.fps || 0,
+                mimeType: sheet.mimeType,
+                createdAt: new Date().toISOString()
+            };
+
+            // Sprite first, index last: an index on disk always refers to a complete sprite
+            await fs.writeFile(`${spritePath}.tmp`, sheet.image);
+            await fs.rename(`${spritePath}.tmp`, spritePath);
+            await fs.writeFile(indexPath, JSON.stringify(index, null, 2));
+            this._pruneDataCache();
+
+            return {
+                success: true,
+                experimentId: experimentId,
+                index: index,
+                spritePath: spritePath,
+                sparkline: sheet.frameStats.maxTemp,
+                fromCache: false
+            };
+
+        } catch (error) {
+            console.error(`Error building thumbnails for ${experimentId}:`, error);
+            return {
+                success: false,
+                error: `Failed to build thumbnails: ${error.message}`,
+                experimentId: experimentId
+            };
+        }
+    }
+
+    /**
+     * Attach an existing temperature volume or build and attach a new one
+     * @private
+     */
+    async _runTemperatureVolumeJob(experimentId, job, options) {
+        try {
+            // Ensure data is parsed
+            const parseResult = await this.parseExperimentThermalFile(experimentId);
+            if (!parseResult.success) {
+                return { success: false, error: parseResult.message };
+            }
+
+            const cachedData = this._getCachedData(experimentId);
+            if (!cachedData) {
+                return { success: false, error: 'No cached data found' };
+            }
+
+            const volumePath = this._getVolumePath(experimentId);
+            await fs.mkdir(path.dirname(volumePath), { recursive: true });
+
+            if (!options.forceRebuild) {
+                if (cachedData.processor.temperatureVolume) {
+                    return { success: true, experimentId: experimentId, path: volumePath, attached: true, fromCache: true };
+                }
+
+                const attach = await cachedData.processor.attachTemperatureVolume(volumePath);
+                if (attach.attached) {
+                    this._touchDataFiles(volumePath);
+                    return { success: true, experimentId: experimentId, path: volumePath, attached: true, fromCache: true };
+                }
+            }
+
+            const result = await cachedData.processor.buildTemperatureVolume(volumePath, {
+                tileSize: options.tileSize ?? config.thermal?.temperatureVolume?.tileSize,
+                onProgress: (done, total) => {
+                    job.done = done;
+                    job.total = total;
+                }
+            });
+
+            if (!result.success) {
+                return result;
+            }
+
+            console.log(`Temperature volume for ${experimentId}: ${(result.byteSize / 1024 / 1024).toFixed(1)} MB ` +
+                `(${result.compressionRatio.toFixed(2)}x vs. raw 16-bit)`);
+            this._pruneDataCache();
+
+            return {
+                ...result,
+                experimentId: experimentId,
+                fromCache: false
+            };
+
+        } catch (error) {
+            console.error(`Error preparing temperature volume for ${experimentId}:`, error);
+            return {
+                success: false,
+                error: `Failed to prepare temperature volume: ${error.message}`,
+                experimentId: experimentId
+            };
+        }
+    }
+
+    /**
+     * Temperature volume file of an experiment
+     * @private
+     */
+    _getVolumePath(experimentId) {
+        return this._getDataPath(experimentId, 'tvol.bin');
+    }
+
+    /**
+     * Analysis file of an experiment in the data cache (not served over HTTP)
+     * @private
+     */
+    _getDataPath(experimentId, suffix) {
+        const dataCacheDir = config.thermal?.dataCacheDir || path.join(__dirname, '..', 'cache', 'thermal-data');
+        return path.join(dataCacheDir, `${experimentId}_${suffix}`);
+    }
+
+    /**
+     * Mark analysis files as used now (the prune goes by modification time)
+     * @private
+     */
+    _touchDataFiles(...filePaths) {
+        const now = new Date();
+        for (const filePath of filePaths) {
+            fs.utimes(filePath, now, now).catch(() => {});
+        }
+    }
+
+    /**
+     * Delete analysis files unused for dataCacheTimeoutHours, then the least
+     * recently used ones until the rest fit dataCacheMaxSizeMB. Files of
+     * experiments with a running job and attached volumes are kept; leftover
+     * temporary files of interrupted writes go with the expired files.
+     * Analysis files that earlier versions wrote to the served cacheDir are
+     * removed. Prunes run one at a time.
+     * @private
+     */
+    _pruneDataCache() {
+        const previous = this.dataPrune || Promise.resolve();
+        const current = previous.then(() => this._pruneDataCacheNow());
+        this.dataPrune = current;
+        current.finally(() => {
+            if (this.dataPrune === current) this.dataPrune = null;
+        });
+        return current;
+    }
+
+    /**
+     * @private
+     */
+    async _pruneDataCacheNow() {
+        const dataCacheDir = config.thermal?.dataCacheDir || path.join(__dirname, '..', 'cache', 'thermal-data');
+        const maxAge = (config.thermal?.dataCacheTimeoutHours ?? 168) * 60 * 60 * 1000;
+        const maxBytes = (config.thermal?.dataCacheMaxSizeMB ?? 10240) * 1024 * 1024;
+
+        const busy = new Set([
+            ...this.frameStatsJobs.keys(),
+            ...this.thumbnailJobs.keys(),
+            ...this.volumeJobs.keys()
+        ]);
+        const attached = new Set();
+        for (const data of this.dataCache.values()) {
+            const volume = data.processor?.temperatureVolume;
+            if (volume) attached.add(volume.path);
+        }
+
+        // Left next to the served video cache by earlier versions
+        if (config.thermal?.cacheDir) {
+            try {
+                for (const name of await fs.readdir(config.thermal.cacheDir)) {
+                    if (DATA_FILE_PATTERN.test(name)) {
+                        await this._removeDataFile(path.join(config.thermal.cacheDir, name), 'moved to the data cache');
+                    }
+                }
+            } catch (error) {
+                if (error.code !== 'ENOENT') {
+                    console.warn(`Could not clean the thermal cache folder: ${error.message}`);
+                }
+            }
+        }
+
+        try {
+            const now = Date.now();
+            const files = [];
+            let total = 0;
+            for (const name of await fs.readdir(dataCacheDir)) {
+                const match = name.match(DATA_FILE_PATTERN);
+                if (!match) continue;
+
+                const filePath = path.join(dataCacheDir, name);
+                const stats = await fs.stat(filePath).catch(() => null);
+                if (!stats) continue;
+
+                // In-use files count towards the limit
+                if (busy.has(name.slice(0, match.index)) || attached.has(filePath)) {
+                    total += stats.size;
+                } else if (now - stats.mtimeMs > maxAge) {
+                    await this._removeDataFile(filePath, 'expired');
+                } else if (!match[2]) {
+                    files.push({ filePath, size: stats.size, mtimeMs: stats.mtimeMs });
+                }
+            }
+
+            // Most recently used first
+            files.sort((a, b) => b.mtimeMs - a.mtimeMs);
+            for (const file of files) {
+                total += file.size;
+                if (total > maxBytes) {
+                    await this._removeDataFile(file.filePath, 'over the size limit');
+                    total -= file.size;
+                }
+            }
+        } catch (error) {
+            if (error.code !== 'ENOENT') {
+                console.warn(`Could not prune the thermal data cache: ${error.message}`);
+            }
+        }
+    }
+
+    /**
+     * @private
+     */
+    async _removeDataFile(filePath, reason) {
+        try {
+            await fs.unlink(filePath);
+            console.log(`Removed thermal data file ${path.basename(filePath)} (${reason})`);
+        } catch (error) {
+            console.warn(`Could not remove thermal data file ${path.basename(filePath)}: ${error.message}`);
+        }
+    }
+
     /**
      * Get cached data for experiment
      * @private
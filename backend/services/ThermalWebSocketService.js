@@ -64,6 +64,8 @@ class ThermalWebSocketService {
             capabilities: [
                 'loadVideo',
                 'analyzeLines', 
+                'analyzeLinesBinary',
+                'analyzeLineOverTime',
                 'pixelTemperature',
                 'videoInfo'
             ],
@@ -149,6 +151,10 @@ class ThermalWebSocketService {
                     await this.handleAnalyzeLines(ws, message.data, connectionId);
                     break;
                     
+                case 'analyzeLineOverTime':
+                    await this.handleAnalyzeLineOverTime(ws, message.data, connectionId);
+                    break;
+                    
                 case 'pixelTemperature':
                     await this.handlePixelTemperature(ws, message.data, connectionId);
                     break;
@@ -237,6 +243,8 @@ class ThermalWebSocketService {
 
     /**
      * Handle line analysis request
+     * With data.format === 'binary' the reply is a binary message (see sendBinary)
+     * instead of an 'analysisResult' JSON message
      * @param {WebSocket} ws - WebSocket connection
      * @param {Object} data - Message data
      * @param {string} connectionId - Connection ID
@@ -249,7 +257,7 @@ class ThermalWebSocketService {
                 return;
             }
             
-            const { experimentId, frameNum, lines } = data;
+            const { experimentId, frameNum, lines, sampling } = data;
             this.stats.totalAnalysisRequests++;
             
             // Limit lines per request
@@ -260,8 +268,21 @@ class ThermalWebSocketService {
             
             console.log(`🔍 Analyzing ${lines.length} lines for ${experimentId} frame ${frameNum}`);
             
+            // Binary reply: the native packed Float32 result goes out as is
+            if (data.format === 'binary') {
+                const packedResult = await this.thermalService.analyzeLinesPacked(experimentId, frameNum, lines, { sampling });
+                
+                if (!packedResult.success) {
+                    this.sendError(ws, `Analysis failed: ${packedResult.error}`);
+                    return;
+                }
+                
+                this.sendBinary(ws, packedResult.packed);
+                return;
+            }
+            
             // Perform analysis
-            const analysisResult = await this.thermalService.analyzeLines(experimentId, frameNum, lines);
+            const analysisResult = await this.thermalService.analyzeLines(experimentId, frameNum, lines, { sampling });
             
             if (!analysisResult.success) {
                 this.sendError(ws, `Analysis failed: ${analysisResult.error}`);
@@ -289,6 +310,69 @@ class ThermalWebSocketService {
         }
     }
 
+    /**
+     * Handle line-over-time (kymograph) request
+     * Streams row blocks as 'lineOverTimeChunk' while the native engine decodes,
+     * then sends 'lineOverTimeComplete' with the matrix shape
+     * @param {WebSocket} ws - WebSocket connection
+     * @param {Object} data - Message data
+     * @param {string} connectionId - Connection ID
+     */
+    async handleAnalyzeLineOverTime(ws, data, connectionId) {
+        try {
+            // Validate request data
+            if (!data || !data.experimentId || !data.line ||
+                typeof data.startFrame !== 'number' || typeof data.endFrame !== 'number') {
+                this.sendError(ws, 'analyzeLineOverTime requires experimentId, line, startFrame and endFrame');
+                return;
+            }
+            
+            const { experimentId, line, startFrame, endFrame, step = 1, requestId = null } = data;
+            this.stats.totalAnalysisRequests++;
+            
+            console.log(`📈 Line over time for ${experimentId} frames ${startFrame}-${endFrame} (step ${step})`);
+            
+            const result = await this.thermalService.analyzeLineOverTime(experimentId, line, {
+                startFrame,
+                endFrame,
+                step,
+                onChunk: (chunk) => {
+                    this.sendResponse(ws, 'lineOverTimeChunk', {
+                        experimentId: experimentId,
+                        requestId: requestId,
+                        firstRow: chunk.firstRow,
+                        rowCount: chunk.rowCount,
+                        firstFrame: chunk.firstFrame,
+                        pixelCount: chunk.pixelCount,
+                        temperatures: Array.from(chunk.data)
+                    });
+                }
+            });
+            
+            if (!result.success) {
+                this.sendError(ws, `Line over time failed: ${result.error}`);
+                return;
+            }
+            
+            this.sendResponse(ws, 'lineOverTimeComplete', {
+                experimentId: experimentId,
+                requestId: requestId,
+                line: result.line,
+                startFrame: result.startFrame,
+                endFrame: result.endFrame,
+                step: result.step,
+                frameCount: result.frameCount,
+                pixelCount: result.pixelCount,
+                metadata: result.metadata
+            });
+            
+        } catch (error) {
+            console.error(`❌ Error analyzing line over time:`, error);
+            this.stats.errors++;
+            this.sendError(ws, `Line over time failed: ${error.message}`);
+        }
+    }
+
     /**
      * Handle pixel temperature request
      * @param {WebSocket} ws - WebSocket connection
@@ -447,6 +531,24 @@ class ThermalWebSocketService {
         }
     }
 
+    /**
+     * Send a typed array as one binary message (no copy, no JSON)
+     * Binary messages on this socket carry packed line analysis results:
+     * [lineCount, frameNumber, totalSamples], offsets[lineCount + 1],
+     * stats[lineCount * 3] (min, max, mean), temperatures[totalSamples], all float32 LE
+     * @param {WebSocket} ws - WebSocket connection
+     * @param {ArrayBufferView} view - Payload
+     */
+    sendBinary(ws, view) {
+        try {
+            if (ws.readyState === ws.OPEN) {
+                ws.send(Buffer.from(view.buffer, view.byteOffset, view.byteLength), { binary: true });
+            }
+        } catch (error) {
+            console.error(`❌ Error sending binary response:`, error);
+        }
+    }
+
     /**
      * Send error response to client
      * @param {WebSocket} ws - WebSocket connection
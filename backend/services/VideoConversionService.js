@@ -3,6 +3,8 @@
  * Handles AVI to MP4 conversion for thermal video files using FFmpeg
  * Manages conversion cache, progress tracking, and file serving
  * UPDATED: Returns static file paths for Express static serving
+ * Transcodes natively through the thermal addon when available (frame-accurate,
+ * writes a timestamp map next to the MP4) and falls back to FFmpeg otherwise
  */
 
 const path = require('path');
@@ -12,6 +14,47 @@ const ffmpegStatic = require('ffmpeg-static');
 const config = require('../config/config');
 const { createServiceResult } = require('../models/ApiResponse');
 
+// Routes create a service per request, so conversion state lives at module level
+const conversionCache = new Map(); // experimentId → conversion info
+const activeConversions = new Map(); // experimentId → conversion promise
+const conversionProgress = new Map(); // experimentId → { done, total, encoder }
+
+const TIMESTAMP_MAP_VERSION = 1;
+
+let nativeTranscoder; // undefined = not tried yet, null = unavailable
+
+/**
+ * Load the transcodeVideo export of the thermal addon (once per process)
+ * @returns {Function|null} transcodeVideo(inputPath, outputPath, onProgress) or null
+ */
+function loadNativeTranscoder() {
+    if (nativeTranscoder !== undefined) return nativeTranscoder;
+
+    nativeTranscoder = null;
+    const possiblePaths = [
+        '../native/thermal/build/Release/thermal_engine.node',
+        './native/thermal/build/Release/thermal_engine.node',
+        path.join(__dirname, '../native/thermal/build/Release/thermal_engine.node')
+    ];
+
+    for (const modulePath of possiblePaths) {
+        try {
+            const nativeModule = require(modulePath);
+            if (typeof nativeModule.transcodeVideo === 'function') {
+                nativeTranscoder = nativeModule.transcodeVideo;
+                break;
+            }
+        } catch (e) {
+            // Continue to next path
+        }
+    }
+
+    if (!nativeTranscoder) {
+        console.log('Native transcoder not available - using FFmpeg for thermal video conversion');
+    }
+    return nativeTranscoder;
+}
+
 class VideoConversionService {
     constructor() {
         this.serviceName = 'Video Conversion Service';
@@ -20,8 +63,9 @@ class VideoConversionService {
         ffmpeg.setFfmpegPath(ffmpegStatic);
         
         // Conversion cache and status tracking
-        this.conversionCache = new Map(); // experimentId → conversion info
-        this.activeConversions = new Map(); // experimentId → conversion promise
+        this.conversionCache = conversionCache;
+        this.activeConversions = activeConversions;
+        this.conversionProgress = conversionProgress;
         
         // Configuration - UPDATED: Use cache directory instead of temp
         this.outputFormat = 'mp4';
@@ -153,6 +197,44 @@ class VideoConversionService {
         }
     }
 
+    /**
+     * Get the frame timestamp map of the converted MP4, converting first if needed
+     * @param {string} experimentId - Experiment ID
+     * @param {string} aviFilePath - Source AVI file path
+     * @returns {Promise<Object>} { success, data: timestamp map } or { success: false, message }
+     */
+    async getTimestampMap(experimentId, aviFilePath) {
+        try {
+            const conversionResult = await this.convertAndGetMp4Path(experimentId, aviFilePath);
+            if (!conversionResult.success) {
+                return {
+                    success: false,
+                    message: conversionResult.message,
+                    error: conversionResult.error || 'Conversion failed'
+                };
+            }
+
+            const timestampMap = await this._readTimestampMap(experimentId);
+            if (!timestampMap) {
+                return {
+                    success: false,
+                    message: 'Timestamp map not found for converted video',
+                    error: `Missing ${path.basename(this._getTimestampMapPath(experimentId))}`
+                };
+            }
+
+            return { success: true, data: timestampMap };
+
+        } catch (error) {
+            console.error(`Error getting timestamp map for ${experimentId}:`, error);
+            return {
+                success: false,
+                message: `Timestamp map failed: ${error.message}`,
+                error: error.toString()
+            };
+        }
+    }
+
     /**
      * Get conversion status for an experiment
      * @param {string} experimentId - Experiment ID
@@ -161,10 +243,16 @@ class VideoConversionService {
     getConversionStatus(experimentId) {
         // Check if actively converting
         if (this.activeConversions.has(experimentId)) {
+            const progress = this.conversionProgress.get(experimentId);
             return {
                 status: 'converting',
                 experimentId: experimentId,
-                message: 'Conversion in progress'
+                message: 'Conversion in progress',
+                encoder: progress?.encoder || null,
+                framesDone: progress?.done || 0,
+                framesTotal: progress?.total || 0,
+                percent: progress && progress.total > 0
+                    ? Math.round((progress.done / progress.total) * 100) : null
             };
         }
 
@@ -177,6 +265,8 @@ class VideoConversionService {
                 convertedAt: cached.convertedAt,
                 fileSize: cached.fileSize,
                 mp4Path: cached.mp4Path,
+                encoder: cached.encoder,
+                frameAccurate: cached.frameAccurate,
                 staticUrl: `/cache/thermal/${experimentId}.mp4`
             };
         }
@@ -205,6 +295,12 @@ class VideoConversionService {
                 } catch (error) {
                     console.warn(`Could not delete MP4 file: ${error.message}`);
                 }
+
+                try {
+                    await fs.unlink(this._getTimestampMapPath(experimentId));
+                } catch {
+                    // No map written for this conversion
+                }
             }
 
             // Remove from cache
@@ -247,6 +343,7 @@ class VideoConversionService {
                 fileSize: cached.fileSize,
                 fileSizeMB: (cached.fileSize / 1024 / 1024).toFixed(1),
                 mp4File: path.basename(cached.mp4Path),
+                encoder: cached.encoder,
                 staticUrl: `/cache/thermal/${experimentId}.mp4`
             });
         }
@@ -255,6 +352,7 @@ class VideoConversionService {
             serviceName: this.serviceName,
             status: 'active',
             ffmpegPath: ffmpegStatic,
+            nativeTranscoder: loadNativeTranscoder() !== null,
             cacheDirectory: this.cacheDir,
             cache: {
                 totalConversions: this.conversionCache.size,
@@ -270,9 +368,11 @@ class VideoConversionService {
             capabilities: {
                 inputFormats: ['.avi'],
                 outputFormat: this.outputFormat,
-                videoCodec: 'libx264',
+                videoCodec: loadNativeTranscoder() ? 'h264' : 'libx264',
                 audioCodec: 'aac',
-                staticServing: true
+                staticServing: true,
+                timestampMap: true,
+                conversionProgress: true
             }
         };
     }
@@ -298,41 +398,72 @@ class VideoConversionService {
             const mp4FileName = `${experimentId}.mp4`;
             const mp4Path = path.join(this.cacheDir, mp4FileName);
 
-            // Check if output already exists (shouldn't happen due to cache check, but safety)
+            // Get source file info
+            const sourceStats = await fs.stat(aviFilePath);
+            const sourceSizeMB = (sourceStats.size / 1024 / 1024).toFixed(1);
+
+            // An MP4 from an earlier run is reused while its source is unchanged
+            const existing = await this._readTimestampMap(experimentId);
+            if (existing && this._sourceMatches(existing, sourceStats) && await this._fileExists(mp4Path)) {
+                const outputStats = await fs.stat(mp4Path);
+                const cacheEntry = this._cacheConversion(experimentId, aviFilePath, mp4Path, outputStats, existing, 0);
+                console.log(`Reusing converted MP4 on disk for ${experimentId}`);
+
+                return {
+                    success: true,
+                    message: 'Using converted MP4 file',
+                    mp4Path: mp4Path,
+                    fileSize: outputStats.size,
+                    convertedAt: cacheEntry.convertedAt,
+                    conversionTime: 0,
+                    fromCache: true
+                };
+            }
+
             if (await this._fileExists(mp4Path)) {
                 await fs.unlink(mp4Path);
             }
 
-            // Get source file info
-            const sourceStats = await fs.stat(aviFilePath);
-            const sourceSizeMB = (sourceStats.size / 1024 / 1024).toFixed(1);
             console.log(`Converting ${sourceSizeMB}MB AVI to MP4...`);
 
-            // Perform conversion
-            await this._ffmpegConvert(aviFilePath, mp4Path);
+            // Native transcode keeps every source frame at i / fps; FFmpeg is the fallback
+            let timestampMap = null;
+            const transcodeVideo = loadNativeTranscoder();
+            if (transcodeVideo) {
+                try {
+                    this.conversionProgress.set(experimentId, { done: 0, total: 0, encoder: 'native' });
+                    const result = await transcodeVideo(aviFilePath, mp4Path, (done, total) => {
+                        this.conversionProgress.set(experimentId, { done, total, encoder: 'native' });
+                    });
+                    timestampMap = this._buildTimestampMap(sourceStats, 'native', result);
+                } catch (error) {
+                    console.warn(`Native transcode failed for ${experimentId}, falling back to FFmpeg: ${error.message}`);
+                }
+            }
+
+            if (!timestampMap) {
+                this.conversionProgress.set(experimentId, { done: 0, total: 100, encoder: 'ffmpeg' });
+                await this._ffmpegConvert(aviFilePath, mp4Path, (percent) => {
+                    this.conversionProgress.set(experimentId, { done: percent, total: 100, encoder: 'ffmpeg' });
+                });
+                timestampMap = this._buildTimestampMap(sourceStats, 'ffmpeg', null);
+            }
 
             // Verify output file
             if (!await this._fileExists(mp4Path)) {
                 throw new Error('MP4 file was not created');
             }
 
+            await this._writeTimestampMap(experimentId, timestampMap);
+
             const outputStats = await fs.stat(mp4Path);
             const outputSizeMB = (outputStats.size / 1024 / 1024).toFixed(1);
             const duration = Date.now() - startTime;
 
-            console.log(`Conversion completed: ${sourceSizeMB}MB AVI → ${outputSizeMB}MB MP4 in ${duration}ms`);
+            console.log(`Conversion completed (${timestampMap.encoder}): ${sourceSizeMB}MB AVI → ${outputSizeMB}MB MP4 in ${duration}ms`);
 
             // Cache the result
-            const cacheEntry = {
-                experimentId: experimentId,
-                mp4Path: mp4Path,
-                fileSize: outputStats.size,
-                convertedAt: new Date(),
-                sourceFile: aviFilePath,
-                conversionTime: duration
-            };
-            
-            this.conversionCache.set(experimentId, cacheEntry);
+            const cacheEntry = this._cacheConversion(experimentId, aviFilePath, mp4Path, outputStats, timestampMap, duration);
 
             // Return simple object (not createServiceResult)
             return {
@@ -354,14 +485,98 @@ class VideoConversionService {
                 error: error.toString(),
                 conversionTime: duration
             };
+        } finally {
+            this.conversionProgress.delete(experimentId);
+        }
+    }
+
+    /**
+     * Record a finished conversion in the shared cache
+     * @private
+     */
+    _cacheConversion(experimentId, aviFilePath, mp4Path, outputStats, timestampMap, duration) {
+        const cacheEntry = {
+            experimentId: experimentId,
+            mp4Path: mp4Path,
+            fileSize: outputStats.size,
+            convertedAt: new Date(),
+            sourceFile: aviFilePath,
+            conversionTime: duration,
+            encoder: timestampMap.encoder,
+            frameAccurate: timestampMap.frames !== null
+        };
+
+        this.conversionCache.set(experimentId, cacheEntry);
+        return cacheEntry;
+    }
+
+    /**
+     * Build the MP4 timestamp map. MP4 frame i is shown at [i / fps, (i + 1) / fps)
+     * and is source frame i; sourceTimesMs holds each frame's source timestamp.
+     * FFmpeg conversions carry no per-frame information (frames/fps are null).
+     * @private
+     */
+    _buildTimestampMap(sourceStats, encoder, result) {
+        return {
+            version: TIMESTAMP_MAP_VERSION,
+            source: {
+                size: sourceStats.size,
+                mtimeMs: sourceStats.mtimeMs
+            },
+            encoder: encoder,
+            codec: result ? result.codec : 'libx264',
+            fps: result ? result.fps : null,
+            frames: result ? result.frames : null,
+            width: result ? result.width : null,
+            height: result ? result.height : null,
+            sourceTimesMs: result ? Array.from(result.sourceTimes) : null
+        };
+    }
+
+    /**
+     * @private
+     */
+    _getTimestampMapPath(experimentId) {
+        return path.join(this.cacheDir, `${experimentId}.timestamps.json`);
+    }
+
+    /**
+     * @private
+     */
+    async _writeTimestampMap(experimentId, timestampMap) {
+        try {
+            await fs.writeFile(this._getTimestampMapPath(experimentId), JSON.stringify(timestampMap));
+        } catch (error) {
+            console.warn(`Could not write timestamp map for ${experimentId}: ${error.message}`);
         }
     }
 
+    /**
+     * @private
+     */
+    async _readTimestampMap(experimentId) {
+        try {
+            const map = JSON.parse(await fs.readFile(this._getTimestampMapPath(experimentId), 'utf8'));
+            return map.version === TIMESTAMP_MAP_VERSION ? map : null;
+        } catch {
+            return null;
+        }
+    }
+
+    /**
+     * @private
+     */
+    _sourceMatches(timestampMap, sourceStats) {
+        return timestampMap.source &&
+            timestampMap.source.size === sourceStats.size &&
+            timestampMap.source.mtimeMs === sourceStats.mtimeMs;
+    }
+
     /**
      * Execute FFmpeg conversion
      * @private
      */
-_ffmpegConvert(inputPath, outputPath) {
+_ffmpegConvert(inputPath, outputPath, onProgress) {
     return new Promise((resolve, reject) => {
         ffmpeg(inputPath)
             .outputOptions([
@@ -381,6 +596,7 @@ _ffmpegConvert(inputPath, outputPath) {
             .on('progress', (progress) => {
                 if (progress.percent) {
                     console.log(`Conversion progress: ${Math.round(progress.percent)}%`);
+                    if (onProgress) onProgress(Math.round(progress.percent));
                 }
             })
             .on('end', () => {
@@ -10,7 +10,7 @@
 
 const fs = require('fs').promises;
 const path = require('path');
-const Papa = require('papaparse');
+const CsvIngest = require('./CsvIngest');
 
 class AccelerationCsvReader {
     constructor(filename) {
@@ -19,6 +19,9 @@ class AccelerationCsvReader {
         this.accelerationData = {};
         this.processingStats = {};
         
+        // Overview of the rows parsed so far, while readFile runs
+        this.preview = null;
+        
         // Channel mapping for 3-axis acceleration
         this.channelMapping = {};
         
@@ -308,24 +311,6 @@ class AccelerationCsvReader {
         return timeArray;
     }
 
-    /**
-     * Convert time array from seconds to microseconds
-     * @param {number[]} timeSeconds - Time in seconds
-     * @returns {Float32Array} Time in microseconds
-     */
-    convertTimeToMicroseconds(timeSeconds) {
-        const timeUs = new Float32Array(timeSeconds.length);
-        
-        // Normalize to start from 0 and convert to microseconds
-        const startTime = timeSeconds[0] || 0;
-        
-        for (let i = 0; i < timeSeconds.length; i++) {
-            timeUs[i] = (timeSeconds[i] - startTime) * 1_000_000; // Convert to microseconds
-        }
-        
-        return timeUs;
-    }
-
     /**
      * Main file reading method
      * @returns {Promise<void>}
@@ -343,63 +328,26 @@ class AccelerationCsvReader {
                 }
             }
 
-            // Read entire file
-            const fileReadStart = process.hrtime.bigint();
-            const fileContent = await fs.readFile(this.filename, 'utf8');
-            const fileReadTime = Number(process.hrtime.bigint() - fileReadStart) / 1e9;
-            
-            console.log(`File loaded: ${(fileContent.length / 1024).toFixed(1)} KB in ${fileReadTime.toFixed(2)}s`);
-            
-            // Parse CSV with Papa Parse - AUTO-DETECT DELIMITER
+            // Parse into typed columns: native ingester (mapped file, SIMD
+            // field scan, chunks parsed in parallel) when built, Papa Parse
+            // otherwise. Headers and format come from the prefix rows only.
             const parseStart = process.hrtime.bigint();
-            
-            // First, try to detect the delimiter
-            let delimiter = ','; // Default to comma
-            const sampleLines = fileContent.split('\n').slice(0, 20);
-            
-            // Count delimiters in sample lines to detect format
-            let commaCount = 0;
-            let tabCount = 0;
-            let semicolonCount = 0;
-            
-            for (const line of sampleLines) {
-                if (line.includes('\t')) tabCount++;
-                if (line.includes(',')) commaCount++;
-                if (line.includes(';')) semicolonCount++;
-            }
-            
-            console.log(`Delimiter detection: commas=${commaCount}, tabs=${tabCount}, semicolons=${semicolonCount}`);
-            
-            // Choose the most common delimiter
-            if (tabCount > commaCount && tabCount > semicolonCount) {
-                delimiter = '\t';
-                console.log('Using tab delimiter');
-            } else if (semicolonCount > commaCount && semicolonCount > tabCount) {
-                delimiter = ';';
-                console.log('Using semicolon delimiter');
-            } else {
-                console.log('Using comma delimiter');
-            }
-            
-            const parseResult = Papa.parse(fileContent, {
-                header: false, // DON'T use first line as header - let us find the real headers
-                skipEmptyLines: true,
-                delimiter: delimiter, // Use detected delimiter
-                dynamicTyping: false, // We'll handle number parsing manually
-                comments: '#' // Skip comment lines
-            });
-            
-            if (parseResult.errors.length > 0) {
-                console.warn('CSV parsing warnings:', parseResult.errors.slice(0, 5)); // Show first 5 errors only
-            }
-            
+            const csv = await CsvIngest.parseFile(this.filename, {
+                delimiter: 'auto', // tab, semicolon or comma from the first 20 lines
+                comment: '#', // Skip comment lines
+                types: ['number', 'number', 'number', 'number'],
+                prefixRows: 200 // device header and column header rows
+            }, (progress) => this._updatePreview(progress));
+            const previewFormat = this.preview ? this.preview.formatInfo : null;
+            this.preview = null;
             const parseTime = Number(process.hrtime.bigint() - parseStart) / 1e9;
-            const rawData = parseResult.data;
-            
-            console.log(`CSV parsed: ${rawData.length} rows, ${rawData[0]?.length || 0} columns in ${parseTime.toFixed(2)}s`);
-            
-            // Convert array format to object format for easier processing
-            const processedData = rawData.map((row, index) => {
+            this.processingStats.parser = csv.parser;
+            this.processingStats.parseChunks = csv.stats.chunks;
+
+            console.log(`CSV parsed (${csv.parser}, ${csv.stats.chunks} chunks): ${csv.rows} rows, delimiter ${JSON.stringify(csv.delimiter)} in ${parseTime.toFixed(2)}s`);
+
+            // Leading rows in the col_N form the format heuristics work on
+            const prefixData = csv.prefixRows.map(row => {
                 const obj = {};
                 row.forEach((value, colIndex) => {
                     obj[`col_${colIndex}`] = value;
@@ -407,15 +355,16 @@ class AccelerationCsvReader {
                 return obj;
             });
             
-            console.log(`Sample rows after processing:`, processedData.slice(0, 3));
+            console.log(`Sample rows after processing:`, prefixData.slice(0, 3));
             
-            // Detect format using the processed data
-            const formatInfo = this.detectCsvFormat(null, processedData.slice(0, 100)); // Check more rows for format detection
+            // Detect format using the leading rows (already done for the preview
+            // when the native parser reported progress)
+            const formatInfo = previewFormat || this.detectCsvFormat(null, prefixData.slice(0, 100)); // Check more rows for format detection
             
             // Process data
             console.log('Processing acceleration data...');
             const dataProcessStart = process.hrtime.bigint();
-            await this.processAccelerationData(processedData, null); // No headers since we're parsing manually
+            await this.processAccelerationData(csv, prefixData);
             const dataProcessTime = Number(process.hrtime.bigint() - dataProcessStart) / 1e9;
             
             // Store comprehensive metadata
@@ -427,8 +376,8 @@ class AccelerationCsvReader {
                 processedAt: new Date(),
                 
                 // CSV-specific metadata
-                rowCount: processedData.length,
-                columnCount: processedData[0]?.length || 0,
+                rowCount: csv.rows,
+                columnCount: this.detectedFormat.columnCount,
                 headers: [], // No predefined headers
                 formatInfo: formatInfo,
                 channelMapping: this.channelMapping,
@@ -437,7 +386,6 @@ class AccelerationCsvReader {
                 // Processing statistics
                 processingStats: {
                     ...this.processingStats,
-                    fileReadTime,
                     parseTime,
                     dataProcessTime,
                     totalProcessingTime: Number(process.hrtime.bigint() - overallStartTime) / 1e9
@@ -445,7 +393,6 @@ class AccelerationCsvReader {
             };
             
             console.log(`Acceleration data processing completed:`);
-            console.log(`- File read: ${fileReadTime.toFixed(2)}s`);
             console.log(`- CSV parse: ${parseTime.toFixed(2)}s`);
             console.log(`- Data process: ${dataProcessTime.toFixed(2)}s`);
             console.log(`- Total: ${this.metadata.processingStats.totalProcessingTime.toFixed(2)}s`);
@@ -459,60 +406,49 @@ class AccelerationCsvReader {
     }
 
     /**
-     * Process acceleration data from parsed CSV
-     * @param {Array} rawData - Parsed CSV data rows
-     * @param {Array} headers - CSV column headers
+     * Process acceleration data from the parsed columns
+     * @param {Object} csv - CsvIngest result (columns 0-3 as numbers)
+     * @param {Object[]} prefixData - Leading rows in col_N form
      */
-    async processAccelerationData(rawData, headers) {
-        if (rawData.length === 0) {
+    async processAccelerationData(csv, prefixData) {
+        if (csv.rows === 0) {
             throw new Error('No data rows found in CSV file');
         }
         
-        // Filter out header/metadata rows if they exist in data
-        const filteredData = this._filterMetadataRows(rawData);
-        console.log(`Filtered data: ${rawData.length} -> ${filteredData.length} rows`);
+        // Skip device information and column headers, keep complete rows
+        const dataStart = this._findDataStart(prefixData);
+        const timeOffset = this.detectedFormat.hasTimeColumn ? 1 : 0;
+        const columns = csv.columns.map(column => column.values);
+        const rows = this._selectDataRows(columns, dataStart, csv.rows, 3 + timeOffset);
+        const rowCount = rows.length;
+        console.log(`Filtered data: ${csv.rows} -> ${rowCount} rows`);
         
-        // Extract time data (if present)
-        let timeData = null;
+        // Time axis: from the time column (seconds) or synthetic
+        let finalTime;
         let samplingIntervalUs = 100; // Default 100µs (10 kHz)
         
         if (this.detectedFormat.hasTimeColumn) {
-            timeData = this._extractTimeData(filteredData);
-            if (timeData && timeData.length > 1) {
+            finalTime = this._gatherTimeMicroseconds(columns[0], rows);
+            if (rowCount > 1) {
                 // Calculate actual sampling interval from time data
-                const avgInterval = (timeData[timeData.length - 1] - timeData[0]) / (timeData.length - 1);
+                const avgInterval = (finalTime[rowCount - 1] - finalTime[0]) / (rowCount - 1);
                 samplingIntervalUs = avgInterval; // Already in microseconds
                 console.log(`Calculated sampling interval from time data: ${samplingIntervalUs.toFixed(1)}µs`);
             }
         } else {
             // Generate synthetic time array
-            timeData = this.generateSyntheticTime(filteredData.length, samplingIntervalUs);
-            console.log(`Generated synthetic time array for ${filteredData.length} samples at ${samplingIntervalUs}µs intervals`);
+            finalTime = this.generateSyntheticTime(rowCount, samplingIntervalUs);
+            console.log(`Generated synthetic time array for ${rowCount} samples at ${samplingIntervalUs}µs intervals`);
         }
         
         // Calculate sampling rate
         const samplingRate = 1_000_000 / samplingIntervalUs; // Hz
         this.detectedFormat.samplingRate = samplingRate;
         
-        // Extract acceleration data for each axis
-        const axesData = this._extractAccelerationAxes(filteredData);
-        
-        // Validate data consistency
-        const minLength = Math.min(timeData.length, axesData.x.length, axesData.y.length, axesData.z.length);
-        console.log(`Data length consistency check: time=${timeData.length}, x=${axesData.x.length}, y=${axesData.y.length}, z=${axesData.z.length} -> using ${minLength}`);
-        
-        // Create final typed arrays with consistent length
-        const finalTime = new Float32Array(minLength);
-        const finalX = new Float32Array(minLength);
-        const finalY = new Float32Array(minLength);
-        const finalZ = new Float32Array(minLength);
-        
-        for (let i = 0; i < minLength; i++) {
-            finalTime[i] = timeData[i];
-            finalX[i] = axesData.x[i] || 0;
-            finalY[i] = axesData.y[i] || 0;
-            finalZ[i] = axesData.z[i] || 0;
-        }
+        // Acceleration data for each axis
+        const finalX = this._gatherAxis(columns[timeOffset + 0], rows);
+        const finalY = this._gatherAxis(columns[timeOffset + 1], rows);
+        const finalZ = this._gatherAxis(columns[timeOffset + 2], rows);
         
         // Store acceleration data for each channel
         this.accelerationData['acc_x'] = {
@@ -522,7 +458,7 @@ class AccelerationCsvReader {
             unit: 'm/s²',
             originalHeader: this.channelMapping['acc_x'].originalHeader,
             columnIndex: this.channelMapping['acc_x'].columnIndex,
-            points: minLength,
+            points: rowCount,
             samplingRate: samplingRate,
             channelId: 'acc_x',
             axis: 'X'
@@ -535,7 +471,7 @@ class AccelerationCsvReader {
             unit: 'm/s²',
             originalHeader: this.channelMapping['acc_y'].originalHeader,
             columnIndex: this.channelMapping['acc_y'].columnIndex,
-            points: minLength,
+            points: rowCount,
             samplingRate: samplingRate,
             channelId: 'acc_y',
             axis: 'Y'
@@ -548,17 +484,17 @@ class AccelerationCsvReader {
             unit: 'm/s²',
             originalHeader: this.channelMapping['acc_z'].originalHeader,
             columnIndex: this.channelMapping['acc_z'].columnIndex,
-            points: minLength,
+            points: rowCount,
             samplingRate: samplingRate,
             channelId: 'acc_z',
             axis: 'Z'
         };
         
-        console.log(`Acceleration data processed: ${minLength} points at ${samplingRate.toFixed(1)} Hz`);
-        console.log(`Time range: ${finalTime[0].toFixed(2)} to ${finalTime[finalTime.length - 1].toFixed(2)} µs`);
+        console.log(`Acceleration data processed: ${rowCount} points at ${samplingRate.toFixed(1)} Hz`);
         
         // Log sample values for verification
-        if (minLength > 0) {
+        if (rowCount > 0) {
+            console.log(`Time range: ${finalTime[0].toFixed(2)} to ${finalTime[rowCount - 1].toFixed(2)} µs`);
             console.log(`Sample values at start: X=${finalX[0].toFixed(3)}, Y=${finalY[0].toFixed(3)}, Z=${finalZ[0].toFixed(3)}`);
         } else {
             console.warn('No data points processed - all arrays are empty');
@@ -571,50 +507,30 @@ class AccelerationCsvReader {
     }
 
     /**
-     * Filter out metadata/header rows that might be mixed with data
-     * Now works with col_0, col_1, col_2 format
+     * First data row: the row after the column headers ("Time ...") or the
+     * first numeric row with a non-negative first value. Rows past the
+     * leading rows are left to the validity filter.
      * @private
      */
-    _filterMetadataRows(rawData) {
-        console.log(`Filtering metadata rows from ${rawData.length} total rows...`);
-        
-        let actualDataRows = [];
-        let foundDataStart = false;
-        
-        for (let i = 0; i < rawData.length; i++) {
-            const row = rawData[i];
-            const col0 = row.col_0 ? row.col_0.toString().trim() : '';
-            const col1 = row.col_1 ? row.col_1.toString().trim() : '';
-            const col2 = row.col_2 ? row.col_2.toString().trim() : '';
+    _findDataStart(prefixData) {
+        for (let i = 0; i < prefixData.length; i++) {
+            const row = prefixData[i];
+            const col0 = row.col_0 || '';
+            const col1 = row.col_1 || '';
+            const col2 = row.col_2 || '';
             
-            // Skip device information headers and similar
-            if (!foundDataStart) {
-                // Look for the actual time/data header or first numeric row
-                if (col0.toLowerCase().includes('time') || 
-                    (!isNaN(parseFloat(col0)) && parseFloat(col0) >= 0 && col1 && col2)) {
-                    foundDataStart = true;
-                    
-                    // If this row has "Time" header, skip it and start from next row
-                    if (col0.toLowerCase().includes('time')) {
-                        console.log(`Found column headers at row ${i}: "${col0}, ${col1}, ${col2}", starting data from next row`);
-                        continue;
-                    }
-                    // If this is already a numeric row, include it
-                    console.log(`Found data start at row ${i}: "${col0}, ${col1}, ${col2}"`);
-                }
+            // If this row has "Time" header, skip it and start from next row
+            if (col0.toLowerCase().includes('time')) {
+                console.log(`Found column headers at row ${i}: "${col0}, ${col1}, ${col2}", starting data from next row`);
+                return i + 1;
             }
-            
-            if (foundDataStart) {
-                // Only include rows that have numeric data in all 3 columns (or 4 with time)
-                if (this._hasValidAccelerationData(row)) {
-                    actualDataRows.push(row);
-                }
+            // If this is already a numeric row, include it
+            if (!isNaN(parseFloat(col0)) && parseFloat(col0) >= 0 && col1 && col2) {
+                console.log(`Found data start at row ${i}: "${col0}, ${col1}, ${col2}"`);
+                return i;
             }
         }
-        
-        console.log(`Filtered: ${rawData.length} -> ${actualDataRows.length} data rows`);
-        
-        return actualDataRows;
+        return prefixData.length;
     }
 
     /**
@@ -626,89 +542,149 @@ class AccelerationCsvReader {
         const col1 = row.col_1 ? row.col_1.toString().trim() : '';
         const col2 = row.col_2 ? row.col_2.toString().trim() : '';
         const col3 = row.col_3 ? row.col_3.toString().trim() : '';
-        
+
         // Check for 4-column format (Time, X, Y, Z)
         const col0Num = parseFloat(col0);
         const col1Num = parseFloat(col1);
         const col2Num = parseFloat(col2);
         const col3Num = parseFloat(col3);
-        
+
         if (!isNaN(col0Num) && !isNaN(col1Num) && !isNaN(col2Num) && !isNaN(col3Num)) {
             return true; // 4-column format
         }
-        
+
         // Check for 3-column format (X, Y, Z)
         if (!isNaN(col0Num) && !isNaN(col1Num) && !isNaN(col2Num)) {
             return true; // 3-column format
         }
-        
+
         return false;
     }
 
     /**
-     * Extract time data from CSV rows
-     * Updated for col_0, col_1, col_2 format
+     * Indices of the rows from dataStart whose first columnCount columns
+     * all hold numbers
      * @private
      */
-    _extractTimeData(filteredData) {
-        const timeValues = [];
-        
-        for (const row of filteredData) {
-            const timeValue = this.parseNumber(row.col_0); // First column should be time
-            
-            if (!isNaN(timeValue)) {
-                timeValues.push(timeValue);
+    _selectDataRows(columns, dataStart, rowCount, columnCount) {
+        const rows = new Uint32Array(Math.max(0, rowCount - dataStart));
+        let count = 0;
+        
+        for (let r = dataStart; r < rowCount; r++) {
+            let valid = true;
+            for (let c = 0; c < columnCount && valid; c++) {
+                valid = !isNaN(columns[c][r]);
             }
+            if (valid) rows[count++] = r;
         }
         
-        // Convert from seconds to microseconds
-        return this.convertTimeToMicroseconds(timeValues);
+        return rows.subarray(0, count);
     }
 
     /**
-     * Extract acceleration data for all three axes
-     * Updated to work with col_0, col_1, col_2 format
+     * Time column of the selected rows, seconds to microseconds from the first
      * @private
      */
-    _extractAccelerationAxes(filteredData) {
-        const xValues = [];
-        const yValues = [];
-        const zValues = [];
+    _gatherTimeMicroseconds(timeSeconds, rows) {
+        const timeUs = new Float32Array(rows.length);
+        const startTime = rows.length > 0 ? timeSeconds[rows[0]] : 0;
         
-        const timeOffset = this.detectedFormat.hasTimeColumn ? 1 : 0;
+        for (let i = 0; i < rows.length; i++) {
+            timeUs[i] = (timeSeconds[rows[i]] - startTime) * 1_000_000; // Convert to microseconds
+        }
         
-        for (const row of filteredData) {
-            let x, y, z;
-            
-            if (timeOffset === 1) {
-                // 4-column format: Time, X, Y, Z
-                x = this.parseNumber(row.col_1);
-                y = this.parseNumber(row.col_2);
-                z = this.parseNumber(row.col_3);
-            } else {
-                // 3-column format: X, Y, Z
-                x = this.parseNumber(row.col_0);
-                y = this.parseNumber(row.col_1);
-                z = this.parseNumber(row.col_2);
+        return timeUs;
+    }
+
+    /**
+     * One axis column of the selected rows
+     * @private
+     */
+    _gatherAxis(values, rows) {
+        const axis = new Float32Array(rows.length);
+        for (let i = 0; i < rows.length; i++) {
+            axis[i] = values[rows[i]];
+        }
+        return axis;
+    }
+
+    /**
+     * Turn a parse progress report into the preview: per channel the min/max
+     * envelope of every rowsPerBucket rows, on the time axis of the data
+     * (µs from the first sample, synthetic at 100µs without a time column)
+     * @param {Object} progress - CsvIngest progress report
+     * @private
+     */
+    _updatePreview(progress) {
+        const { overview } = progress;
+        if (!this.preview) {
+            const prefixData = progress.prefixRows.map(row => {
+                const obj = {};
+                row.forEach((value, colIndex) => {
+                    obj[`col_${colIndex}`] = value;
+                });
+                return obj;
+            });
+            this.preview = {
+                formatInfo: this.detectCsvFormat(null, prefixData.slice(0, 100)),
+                dataStart: this._findDataStart(prefixData)
+            };
+        }
+
+        const hasTimeColumn = this.detectedFormat.hasTimeColumn;
+        const timeOffset = hasTimeColumn ? 1 : 0;
+        const buckets = overview.columns[timeOffset] ? overview.columns[timeOffset].min.length : 0;
+        const time = new Float64Array(buckets);
+        if (hasTimeColumn) {
+            const firstTime = overview.columns[0].min.find(t => !isNaN(t)) || 0;
+            for (let b = 0; b < buckets; b++) {
+                time[b] = (overview.columns[0].min[b] - firstTime) * 1_000_000;
             }
-            
-            // Only include rows where all three axes have valid data
-            if (!isNaN(x) && !isNaN(y) && !isNaN(z)) {
-                xValues.push(x);
-                yValues.push(y);
-                zValues.push(z);
+        } else {
+            for (let b = 0; b < buckets; b++) {
+                time[b] = Math.max(0, b * overview.rowsPerBucket - this.preview.dataStart) * 100;
             }
         }
-        
-        return {
-            x: xValues,
-            y: yValues,
-            z: zValues
-        };
+
+        const channels = {};
+        ['acc_x', 'acc_y', 'acc_z'].forEach((channelId, axis) => {
+            const column = overview.columns[timeOffset + axis];
+            if (column) channels[channelId] = { min: column.min, max: column.max };
+        });
+
+        Object.assign(this.preview, {
+            rows: progress.rows,
+            bytesParsed: progress.bytesParsed,
+            fileSize: progress.fileSize,
+            rowsPerBucket: overview.rowsPerBucket,
+            time,
+            channels
+        });
     }
 
     // === PUBLIC DATA ACCESS METHODS ===
 
+
+    /**
+     * Overview of the rows parsed so far, or null when no parse is running
+     * or the JS parser is in use
+     * @returns {Object|null} { rows, bytesParsed, fileSize, progress, rowsPerBucket, time, channels }
+     */
+    getPreview() {
+        if (!this.preview || !this.preview.time) return null;
+
+        const { rows, bytesParsed, fileSize, rowsPerBucket, time, channels } = this.preview;
+        return {
+            rows,
+            bytesParsed,
+            fileSize,
+            progress: fileSize > 0 ? bytesParsed / fileSize : 0,
+            rowsPerBucket,
+            time,
+            channels
+        };
+    }
+
     getMetadata() {
         return {
             ...this.metadata,
@@ -5,6 +5,8 @@
  * Optimized for 10kHz+ sampling rates with intelligent downsampling
  */
 
+const Downsampler = require('./Downsampler');
+
 class AccelerationDataProcessor {
     constructor(accelerationData, metadata) {
         this.accelerationData = accelerationData;
@@ -101,17 +103,7 @@ class AccelerationDataProcessor {
      * @private
      */
     _simpleDecimation(channelData, startIdx, endIdx, maxPoints) {
-        const totalPoints = endIdx - startIdx + 1;
-        const step = Math.ceil(totalPoints / maxPoints);
-        const resampledTime = [];
-        const resampledValues = [];
-        
-        for (let i = startIdx; i <= endIdx; i += step) {
-            resampledTime.push(channelData.time[i]);
-            resampledValues.push(channelData.values[i]);
-        }
-        
-        return { time: resampledTime, values: resampledValues };
+        return Downsampler.decimate(channelData, startIdx, endIdx - startIdx + 1, maxPoints);
     }
 
     /**
@@ -120,50 +112,7 @@ class AccelerationDataProcessor {
      * @private
      */
     _minMaxResample(channelData, startIdx, endIdx, maxPoints) {
-        const totalPoints = endIdx - startIdx + 1;
-        const bucketSize = Math.ceil(totalPoints / (maxPoints / 2)); // Use half points for min-max pairs
-        
-        const resampledTime = [];
-        const resampledValues = [];
-        
-        for (let bucketStart = startIdx; bucketStart < endIdx; bucketStart += bucketSize) {
-            const bucketEnd = Math.min(bucketStart + bucketSize - 1, endIdx);
-            
-            // Find min and max in this bucket
-            let minVal = channelData.values[bucketStart];
-            let maxVal = channelData.values[bucketStart];
-            let minIdx = bucketStart;
-            let maxIdx = bucketStart;
-            
-            for (let i = bucketStart + 1; i <= bucketEnd; i++) {
-                const val = channelData.values[i];
-                if (val < minVal) {
-                    minVal = val;
-                    minIdx = i;
-                }
-                if (val > maxVal) {
-                    maxVal = val;
-                    maxIdx = i;
-                }
-            }
-            
-            // Add min and max points (in chronological order)
-            if (minIdx <= maxIdx) {
-                if (minIdx !== maxIdx) {
-                    resampledTime.push(channelData.time[minIdx]);
-                    resampledValues.push(minVal);
-                }
-                resampledTime.push(channelData.time[maxIdx]);
-                resampledValues.push(maxVal);
-            } else {
-                resampledTime.push(channelData.time[maxIdx]);
-                resampledValues.push(maxVal);
-                resampledTime.push(channelData.time[minIdx]);
-                resampledValues.push(minVal);
-            }
-        }
-        
-        return { time: resampledTime, values: resampledValues };
+        return Downsampler.minMax(channelData, startIdx, endIdx - startIdx + 1, maxPoints);
     }
 
     /**
@@ -172,37 +121,7 @@ class AccelerationDataProcessor {
      * @private
      */
     _rmsResample(channelData, startIdx, endIdx, maxPoints) {
-        const totalPoints = endIdx - startIdx + 1;
-        const bucketSize = Math.ceil(totalPoints / maxPoints);
-        
-        const resampledTime = [];
-        const resampledValues = [];
-        
-        for (let bucketStart = startIdx; bucketStart < endIdx; bucketStart += bucketSize) {
-            const bucketEnd = Math.min(bucketStart + bucketSize - 1, endIdx);
-            
-            // Calculate RMS value for this bucket
-            let sumSquares = 0;
-            let count = 0;
-            let timeSum = 0;
-            
-            for (let i = bucketStart; i <= bucketEnd; i++) {
-                const val = channelData.values[i];
-                sumSquares += val * val;
-                timeSum += channelData.time[i];
-                count++;
-            }
-            
-            if (count > 0) {
-                const rmsValue = Math.sqrt(sumSquares / count);
-                const avgTime = timeSum / count;
-                
-                resampledTime.push(avgTime);
-                resampledValues.push(rmsValue);
-            }
-        }
-        
-        return { time: resampledTime, values: resampledValues };
+        return Downsampler.rms(channelData, startIdx, endIdx - startIdx + 1, maxPoints);
     }
 
     /**
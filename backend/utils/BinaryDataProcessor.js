@@ -4,6 +4,9 @@
  * Supports both raw channels (0-7) and calculated engineering channels (calc_0-6)
  */
 
+const BinaryReader = require('./BinaryReader');
+const Downsampler = require('./Downsampler');
+
 class BinaryDataProcessor {
     constructor(rawData, calculatedData, metadata) {
         this.rawData = rawData;
@@ -52,18 +55,27 @@ class BinaryDataProcessor {
             startTime = validatedRange.startTime;
             endTime = validatedRange.endTime;
 
+            if (channelData.points === 0) {
+                return { time: [], values: [] };
+            }
+
             // Find indices for time range
-            const startIdx = this.findTimeIndex(channelData.time, startTime);
-            const endIdx = this.findTimeIndex(channelData.time, endTime);
+            const startIdx = this.findTimeIndex(channelData, startTime);
+            const endIdx = this.findTimeIndex(channelData, endTime);
             
             const totalPoints = endIdx - startIdx + 1;
+            maxPoints = Math.max(2, Math.floor(maxPoints) || 0);
             
             let result;
             
             if (totalPoints <= maxPoints) {
                 // Return raw data if within limits
+                const time = new Array(totalPoints);
+                for (let i = 0; i < totalPoints; i++) {
+                    time[i] = this._timeAt(channelData, startIdx + i);
+                }
                 result = {
-                    time: Array.from(channelData.time.slice(startIdx, endIdx + 1)),
+                    time,
                     values: Array.from(channelData.values.slice(startIdx, endIdx + 1))
                 };
             } else {
@@ -85,77 +97,19 @@ class BinaryDataProcessor {
     }
 
     /**
-     * Smart resampling with spike preservation
+     * Envelope resampling: the minimum and maximum of each of maxPoints / 2
+     * buckets, in sample order, so spikes survive at any zoom level. Served
+     * from the channel's native min/max pyramid in O(maxPoints) when the
+     * native parser built one, otherwise by the shared envelope kernel.
      * @private
      */
     _performSmartResampling(channelData, startIdx, endIdx, maxPoints) {
-        const totalPoints = endIdx - startIdx + 1;
-        const step = Math.floor(totalPoints / maxPoints);
-        
-        const resampledTime = [];
-        const resampledValues = [];
-        
-        // Use MinMax-LTTB algorithm for better spike preservation
-        for (let i = startIdx; i <= endIdx; i += step) {
-            const bucketEnd = Math.min(i + step, endIdx + 1);
-            
-            // Find min, max, and calculate average in bucket
-            let min = channelData.values[i];
-            let max = channelData.values[i];
-            let sum = 0;
-            let count = 0;
-            let minIndex = i;
-            let maxIndex = i;
-            
-            for (let j = i; j < bucketEnd; j++) {
-                const val = channelData.values[j];
-                if (val < min) {
-                    min = val;
-                    minIndex = j;
-                }
-                if (val > max) {
-                    max = val;
-                    maxIndex = j;
-                }
-                sum += val;
-                count++;
-            }
-            
-            if (count === 0) continue;
-            
-            const avg = sum / count;
-            const range = max - min;
-            const avgAbs = Math.abs(avg);
-            
-            // Determine if we need to preserve spikes
-            if (range > avgAbs * 0.1 && count > 2) {
-                // Significant variation - include min, max, and representative points
-                if (minIndex !== maxIndex) {
-                    // Add min point
-                    resampledTime.push(channelData.time[minIndex]);
-                    resampledValues.push(min);
-                    
-                    // Add max point
-                    resampledTime.push(channelData.time[maxIndex]);
-                    resampledValues.push(max);
-                    
-                    // Add average point at bucket center
-                    const centerIdx = Math.floor((i + bucketEnd - 1) / 2);
-                    resampledTime.push(channelData.time[centerIdx]);
-                    resampledValues.push(avg);
-                } else {
-                    // Min and max at same point
-                    resampledTime.push(channelData.time[i]);
-                    resampledValues.push(avg);
-                }
-            } else {
-                // Small variation - just use average
-                resampledTime.push(channelData.time[i]);
-                resampledValues.push(avg);
-            }
-        }
-        
-        return { time: resampledTime, values: resampledValues };
+        const count = endIdx - startIdx + 1;
+        const buckets = Math.max(1, Math.floor(maxPoints / 2));
+
+        const envelope = BinaryReader.pyramidEnvelope(channelData, startIdx, count, buckets) ||
+            Downsampler.envelope(channelData.values, startIdx, count, buckets);
+        return Downsampler.envelopePoints(channelData, envelope);
     }
 
     /**
@@ -174,25 +128,24 @@ class BinaryDataProcessor {
     }
     
     /**
-     * Binary search for time index
-     * @param {Float32Array} timeArray - Time array
+     * Index of the first sample at or after targetTime, clamped to the
+     * channel. Computed from the implicit time axis in O(1).
+     * @param {Object} channelData - Channel with timeStart, timeStep, points
      * @param {number} targetTime - Target time
      * @returns {number} Index
      */
-    findTimeIndex(timeArray, targetTime) {
-        let left = 0;
-        let right = timeArray.length - 1;
-        
-        while (left <= right) {
-            const mid = Math.floor((left + right) / 2);
-            if (timeArray[mid] < targetTime) {
-                left = mid + 1;
-            } else {
-                right = mid - 1;
-            }
-        }
-        
-        return Math.max(0, Math.min(timeArray.length - 1, left));
+    findTimeIndex(channelData, targetTime) {
+        // Tolerance so a time computed from an index maps back to it
+        const index = Math.ceil((targetTime - channelData.timeStart) / channelData.timeStep - 1e-9);
+        return Math.max(0, Math.min(channelData.points - 1, index));
+    }
+
+    /**
+     * Time of sample index of a channel
+     * @private
+     */
+    _timeAt(channelData, index) {
+        return channelData.timeStart + index * channelData.timeStep;
     }
 
     /**
@@ -245,6 +198,12 @@ class BinaryDataProcessor {
      */
     _calculateChannelRange(channelData) {
         const values = channelData.values;
+
+        // The top pyramid level holds the extremes of the whole channel
+        const pyramid = channelData.pyramid;
+        if (pyramid && pyramid.min.length > 0 && pyramid.min[pyramid.min.length - 1] <= pyramid.max[pyramid.max.length - 1]) {
+            return this._paddedRange(channelData, pyramid.min[pyramid.min.length - 1], pyramid.max[pyramid.max.length - 1]);
+        }
         
         // Use efficient min/max calculation
         let min = values[0];
@@ -256,6 +215,14 @@ class BinaryDataProcessor {
             if (val > max) max = val;
         }
         
+        return this._paddedRange(channelData, min, max);
+    }
+
+    /**
+     * Axis range around [min, max] with padding
+     * @private
+     */
+    _paddedRange(channelData, min, max) {
         // Add padding (5%) for better visualization
         const range = max - min;
         const padding = Math.max(range * 0.05, Math.abs(max) * 0.01);
@@ -302,7 +269,7 @@ class BinaryDataProcessor {
                 label: ch.label,
                 unit: ch.unit,
                 points: ch.points,
-                duration: ch.time[ch.time.length - 1],
+                duration: this._channelDuration(ch),
                 samplingRate: ch.samplingRate || (1e9 / (this.metadata.samplingInterval * ch.downsampling)),
                 downsampling: ch.downsampling,
                 type: 'raw'
@@ -324,7 +291,7 @@ class BinaryDataProcessor {
                 label: ch.label,
                 unit: ch.unit,
                 points: ch.points,
-                duration: ch.time[ch.time.length - 1],
+                duration: this._channelDuration(ch),
                 samplingRate: ch.samplingRate,
                 downsampling: ch.downsampling,
                 sourceChannels: ch.sourceChannels,
@@ -339,6 +306,14 @@ class BinaryDataProcessor {
         return summary;
     }
 
+    /**
+     * Time of the last sample of a channel
+     * @private
+     */
+    _channelDuration(channelData) {
+        return this._timeAt(channelData, Math.max(0, channelData.points - 1));
+    }
+
     /**
      * Get time range for all channels (cached)
      * @returns {Object} {min: number, max: number}
@@ -358,19 +333,19 @@ class BinaryDataProcessor {
         // Check raw channels
         for (let i = 0; i < 8; i++) {
             const ch = this.rawData[`channel_${i}`];
-            if (!ch || ch.time.length === 0) continue;
+            if (!ch || ch.points === 0) continue;
             
-            minTime = Math.min(minTime, ch.time[0]);
-            maxTime = Math.max(maxTime, ch.time[ch.time.length - 1]);
+            minTime = Math.min(minTime, ch.timeStart);
+            maxTime = Math.max(maxTime, this._channelDuration(ch));
         }
         
         // Check calculated channels
         for (let i = 0; i < 7; i++) {
             const ch = this.calculatedData[`calc_${i}`];
-            if (!ch || ch.time.length === 0) continue;
+            if (!ch || ch.points === 0) continue;
             
-            minTime = Math.min(minTime, ch.time[0]);
-            maxTime = Math.max(maxTime, ch.time[ch.time.length - 1]);
+            minTime = Math.min(minTime, ch.timeStart);
+            maxTime = Math.max(maxTime, this._channelDuration(ch));
         }
         
         // Fallback to reasonable defaults
@@ -532,25 +507,7 @@ class BinaryDataProcessor {
             }
 
             const data = this.getResampledData(channelId, startTime, endTime, maxPoints);
-            
-            return {
-                success: true,
-                channelId: channelId,
-                data: {
-                    time: data.time,
-                    values: data.values
-                },
-                metadata: {
-                    label: channelData.label,
-                    unit: channelData.unit,
-                    type: channelId.startsWith('calc_') ? 'calculated' : 'raw',
-                    actualPoints: data.time.length,
-                    requestedRange: { startTime, endTime },
-                    maxPointsRequested: maxPoints,
-                    sourceChannels: channelData.sourceChannels || null,
-                    samplingRate: channelData.samplingRate
-                }
-            };
+            return this._formatChannelData(channelId, channelData, data, startTime, endTime, maxPoints);
 
         } catch (error) {
             return {
@@ -560,6 +517,31 @@ class BinaryDataProcessor {
         }
     }
 
+    /**
+     * API response for resampled channel data
+     * @private
+     */
+    _formatChannelData(channelId, channelData, data, startTime, endTime, maxPoints) {
+        return {
+            success: true,
+            channelId: channelId,
+            data: {
+                time: data.time,
+                values: data.values
+            },
+            metadata: {
+                label: channelData.label,
+                unit: channelData.unit,
+                type: channelId.startsWith('calc_') ? 'calculated' : 'raw',
+                actualPoints: data.time.length,
+                requestedRange: { startTime, endTime },
+                maxPointsRequested: maxPoints,
+                sourceChannels: channelData.sourceChannels || null,
+                samplingRate: channelData.samplingRate
+            }
+        };
+    }
+
     /**
      * Get multiple channels data efficiently for API
      * @param {Array<string>} channelIds - Channel IDs
@@ -590,6 +572,14 @@ class BinaryDataProcessor {
             }
         }
 
+        return this._formatBulkChannelData(channelIds, results, errors, startTime, endTime, maxPoints);
+    }
+
+    /**
+     * API response for several channels' results
+     * @private
+     */
+    _formatBulkChannelData(channelIds, results, errors, startTime, endTime, maxPoints) {
         return {
             success: true,
             requestedChannels: channelIds.length,
@@ -638,7 +628,14 @@ class BinaryDataProcessor {
         const channelData = this.getChannelById(channelId);
         if (!channelData) return null;
         
-        const values = channelData.values;
+        return this._calculateStatistics(channelData, channelData.values);
+    }
+
+    /**
+     * Statistics over a set of channel values
+     * @private
+     */
+    _calculateStatistics(channelData, values) {
         const n = values.length;
         
         if (n === 0) return null;
@@ -8,6 +8,51 @@ const fs = require('fs').promises;
 const path = require('path');
 const { convertAdcToPhysical } = require('./utils');
 
+/**
+ * Load the native .bin parser if it has been built
+ * @returns {Object|null} Native module, or null to use the JS parser
+ */
+function loadNativeBinaryParser() {
+    const possiblePaths = [
+        '../native/binary/build/Release/binary_native.node',
+        './native/binary/build/Release/binary_native.node',
+        path.join(__dirname, '../native/binary/build/Release/binary_native.node')
+    ];
+
+    for (const modulePath of possiblePaths) {
+        try {
+            const nativeModule = require(modulePath);
+            console.log(`Loaded native binary parser from: ${modulePath} (SIMD: ${nativeModule.simd})`);
+            return nativeModule;
+        } catch (e) {
+            // Continue to next path
+        }
+    }
+
+    console.log('Native binary parser not available, using JS parser (run "npm run build-binary")');
+    return null;
+}
+
+let nativeBinaryParser;
+
+function getNativeBinaryParser() {
+    if (nativeBinaryParser === undefined) {
+        nativeBinaryParser = loadNativeBinaryParser();
+    }
+    return nativeBinaryParser;
+}
+
+// Calculated engineering channels and the raw channels they derive from
+const CALC_CHANNEL_DEFS = {
+    0: { label: 'UL3L1*', unit: 'V', sourceChannels: [0, 1] },
+    1: { label: 'IL2GR1*', unit: 'V', sourceChannels: [2, 3] },
+    2: { label: 'IL2GR2*', unit: 'V', sourceChannels: [4, 5] },
+    3: { label: 'I_DC_GR1*', unit: 'A', sourceChannels: [2, 3] },
+    4: { label: 'I_DC_GR2*', unit: 'A', sourceChannels: [4, 5] },
+    5: { label: 'U_DC*', unit: 'V', sourceChannels: [0, 1] },
+    6: { label: 'F_Schlitten*', unit: 'kN', sourceChannels: [6, 7] }
+};
+
 class BinaryReader {
     constructor(filename) {
         this.filename = filename;
@@ -43,19 +88,20 @@ class BinaryReader {
                 return { isValid: false, errors };
             }
 
-            // Check file size
+            // Check file size. Only the JS parser, which loads the whole file
+            // into one Buffer, is limited; the native parser maps the file.
             const stats = await fs.stat(this.filename);
             const fileSizeGB = stats.size / (1024 * 1024 * 1024);
             
             if (stats.size === 0) {
                 errors.push('File is empty');
-            } else if (fileSizeGB > 2) {
-                errors.push(`File too large: ${fileSizeGB.toFixed(1)}GB (max 2GB)`);
+            } else if (fileSizeGB > 2 && !getNativeBinaryParser()) {
+                errors.push(`File too large: ${fileSizeGB.toFixed(1)}GB (max 2GB without the native parser)`);
             }
 
             // Try to read header to validate format
             try {
-                const buffer = await fs.readFile(this.filename, { start: 0, end: 1024 });
+                const buffer = await this._readFilePrefix(1024);
                 const headerResult = this.readCSharpString(buffer, 0);
                 
                 if (!headerResult.value || headerResult.value.length === 0) {
@@ -85,6 +131,23 @@ class BinaryReader {
         }
     }
 
+    /**
+     * Read the first bytes of the file
+     * @param {number} length - Maximum number of bytes
+     * @returns {Promise<Buffer>} File prefix
+     * @private
+     */
+    async _readFilePrefix(length) {
+        const handle = await fs.open(this.filename, 'r');
+        try {
+            const buffer = Buffer.alloc(length);
+            const { bytesRead } = await handle.read(buffer, 0, length, 0);
+            return buffer.subarray(0, bytesRead);
+        } finally {
+            await handle.close();
+        }
+    }
+
     /**
      * Read C# string format (7-bit encoded length + UTF-8 data)
      * @param {Buffer} buffer - Data buffer
@@ -191,6 +254,12 @@ class BinaryReader {
                 }
             }
 
+            // Native parser: mapped file, de-interleaving off the main thread
+            if (await this._readFileNative()) {
+                this._finishReading(overallStartTime, true);
+                return;
+            }
+
             // Read entire file into buffer
             const fileReadStart = process.hrtime.bigint();
             const buffer = await fs.readFile(this.filename);
@@ -207,7 +276,7 @@ class BinaryReader {
             console.log(`Header: ${header}`);
             
             // Read metadata section
-            offset = await this._readMetadataSection(buffer, offset);
+            offset = await this._readMetadataSection(buffer, offset, header);
             
             // Read the actual measurement data
             console.log('Reading measurement data...');
@@ -215,27 +284,14 @@ class BinaryReader {
             await this.readChannelData(buffer, offset, this.metadata.bufferSize, this.metadata.downsampling);
             const dataReadTime = Number(process.hrtime.bigint() - dataStartTime) / 1e9;
             
-            // Compute calculated channels
-            console.log('Computing calculated channels...');
-            const calcStartTime = process.hrtime.bigint();
-            this.computeCalculatedChannels();
-            const calcTime = Number(process.hrtime.bigint() - calcStartTime) / 1e9;
-            
-            // Store processing statistics
-            const totalTime = Number(process.hrtime.bigint() - overallStartTime) / 1e9;
             this.processingStats = {
                 ...this.processingStats,
+                parser: 'js',
                 fileReadTime,
-                dataReadTime,
-                calculationTime: calcTime,
-                totalProcessingTime: totalTime,
-                memoryUsageMB: process.memoryUsage().heapUsed / 1024 / 1024
+                dataReadTime
             };
             
-            console.log(`Data reading completed in: ${dataReadTime.toFixed(2)}s`);
-            console.log(`Calculated channels computed in: ${calcTime.toFixed(2)}s`);
-            console.log(`Total processing time: ${totalTime.toFixed(2)}s`);
-            console.log(`Memory usage: ${this.processingStats.memoryUsageMB.toFixed(1)} MB`);
+            this._finishReading(overallStartTime);
             
         } catch (error) {
             console.error('Error reading binary file:', error);
@@ -243,17 +299,268 @@ class BinaryReader {
         }
     }
 
+    /**
+     * Parse the file with the native addon
+     * @returns {Promise<boolean>} False if the addon is unavailable or failed
+     * @private
+     */
+    async _readFileNative() {
+        const nativeParser = getNativeBinaryParser();
+        if (!nativeParser) return false;
+
+        const parseStart = process.hrtime.bigint();
+        let parsed;
+        try {
+            parsed = await nativeParser.parseBinFile(this.filename);
+        } catch (error) {
+            console.warn(`Native binary parser failed, falling back to JS parser: ${error.message}`);
+            return false;
+        }
+        const dataReadTime = Number(process.hrtime.bigint() - parseStart) / 1e9;
+
+        const meta = parsed.metadata;
+        console.log(`Header: ${parsed.header}`);
+        this._storeMetadata({
+            header: parsed.header,
+            bufferSize: meta.bufferSize,
+            startTimeBinary: meta.startTimeBinary,
+            maxAdcValue: meta.maxAdcValue,
+            channelRanges: meta.channelRanges,
+            channelScaling: meta.channelScaling,
+            samplingInterval: meta.samplingInterval,
+            downsampling: meta.downsampling,
+            units: meta.units,
+            labels: meta.labels
+        });
+
+        // Every channel comes with its min/max pyramid for envelope queries
+        for (let channel = 0; channel < 8; channel++) {
+            this._storeChannel(channel, parsed.channels[channel].values, meta.downsampling[channel]);
+            this.rawData[`channel_${channel}`].pyramid = parsed.channels[channel].pyramid;
+        }
+
+        // Calculated channels come out of the same native pass
+        for (const [calcIndex, def] of Object.entries(CALC_CHANNEL_DEFS)) {
+            const entry = this._calculatedChannelEntry(parseInt(calcIndex), def, parsed.calculated[calcIndex].values);
+            if (entry) {
+                entry.pyramid = parsed.calculated[calcIndex].pyramid;
+                this.calculatedData[`calc_${calcIndex}`] = entry;
+            }
+        }
+
+        console.log(`File parsed natively: ${(parsed.stats.fileSize / 1024 / 1024).toFixed(1)} MB, ` +
+                   `${parsed.stats.totalPoints.toLocaleString()} points in ${parsed.stats.parseTimeMs.toFixed(0)} ms`);
+
+        this.processingStats = {
+            ...this.processingStats,
+            parser: 'native',
+            fileReadTime: 0, // mapped, read during parsing
+            dataReadTime
+        };
+        return true;
+    }
+
+    // === STREAMING ACCESS (native parser only) ===
+
+    /**
+     * Open the file for on-demand reads instead of loading it. Only the
+     * metadata is parsed; samples are decoded per channel and range, or
+     * served from the column cache when a valid one exists at cachePath.
+     * @param {string} [cachePath] - Column cache written by buildCache
+     * @returns {Promise<void>}
+     */
+    async openStream(cachePath) {
+        const nativeParser = getNativeBinaryParser();
+        if (!nativeParser) {
+            throw new Error('Streaming access requires the native binary parser (run "npm run build-binary")');
+        }
+
+        this.closeStream();
+        const stream = cachePath
+            ? new nativeParser.BinFile(this.filename, cachePath)
+            : new nativeParser.BinFile(this.filename);
+        const info = stream.info();
+        const meta = info.metadata;
+
+        console.log(`Opened binary file for streaming: ${path.basename(this.filename)} ` +
+                   `(${(info.fileSize / 1024 / 1024).toFixed(1)} MB` +
+                   `${info.cached ? ', column cache' : ''})`);
+        this._storeMetadata({
+            header: info.header,
+            bufferSize: meta.bufferSize,
+            startTimeBinary: meta.startTimeBinary,
+            maxAdcValue: meta.maxAdcValue,
+            channelRanges: meta.channelRanges,
+            channelScaling: meta.channelScaling,
+            samplingInterval: meta.samplingInterval,
+            downsampling: meta.downsampling,
+            units: meta.units,
+            labels: meta.labels
+        });
+
+        this.stream = stream;
+        this.streamPoints = info.points;
+        this.streamCalculatedPoints = info.calculatedPoints;
+        this.streamCached = !!info.cached;
+        this.processingStats = {
+            ...this.processingStats,
+            parser: info.cached ? 'native-cache' : 'native-stream',
+            fileSize: info.fileSize
+        };
+    }
+
+    isStreaming() {
+        return !!this.stream;
+    }
+
+    /**
+     * Whether the open stream is served from a column cache
+     */
+    isStreamCached() {
+        return !!this.stream && this.streamCached;
+    }
+
+    /**
+     * Decode every raw and calculated channel once into a column cache that
+     * later openStream(cachePath) calls map instead of the .bin. Uses the
+     * open stream, or a temporary one.
+     * @param {string} cachePath - Destination file
+     * @returns {Promise<{path: string, byteSize: number}>}
+     */
+    async buildCache(cachePath) {
+        if (this.stream) {
+            return this.stream.buildCache(cachePath);
+        }
+
+        const nativeParser = getNativeBinaryParser();
+        if (!nativeParser) {
+            throw new Error('The column cache requires the native binary parser (run "npm run build-binary")');
+        }
+        const stream = new nativeParser.BinFile(this.filename);
+        try {
+            return await stream.buildCache(cachePath);
+        } finally {
+            stream.close();
+        }
+    }
+
+    /**
+     * Number of samples of a raw channel in streaming mode
+     * @param {number} channel - Raw channel index (0-7)
+     */
+    getStreamPoints(channel) {
+        return this.streamPoints ? this.streamPoints[channel] : 0;
+    }
+
+    /**
+     * Number of samples of a calculated channel in streaming mode (where
+     * both of its source channels have a sample)
+     * @param {number} calcIndex - Calculated channel index (0-6)
+     */
+    getStreamCalculatedPoints(calcIndex) {
+        return this.streamCalculatedPoints ? this.streamCalculatedPoints[calcIndex] : 0;
+    }
+
+    /**
+     * Decode samples of one raw channel
+     * @param {number} channel - Raw channel index (0-7)
+     * @param {number} startIndex - First sample
+     * @param {number} count - Number of samples to return
+     * @param {number} step - Take every step-th sample (default 1)
+     * @returns {Promise<Float32Array>} Physical values
+     */
+    readChannelRange(channel, startIndex, count, step = 1) {
+        return this._requireStream().read(channel, startIndex, count, step);
+    }
+
+    /**
+     * Per-bucket min/max of one raw channel with the sample index of each extreme
+     * @returns {Promise<{min: Float32Array, max: Float32Array, minIndex: Float64Array, maxIndex: Float64Array}>}
+     */
+    readChannelEnvelope(channel, startIndex, count, buckets) {
+        return this._requireStream().envelope(channel, startIndex, count, buckets);
+    }
+
+    /**
+     * Evaluate samples of one calculated channel from its mapped sources
+     * @param {number} calcIndex - Calculated channel index (0-6)
+     * @returns {Promise<Float32Array>} Same arguments and result as readChannelRange
+     */
+    readCalculatedRange(calcIndex, startIndex, count, step = 1) {
+        return this._requireStream().readCalculated(calcIndex, startIndex, count, step);
+    }
+
+    /**
+     * Per-bucket min/max of one calculated channel, as readChannelEnvelope
+     */
+    readCalculatedEnvelope(calcIndex, startIndex, count, buckets) {
+        return this._requireStream().envelopeCalculated(calcIndex, startIndex, count, buckets);
+    }
+
+    /**
+     * Min, max, mean and RMS of every raw and calculated channel (one pass
+     * over the file)
+     * @returns {Promise<{channels: Array<Object>, calculated: Array<Object>}>}
+     */
+    summarizeChannels() {
+        return this._requireStream().summarize();
+    }
+
+    /**
+     * Release the file mapping (reads still in flight complete first)
+     */
+    closeStream() {
+        if (this.stream) {
+            this.stream.close();
+            this.stream = null;
+        }
+    }
+
+    _requireStream() {
+        if (!this.stream) {
+            throw new Error('Binary file is not open for streaming');
+        }
+        return this.stream;
+    }
+
+    /**
+     * Compute calculated channels (unless the parser already did) and record
+     * timing once raw data is loaded
+     * @private
+     */
+    _finishReading(overallStartTime, calculatedReady = false) {
+        const calcStartTime = process.hrtime.bigint();
+        if (!calculatedReady) {
+            console.log('Computing calculated channels...');
+            this.computeCalculatedChannels();
+        }
+        const calcTime = Number(process.hrtime.bigint() - calcStartTime) / 1e9;
+        
+        // Store processing statistics
+        const totalTime = Number(process.hrtime.bigint() - overallStartTime) / 1e9;
+        this.processingStats = {
+            ...this.processingStats,
+            calculationTime: calcTime,
+            totalProcessingTime: totalTime,
+            memoryUsageMB: process.memoryUsage().heapUsed / 1024 / 1024
+        };
+        
+        console.log(`Data reading completed in: ${this.processingStats.dataReadTime.toFixed(2)}s (${this.processingStats.parser} parser)`);
+        console.log(`Calculated channels computed in: ${calcTime.toFixed(2)}s`);
+        console.log(`Total processing time: ${totalTime.toFixed(2)}s`);
+        console.log(`Memory usage: ${this.processingStats.memoryUsageMB.toFixed(1)} MB`);
+    }
+
     /**
      * Read metadata section from binary file
      * @private
      */
-    async _readMetadataSection(buffer, offset) {
+    async _readMetadataSection(buffer, offset, header = '') {
         // Read buffer size
         const bufferSize = buffer.readUInt32LE(offset); offset += 4;
         
         // Read start time (C# DateTime.ToBinary format)
         const startTimeBinary = buffer.readBigInt64LE(offset); offset += 8;
-        const binaryUnixMs = this.convertBinaryTimestampToUnixMs(startTimeBinary);
         
         // Read max ADC value
         const maxAdcValue = buffer.readInt16LE(offset); offset += 2;
@@ -298,23 +605,46 @@ class BinaryReader {
             offset = result.newOffset;
         }
         
-        // Create readable date for logging
-        const readDateTime = binaryUnixMs > 0 ? new Date(binaryUnixMs) : null;
-        
-        // Store comprehensive metadata
-        this.metadata = {
-            header: this.metadata.header || '', // Keep existing header
+        this._storeMetadata({
+            header,
             bufferSize,
             startTimeBinary,
-            binaryUnixMs,
-            readDateTime,
             maxAdcValue,
             channelRanges,
             channelScaling,
             samplingInterval,
             downsampling,
             units,
-            labels,
+            labels
+        });
+        
+        return offset;
+    }
+
+    /**
+     * Store parsed metadata fields (shared by the JS and native parsers)
+     * @private
+     */
+    _storeMetadata(fields) {
+        const binaryUnixMs = this.convertBinaryTimestampToUnixMs(fields.startTimeBinary);
+        
+        // Create readable date for logging
+        const readDateTime = binaryUnixMs > 0 ? new Date(binaryUnixMs) : null;
+        
+        // Store comprehensive metadata
+        this.metadata = {
+            header: fields.header || this.metadata.header || '',
+            bufferSize: fields.bufferSize,
+            startTimeBinary: fields.startTimeBinary,
+            binaryUnixMs,
+            readDateTime,
+            maxAdcValue: fields.maxAdcValue,
+            channelRanges: fields.channelRanges,
+            channelScaling: fields.channelScaling,
+            samplingInterval: fields.samplingInterval,
+            downsampling: fields.downsampling,
+            units: fields.units,
+            labels: fields.labels,
             
             // Additional metadata for the service layer
             filePath: this.filename,
@@ -322,11 +652,9 @@ class BinaryReader {
             processedAt: new Date()
         };
         
-        console.log(`Buffer size: ${bufferSize.toLocaleString()} points`);
-        console.log(`Sampling interval: ${samplingInterval} ns (${(1e9/samplingInterval).toFixed(0)} Hz)`);
+        console.log(`Buffer size: ${fields.bufferSize.toLocaleString()} points`);
+        console.log(`Sampling interval: ${fields.samplingInterval} ns (${(1e9/fields.samplingInterval).toFixed(0)} Hz)`);
         console.log(`Recording start time: ${readDateTime ? readDateTime.toISOString() : 'Unknown'}`);
-        
-        return offset;
     }
 
     /**
@@ -396,51 +724,44 @@ class BinaryReader {
             }
         }
         
-        // Create time axes and store data
+        // Store data (time axes are implicit, see _storeChannel)
         for (let channel = 0; channel < 8; channel++) {
-            const actualPoints = channelIndices[channel];
-            const dataArray = channelDataArrays[channel].slice(0, actualPoints);
-            
-            // Create time axis
-            const dtSeconds = (this.metadata.samplingInterval * downsampling[channel]) / 1e9;
-            const timeArray = new Float32Array(actualPoints);
-            for (let i = 0; i < actualPoints; i++) {
-                timeArray[i] = i * dtSeconds;
-            }
-            
-            this.rawData[`channel_${channel}`] = {
-                time: timeArray,
-                values: dataArray,
-                label: this.metadata.labels[channel] || `Channel ${channel}`,
-                unit: this.metadata.units[channel] || 'V',
-                downsampling: downsampling[channel],
-                points: actualPoints,
-                channelIndex: channel,
-                samplingRate: 1e9 / (this.metadata.samplingInterval * downsampling[channel])
-            };
-            
-            console.log(`Channel ${channel}: ${actualPoints.toLocaleString()} points, ` +
-                       `${(actualPoints * dtSeconds).toFixed(1)}s duration`);
+            const dataArray = channelDataArrays[channel].slice(0, channelIndices[channel]);
+            this._storeChannel(channel, dataArray, downsampling[channel]);
         }
     }
 
     /**
-     * Compute calculated engineering channels from raw data
+     * Store one raw channel (shared by the JS and native parsers). Samples
+     * are uniformly spaced, so instead of a time array the channel carries
+     * its time axis as timeStart + i * timeStep (seconds).
+     * @private
      */
-    computeCalculatedChannels() {
-        // Define calculated channel metadata
-        const calcChannelDefs = {
-            0: { label: 'UL3L1*', unit: 'V', sourceChannels: [0, 1] },
-            1: { label: 'IL2GR1*', unit: 'V', sourceChannels: [2, 3] },
-            2: { label: 'IL2GR2*', unit: 'V', sourceChannels: [4, 5] },
-            3: { label: 'I_DC_GR1*', unit: 'A', sourceChannels: [2, 3] },
-            4: { label: 'I_DC_GR2*', unit: 'A', sourceChannels: [4, 5] },
-            5: { label: 'U_DC*', unit: 'V', sourceChannels: [0, 1] },
-            6: { label: 'F_Schlitten*', unit: 'kN', sourceChannels: [6, 7] }
+    _storeChannel(channel, values, downsampling) {
+        const dtSeconds = (this.metadata.samplingInterval * downsampling) / 1e9;
+        
+        this.rawData[`channel_${channel}`] = {
+            values,
+            timeStart: 0,
+            timeStep: dtSeconds,
+            label: this.metadata.labels[channel] || `Channel ${channel}`,
+            unit: this.metadata.units[channel] || 'V',
+            downsampling,
+            points: values.length,
+            channelIndex: channel,
+            samplingRate: 1e9 / (this.metadata.samplingInterval * downsampling)
         };
+        
+        console.log(`Channel ${channel}: ${values.length.toLocaleString()} points, ` +
+                   `${(values.length * dtSeconds).toFixed(1)}s duration`);
+    }
 
+    /**
+     * Compute calculated engineering channels from raw data
+     */
+    computeCalculatedChannels() {
         // Compute each calculated channel
-        for (const [calcIndex, def] of Object.entries(calcChannelDefs)) {
+        for (const [calcIndex, def] of Object.entries(CALC_CHANNEL_DEFS)) {
             try {
                 const result = this.computeSingleCalculatedChannel(parseInt(calcIndex), def);
                 if (result) {
@@ -472,110 +793,113 @@ class BinaryReader {
             }
         }
 
-        // Get the primary source channel (first one) for time reference
-        const primaryChannel = sourceChannels[0];
-        const primaryData = this.rawData[`channel_${primaryChannel}`];
-        const numPoints = primaryData.points;
-        
-        // Create arrays for calculated channel
-        const timeArray = new Float32Array(primaryData.time);
+        // Samples where both sources are present (mixed downsampling leaves
+        // one shorter), as the native parser and the streaming reader count them
+        const numPoints = Math.min(
+            this.rawData[`channel_${sourceChannels[0]}`].points,
+            this.rawData[`channel_${sourceChannels[1]}`].points
+        );
         const valuesArray = new Float32Array(numPoints);
         
-        // Perform calculations based on channel index
+        const computed = this.computeCalculatedValues(
+            calcIndex,
+            this.rawData[`channel_${sourceChannels[0]}`].values,
+            this.rawData[`channel_${sourceChannels[1]}`].values,
+            valuesArray,
+            numPoints
+        );
+        if (!computed) return null;
+        
+        return this._calculatedChannelEntry(calcIndex, def, valuesArray);
+    }
+
+    /**
+     * Channel entry for computed values, on the time axis of the primary
+     * (first) source channel
+     * @private
+     */
+    _calculatedChannelEntry(calcIndex, def, values) {
+        const primaryData = this.rawData[`channel_${def.sourceChannels[0]}`];
+        if (!primaryData) return null;
+
+        return {
+            values,
+            timeStart: primaryData.timeStart,
+            timeStep: primaryData.timeStep,
+            label: def.label,
+            unit: def.unit,
+            sourceChannels: def.sourceChannels,
+            points: values.length,
+            downsampling: primaryData.downsampling,
+            channelIndex: calcIndex,
+            samplingRate: primaryData.samplingRate
+        };
+    }
+
+    /**
+     * Evaluate a calculated channel on aligned samples of its two source
+     * channels (whole channels, or a decoded range in streaming mode)
+     * @param {number} calcIndex - Calculated channel index (0-6)
+     * @param {Float32Array} data1 - Values of the first source channel
+     * @param {Float32Array} data2 - Values of the second source channel
+     * @param {Float32Array} output - Receives numPoints values
+     * @param {number} numPoints - Number of samples
+     * @returns {boolean} False for an unknown channel index
+     */
+    computeCalculatedValues(calcIndex, data1, data2, output, numPoints) {
         switch (calcIndex) {
             case 0: // UL3L1* = -channel[0] - channel[1]
-                this.calculateDifferential(valuesArray, 0, 1, numPoints, -1, -1);
-                break;
-                
             case 1: // IL2GR1* = -channel[2] - channel[3]
-                this.calculateDifferential(valuesArray, 2, 3, numPoints, -1, -1);
-                break;
-                
             case 2: // IL2GR2* = -channel[4] - channel[5]
-                this.calculateDifferential(valuesArray, 4, 5, numPoints, -1, -1);
-                break;
+                this.calculateDifferential(output, data1, data2, numPoints, -1, -1);
+                return true;
                 
             case 3: // I_DC_GR1* = TRAFO_MULTIPLIER * (|ch[2]| + |ch[3]| + |IL2GR1*|)
-                this.calculateDCCurrent(valuesArray, 2, 3, 1, numPoints);
-                break;
-                
             case 4: // I_DC_GR2* = TRAFO_MULTIPLIER * (|ch[4]| + |ch[5]| + |IL2GR2*|)
-                this.calculateDCCurrent(valuesArray, 4, 5, 2, numPoints);
-                break;
-                
-            case 5: // U_DC* = (|ch[0]| + |ch[1]| + |UL3L1*|) / TRAFO_MULTIPLIER
-                this.calculateDCVoltage(valuesArray, 0, 1, 0, numPoints);
-                break;
+            case 5: { // U_DC* = (|ch[0]| + |ch[1]| + |UL3L1*|) / TRAFO_MULTIPLIER
+                const diffData = new Float32Array(numPoints);
+                this.calculateDifferential(diffData, data1, data2, numPoints, -1, -1);
+                if (calcIndex === 5) {
+                    this.calculateDCVoltage(output, data1, data2, diffData, numPoints);
+                } else {
+                    this.calculateDCCurrent(output, data1, data2, diffData, numPoints);
+                }
+                return true;
+            }
                 
             case 6: // F_Schlitten* = ch[6] * 6.2832 - ch[7] * 5.0108
-                this.calculateForce(valuesArray, 6, 7, numPoints);
-                break;
+                this.calculateForce(output, data1, data2, numPoints);
+                return true;
                 
             default:
                 console.warn(`Unknown calculated channel index: ${calcIndex}`);
-                return null;
+                return false;
         }
-        
-        return {
-            time: timeArray,
-            values: valuesArray,
-            label: def.label,
-            unit: def.unit,
-            sourceChannels: sourceChannels,
-            points: numPoints,
-            downsampling: primaryData.downsampling,
-            channelIndex: calcIndex,
-            samplingRate: primaryData.samplingRate
-        };
     }
 
     // === CALCULATION METHODS ===
 
-    calculateDifferential(output, ch1, ch2, numPoints, coeff1, coeff2) {
-        const data1 = this.rawData[`channel_${ch1}`].values;
-        const data2 = this.rawData[`channel_${ch2}`].values;
-        
+    calculateDifferential(output, data1, data2, numPoints, coeff1, coeff2) {
         for (let i = 0; i < numPoints; i++) {
             output[i] = coeff1 * data1[i] + coeff2 * data2[i];
         }
     }
 
-    calculateDCCurrent(output, ch1, ch2, diffChannelIndex, numPoints) {
-        const data1 = this.rawData[`channel_${ch1}`].values;
-        const data2 = this.rawData[`channel_${ch2}`].values;
-        const diffData = this.calculatedData[`calc_${diffChannelIndex}`]?.values;
-        
-        if (!diffData) {
-            console.warn(`Differential channel calc_${diffChannelIndex} not computed yet`);
-            return;
-        }
-        
+    calculateDCCurrent(output, data1, data2, diffData, numPoints) {
         for (let i = 0; i < numPoints; i++) {
             const sum = Math.abs(data1[i]) + Math.abs(data2[i]) + Math.abs(diffData[i]);
             output[i] = this.TRAFO_STROM_MULTIPLIER * sum;
         }
     }
 
-    calculateDCVoltage(output, ch1, ch2, diffChannelIndex, numPoints) {
-        const data1 = this.rawData[`channel_${ch1}`].values;
-        const data2 = this.rawData[`channel_${ch2}`].values;
-        const diffData = this.calculatedData[`calc_${diffChannelIndex}`]?.values;
-        
-        if (!diffData) {
-            console.warn(`Differential channel calc_${diffChannelIndex} not computed yet`);
-            return;
-        }
-        
+    calculateDCVoltage(output, data1, data2, diffData, numPoints) {
         for (let i = 0; i < numPoints; i++) {
             const sum = Math.abs(data1[i]) + Math.abs(data2[i]) + Math.abs(diffData[i]);
             output[i] = sum / this.TRAFO_STROM_MULTIPLIER;
         }
     }
 
-    calculateForce(output, ch1, ch2, numPoints) {
-        const data1 = this.rawData[`channel_${ch1}`].values;
-        const data2 = this.rawData[`channel_${ch2}`].values;
-        
+    calculateForce(output, data1, data2, numPoints) {
         for (let i = 0; i < numPoints; i++) {
             output[i] = data1[i] * this.FORCE_COEFF_1 - data2[i] * this.FORCE_COEFF_2;
         }
@@ -641,4 +965,19 @@ class BinaryReader {
     }
 }
 
+BinaryReader.CALC_CHANNEL_DEFS = CALC_CHANNEL_DEFS;
+BinaryReader.isNativeAvailable = () => !!getNativeBinaryParser();
+
+/**
+ * Per-bucket min/max of a loaded channel from its native pyramid, touching
+ * O(buckets) pyramid entries whatever the range length
+ * @param {Object} channelData - Channel with values and pyramid
+ * @returns {Object|null} {min, max, minIndex, maxIndex}, or null without a pyramid
+ */
+BinaryReader.pyramidEnvelope = (channelData, startIndex, count, buckets) => {
+    const nativeParser = getNativeBinaryParser();
+    if (!nativeParser || !channelData.pyramid) return null;
+    return nativeParser.pyramidEnvelope(channelData.values, channelData.pyramid, startIndex, count, buckets);
+};
+
 module.exports = BinaryReader;
\ No newline at end of file
@@ -0,0 +1,302 @@
+/**
+ * Binary Stream Processor
+ * BinaryDataProcessor for .bin files opened for streaming (native parser):
+ * channels are descriptors instead of loaded arrays and every request decodes
+ * only the channel and time range it needs from the memory-mapped file.
+ * Used for files too large to load whole; no upper file size limit.
+ */
+
+const BinaryDataProcessor = require('./BinaryDataProcessor');
+const BinaryReader = require('./BinaryReader');
+const Downsampler = require('./Downsampler');
+
+// Samples per channel decoded at open (strided) for distribution statistics;
+// the native column cache stores exactly this overview (BinCache::OVERVIEW_POINTS)
+const OVERVIEW_POINTS = 65536;
+
+class BinaryStreamProcessor extends BinaryDataProcessor {
+    /**
+     * Build the processor for a reader opened with openStream()
+     * @param {BinaryReader} reader - Streaming reader
+     * @returns {Promise<BinaryStreamProcessor>}
+     */
+    static async create(reader) {
+        const metadata = reader.getMetadata();
+        const rawData = {};
+        const calculatedData = {};
+
+        // Exact extremes, mean and RMS come with a column cache; without one
+        // they take a whole-file pass, run on the first statistics request
+        const summaries = reader.isStreamCached() ? await reader.summarizeChannels() : null;
+
+        for (let channel = 0; channel < 8; channel++) {
+            const downsampling = metadata.downsampling[channel];
+            const timeStep = (metadata.samplingInterval * downsampling) / 1e9;
+
+            rawData[`channel_${channel}`] = {
+                label: metadata.labels[channel] || `Channel ${channel}`,
+                unit: metadata.units[channel] || 'V',
+                downsampling,
+                points: reader.getStreamPoints(channel),
+                channelIndex: channel,
+                samplingRate: 1 / timeStep,
+                timeStart: 0,
+                timeStep,
+                summary: summaries ? summaries.channels[channel] : null
+            };
+        }
+
+        for (const [calcIndex, def] of Object.entries(BinaryReader.CALC_CHANNEL_DEFS)) {
+            const first = rawData[`channel_${def.sourceChannels[0]}`];
+            calculatedData[`calc_${calcIndex}`] = {
+                label: def.label,
+                unit: def.unit,
+                sourceChannels: def.sourceChannels,
+                points: reader.getStreamCalculatedPoints(parseInt(calcIndex)),
+                downsampling: first.downsampling,
+                channelIndex: parseInt(calcIndex),
+                samplingRate: first.samplingRate,
+                timeStart: first.timeStart,
+                timeStep: first.timeStep,
+                summary: summaries ? summaries.calculated[calcIndex] : null
+            };
+        }
+
+        // Strided overviews of all channels, decoded in parallel
+        await Promise.all([
+            ...Object.values(rawData).map(async (channelData) => {
+                channelData.overview = await reader.readChannelRange(
+                    channelData.channelIndex, ...BinaryStreamProcessor._overviewSpan(channelData.points)
+                );
+            }),
+            ...Object.values(calculatedData).map(async (channelData) => {
+                channelData.overview = await reader.readCalculatedRange(
+                    channelData.channelIndex, ...BinaryStreamProcessor._overviewSpan(channelData.points)
+                );
+            })
+        ]);
+
+        return new BinaryStreamProcessor(reader, rawData, calculatedData, metadata, !!summaries);
+    }
+
+    constructor(reader, rawData, calculatedData, metadata, summarized = false) {
+        super(rawData, calculatedData, metadata);
+        this.reader = reader;
+        this.streaming = true;
+        this.summaryPromise = summarized ? Promise.resolve() : null;
+    }
+
+    /**
+     * Get resampled data for a channel, decoding only the requested range.
+     * Ranges above maxPoints return per-bucket extremes in sample order.
+     * @returns {Promise<Object>} {time: Array, values: Array}
+     */
+    async getResampledData(channelId, startTime, endTime, maxPoints = 2000) {
+        try {
+            const cacheKey = `${channelId}_${startTime}_${endTime}_${maxPoints}`;
+            const cached = this._getCachedResampling(cacheKey);
+            if (cached) {
+                return cached;
+            }
+
+            const channelData = this.getChannelById(channelId);
+            if (!channelData) {
+                console.warn(`Channel ${channelId} not found`);
+                return { time: [], values: [] };
+            }
+            if (channelData.points === 0) {
+                return { time: [], values: [] };
+            }
+
+            const validatedRange = this.validateTimeRange(startTime, endTime);
+            const startIdx = this.findTimeIndex(channelData, validatedRange.startTime);
+            const endIdx = this.findTimeIndex(channelData, validatedRange.endTime);
+            const count = endIdx - startIdx + 1;
+            maxPoints = Math.max(2, Math.floor(maxPoints) || 0);
+
+            const result = await this._readRange(channelData, startIdx, count, maxPoints);
+
+            this._setCachedResampling(cacheKey, result);
+            return result;
+
+        } catch (error) {
+            console.error(`Error resampling channel ${channelId}:`, error);
+            return { time: [], values: [] };
+        }
+    }
+
+    /**
+     * Get channel data formatted for API responses
+     * @returns {Promise<Object>} API-formatted channel data
+     */
+    async getChannelDataForAPI(channelId, startTime, endTime, maxPoints) {
+        try {
+            const channelData = this.getChannelById(channelId);
+            if (!channelData) {
+                return {
+                    success: false,
+                    error: `Channel ${channelId} not found`
+                };
+            }
+
+            const data = await this.getResampledData(channelId, startTime, endTime, maxPoints);
+            return this._formatChannelData(channelId, channelData, data, startTime, endTime, maxPoints);
+
+        } catch (error) {
+            return {
+                success: false,
+                error: `Failed to get channel data: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Get multiple channels data for API, channels decoded in parallel
+     * @returns {Promise<Object>} API-formatted bulk channel data
+     */
+    async getBulkChannelDataForAPI(channelIds, startTime, endTime, maxPoints) {
+        const results = {};
+        const errors = [];
+
+        const channelResults = await Promise.all(channelIds.map(channelId =>
+            this.getChannelDataForAPI(channelId, startTime, endTime, maxPoints)
+        ));
+
+        channelIds.forEach((channelId, i) => {
+            results[channelId] = channelResults[i];
+            if (!channelResults[i].success) {
+                errors.push(`${channelId}: ${channelResults[i].error}`);
+            }
+        });
+
+        return this._formatBulkChannelData(channelIds, results, errors, startTime, endTime, maxPoints);
+    }
+
+    /**
+     * Channel statistics: exact extremes, mean and RMS from the full-file
+     * summary, distribution measures from the overview
+     * @returns {Promise<Object|null>} Channel statistics
+     */
+    async getChannelStatistics(channelId) {
+        const channelData = this.getChannelById(channelId);
+        if (!channelData || channelData.overview.length === 0) return null;
+
+        await this._ensureSummaries();
+
+        const stats = this._calculateStatistics(channelData, channelData.overview);
+        stats.count = channelData.points;
+        stats.sampledPoints = channelData.overview.length;
+
+        const summary = channelData.summary;
+        if (summary && summary.count > 0) {
+            const variance = Math.max(0, summary.rms * summary.rms - summary.mean * summary.mean);
+            const stdDev = Math.sqrt(variance);
+            Object.assign(stats, {
+                min: summary.min,
+                max: summary.max,
+                mean: summary.mean,
+                stdDev,
+                variance,
+                rms: summary.rms,
+                range: summary.max - summary.min,
+                peakToPeak: summary.max - summary.min,
+                crestFactor: stdDev > 0 ? (summary.max - summary.mean) / stdDev : 0
+            });
+        }
+
+        return stats;
+    }
+
+    /**
+     * Release the file mapping
+     */
+    close() {
+        this.reader.closeStream();
+    }
+
+    // === STREAMING OVERRIDES ===
+
+    /**
+     * Axis range from the exact summary, or from the overview until the
+     * summary has been computed
+     * @private
+     */
+    _calculateChannelRange(channelData) {
+        const summary = channelData.summary;
+        if (summary && summary.count > 0) {
+            return this._paddedRange(channelData, summary.min, summary.max);
+        }
+
+        let min = Infinity;
+        let max = -Infinity;
+        for (const value of channelData.overview || []) {
+            if (value < min) min = value;
+            if (value > max) max = value;
+        }
+        return min <= max
+            ? this._paddedRange(channelData, min, max)
+            : this._paddedRange(channelData, 0, 0);
+    }
+
+    /**
+     * Run the whole-file summary pass once and attach it to the channels
+     * @private
+     */
+    _ensureSummaries() {
+        if (!this.summaryPromise) {
+            this.summaryPromise = this.reader.summarizeChannels().then((summaries) => {
+                for (const channelData of Object.values(this.rawData)) {
+                    channelData.summary = summaries.channels[channelData.channelIndex];
+                }
+                for (const channelData of Object.values(this.calculatedData)) {
+                    channelData.summary = summaries.calculated[channelData.channelIndex];
+                }
+                this.dataRanges = this._calculateDataRanges();
+            }).catch((error) => {
+                this.summaryPromise = null;
+                throw error;
+            });
+        }
+        return this.summaryPromise;
+    }
+
+    // === RANGE DECODING ===
+
+    async _readRange(channelData, startIdx, count, maxPoints) {
+        const index = channelData.channelIndex;
+        const calculated = !!channelData.sourceChannels;
+
+        if (count <= maxPoints) {
+            const values = calculated
+                ? await this.reader.readCalculatedRange(index, startIdx, count)
+                : await this.reader.readChannelRange(index, startIdx, count);
+            const time = new Array(count);
+            for (let i = 0; i < count; i++) {
+                time[i] = this._timeAt(channelData, startIdx + i);
+            }
+            return { time, values: Array.from(values) };
+        }
+
+        // Two points per bucket: its minimum and maximum, in sample order
+        const buckets = Math.floor(maxPoints / 2);
+        const envelope = calculated
+            ? await this.reader.readCalculatedEnvelope(index, startIdx, count, buckets)
+            : await this.reader.readChannelEnvelope(index, startIdx, count, buckets);
+        return Downsampler.envelopePoints(channelData, envelope);
+    }
+
+    /**
+     * [start, count, step] of the strided overview of a channel
+     * @private
+     */
+    static _overviewSpan(points) {
+        const step = BinaryStreamProcessor._overviewStep(points);
+        return [0, points > 0 ? Math.floor((points - 1) / step) + 1 : 0, step];
+    }
+
+    static _overviewStep(points) {
+        return Math.max(1, Math.ceil(points / OVERVIEW_POINTS));
+    }
+}
+
+module.exports = BinaryStreamProcessor;
@@ -0,0 +1,394 @@
+/**
+ * CsvIngest - Shared CSV ingest for the sensor CSV readers
+ * Parses a whole file into typed columns in one pass: one Float64Array per
+ * column, NaN where a cell is missing, empty or does not parse.
+ *
+ * Runs on the native CSV addon (native/csv: memory-mapped file, SSE2 field
+ * scanning, parsing off the main thread, large files split at row
+ * boundaries and parsed on up to options.threads threads) and falls back to Papa Parse plus
+ * the JS field parsers below otherwise. Both follow the same rules:
+ * - rows: quoted fields may hold delimiters, lines starting with the comment
+ *   character are skipped, blank lines are skipped unless skipEmptyLines is
+ *   false; the delimiter is detected from the first 20 lines unless given
+ * - numbers: [+-]digits[sep digits][e[+-]digits] and nothing else; the
+ *   decimal separator is '.', ',' or (auto) ',' for fields with a comma
+ *   and no point
+ * - datetimes: yyyy-MM-dd[ T]HH:mm:ss[.f] or d.M.yyyy H:m:s, as wall-clock
+ *   milliseconds since 1970-01-01 (no time zone applied)
+ * - pairs: {X=number, Y=number}
+ * - column types are given (options.types) or inferred from the first rows:
+ *   the most frequent typed content, text if text cells outnumber it
+ *
+ * Result: {delimiter, rows, prefixRows, columns, stats, parser}, where
+ * prefixRows are the first rows as trimmed strings (headers, metadata) and
+ * each column is {type, values} ('number', 'datetime'), {type, x, y}
+ * ('pair') or {type} ('text', 'empty'), with an invalid cell count.
+ *
+ * With an onProgress callback the native parser works through the file in
+ * waves of growing size and reports each completed prefix of rows:
+ * {rows, bytesParsed, fileSize, delimiter, prefixRows, overview}, where
+ * overview = {rowsPerBucket, columns} holds per number/datetime column the
+ * min and max of every rowsPerBucket rows (null for other columns). The JS
+ * fallback does not report progress.
+ */
+
+const fs = require('fs').promises;
+const path = require('path');
+const Papa = require('papaparse');
+
+/**
+ * Load the native CSV addon
+ * @returns {Object|null} Native module, or null to use the JS parser
+ */
+function loadNativeCsvParser() {
+    const possiblePaths = [
+        '../native/csv/build/Release/csv_native.node',
+        './native/csv/build/Release/csv_native.node',
+        path.join(__dirname, '../native/csv/build/Release/csv_native.node')
+    ];
+
+    for (const modulePath of possiblePaths) {
+        try {
+            const nativeModule = require(modulePath);
+            console.log(`Loaded native CSV parser from: ${modulePath} (SIMD: ${nativeModule.simd})`);
+            return nativeModule;
+        } catch (e) {
+            // Continue to next path
+        }
+    }
+
+    console.log('Native CSV parser not available, using JS parser (run "npm run build-csv")');
+    return null;
+}
+
+let nativeCsvParser;
+
+function getNativeCsvParser() {
+    if (nativeCsvParser === undefined) {
+        nativeCsvParser = loadNativeCsvParser();
+    }
+    return nativeCsvParser;
+}
+
+const DEFAULT_OPTIONS = {
+    delimiter: 'auto',
+    comment: null,
+    decimal: 'auto',
+    skipEmptyLines: true,
+    prefixRows: 100,
+    inferRows: 1000,
+    types: null,
+    threads: 0 // native only; 0: one per core, up to 8
+};
+
+const MAX_COLUMNS = 256;
+
+class CsvIngest {
+    /**
+     * Parse a CSV file into typed columns
+     * @param {string} filename - CSV file path
+     * @param {Object} options - {delimiter, comment, decimal, skipEmptyLines, prefixRows, inferRows, types, threads}
+     * @param {Function} [onProgress] - Called with each completed row prefix (native parser only)
+     * @returns {Promise<Object>} {delimiter, rows, prefixRows, columns, stats, parser}
+     */
+    static async parseFile(filename, options = {}, onProgress = null) {
+        options = { ...DEFAULT_OPTIONS, ...options };
+
+        const native = getNativeCsvParser();
+        if (native) {
+            try {
+                // The prefix rows come with the first report only. Errors
+                // stay here: thrown from a native callback they would be fatal.
+                let prefixRows = [];
+                const report = onProgress ? (progress) => {
+                    prefixRows = progress.prefixRows || prefixRows;
+                    try {
+                        onProgress({ ...progress, prefixRows });
+                    } catch (error) {
+                        console.warn(`CSV progress handler failed: ${error.message}`);
+                    }
+                } : undefined;
+
+                const result = await native.parseCsvFile(filename, {
+                    delimiter: options.delimiter,
+                    comment: options.comment || undefined,
+                    decimal: options.decimal,
+                    skipEmptyLines: options.skipEmptyLines,
+                    prefixRows: options.prefixRows,
+                    inferRows: options.inferRows,
+                    types: options.types || undefined,
+                    threads: options.threads
+                }, report);
+                return { ...result, parser: 'native' };
+            } catch (error) {
+                console.warn(`Native CSV parser failed, falling back to JS parser: ${error.message}`);
+            }
+        }
+
+        return CsvIngest.parseFileJs(filename, options);
+    }
+
+    /**
+     * JS implementation of parseFile
+     */
+    static async parseFileJs(filename, options = {}) {
+        options = { ...DEFAULT_OPTIONS, ...options };
+        const started = process.hrtime.bigint();
+
+        let content = await fs.readFile(filename, 'utf8');
+        const fileSize = Buffer.byteLength(content, 'utf8');
+        if (content.charCodeAt(0) === 0xFEFF) content = content.slice(1);
+
+        const delimiter = options.delimiter && options.delimiter !== 'auto'
+            ? options.delimiter
+            : CsvIngest.detectDelimiter(content);
+
+        const parsed = Papa.parse(content, {
+            header: false,
+            skipEmptyLines: false,
+            delimiter: delimiter,
+            dynamicTyping: false,
+            comments: options.comment || false
+        });
+
+        // Blank lines as the native parser sees them: one field, only blanks;
+        // a final newline ends the last row rather than starting an empty one
+        let rows = parsed.data;
+        if (options.skipEmptyLines) {
+            rows = rows.filter(row => !(row.length === 1 && trimBlank(row[0]) === ''));
+        } else if (rows.length > 0 && rows[rows.length - 1].length === 1 && rows[rows.length - 1][0] === '') {
+            rows.pop();
+        }
+
+        const prefixRows = [];
+        for (let r = 0; r < Math.min(options.prefixRows, rows.length); r++) {
+            prefixRows.push(rows[r].slice(0, MAX_COLUMNS).map(cell => fieldContent(cell)));
+        }
+
+        const types = options.types || inferTypes(rows, options);
+        const columns = types.map((type, c) => parseColumn(rows, c, type, options.decimal));
+
+        return {
+            delimiter,
+            rows: rows.length,
+            prefixRows,
+            columns,
+            stats: {
+                fileSize,
+                parseTimeMs: Number(process.hrtime.bigint() - started) / 1e6,
+                chunks: 1
+            },
+            parser: 'js'
+        };
+    }
+
+    /**
+     * Delimiter found on most of the first 20 lines; tab and semicolon only
+     * if strictly ahead of the comma
+     */
+    static detectDelimiter(content) {
+        let commas = 0;
+        let tabs = 0;
+        let semicolons = 0;
+        for (const line of content.split('\n', 20)) {
+            if (line.includes('\t')) tabs++;
+            if (line.includes(',')) commas++;
+            if (line.includes(';')) semicolons++;
+        }
+        if (tabs > commas && tabs > semicolons) return '\t';
+        if (semicolons > commas && semicolons > tabs) return ';';
+        return ',';
+    }
+
+    /**
+     * Number of a field, NaN if it is not one
+     */
+    static parseNumber(text, decimal = 'auto') {
+        return parseNumberContent(fieldContent(text), decimal);
+    }
+
+    /**
+     * Wall-clock milliseconds since 1970-01-01 of a datetime field, NaN if
+     * it is not one
+     */
+    static parseDateTime(text) {
+        text = fieldContent(text);
+        let match = DATETIME_ISO.exec(text);
+        let year, month, day;
+        if (match) {
+            [year, month, day] = [match[1], match[2], match[3]];
+        } else {
+            match = DATETIME_DOTTED.exec(text);
+            if (!match) return NaN;
+            [day, month, year] = [match[1], match[2], match[3]];
+        }
+        const [hour, minute, second] = [+match[4], +match[5], +match[6]];
+        month = +month;
+        day = +day;
+        if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+            return NaN;
+        }
+
+        // Fraction as an integer over a power of ten: ms = digits / 10^(n - 3)
+        let fraction = 0;
+        if (match[7] !== undefined) {
+            const digits = match[7].slice(0, 9);
+            fraction = digits.length >= 3
+                ? Number(digits) / POW10[digits.length - 3]
+                : Number(digits) * POW10[3 - digits.length];
+        }
+
+        const days = daysFromCivil(+year, month, day);
+        return ((days * 24 + hour) * 60 + minute) * 60000 + second * 1000 + fraction;
+    }
+
+    /**
+     * {x, y} of a {X=number, Y=number} field, null if it is not one
+     */
+    static parsePair(text) {
+        const match = PAIR.exec(fieldContent(text));
+        if (!match) return null;
+        const x = parseNumberContent(trimBlank(match[1]), '.');
+        const y = parseNumberContent(trimBlank(match[2]), '.');
+        return isNaN(x) || isNaN(y) ? null : { x, y };
+    }
+
+    /**
+     * Type of a field's content: 'empty', 'number', 'pair', 'datetime' or 'text'
+     */
+    static classify(text, decimal = 'auto') {
+        text = fieldContent(text);
+        if (text === '') return 'empty';
+        if (!isNaN(CsvIngest.parseNumber(text, decimal))) return 'number';
+        if (text[0] === '{' && CsvIngest.parsePair(text)) return 'pair';
+        if (text[0] >= '0' && text[0] <= '9' && !isNaN(CsvIngest.parseDateTime(text))) return 'datetime';
+        return 'text';
+    }
+
+    /**
+     * Local Date of wall-clock milliseconds from parseDateTime
+     */
+    static toLocalDate(milliseconds) {
+        const wall = new Date(Math.floor(milliseconds));
+        return new Date(wall.getUTCFullYear(), wall.getUTCMonth(), wall.getUTCDate(),
+            wall.getUTCHours(), wall.getUTCMinutes(), wall.getUTCSeconds(), wall.getUTCMilliseconds());
+    }
+
+    static isNativeAvailable() {
+        return !!getNativeCsvParser();
+    }
+
+    /**
+     * SIMD level of the native parser, or null when running the JS parser
+     */
+    static get simd() {
+        const native = getNativeCsvParser();
+        return native ? native.simd : null;
+    }
+}
+
+// === JS FIELD PARSERS ===
+
+const NUMBER = /^[+-]?(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?$/;
+const DATETIME_ISO = /^(\d{4})-(\d{2})-(\d{2})[ T](\d{1,2}):(\d{1,2}):(\d{1,2})(?:\.(\d+))?$/;
+const DATETIME_DOTTED = /^(\d{1,2})\.(\d{1,2})\.(\d{4}) +(\d{1,2}):(\d{1,2}):(\d{1,2})(?:\.(\d+))?$/;
+const PAIR = /^\{ *X=([^,]*), *Y=(.*)\}$/;
+const POW10 = [1, 10, 100, 1000, 10000, 100000, 1000000];
+const TYPE_ORDER = ['number', 'pair', 'datetime'];
+
+function trimBlank(text) {
+    return text.replace(/^[ \t\r]+|[ \t\r]+$/g, '');
+}
+
+/**
+ * Trimmed content without enclosing quotes
+ */
+function fieldContent(text) {
+    if (typeof text !== 'string') return '';
+    text = trimBlank(text);
+    if (text.length >= 2 && text[0] === '"' && text[text.length - 1] === '"') {
+        text = trimBlank(text.slice(1, -1));
+    }
+    return text;
+}
+
+function parseNumberContent(text, decimal) {
+    let separator = decimal;
+    if (decimal === 'auto') {
+        separator = text.includes('.') || !text.includes(',') ? '.' : ',';
+    }
+    if (separator === ',') {
+        if (text.includes('.')) return NaN;
+        text = text.replace(',', '.');
+    }
+    return NUMBER.test(text) ? Number(text) : NaN;
+}
+
+/**
+ * Days since 1970-01-01 of a proleptic Gregorian date
+ */
+function daysFromCivil(year, month, day) {
+    year -= month <= 2 ? 1 : 0;
+    const era = Math.floor(year / 400);
+    const yearOfEra = year - era * 400;
+    const dayOfYear = Math.floor((153 * (month > 2 ? month - 3 : month + 9) + 2) / 5) + day - 1;
+    const dayOfEra = yearOfEra * 365 + Math.floor(yearOfEra / 4) - Math.floor(yearOfEra / 100) + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Column types from the first inferRows rows
+ */
+function inferTypes(rows, options) {
+    const counts = [];
+    for (let r = 0; r < Math.min(options.inferRows, rows.length); r++) {
+        const row = rows[r];
+        for (let c = 0; c < Math.min(row.length, MAX_COLUMNS); c++) {
+            if (!counts[c]) counts[c] = { empty: 0, number: 0, pair: 0, datetime: 0, text: 0 };
+            counts[c][CsvIngest.classify(row[c], options.decimal)]++;
+        }
+    }
+
+    return counts.map(count => {
+        let best = TYPE_ORDER[0];
+        for (const type of TYPE_ORDER) {
+            if (count[type] > count[best]) best = type;
+        }
+        if (count[best] === 0) return count.text > 0 ? 'text' : 'empty';
+        return count.text > count[best] ? 'text' : best;
+    });
+}
+
+function parseColumn(rows, c, type, decimal) {
+    const column = { type, invalid: 0 };
+    if (type === 'pair') {
+        column.x = new Float64Array(rows.length).fill(NaN);
+        column.y = new Float64Array(rows.length).fill(NaN);
+    } else if (type === 'number' || type === 'datetime') {
+        column.values = new Float64Array(rows.length).fill(NaN);
+    } else {
+        return column;
+    }
+
+    for (let r = 0; r < rows.length; r++) {
+        const text = fieldContent(rows[r][c]);
+        if (text === '') continue;
+
+        if (type === 'pair') {
+            const pair = CsvIngest.parsePair(text);
+            if (pair) {
+                column.x[r] = pair.x;
+                column.y[r] = pair.y;
+            } else {
+                column.invalid++;
+            }
+        } else {
+            const value = type === 'number' ? CsvIngest.parseNumber(text, decimal) : CsvIngest.parseDateTime(text);
+            if (isNaN(value)) column.invalid++;
+            else column.values[r] = value;
+        }
+    }
+    return column;
+}
+
+module.exports = CsvIngest;
@@ -0,0 +1,63 @@
+/**
+ * CsvParseJobs - Running parses of the sensor CSV services
+ * One parse per experiment: later requests join the running one, and the
+ * reader's preview (see CsvIngest progress reports) is served while it runs.
+ */
+
+class CsvParseJobs {
+    constructor() {
+        // experimentId → { promise, reader, startedAt }
+        this.jobs = new Map();
+    }
+
+    /**
+     * Run a parse, or join the one already running for the experiment
+     * @param {string} experimentId - Experiment ID
+     * @param {Function} parse - async (job) => result; sets job.reader as soon
+     *        as the reader exists so its preview can be served
+     * @returns {Promise<Object>} Result of parse
+     */
+    async run(experimentId, parse) {
+        const running = this.jobs.get(experimentId);
+        if (running) {
+            return await running.promise;
+        }
+
+        const job = { promise: null, reader: null, startedAt: new Date() };
+        job.promise = parse(job);
+        this.jobs.set(experimentId, job);
+
+        try {
+            return await job.promise;
+        } finally {
+            this.jobs.delete(experimentId);
+        }
+    }
+
+    /**
+     * Overview of a running parse, for a rough plot before the data is ready
+     * @param {string} experimentId - Experiment ID
+     * @returns {Object|null} { rows, bytesParsed, fileSize, progress, rowsPerBucket, time,
+     *          channels: { [channelId]: { min, max } }, startedAt } or null when there is none yet
+     */
+    getPreview(experimentId) {
+        const job = this.jobs.get(experimentId);
+        const preview = job && job.reader ? job.reader.getPreview() : null;
+        if (!preview) return null;
+
+        // Plain arrays for JSON (NaN for empty buckets becomes null)
+        const channels = {};
+        for (const [channelId, envelope] of Object.entries(preview.channels)) {
+            channels[channelId] = { min: Array.from(envelope.min), max: Array.from(envelope.max) };
+        }
+
+        return {
+            ...preview,
+            time: Array.from(preview.time),
+            channels,
+            startedAt: job.startedAt
+        };
+    }
+}
+
+module.exports = CsvParseJobs;
@@ -0,0 +1,371 @@
+/**
+ * Downsampler - Shared resampling kernels for all data processors
+ * Picks the samples of a channel range worth plotting: decimation, MinMax
+ * envelope, M4, RMS per bucket, LTTB and MinMaxLTTB.
+ *
+ * Runs on the native downsampling addon (native/downsample, SSE2) for
+ * Float32Array/Float64Array channels and falls back to the JS kernels below
+ * otherwise. Both follow the same rules and give identical results:
+ * - buckets split [start, start + count) at start + floor(count * b / buckets)
+ * - extremes ignore NaN and report the first occurrence; a bucket without a
+ *   number reports its first sample
+ * - sums run in two interleaved partial sums (even and odd offsets from the
+ *   range start), the order of the SIMD lanes
+ *
+ * A channel is {values, time} or, for implicit time axes, {values,
+ * timeStart, timeStep}; x coordinates of the latter are sample indices.
+ * Results are {time: Array, values: Array}.
+ */
+
+const path = require('path');
+
+/**
+ * Load the native downsampling addon
+ * @returns {Object|null} Native module, or null to use the JS kernels
+ */
+function loadNativeDownsampler() {
+    const possiblePaths = [
+        '../native/downsample/build/Release/downsample_native.node',
+        './native/downsample/build/Release/downsample_native.node',
+        path.join(__dirname, '../native/downsample/build/Release/downsample_native.node')
+    ];
+
+    for (const modulePath of possiblePaths) {
+        try {
+            const nativeModule = require(modulePath);
+            console.log(`Loaded native downsampler from: ${modulePath} (SIMD: ${nativeModule.simd})`);
+            return nativeModule;
+        } catch (e) {
+            // Continue to next path
+        }
+    }
+
+    console.log('Native downsampler not available, using JS kernels (run "npm run build-downsample")');
+    return null;
+}
+
+let nativeDownsampler;
+
+function getNativeDownsampler() {
+    if (nativeDownsampler === undefined) {
+        nativeDownsampler = loadNativeDownsampler();
+    }
+    return nativeDownsampler;
+}
+
+function isFloatArray(array) {
+    return array instanceof Float32Array || array instanceof Float64Array;
+}
+
+/**
+ * Native module if it can take the channel's values (and time array)
+ */
+function nativeFor(channel) {
+    if (!isFloatArray(channel.values)) return null;
+    if (channel.time && !isFloatArray(channel.time)) return null;
+    return getNativeDownsampler();
+}
+
+class Downsampler {
+    /**
+     * Every step-th sample of [start, start + count), step = ceil(count / maxPoints)
+     */
+    static decimate(channel, start, count, maxPoints) {
+        const step = Math.ceil(count / maxPoints);
+        const indices = [];
+        for (let i = 0; i < count; i += step) {
+            indices.push(start + i);
+        }
+        return Downsampler.points(channel, indices);
+    }
+
+    /**
+     * Minimum and maximum of each of buckets buckets (at most count)
+     * @returns {Object} {min, max, minIndex, maxIndex}
+     */
+    static envelope(values, start, count, buckets) {
+        const native = isFloatArray(values) ? getNativeDownsampler() : null;
+        let minIndex, maxIndex;
+        if (native) {
+            ({ minIndex, maxIndex } = native.envelope(values, start, count, buckets));
+        } else {
+            buckets = Math.min(buckets, count);
+            minIndex = new Float64Array(buckets);
+            maxIndex = new Float64Array(buckets);
+            for (let b = 0; b < buckets; b++) {
+                const extremes = scanExtremes(values, bucketStart(start, count, buckets, b),
+                    bucketStart(start, count, buckets, b + 1));
+                minIndex[b] = extremes.minIndex;
+                maxIndex[b] = extremes.maxIndex;
+            }
+        }
+
+        const min = new Float64Array(minIndex.length);
+        const max = new Float64Array(maxIndex.length);
+        for (let b = 0; b < minIndex.length; b++) {
+            min[b] = values[minIndex[b]];
+            max[b] = values[maxIndex[b]];
+        }
+        return { min, max, minIndex, maxIndex };
+    }
+
+    /**
+     * Time/value points of an envelope: the minimum and maximum of each
+     * bucket in sample order (one point if they coincide)
+     */
+    static envelopePoints(channel, envelope) {
+        const time = [];
+        const values = [];
+        for (let b = 0; b < envelope.min.length; b++) {
+            const minIndex = envelope.minIndex[b];
+            const maxIndex = envelope.maxIndex[b];
+            if (minIndex === maxIndex) {
+                time.push(timeAt(channel, minIndex));
+                values.push(envelope.min[b]);
+            } else if (minIndex < maxIndex) {
+                time.push(timeAt(channel, minIndex), timeAt(channel, maxIndex));
+                values.push(envelope.min[b], envelope.max[b]);
+            } else {
+                time.push(timeAt(channel, maxIndex), timeAt(channel, minIndex));
+                values.push(envelope.max[b], envelope.min[b]);
+            }
+        }
+        return { time, values };
+    }
+
+    /**
+     * MinMax: the envelope of maxPoints / 2 buckets
+     */
+    static minMax(channel, start, count, maxPoints) {
+        const buckets = Math.max(1, Math.floor(maxPoints / 2));
+        return Downsampler.envelopePoints(channel, Downsampler.envelope(channel.values, start, count, buckets));
+    }
+
+    /**
+     * M4: first, minimum, maximum and last sample of each of maxPoints / 4
+     * buckets
+     */
+    static m4(channel, start, count, maxPoints) {
+        let buckets = Math.max(1, Math.floor(maxPoints / 4));
+        const native = nativeFor(channel);
+        if (native) {
+            return Downsampler.points(channel, native.m4(channel.values, start, count, buckets));
+        }
+
+        const indices = [];
+        buckets = Math.min(buckets, count);
+        for (let b = 0; b < buckets; b++) {
+            const first = bucketStart(start, count, buckets, b);
+            const last = bucketStart(start, count, buckets, b + 1);
+            const extremes = scanExtremes(channel.values, first, last);
+            const picks = [first, extremes.minIndex, extremes.maxIndex, last - 1].sort((a, c) => a - c);
+            for (const pick of picks) {
+                if (indices.length === 0 || indices[indices.length - 1] !== pick) indices.push(pick);
+            }
+        }
+        return Downsampler.points(channel, indices);
+    }
+
+    /**
+     * Root mean square of each of buckets buckets, at the mean time of the bucket
+     */
+    static rms(channel, start, count, buckets) {
+        const native = nativeFor(channel);
+        let x, rms;
+        if (native) {
+            ({ x, values: rms } = native.rms(channel.values, channel.time || null, start, count, buckets));
+        } else {
+            buckets = Math.min(buckets, count);
+            x = new Float64Array(buckets);
+            rms = new Float64Array(buckets);
+            const values = channel.values;
+            const xAt = axisOf(channel);
+            for (let b = 0; b < buckets; b++) {
+                const first = bucketStart(start, count, buckets, b);
+                const last = bucketStart(start, count, buckets, b + 1);
+                const n = last - first;
+                rms[b] = Math.sqrt(sumTerms(i => values[i] * values[i], first, last) / n);
+                x[b] = sumTerms(xAt, first, last) / n;
+            }
+        }
+
+        const time = new Array(x.length);
+        for (let b = 0; b < x.length; b++) {
+            time[b] = channel.time ? x[b] : channel.timeStart + x[b] * channel.timeStep;
+        }
+        return { time, values: Array.from(rms) };
+    }
+
+    /**
+     * Largest-Triangle-Three-Buckets down to threshold samples
+     */
+    static lttb(channel, start, count, threshold) {
+        const native = nativeFor(channel);
+        if (native) {
+            return Downsampler.points(channel, native.lttb(channel.values, channel.time || null, start, count, threshold));
+        }
+        return Downsampler.points(channel, lttbOver(channel, k => start + k, count, threshold));
+    }
+
+    /**
+     * MinMaxLTTB: LTTB over the extremes of threshold * ratio / 2 buckets.
+     * Near-LTTB shape at a fraction of the cost on long ranges.
+     */
+    static minMaxLttb(channel, start, count, threshold, ratio = 4) {
+        const native = nativeFor(channel);
+        if (native) {
+            return Downsampler.points(channel,
+                native.minMaxLttb(channel.values, channel.time || null, start, count, threshold, ratio));
+        }
+
+        if (count <= threshold || count <= 2 || threshold < 3) {
+            return Downsampler.lttb(channel, start, count, threshold);
+        }
+
+        const envelope = Downsampler.envelope(channel.values, start + 1, count - 2,
+            Math.max(1, Math.floor(threshold * Math.max(1, ratio) / 2)));
+        const candidates = [start];
+        for (let b = 0; b < envelope.minIndex.length; b++) {
+            const a = Math.min(envelope.minIndex[b], envelope.maxIndex[b]);
+            const c = Math.max(envelope.minIndex[b], envelope.maxIndex[b]);
+            candidates.push(a);
+            if (c !== a) candidates.push(c);
+        }
+        candidates.push(start + count - 1);
+
+        if (candidates.length <= threshold) {
+            return Downsampler.points(channel, candidates);
+        }
+        return Downsampler.points(channel, lttbOver(channel, k => candidates[k], candidates.length, threshold));
+    }
+
+    /**
+     * Time/value points of sample indices
+     */
+    static points(channel, indices) {
+        const time = new Array(indices.length);
+        const values = new Array(indices.length);
+        for (let k = 0; k < indices.length; k++) {
+            time[k] = timeAt(channel, indices[k]);
+            values[k] = channel.values[indices[k]];
+        }
+        return { time, values };
+    }
+
+    /**
+     * SIMD level of the native kernels, or null when running the JS kernels
+     */
+    static get simd() {
+        const native = getNativeDownsampler();
+        return native ? native.simd : null;
+    }
+}
+
+// === JS KERNELS ===
+
+function bucketStart(start, count, buckets, b) {
+    return start + Math.floor(count * b / buckets);
+}
+
+function timeAt(channel, index) {
+    return channel.time ? channel.time[index] : channel.timeStart + index * channel.timeStep;
+}
+
+/**
+ * x coordinate of a sample: its time, or its index on implicit time axes
+ */
+function axisOf(channel) {
+    const time = channel.time;
+    return time ? i => time[i] : i => i;
+}
+
+/**
+ * Indices of the first minimum and maximum of [first, last), NaN ignored
+ */
+function scanExtremes(values, first, last) {
+    let min = Infinity;
+    let max = -Infinity;
+    let minIndex = first;
+    let maxIndex = first;
+    for (let i = first; i < last; i++) {
+        const value = values[i];
+        if (value < min) {
+            min = value;
+            minIndex = i;
+        }
+        if (value > max) {
+            max = value;
+            maxIndex = i;
+        }
+    }
+    return { minIndex, maxIndex };
+}
+
+/**
+ * Sum of term(i) over [first, last) in the two-lane order
+ */
+function sumTerms(term, first, last) {
+    let lane0 = 0;
+    let lane1 = 0;
+    let i = first;
+    for (; i + 2 <= last; i += 2) {
+        lane0 += term(i);
+        lane1 += term(i + 1);
+    }
+    if (i < last) lane0 += term(i);
+    return lane0 + lane1;
+}
+
+/**
+ * LTTB over n points, point k being sample at(k); returns sample indices
+ */
+function lttbOver(channel, at, n, threshold) {
+    const indices = [];
+    if (n === 0 || threshold === 0) return indices;
+    if (threshold < 3) {
+        indices.push(at(0));
+        if (threshold === 2 && n > 1) indices.push(at(n - 1));
+        return indices;
+    }
+    if (n <= threshold) {
+        for (let k = 0; k < n; k++) indices.push(at(k));
+        return indices;
+    }
+
+    const values = channel.values;
+    const xAt = axisOf(channel);
+    const every = (n - 2) / (threshold - 2);
+    let a = 0;
+    indices.push(at(0));
+
+    for (let i = 0; i < threshold - 2; i++) {
+        // Average of the next bucket (the last point for the final one)
+        const avgFirst = Math.floor((i + 1) * every) + 1;
+        const avgLast = Math.min(Math.floor((i + 2) * every) + 1, n);
+        const avgCount = avgLast - avgFirst;
+        const avgX = sumTerms(k => xAt(at(k)), avgFirst, avgLast) / avgCount;
+        const avgY = sumTerms(k => values[at(k)], avgFirst, avgLast) / avgCount;
+
+        const first = Math.floor(i * every) + 1;
+        const last = Math.floor((i + 1) * every) + 1;
+        const ax = xAt(at(a));
+        const ay = values[at(a)];
+
+        let maxArea = -1;
+        let next = first;
+        for (let k = first; k < last; k++) {
+            const area = Math.abs((ax - avgX) * (values[at(k)] - ay) - (ax - xAt(at(k))) * (avgY - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                next = k;
+            }
+        }
+        indices.push(at(next));
+        a = next;
+    }
+
+    indices.push(at(n - 1));
+    return indices;
+}
+
+module.exports = Downsampler;
@@ -4,12 +4,12 @@
  * Format: snapshot_optoNCDT-ILD1220_*.csv files
  * Columns: DateTime, UnixTime, RawPosition (tab-separated)
  * 
- * Fixed: Uses Papa Parse and single-pass processing to avoid stack overflow on large files
+ * Parsed into typed columns by CsvIngest, then processed in a single pass
  */
 
 const fs = require('fs').promises;
 const path = require('path');
-const Papa = require('papaparse');
+const CsvIngest = require('./CsvIngest');
 
 class PositionCsvReader {
     constructor(filename) {
@@ -97,74 +97,6 @@ class PositionCsvReader {
         }
     }
 
-    /**
-     * Parse datetime string with microsecond precision
-     * Format: "yyyy-MM-dd HH:mm:ss.ffffff"
-     * @param {string} datetimeStr - DateTime string
-     * @returns {Date|null} Parsed date object
-     */
-    parseDateTime(datetimeStr) {
-        if (!datetimeStr || typeof datetimeStr !== 'string') {
-            return null;
-        }
-        
-        try {
-            // Clean the string
-            const cleaned = datetimeStr.trim();
-            
-            // Parse with microsecond precision: "2025-07-30 10:15:30.123456"
-            const match = cleaned.match(/^(\d{4})-(\d{2})-(\d{2}) (\d{2}):(\d{2}):(\d{2})\.(\d{6})$/);
-            if (!match) {
-                return null;
-            }
-            
-            const [, year, month, day, hour, minute, second, microseconds] = match;
-            
-            // Create date object (month is 0-based in JavaScript)
-            const date = new Date(
-                parseInt(year), 
-                parseInt(month) - 1, 
-                parseInt(day),
-                parseInt(hour),
-                parseInt(minute),
-                parseInt(second),
-                Math.floor(parseInt(microseconds) / 1000) // Convert microseconds to milliseconds
-            );
-            
-            // Validate the created date
-            if (isNaN(date.getTime())) {
-                return null;
-            }
-            
-            return date;
-            
-        } catch (error) {
-            console.warn(`Error parsing datetime "${datetimeStr}":`, error.message);
-            return null;
-        }
-    }
-
-    /**
-     * Parse numeric value (position or time)
-     * @param {string} value - Numeric string
-     * @returns {number} Parsed number
-     */
-    parseNumber(value) {
-        if (!value || typeof value !== 'string') {
-            return NaN;
-        }
-        
-        // Clean and parse
-        const cleaned = value.trim().replace(/"/g, '');
-        
-        if (cleaned === '') {
-            return NaN;
-        }
-        
-        const number = parseFloat(cleaned);
-        return isNaN(number) ? NaN : number;
-    }
-
     /**
      * Main file reading method
      * @returns {Promise<void>}
@@ -182,36 +114,24 @@ class PositionCsvReader {
                 }
             }
 
-            // Read entire file
-            const fileReadStart = process.hrtime.bigint();
-            const fileContent = await fs.readFile(this.filename, 'utf8');
-            const fileReadTime = Number(process.hrtime.bigint() - fileReadStart) / 1e9;
-            
-            console.log(`File loaded: ${(fileContent.length / 1024).toFixed(1)} KB in ${fileReadTime.toFixed(2)}s`);
-            
-            // Parse CSV with Papa Parse (configured for tab-delimited)
+            // Parse into typed columns: native ingester (mapped file, SIMD
+            // field scan) when built, Papa Parse otherwise
             const parseStart = process.hrtime.bigint();
-            const parseResult = Papa.parse(fileContent, {
-                header: false, // Position CSV has no headers
-                skipEmptyLines: true,
+            const csv = await CsvIngest.parseFile(this.filename, {
                 delimiter: '\t', // Tab-delimited
-                dynamicTyping: false, // We'll handle parsing manually
-                comments: '#' // Skip comment lines
+                comment: '#', // Skip comment lines
+                types: ['datetime', 'number', 'number'],
+                prefixRows: 0 // Position CSV has no headers
             });
-            
-            if (parseResult.errors.length > 0) {
-                console.warn('CSV parsing warnings:', parseResult.errors.slice(0, 5)); // Show first 5 errors only
-            }
-            
             const parseTime = Number(process.hrtime.bigint() - parseStart) / 1e9;
-            const rawData = parseResult.data;
+            this.processingStats.parser = csv.parser;
             
-            console.log(`CSV parsed: ${rawData.length} rows in ${parseTime.toFixed(2)}s`);
+            console.log(`CSV parsed (${csv.parser}): ${csv.rows} rows in ${parseTime.toFixed(2)}s`);
             
             // Process data in single pass
             console.log('Processing position data...');
             const dataProcessStart = process.hrtime.bigint();
-            await this.processPositionData(rawData);
+            await this.processPositionData(csv);
             const dataProcessTime = Number(process.hrtime.bigint() - dataProcessStart) / 1e9;
             
             // Store comprehensive metadata
@@ -223,7 +143,7 @@ class PositionCsvReader {
                 processedAt: new Date(),
                 
                 // CSV-specific metadata
-                totalLines: rawData.length,
+                totalLines: csv.rows,
                 validDataLines: this.positionData.pos_x ? this.positionData.pos_x.points : 0,
                 formatInfo: {
                     type: 'position_tab_delimited',
@@ -237,7 +157,6 @@ class PositionCsvReader {
                 // Processing statistics
                 processingStats: {
                     ...this.processingStats,
-                    fileReadTime,
                     parseTime,
                     dataProcessTime,
                     totalProcessingTime: Number(process.hrtime.bigint() - overallStartTime) / 1e9
@@ -245,7 +164,6 @@ class PositionCsvReader {
             };
             
             console.log(`Position data processing completed:`);
-            console.log(`- File read: ${fileReadTime.toFixed(2)}s`);
             console.log(`- Parse: ${parseTime.toFixed(2)}s`);
             console.log(`- Data process: ${dataProcessTime.toFixed(2)}s`);
             console.log(`- Total: ${this.metadata.processingStats.totalProcessingTime.toFixed(2)}s`);
@@ -258,96 +176,62 @@ class PositionCsvReader {
     }
 
     /**
-     * Process position data from parsed CSV - SINGLE PASS VERSION
-     * @param {Array} rawData - Papa Parse data rows (array of arrays)
+     * Process position data from the parsed columns - SINGLE PASS VERSION
+     * @param {Object} csv - CsvIngest result (datetime, unix time, raw position)
      */
-    async processPositionData(rawData) {
-        if (rawData.length === 0) {
+    async processPositionData(csv) {
+        if (csv.rows === 0) {
             throw new Error('No data rows found in CSV file');
         }
         
-        console.log(`Processing ${rawData.length} CSV rows...`);
+        console.log(`Processing ${csv.rows} CSV rows...`);
         
-        // Pre-allocate arrays with estimated size (we'll trim later)
-        const maxRows = rawData.length;
-        const tempRelativeTime = new Array(maxRows);
-        const tempTransformedPositions = new Array(maxRows);
-        const tempDatetimes = new Array(maxRows);
-        const tempUnixTimes = new Array(maxRows);
+        const datetimes = csv.columns[0].values; // wall-clock ms
+        const unixTimes = csv.columns[1].values;
+        const rawPositions = csv.columns[2].values;
+        
+        // Pre-allocate arrays with the row count (we'll trim later)
+        const relativeTime = new Float32Array(csv.rows);
+        const transformedPositions = new Float32Array(csv.rows);
         
         let validCount = 0;
         let skippedCount = 0;
         let startUnixTime = null;
+        let firstRow = -1;
+        let lastRow = -1;
         
         // Single pass through all data
-        for (let i = 0; i < rawData.length; i++) {
-            const row = rawData[i];
-            
-            // Skip rows that don't have 3 columns
-            if (!row || row.length < 3) {
-                skippedCount++;
-                continue;
-            }
+        for (let i = 0; i < csv.rows; i++) {
+            const unixTime = unixTimes[i];
+            const rawPosition = rawPositions[i];
             
-            try {
-                // Parse datetime (field 0)
-                const datetime = this.parseDateTime(row[0]);
-                if (!datetime) {
-                    skippedCount++;
-                    if (validCount < 5) {
-                        console.warn(`Row ${i + 1}: Invalid datetime format: "${row[0]}"`);
-                    }
-                    continue;
-                }
-                
-                // Parse unix time (field 1)
-                const unixTime = this.parseNumber(row[1]);
-                if (isNaN(unixTime)) {
-                    skippedCount++;
-                    if (validCount < 5) {
-                        console.warn(`Row ${i + 1}: Invalid unix time: "${row[1]}"`);
-                    }
-                    continue;
-                }
-                
-                // Parse raw position (field 2)
-                const rawPosition = this.parseNumber(row[2]);
-                if (isNaN(rawPosition)) {
-                    skippedCount++;
-                    if (validCount < 5) {
-                        console.warn(`Row ${i + 1}: Invalid position value: "${row[2]}"`);
-                    }
-                    continue;
-                }
-                
-                // Set start time on first valid record
-                if (startUnixTime === null) {
-                    startUnixTime = unixTime;
-                }
-                
-                // Store data - do all transformations in single pass
-                tempDatetimes[validCount] = datetime;
-                tempUnixTimes[validCount] = unixTime;
-                
-                // Convert to relative time (microseconds from start)
-                tempRelativeTime[validCount] = (unixTime - startUnixTime) * 1000;
-                
-                // Transform position (apply -1 * raw + 49.73)
-                tempTransformedPositions[validCount] = -1 * rawPosition + 49.73;
-                
-                validCount++;
-                
-                if (validCount <= 5) {
-                    console.log(`Row ${i + 1}: DateTime=${datetime.toISOString()}, UnixTime=${unixTime}, RawPos=${rawPosition}, TransformedPos=${tempTransformedPositions[validCount - 1].toFixed(3)}`);
-                }
-                
-            } catch (error) {
+            // Skip rows without a valid datetime, unix time and raw position
+            if (isNaN(datetimes[i]) || isNaN(unixTime) || isNaN(rawPosition)) {
                 skippedCount++;
                 if (validCount < 5) {
-                    console.warn(`Row ${i + 1}: Parse error: ${error.message}`);
+                    console.warn(`Row ${i + 1}: Invalid or missing datetime, unix time or position value`);
                 }
                 continue;
             }
+            
+            // Set start time on first valid record
+            if (startUnixTime === null) {
+                startUnixTime = unixTime;
+                firstRow = i;
+            }
+            lastRow = i;
+            
+            // Convert to relative time (microseconds from start)
+            relativeTime[validCount] = (unixTime - startUnixTime) * 1000;
+            
+            // Transform position (apply -1 * raw + 49.73)
+            transformedPositions[validCount] = -1 * rawPosition + 49.73;
+            
+            validCount++;
+            
+            if (validCount <= 5) {
+                console.log(`Row ${i + 1}: DateTime=${CsvIngest.toLocalDate(datetimes[i]).toISOString()}, UnixTime=${unixTime}, RawPos=${rawPosition}, TransformedPos=${transformedPositions[validCount - 1].toFixed(3)}`);
+            }
         }
         
         if (validCount === 0) {
@@ -356,19 +240,14 @@ class PositionCsvReader {
         
         console.log(`Processing complete: ${validCount} valid rows, ${skippedCount} skipped`);
         
-        // Create final typed arrays with exact size
-        const finalRelativeTime = new Float32Array(validCount);
-        const finalTransformedPositions = new Float32Array(validCount);
-        
-        for (let i = 0; i < validCount; i++) {
-            finalRelativeTime[i] = tempRelativeTime[i];
-            finalTransformedPositions[i] = tempTransformedPositions[i];
-        }
+        // Trim to the valid rows
+        const finalRelativeTime = relativeTime.slice(0, validCount);
+        const finalTransformedPositions = transformedPositions.slice(0, validCount);
         
         // Calculate sampling rate (approximate)
         let samplingRate = 1000.0; // Default 1 kHz
         if (validCount > 1) {
-            const totalTime = tempUnixTimes[validCount - 1] - tempUnixTimes[0];
+            const totalTime = unixTimes[lastRow] - unixTimes[firstRow];
             const avgInterval = totalTime / (validCount - 1);
             samplingRate = avgInterval > 0 ? 1.0 / avgInterval : 1000.0;
         }
@@ -386,13 +265,13 @@ class PositionCsvReader {
             
             // Additional metadata
             rawTimeRange: {
-                start: tempUnixTimes[0],
-                end: tempUnixTimes[validCount - 1],
-                duration: tempUnixTimes[validCount - 1] - tempUnixTimes[0]
+                start: unixTimes[firstRow],
+                end: unixTimes[lastRow],
+                duration: unixTimes[lastRow] - unixTimes[firstRow]
             },
             datetimeRange: {
-                start: tempDatetimes[0],
-                end: tempDatetimes[validCount - 1]
+                start: CsvIngest.toLocalDate(datetimes[firstRow]),
+                end: CsvIngest.toLocalDate(datetimes[lastRow])
             }
         };
         
@@ -4,6 +4,8 @@
  * Implements the complex interpolation logic from the C# codebase
  */
 
+const Downsampler = require('./Downsampler');
+
 class PositionDataProcessor {
     constructor(positionData, metadata) {
         this.positionData = positionData;
@@ -187,73 +189,14 @@ class PositionDataProcessor {
         
         if (totalPoints <= maxPoints * 2) {
             // Use simple decimation for moderate oversampling
-            const step = Math.ceil(totalPoints / maxPoints);
-            const resampledTime = [];
-            const resampledValues = [];
-            
-            for (let i = startIdx; i <= endIdx; i += step) {
-                resampledTime.push(channelData.time[i]);
-                resampledValues.push(channelData.values[i]);
-            }
-            
-            return { time: resampledTime, values: resampledValues };
+            return Downsampler.decimate(channelData, startIdx, totalPoints, maxPoints);
         } else {
-            // Use min-max resampling for heavy oversampling to preserve spikes
-            return this._minMaxResample(channelData, startIdx, endIdx, maxPoints);
+            // M4 for heavy oversampling: first, min, max and last of each
+            // bucket keep spikes and the line between buckets exact
+            return Downsampler.m4(channelData, startIdx, totalPoints, maxPoints);
         }
     }
 
-    /**
-     * Min-max resampling to preserve spikes and important features
-     * @private
-     */
-    _minMaxResample(channelData, startIdx, endIdx, maxPoints) {
-        const totalPoints = endIdx - startIdx + 1;
-        const bucketSize = Math.ceil(totalPoints / (maxPoints / 2)); // Use half points for min-max pairs
-        
-        const resampledTime = [];
-        const resampledValues = [];
-        
-        for (let bucketStart = startIdx; bucketStart < endIdx; bucketStart += bucketSize) {
-            const bucketEnd = Math.min(bucketStart + bucketSize - 1, endIdx);
-            
-            // Find min and max in this bucket
-            let minVal = channelData.values[bucketStart];
-            let maxVal = channelData.values[bucketStart];
-            let minIdx = bucketStart;
-            let maxIdx = bucketStart;
-            
-            for (let i = bucketStart + 1; i <= bucketEnd; i++) {
-                const val = channelData.values[i];
-                if (val < minVal) {
-                    minVal = val;
-                    minIdx = i;
-                }
-                if (val > maxVal) {
-                    maxVal = val;
-                    maxIdx = i;
-                }
-            }
-            
-            // Add min and max points (in time order)
-            if (minIdx <= maxIdx) {
-                if (minIdx !== maxIdx) {
-                    resampledTime.push(channelData.time[minIdx]);
-                    resampledValues.push(minVal);
-                }
-                resampledTime.push(channelData.time[maxIdx]);
-                resampledValues.push(maxVal);
-            } else {
-                resampledTime.push(channelData.time[maxIdx]);
-                resampledValues.push(maxVal);
-                resampledTime.push(channelData.time[minIdx]);
-                resampledValues.push(minVal);
-            }
-        }
-        
-        return { time: resampledTime, values: resampledValues };
-    }
-
     /**
      * Binary search for time index
      * @param {Float32Array} timeArray - Time array
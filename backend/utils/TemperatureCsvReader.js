@@ -6,7 +6,7 @@
 
 const fs = require('fs').promises;
 const path = require('path');
-const Papa = require('papaparse');
+const CsvIngest = require('./CsvIngest');
 
 class TemperatureCsvReader {
     constructor(filename) {
@@ -15,6 +15,9 @@ class TemperatureCsvReader {
         this.temperatureData = {};
         this.processingStats = {};
         
+        // Overview of the rows parsed so far, while readFile runs
+        this.preview = null;
+        
         // Channel mapping for different CSV formats
         this.channelMapping = {};
         
@@ -234,37 +237,29 @@ class TemperatureCsvReader {
                 }
             }
 
-            // Read entire file
-            const fileReadStart = process.hrtime.bigint();
-            const csvContent = await fs.readFile(this.filename, 'utf8');
-            const fileReadTime = Number(process.hrtime.bigint() - fileReadStart) / 1e9;
-            
-            console.log(`File loaded: ${(csvContent.length / 1024).toFixed(1)} KB in ${fileReadTime.toFixed(2)}s`);
-            
-            // Parse CSV with Papa Parse
+            // Parse into typed columns: native ingester (mapped file, SIMD
+            // field scan) when built, Papa Parse otherwise. Quoted German
+            // decimals ("22,639746") parse as numbers.
             const parseStart = process.hrtime.bigint();
-            const parseResult = Papa.parse(csvContent, {
-                header: true,
-                skipEmptyLines: true,
-                delimiter: ',', // Try comma first
-                dynamicTyping: false, // We'll handle number parsing manually
-                transformHeader: (header) => header.trim() // Clean headers
-            });
-            
-            if (parseResult.errors.length > 0) {
-                console.warn('CSV parsing warnings:', parseResult.errors);
-            }
-            
+            const csv = await CsvIngest.parseFile(this.filename, {
+                delimiter: ',',
+                decimal: 'auto',
+                prefixRows: 1 // header row
+            }, (progress) => this._updatePreview(progress));
+            const previewFormat = this.preview ? this.preview.formatInfo : null;
+            this.preview = null;
             const parseTime = Number(process.hrtime.bigint() - parseStart) / 1e9;
+            this.processingStats.parser = csv.parser;
             
-            const rawData = parseResult.data;
-            const headers = parseResult.meta.fields;
+            const headers = csv.prefixRows[0] || [];
+            const dataRowCount = Math.max(0, csv.rows - 1);
             
-            console.log(`CSV parsed: ${rawData.length} rows, ${headers.length} columns in ${parseTime.toFixed(2)}s`);
+            console.log(`CSV parsed (${csv.parser}): ${dataRowCount} rows, ${headers.length} columns in ${parseTime.toFixed(2)}s`);
             console.log('Headers found:', headers);
             
-            // Detect format and map channels
-            const formatInfo = this.detectCsvFormat(headers);
+            // Detect format and map channels (already done for the preview
+            // when the native parser reported progress)
+            const formatInfo = previewFormat || this.detectCsvFormat(headers);
             
             if (Object.keys(this.channelMapping).length === 0) {
                 throw new Error('No temperature channels detected in CSV file');
@@ -273,7 +268,7 @@ class TemperatureCsvReader {
             // Process data
             console.log('Processing temperature data...');
             const dataProcessStart = process.hrtime.bigint();
-            await this.processTemperatureData(rawData, headers);
+            await this.processTemperatureData(csv, headers);
             const dataProcessTime = Number(process.hrtime.bigint() - dataProcessStart) / 1e9;
             
             // Store comprehensive metadata
@@ -285,7 +280,7 @@ class TemperatureCsvReader {
                 processedAt: new Date(),
                 
                 // CSV-specific metadata
-                rowCount: rawData.length,
+                rowCount: dataRowCount,
                 columnCount: headers.length,
                 headers: headers,
                 formatInfo: formatInfo,
@@ -294,7 +289,6 @@ class TemperatureCsvReader {
                 // Processing statistics
                 processingStats: {
                     ...this.processingStats,
-                    fileReadTime,
                     parseTime,
                     dataProcessTime,
                     totalProcessingTime: Number(process.hrtime.bigint() - overallStartTime) / 1e9
@@ -302,7 +296,6 @@ class TemperatureCsvReader {
             };
             
             console.log(`Temperature data processing completed:`);
-            console.log(`- File read: ${fileReadTime.toFixed(2)}s`);
             console.log(`- CSV parse: ${parseTime.toFixed(2)}s`);
             console.log(`- Data process: ${dataProcessTime.toFixed(2)}s`);
             console.log(`- Total: ${this.metadata.processingStats.totalProcessingTime.toFixed(2)}s`);
@@ -315,12 +308,12 @@ class TemperatureCsvReader {
     }
 
     /**
-     * Process temperature data from parsed CSV
-     * @param {Array} rawData - Parsed CSV data rows
+     * Process temperature data from the parsed columns
+     * @param {Object} csv - CsvIngest result (row 0 holds the headers)
      * @param {Array} headers - CSV column headers
      */
-    async processTemperatureData(rawData, headers) {
-        if (rawData.length === 0) {
+    async processTemperatureData(csv, headers) {
+        if (csv.rows <= 1) {
             throw new Error('No data rows found in CSV file');
         }
         
@@ -330,68 +323,57 @@ class TemperatureCsvReader {
         
         console.log(`Using timestamp column: "${timestampHeader}" (index ${timestampColumnIndex})`);
         
-        // Extract timestamps and convert to numbers
-        const timestamps = [];
-        const validRowIndices = [];
+        // Rows with a valid timestamp
+        const timestampColumn = csv.columns[timestampColumnIndex];
+        const timestampValues = timestampColumn && timestampColumn.values;
+        const validRows = [];
         
-        for (let i = 0; i < rawData.length; i++) {
-            const row = rawData[i];
-            const timestampValue = Object.values(row)[timestampColumnIndex];
-            
-            if (timestampValue && timestampValue.trim() !== '') {
-                const timestamp = this.parseGermanNumber(timestampValue);
-                if (!isNaN(timestamp)) {
-                    timestamps.push(timestamp);
-                    validRowIndices.push(i);
+        if (timestampValues) {
+            for (let r = 1; r < csv.rows; r++) {
+                if (!isNaN(timestampValues[r])) {
+                    validRows.push(r);
                 }
             }
         }
         
-        if (timestamps.length === 0) {
+        if (validRows.length === 0) {
             throw new Error('No valid timestamps found in CSV data');
         }
         
-        console.log(`Found ${timestamps.length} valid data points out of ${rawData.length} total rows`);
-        
-        // Convert timestamps to relative time
-        const relativeTime = timestamps;  // Keep original Unix timestamps!
+        console.log(`Found ${validRows.length} valid data points out of ${csv.rows - 1} total rows`);
         
         // Calculate sampling rate
+        const firstTimestamp = timestampValues[validRows[0]];
+        const lastTimestamp = timestampValues[validRows[validRows.length - 1]];
         let samplingRate = 10.0; // Default 10 Hz
-        if (timestamps.length > 1) {
-            const avgInterval = (timestamps[timestamps.length - 1] - timestamps[0]) / (timestamps.length - 1);
+        if (validRows.length > 1) {
+            const avgInterval = (lastTimestamp - firstTimestamp) / (validRows.length - 1);
             samplingRate = 1.0 / avgInterval;
         }
         
         // Process each detected channel
         for (const [channelId, channelInfo] of Object.entries(this.channelMapping)) {
-            const columnIndex = channelInfo.columnIndex;
-            const values = new Float32Array(validRowIndices.length);
+            const column = csv.columns[channelInfo.columnIndex];
+            const columnValues = column && column.values;
+            const values = new Float32Array(validRows.length);
+            const time = new Float32Array(validRows.length);
             let validCount = 0;
             
-            // Extract temperature values for this channel
-            for (let i = 0; i < validRowIndices.length; i++) {
-                const rowIndex = validRowIndices[i];
-                const row = rawData[rowIndex];
-                const cellValue = Object.values(row)[columnIndex];
-                
-                if (cellValue && cellValue.trim() !== '') {
-                    const temperature = this.parseGermanNumber(cellValue);
+            // Temperature values with their timestamps (original Unix timestamps kept)
+            if (columnValues) {
+                for (const r of validRows) {
+                    const temperature = columnValues[r];
                     if (!isNaN(temperature)) {
                         values[validCount] = temperature;
+                        time[validCount] = timestampValues[r];
                         validCount++;
                     }
                 }
             }
             
             // Trim array to actual valid data
-            const trimmedValues = new Float32Array(validCount);
-            const trimmedTime = new Float32Array(validCount);
-            
-            for (let i = 0; i < validCount; i++) {
-                trimmedValues[i] = values[i];
-                trimmedTime[i] = relativeTime[i];
-            }
+            const trimmedValues = values.slice(0, validCount);
+            const trimmedTime = time.slice(0, validCount);
             
             // Store channel data
             this.temperatureData[channelId] = {
@@ -415,8 +397,71 @@ class TemperatureCsvReader {
         }
     }
 
+    /**
+     * Turn a parse progress report into the preview: per channel the min/max
+     * envelope of every rowsPerBucket rows, at the earliest timestamp of each
+     * @param {Object} progress - CsvIngest progress report
+     * @private
+     */
+    _updatePreview(progress) {
+        const { overview } = progress;
+        if (!this.preview) {
+            this.preview = {
+                formatInfo: this.detectCsvFormat(progress.prefixRows[0] || [])
+            };
+        }
+
+        const timestamps = overview.columns[0];
+        const channels = {};
+        if (timestamps) {
+            for (const [channelId, channelInfo] of Object.entries(this.channelMapping)) {
+                const column = overview.columns[channelInfo.columnIndex];
+                if (column) channels[channelId] = { min: column.min, max: column.max };
+            }
+        }
+
+        Object.assign(this.preview, {
+            rows: progress.rows,
+            bytesParsed: progress.bytesParsed,
+            fileSize: progress.fileSize,
+            rowsPerBucket: overview.rowsPerBucket,
+            time: timestamps ? this._relativePreviewTime(timestamps.min) : new Float64Array(0),
+            channels
+        });
+    }
+
+    /**
+     * Bucket start times in seconds from the first timestamp, like the
+     * channel data (NaN buckets stay NaN)
+     * @private
+     */
+    _relativePreviewTime(timestamps) {
+        const first = timestamps.find(t => !isNaN(t));
+        return first === undefined ? timestamps : timestamps.map(t => t - first);
+    }
+
     // === PUBLIC DATA ACCESS METHODS ===
 
+    /**
+     * Overview of the rows parsed so far, or null when no parse is running
+     * or the JS parser is in use
+     * @returns {Object|null} { rows, bytesParsed, fileSize, progress, rowsPerBucket, time, channels }
+     */
+    getPreview() {
+        if (!this.preview || !this.preview.time) return null;
+
+        const { rows, bytesParsed, fileSize, rowsPerBucket, time, channels } = this.preview;
+        return {
+            rows,
+            bytesParsed,
+            fileSize,
+            progress: fileSize > 0 ? bytesParsed / fileSize : 0,
+            rowsPerBucket,
+            time,
+            channels
+        };
+    }
+
     getMetadata() {
         return {
             ...this.metadata,
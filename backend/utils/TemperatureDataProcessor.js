@@ -4,6 +4,8 @@
  * Follows BinaryDataProcessor pattern without over-engineering
  */
 
+const Downsampler = require('./Downsampler');
+
 class TemperatureDataProcessor {
     constructor(temperatureData, metadata) {
         this.temperatureData = temperatureData;
@@ -51,17 +53,8 @@ class TemperatureDataProcessor {
                     values: Array.from(channelData.values.slice(startIdx, endIdx + 1))
                 };
             } else {
-                // Simple resampling - just take every nth point
-                const step = Math.floor(totalPoints / maxPoints);
-                const resampledTime = [];
-                const resampledValues = [];
-                
-                for (let i = startIdx; i <= endIdx; i += step) {
-                    resampledTime.push(channelData.time[i]);
-                    resampledValues.push(channelData.values[i]);
-                }
-                
-                return { time: resampledTime, values: resampledValues };
+                // LTTB keeps the visual shape of slow temperature curves
+                return Downsampler.lttb(channelData, startIdx, totalPoints, maxPoints);
             }
 
         } catch (error) {
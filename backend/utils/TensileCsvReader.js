@@ -12,7 +12,7 @@
 
 const fs = require('fs').promises;
 const path = require('path');
-const Papa = require('papaparse');
+const CsvIngest = require('./CsvIngest');
 
 class TensileCsvReader {
     constructor(filename) {
@@ -174,40 +174,6 @@ class TensileCsvReader {
         }
     }
 
-    /**
-     * Parse coordinate pair string: "{X=0.013733, Y=2.268685}"
-     * @param {string} coordStr - Coordinate string
-     * @returns {Object|null} {x: number, y: number}
-     */
-    parseCoordinatePair(coordStr) {
-        if (!coordStr || typeof coordStr !== 'string') {
-            return null;
-        }
-        
-        try {
-            const cleaned = coordStr.trim();
-            
-            // Parse format: {X=number, Y=number}
-            const match = cleaned.match(/\{X=([0-9.-]+),\s*Y=([0-9.-]+)\}/);
-            if (!match) {
-                return null;
-            }
-            
-            const x = parseFloat(match[1]);
-            const y = parseFloat(match[2]);
-            
-            if (isNaN(x) || isNaN(y)) {
-                return null;
-            }
-            
-            return { x, y };
-            
-        } catch (error) {
-            console.warn(`Error parsing coordinate pair "${coordStr}":`, error.message);
-            return null;
-        }
-    }
-
     /**
      * Parse numeric value with validation
      * @param {string} value - Numeric string
@@ -244,36 +210,26 @@ class TensileCsvReader {
                 }
             }
 
-            // Read entire file
-            const fileReadStart = process.hrtime.bigint();
-            const fileContent = await fs.readFile(this.filename, 'utf8');
-            const fileReadTime = Number(process.hrtime.bigint() - fileReadStart) / 1e9;
-            
-            console.log(`File loaded: ${(fileContent.length / 1024).toFixed(1)} KB in ${fileReadTime.toFixed(2)}s`);
-            
-            // Parse CSV with Papa Parse (semicolon-delimited)
+            // Parse into typed columns: native ingester (mapped file, SIMD
+            // field scan) when built, Papa Parse otherwise. The {X=.., Y=..}
+            // cells of the coordinate section parse as pairs.
             const parseStart = process.hrtime.bigint();
-            const parseResult = Papa.parse(fileContent, {
-                header: false,
-                skipEmptyLines: false, // We need to detect the empty separator row
+            const csv = await CsvIngest.parseFile(this.filename, {
                 delimiter: ';',
-                dynamicTyping: false, // We'll handle parsing manually
-                comments: false // No comment support in tensile files
+                skipEmptyLines: false, // We need to detect the empty separator row
+                comment: null, // No comment support in tensile files
+                types: ['pair', 'pair', 'pair'],
+                prefixRows: 4 // metadata header, values, separator, data headers
             });
-            
-            if (parseResult.errors.length > 0) {
-                console.warn('CSV parsing warnings:', parseResult.errors.slice(0, 3));
-            }
-            
             const parseTime = Number(process.hrtime.bigint() - parseStart) / 1e9;
-            const rawData = parseResult.data;
+            this.processingStats.parser = csv.parser;
             
-            console.log(`CSV parsed: ${rawData.length} rows in ${parseTime.toFixed(2)}s`);
+            console.log(`CSV parsed (${csv.parser}): ${csv.rows} rows in ${parseTime.toFixed(2)}s`);
             
             // Process the multi-section format
             console.log('Processing tensile data sections...');
             const dataProcessStart = process.hrtime.bigint();
-            await this.processTensileFile(rawData);
+            await this.processTensileFile(csv);
             const dataProcessTime = Number(process.hrtime.bigint() - dataProcessStart) / 1e9;
             
             // Store comprehensive metadata
@@ -285,7 +241,7 @@ class TensileCsvReader {
                 processedAt: new Date(),
                 
                 // CSV-specific metadata
-                totalLines: rawData.length,
+                totalLines: csv.rows,
                 validDataLines: this.coordinateData.length,
                 formatInfo: {
                     type: 'tensile_semicolon_delimited',
@@ -302,7 +258,6 @@ class TensileCsvReader {
                 // Processing statistics
                 processingStats: {
                     ...this.processingStats,
-                    fileReadTime,
                     parseTime,
                     dataProcessTime,
                     totalProcessingTime: Number(process.hrtime.bigint() - overallStartTime) / 1e9
@@ -310,7 +265,6 @@ class TensileCsvReader {
             };
             
             console.log(`Tensile data processing completed:`);
-            console.log(`- File read: ${fileReadTime.toFixed(2)}s`);
             console.log(`- Parse: ${parseTime.toFixed(2)}s`);
             console.log(`- Data process: ${dataProcessTime.toFixed(2)}s`);
             console.log(`- Total: ${this.metadata.processingStats.totalProcessingTime.toFixed(2)}s`);
@@ -325,28 +279,29 @@ class TensileCsvReader {
 
     /**
      * Process the multi-section tensile file format
-     * @param {Array} rawData - Papa Parse data rows (array of arrays)
+     * @param {Object} csv - CsvIngest result (rows 0-3 as prefix rows, pair columns)
      */
-    async processTensileFile(rawData) {
-        if (rawData.length < 5) {
+    async processTensileFile(csv) {
+        if (csv.rows < 5) {
             throw new Error('Tensile CSV file too short - expected at least 5 rows (header + data)');
         }
         
-        console.log(`Processing ${rawData.length} CSV rows in multi-section format...`);
+        console.log(`Processing ${csv.rows} CSV rows in multi-section format...`);
+        const headerRows = csv.prefixRows;
         
         // Section 1: Parse metadata header (rows 0-1)
-        this.parseMetadataHeader(rawData[0], rawData[1]);
+        this.parseMetadataHeader(headerRows[0], headerRows[1]);
         
         // Section 2: Empty separator row (row 2) - just validate
-        if (rawData[2] && rawData[2].length > 0 && rawData[2][0].trim() !== '') {
-            console.warn('Expected empty separator row at index 2, but found content:', rawData[2]);
+        if (headerRows[2] && headerRows[2].length > 0 && headerRows[2][0] !== '') {
+            console.warn('Expected empty separator row at index 2, but found content:', headerRows[2]);
         }
         
         // Section 3: Data headers (row 3)
-        this.validateDataHeaders(rawData[3]);
+        this.validateDataHeaders(headerRows[3]);
         
         // Section 4: Coordinate data (rows 4+)
-        this.parseCoordinateData(rawData.slice(4));
+        this.parseCoordinateData(csv.columns, 4, csv.rows);
         
         // Create channels from coordinate data
         this.createChannelsFromCoordinates();
@@ -456,73 +411,58 @@ class TensileCsvReader {
     }
 
     /**
-     * Parse coordinate data from remaining rows
-     * @param {Array} dataRows - Rows containing coordinate pairs
+     * Collect coordinate data from the pair columns
+     * @param {Array} columns - Pair columns: force/way, force/time, way/time
+     * @param {number} firstRow - First coordinate row
+     * @param {number} rowCount - Number of rows
      */
-    parseCoordinateData(dataRows) {
-        console.log(`Parsing coordinate data from ${dataRows.length} rows...`);
+    parseCoordinateData(columns, firstRow, rowCount) {
+        console.log(`Parsing coordinate data from ${rowCount - firstRow} rows...`);
         
+        const [forceWay, forceTime, wayTime] = columns;   // {X=displacement, Y=force}, {X=time, Y=force}, {X=time, Y=displacement}
         let validRows = 0;
         let skippedRows = 0;
         
-        for (let i = 0; i < dataRows.length; i++) {
-            const row = dataRows[i];
-            
-            // Skip empty rows
-            if (!row || row.length < 3) {
+        for (let r = firstRow; r < rowCount; r++) {
+            // Validate that the row holds three valid pairs (NaN where missing or invalid)
+            if (isNaN(forceWay.x[r]) || isNaN(forceTime.x[r]) || isNaN(wayTime.x[r])) {
                 skippedRows++;
+                if (validRows < 3) {
+                    console.warn(`Row ${r + 1}: Invalid or missing coordinate pairs`);
+                }
                 continue;
             }
             
-            try {
-                // Parse three coordinate pairs
-                const forceWayPair = this.parseCoordinatePair(row[0]);      // {X=displacement, Y=force}
-                const forceTimePair = this.parseCoordinatePair(row[1]);     // {X=time, Y=force}
-                const wayTimePair = this.parseCoordinatePair(row[2]);       // {X=time, Y=displacement}
-                
-                // Validate that we got valid pairs
-                if (!forceWayPair || !forceTimePair || !wayTimePair) {
-                    skippedRows++;
-                    if (validRows < 3) {
-                        console.warn(`Row ${i + 5}: Invalid coordinate pairs - ${row.slice(0, 3)}`);
-                    }
-                    continue;
-                }
-                
-                // Validate data consistency (forces should match, times should match)
-                const forceMatch = Math.abs(forceWayPair.y - forceTimePair.y) < 0.001;
-                const timeMatch = Math.abs(forceTimePair.x - wayTimePair.x) < 0.001;
-                const displacementMatch = Math.abs(forceWayPair.x - wayTimePair.y) < 0.001;
-                
-                if (!forceMatch || !timeMatch || !displacementMatch) {
-                    console.warn(`Row ${i + 5}: Data consistency warning - Force/Time/Displacement mismatch`);
-                }
-                
-                // Store validated coordinate data
-                this.coordinateData.push({
-                    index: validRows,
-                    force: forceWayPair.y,        // kN
-                    displacement: forceWayPair.x,  // mm
-                    time: forceTimePair.x,        // s
-                    
-                    // Store original pairs for debugging
-                    forceWayPair,
-                    forceTimePair,
-                    wayTimePair
-                });
-                
-                validRows++;
-                
-                if (validRows <= 3) {
-                    console.log(`Row ${i + 5}: t=${forceTimePair.x}s, F=${forceWayPair.y}kN, d=${forceWayPair.x}mm`);
-                }
+            const forceWayPair = { x: forceWay.x[r], y: forceWay.y[r] };
+            const forceTimePair = { x: forceTime.x[r], y: forceTime.y[r] };
+            const wayTimePair = { x: wayTime.x[r], y: wayTime.y[r] };
+            
+            // Validate data consistency (forces should match, times should match)
+            const forceMatch = Math.abs(forceWayPair.y - forceTimePair.y) < 0.001;
+            const timeMatch = Math.abs(forceTimePair.x - wayTimePair.x) < 0.001;
+            const displacementMatch = Math.abs(forceWayPair.x - wayTimePair.y) < 0.001;
+            
+            if (!forceMatch || !timeMatch || !displacementMatch) {
+                console.warn(`Row ${r + 1}: Data consistency warning - Force/Time/Displacement mismatch`);
+            }
+            
+            // Store validated coordinate data
+            this.coordinateData.push({
+                index: validRows,
+                force: forceWayPair.y,        // kN
+                displacement: forceWayPair.x,  // mm
+                time: forceTimePair.x,        // s
                 
-            } catch (error) {
-                skippedRows++;
-                if (validRows < 3) {
-                    console.warn(`Row ${i + 5}: Parse error: ${error.message}`);
-                }
-                continue;
+                // Store original pairs for debugging
+                forceWayPair,
+                forceTimePair,
+                wayTimePair
+            });
+            
+            validRows++;
+            
+            if (validRows <= 3) {
+                console.log(`Row ${r + 1}: t=${forceTimePair.x}s, F=${forceWayPair.y}kN, d=${forceWayPair.x}mm`);
             }
         }
         
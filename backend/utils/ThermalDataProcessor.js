@@ -14,6 +14,9 @@ class ThermalDataProcessor {
         this.analysisCache = new Map();
         this.cacheTimeout = 5 * 60 * 1000; // 5 minutes
         
+        // Attached precomputed temperature volume ({ path, attachedAt }) or null
+        this.temperatureVolume = null;
+        
         // Pre-calculate commonly used values
         this.frameRange = { min: 0, max: Math.max(0, this.videoInfo.frames - 1) };
         this.coordinateBounds = {
@@ -45,9 +48,18 @@ class ThermalDataProcessor {
             capabilities: {
                 lineAnalysis: true,
                 pixelTemperature: true,
+                temperatureFrame: true,
+                lineOverTime: true,
+                frameStats: true,
+                roiAnalysis: true,
+                isotherms: true,
+                frameExport: true,
+                thumbnails: true,
+                temperatureVolume: true,
                 frameNavigation: true,
                 realTimeAnalysis: true
-            }
+            },
+            temperatureVolumeAttached: this.temperatureVolume !== null
         };
     }
 
@@ -55,9 +67,12 @@ class ThermalDataProcessor {
      * Analyze temperature along multiple lines for a specific frame
      * @param {number} frameNum - Frame number (0-based)
      * @param {Array} lines - Array of line objects {x1, y1, x2, y2}
-     * @returns {Object} Analysis results for all lines
+     * @param {Object} options - { sampling: { mode: 'pixels' | 'bilinear', samples, width } }
+     *   'bilinear' takes evenly spaced sub-pixel samples (fixed count per line,
+     *   comparable point by point) averaged over width px across the line
+     * @returns {Promise<Object>} Analysis results for all lines
      */
-    analyzeLines(frameNum, lines) {
+    async analyzeLines(frameNum, lines, options = {}) {
         try {
             // Validate frame number
             const validatedFrame = this.validateFrameNumber(frameNum);
@@ -65,6 +80,12 @@ class ThermalDataProcessor {
                 throw new Error(validatedFrame.error);
             }
 
+            const validatedSampling = this.validateSampling(options.sampling);
+            if (!validatedSampling.isValid) {
+                throw new Error(validatedSampling.error);
+            }
+            const sampling = validatedSampling.sampling;
+
             // Validate lines array
             if (!Array.isArray(lines) || lines.length === 0) {
                 throw new Error('Lines must be a non-empty array');
@@ -74,7 +95,7 @@ class ThermalDataProcessor {
                 throw new Error('Maximum 10 lines per analysis');
             }
 
-            const results = [];
+            const results = new Array(lines.length);
             const nativeEngine = this.thermalReader.getNativeEngine();
             
             if (!nativeEngine) {
@@ -83,74 +104,86 @@ class ThermalDataProcessor {
 
             console.log(`Analyzing ${lines.length} lines for frame ${frameNum}`);
 
-            // Process each line
+            // Lines that still need native analysis (validated, not cached)
+            const pending = [];
+
             for (let i = 0; i < lines.length; i++) {
                 const line = lines[i];
                 
-                // Validate coordinates
-                const validatedLine = this.validateCoordinates(line);
+                // Validate coordinates (sub-pixel endpoints are kept for bilinear sampling)
+                const validatedLine = this.validateCoordinates(line, sampling !== null);
                 if (!validatedLine.isValid) {
-                    results.push({
+                    results[i] = {
                         lineIndex: i,
                         success: false,
                         error: validatedLine.error,
                         line: line
-                    });
+                    };
                     continue;
                 }
 
                 // Check cache first
-                const cacheKey = `line_${frameNum}_${line.x1}_${line.y1}_${line.x2}_${line.y2}`;
+                const cacheKey = `line_${frameNum}_${line.x1}_${line.y1}_${line.x2}_${line.y2}` +
+                    (sampling ? `_bilinear_${sampling.samples}_${sampling.width}` : '');
                 const cached = this._getCachedResult(cacheKey);
                 if (cached) {
-                    results.push({
+                    results[i] = {
                         lineIndex: i,
                         success: true,
                         line: validatedLine.line,
                         temperatures: cached.temperatures,
                         statistics: cached.statistics,
                         metadata: { ...cached.metadata, fromCache: true }
-                    });
+                    };
                     continue;
                 }
 
-                // Perform analysis
+                pending.push({ index: i, line: validatedLine.line, cacheKey: cacheKey });
+            }
+
+            if (pending.length > 0) {
+                // All pending lines go through one native call on one decoded frame
+                const coords = ThermalDataProcessor._packLineCoords(pending.map(p => p.line), sampling !== null);
+
                 const analysisStartTime = Date.now();
-                const temperatures = nativeEngine.analyzeLine(
-                    frameNum, 
-                    validatedLine.line.x1, 
-                    validatedLine.line.y1, 
-                    validatedLine.line.x2, 
-                    validatedLine.line.y2
-                );
+                const packed = await nativeEngine.analyzeLines(frameNum, coords, sampling || undefined);
                 const analysisTime = Date.now() - analysisStartTime;
 
-                // Calculate statistics
-                const statistics = this._calculateTemperatureStatistics(temperatures);
+                if (!packed) {
+                    throw new Error(`Could not decode frame ${frameNum}`);
+                }
 
-                // Create result
-                const result = {
-                    lineIndex: i,
-                    success: true,
-                    line: validatedLine.line,
-                    temperatures: temperatures,
-                    statistics: statistics,
-                    metadata: {
-                        frameNumber: frameNum,
-                        pixelCount: temperatures.length,
-                        analysisTime: analysisTime,
-                        fromCache: false
-                    }
-                };
+                const unpacked = ThermalDataProcessor.unpackLineResults(packed);
 
-                // Cache the result
-                this._setCachedResult(cacheKey, {
-                    temperatures: temperatures,
-                    statistics: statistics,
-                    metadata: result.metadata
-                });
+                pending.forEach((p, k) => {
+                    const temperatures = Array.from(unpacked.lines[k].temperatures);
+                    const statistics = this._calculateTemperatureStatistics(temperatures, unpacked.lines[k]);
+
+                    const result = {
+                        lineIndex: p.index,
+                        success: true,
+                        line: p.line,
+                        temperatures: temperatures,
+                        statistics: statistics,
+                        metadata: {
+                            frameNumber: frameNum,
+                            pixelCount: temperatures.length,
+                            sampling: sampling || { mode: 'pixels' },
+                            analysisTime: analysisTime,
+                            batchSize: pending.length,
+                            fromCache: false
+                        }
+                    };
+
+                    // Cache the result
+                    this._setCachedResult(p.cacheKey, {
+                        temperatures: temperatures,
+                        statistics: statistics,
+                        metadata: result.metadata
+                    });
 
-                results.push(result);
+                    results[p.index] = result;
+                });
             }
 
             return {
@@ -173,14 +206,141 @@ class ThermalDataProcessor {
         }
     }
 
+    /**
+     * Analyze lines and keep the native packed Float32Array as it is
+     * (layout at unpackLineResults), so it can be sent as a binary message
+     * without building per-line JS arrays. Bypasses the per-line result cache.
+     * @param {number} frameNum - Frame number (0-based)
+     * @param {Array} lines - Array of line objects {x1, y1, x2, y2}
+     * @param {Object} options - { sampling } as for analyzeLines
+     * @returns {Promise<Object>} { success, frameNumber, packed: Float32Array }
+     */
+    async analyzeLinesPacked(frameNum, lines, options = {}) {
+        try {
+            const validatedFrame = this.validateFrameNumber(frameNum);
+            if (!validatedFrame.isValid) {
+                throw new Error(validatedFrame.error);
+            }
+
+            const validatedSampling = this.validateSampling(options.sampling);
+            if (!validatedSampling.isValid) {
+                throw new Error(validatedSampling.error);
+            }
+            const sampling = validatedSampling.sampling;
+
+            if (!Array.isArray(lines) || lines.length === 0) {
+                throw new Error('Lines must be a non-empty array');
+            }
+
+            if (lines.length > 10) {
+                throw new Error('Maximum 10 lines per analysis');
+            }
+
+            const validatedLines = lines.map((line, i) => {
+                const validatedLine = this.validateCoordinates(line, sampling !== null);
+                if (!validatedLine.isValid) {
+                    throw new Error(`Line ${i}: ${validatedLine.error}`);
+                }
+                return validatedLine.line;
+            });
+
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const analysisStartTime = Date.now();
+            const packed = await nativeEngine.analyzeLines(
+                validatedFrame.frameNumber,
+                ThermalDataProcessor._packLineCoords(validatedLines, sampling !== null),
+                sampling || undefined
+            );
+
+            if (!packed) {
+                throw new Error(`Could not decode frame ${frameNum}`);
+            }
+
+            return {
+                success: true,
+                frameNumber: validatedFrame.frameNumber,
+                lineCount: validatedLines.length,
+                packed: packed,
+                metadata: {
+                    analysisTime: Date.now() - analysisStartTime,
+                    byteLength: packed.byteLength
+                }
+            };
+
+        } catch (error) {
+            console.error(`Error analyzing packed lines for frame ${frameNum}:`, error);
+            return {
+                success: false,
+                error: `Failed to analyze lines: ${error.message}`,
+                frameNumber: frameNum
+            };
+        }
+    }
+
+    /**
+     * Flatten validated lines into the typed array (x1, y1, x2, y2 per line)
+     * expected by the native analyzeLines
+     * @param {Array} lines - Validated line objects
+     * @param {boolean} subPixel - Keep fractional coordinates (Float32Array)
+     * @returns {Int32Array|Float32Array} Packed coordinates
+     * @private
+     */
+    static _packLineCoords(lines, subPixel = false) {
+        const coords = subPixel ? new Float32Array(lines.length * 4) : new Int32Array(lines.length * 4);
+        lines.forEach((line, k) => {
+            coords[k * 4] = line.x1;
+            coords[k * 4 + 1] = line.y1;
+            coords[k * 4 + 2] = line.x2;
+            coords[k * 4 + 3] = line.y2;
+        });
+        return coords;
+    }
+
+    /**
+     * Split the packed Float32Array returned by the native analyzeLines
+     * Layout: [lineCount, frameNumber, totalSamples], offsets[lineCount + 1],
+     * stats[lineCount * 3] (min, max, mean), temperatures[totalSamples]
+     * @param {Float32Array} packed - Native result
+     * @returns {Object} { frameNumber, lines: [{ temperatures, min, max, mean }] } (subarray views, no copies)
+     */
+    static unpackLineResults(packed) {
+        const lineCount = packed[0];
+        const offsetsStart = 3;
+        const statsStart = offsetsStart + lineCount + 1;
+        const samplesStart = statsStart + lineCount * 3;
+
+        const lines = [];
+        for (let i = 0; i < lineCount; i++) {
+            const from = samplesStart + packed[offsetsStart + i];
+            const to = samplesStart + packed[offsetsStart + i + 1];
+            lines.push({
+                temperatures: packed.subarray(from, to),
+                min: packed[statsStart + i * 3],
+                max: packed[statsStart + i * 3 + 1],
+                mean: packed[statsStart + i * 3 + 2]
+            });
+        }
+
+        return {
+            frameNumber: packed[1],
+            totalSamples: packed[2],
+            lines: lines
+        };
+    }
+
     /**
      * Analyze temperature along a single line
      * @param {number} frameNum - Frame number
      * @param {Object} line - Line coordinates {x1, y1, x2, y2}
-     * @returns {Object} Single line analysis result
+     * @param {Object} options - { sampling } as for analyzeLines
+     * @returns {Promise<Object>} Single line analysis result
      */
-    analyzeSingleLine(frameNum, line) {
-        const result = this.analyzeLines(frameNum, [line]);
+    async analyzeSingleLine(frameNum, line, options = {}) {
+        const result = await this.analyzeLines(frameNum, [line], options);
         
         if (!result.success) {
             return result;
@@ -203,9 +363,9 @@ class ThermalDataProcessor {
      * @param {number} r - Red value (0-255)
      * @param {number} g - Green value (0-255)
      * @param {number} b - Blue value (0-255)
-     * @returns {Object} Pixel temperature result
+     * @returns {Promise<Object>} Pixel temperature result
      */
-    getPixelTemperature(r, g, b) {
+    async getPixelTemperature(r, g, b) {
         try {
             // Validate RGB values
             const rgbValidation = this.validateRGBValues(r, g, b);
@@ -219,7 +379,7 @@ class ThermalDataProcessor {
             }
 
             // Get temperature
-            const temperature = nativeEngine.getPixelTemperature(r, g, b);
+            const temperature = await nativeEngine.getPixelTemperature(r, g, b);
 
             return {
                 success: true,
@@ -243,6 +403,595 @@ class ThermalDataProcessor {
         }
     }
 
+    /**
+     * Sample one line over a range of frames (kymograph: frames x pixels)
+     * The native engine decodes the range once on a pool of decoders
+     * @param {Object} line - Line coordinates {x1, y1, x2, y2}
+     * @param {Object} options - { startFrame, endFrame, step, onChunk }
+     *   onChunk({ firstRow, rowCount, firstFrame, pixelCount, data }) receives row blocks as they complete
+     * @returns {Promise<Object>} Matrix result with Float32Array data (row per sampled frame)
+     */
+    async analyzeLineOverTime(line, options = {}) {
+        try {
+            const validatedLine = this.validateCoordinates(line);
+            if (!validatedLine.isValid) {
+                throw new Error(validatedLine.error);
+            }
+
+            const startFrame = Math.floor(options.startFrame ?? this.frameRange.min);
+            const endFrame = Math.floor(options.endFrame ?? this.frameRange.max);
+            const step = Math.max(1, Math.floor(options.step ?? 1));
+
+            for (const frame of [startFrame, endFrame]) {
+                const validatedFrame = this.validateFrameNumber(frame);
+                if (!validatedFrame.isValid) {
+                    throw new Error(validatedFrame.error);
+                }
+            }
+
+            if (startFrame > endFrame) {
+                throw new Error('startFrame must not be after endFrame');
+            }
+
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const { x1, y1, x2, y2 } = validatedLine.line;
+            console.log(`Analyzing line over frames ${startFrame}-${endFrame} (step ${step})`);
+
+            const analysisStartTime = Date.now();
+            const result = await nativeEngine.analyzeLineOverTime(
+                x1, y1, x2, y2, startFrame, endFrame, step,
+                typeof options.onChunk === 'function' ? options.onChunk : undefined
+            );
+
+            return {
+                success: true,
+                line: validatedLine.line,
+                startFrame: result.startFrame,
+                endFrame: result.endFrame,
+                step: result.step,
+                frameCount: result.frameCount,
+                pixelCount: result.pixelCount,
+                data: result.data,
+                metadata: {
+                    analysisTime: Date.now() - analysisStartTime,
+                    startTime: this.convertFrameToTime(result.startFrame),
+                    timeStep: this.convertFrameToTime(result.step)
+                }
+            };
+
+        } catch (error) {
+            console.error('Error analyzing line over time:', error);
+            return {
+                success: false,
+                error: `Failed to analyze line over time: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Per-frame max/min/mean temperature and hotspot series for the whole video
+     * Loads the sidecar if it is up to date, otherwise decodes all frames natively
+     * on worker threads and writes the sidecar for the next time
+     * @param {string} sidecarPath - Sidecar file path
+     * @param {Object} options - { onProgress(done, total), forceRecompute }
+     * @returns {Promise<Object>} Series with typed arrays
+     */
+    async getFrameStats(sidecarPath, options = {}) {
+        try {
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const startTime = Date.now();
+            let series = options.forceRecompute ? null : await nativeEngine.loadFrameStats(sidecarPath);
+
+            if (!series) {
+                console.log(`Computing per-frame thermal statistics (${this.videoInfo.frames} frames)`);
+                series = await this.thermalReader.runOnSeparateEngine(engine => engine.computeFrameStats(
+                    sidecarPath,
+                    typeof options.onProgress === 'function' ? options.onProgress : undefined,
+                    options.forceRecompute === true
+                ));
+            }
+
+            return {
+                success: true,
+                frames: series.frames,
+                fps: this.videoInfo.fps,
+                maxTemp: series.maxTemp,
+                minTemp: series.minTemp,
+                meanTemp: series.meanTemp,
+                hotspotX: series.hotspotX,
+                hotspotY: series.hotspotY,
+                metadata: {
+                    fromSidecar: series.fromSidecar,
+                    sidecarPath: sidecarPath,
+                    processingTime: Date.now() - startTime
+                }
+            };
+
+        } catch (error) {
+            console.error('Error getting frame statistics:', error);
+            return {
+                success: false,
+                error: `Failed to get frame statistics: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Region-of-interest statistics for one frame or a frame range
+     * The ROI mask is rasterized once natively and reused for every frame
+     * @param {Object} roi - { type: 'rect', x, y, width, height }
+     *   | { type: 'polygon', points: [x0, y0, x1, y1, ...] }
+     *   | { type: 'mask', data: Uint8Array(width * height) }
+     * @param {Object} options - { frameNum } or { startFrame, endFrame, step },
+     *   plus { percentiles: [..], thresholds: [..] } (°C, counted as area above)
+     * @returns {Promise<Object>} Single-frame stats or per-frame typed array series
+     */
+    async analyzeRoi(roi, options = {}) {
+        try {
+            const validatedRoi = this.validateRoi(roi);
+            if (!validatedRoi.isValid) {
+                throw new Error(validatedRoi.error);
+            }
+
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const statsOptions = {
+                percentiles: (options.percentiles || []).map(Number),
+                thresholds: (options.thresholds || []).map(Number)
+            };
+
+            if (statsOptions.percentiles.some(p => !Number.isFinite(p) || p < 0 || p > 100)) {
+                throw new Error('percentiles must be numbers between 0 and 100');
+            }
+
+            if (statsOptions.thresholds.some(t => !Number.isFinite(t))) {
+                throw new Error('thresholds must be valid numbers');
+            }
+
+            const analysisStartTime = Date.now();
+
+            if (options.frameNum !== undefined) {
+                const validatedFrame = this.validateFrameNumber(options.frameNum);
+                if (!validatedFrame.isValid) {
+                    throw new Error(validatedFrame.error);
+                }
+
+                const stats = await nativeEngine.analyzeRoi(validatedFrame.frameNumber, validatedRoi.roi, statsOptions);
+                if (!stats) {
+                    throw new Error(`Could not analyze ROI in frame ${options.frameNum}`);
+                }
+
+                return {
+                    success: true,
+                    frameNumber: validatedFrame.frameNumber,
+                    roi: validatedRoi.roi,
+                    ...stats,
+                    metadata: {
+                        analysisTime: Date.now() - analysisStartTime,
+                        timeSeconds: this.convertFrameToTime(validatedFrame.frameNumber)
+                    }
+                };
+            }
+
+            const startFrame = Math.floor(options.startFrame ?? this.frameRange.min);
+            const endFrame = Math.floor(options.endFrame ?? this.frameRange.max);
+            const step = Math.max(1, Math.floor(options.step ?? 1));
+
+            for (const frame of [startFrame, endFrame]) {
+                const validatedFrame = this.validateFrameNumber(frame);
+                if (!validatedFrame.isValid) {
+                    throw new Error(validatedFrame.error);
+                }
+            }
+
+            if (startFrame > endFrame) {
+                throw new Error('startFrame must not be after endFrame');
+            }
+
+            console.log(`Analyzing ROI (${validatedRoi.roi.type}) over frames ${startFrame}-${endFrame} (step ${step})`);
+            const series = await nativeEngine.analyzeRoiOverTime(validatedRoi.roi, startFrame, endFrame, step, statsOptions);
+
+            return {
+                success: true,
+                roi: validatedRoi.roi,
+                ...series,
+                metadata: {
+                    analysisTime: Date.now() - analysisStartTime,
+                    startTime: this.convertFrameToTime(series.startFrame),
+                    timeStep: this.convertFrameToTime(series.step)
+                }
+            };
+
+        } catch (error) {
+            console.error('Error analyzing ROI:', error);
+            return {
+                success: false,
+                error: `Failed to analyze ROI: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Isotherm (threshold area) analysis for one frame or a frame range:
+     * per threshold the number of pixels above it, their bounding box and
+     * optionally their outlines. With a temperature volume attached the
+     * frames are read from it, so re-running with new thresholds is fast.
+     * @param {Object} options - { thresholds: [°C, ...], contours, simplify }
+     *   plus { frameNum } or { startFrame, endFrame, step }
+     * @returns {Promise<Object>} Per-threshold levels or frameCount x thresholds series
+     */
+    async analyzeIsotherms(options = {}) {
+        try {
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const thresholds = Array.from(options.thresholds || [], Number);
+            if (thresholds.length === 0 || thresholds.length > ThermalDataProcessor.MAX_ISOTHERM_THRESHOLDS) {
+                throw new Error(`thresholds must hold 1 to ${ThermalDataProcessor.MAX_ISOTHERM_THRESHOLDS} temperatures`);
+            }
+
+            if (thresholds.some(t => !Number.isFinite(t))) {
+                throw new Error('thresholds must be valid numbers');
+            }
+
+            const simplify = options.simplify === undefined ? 1 : Number(options.simplify);
+            if (!Number.isFinite(simplify) || simplify < 0) {
+                throw new Error('simplify must be a non-negative number');
+            }
+
+            const isothermOptions = { thresholds, contours: Boolean(options.contours), simplify };
+            const analysisStartTime = Date.now();
+
+            if (options.frameNum !== undefined) {
+                const validatedFrame = this.validateFrameNumber(options.frameNum);
+                if (!validatedFrame.isValid) {
+                    throw new Error(validatedFrame.error);
+                }
+
+                const result = await nativeEngine.analyzeIsotherms(validatedFrame.frameNumber, isothermOptions);
+                if (!result) {
+                    throw new Error(`Could not analyze isotherms in frame ${options.frameNum}`);
+                }
+
+                return {
+                    success: true,
+                    frameNumber: validatedFrame.frameNumber,
+                    ...result,
+                    metadata: {
+                        analysisTime: Date.now() - analysisStartTime,
+                        timeSeconds: this.convertFrameToTime(validatedFrame.frameNumber),
+                        temperatureVolumeAttached: this.temperatureVolume !== null
+                    }
+                };
+            }
+
+            const startFrame = Math.floor(options.startFrame ?? this.frameRange.min);
+            const endFrame = Math.floor(options.endFrame ?? this.frameRange.max);
+            const step = Math.max(1, Math.floor(options.step ?? 1));
+
+            for (const frame of [startFrame, endFrame]) {
+                const validatedFrame = this.validateFrameNumber(frame);
+                if (!validatedFrame.isValid) {
+                    throw new Error(validatedFrame.error);
+                }
+            }
+
+            if (startFrame > endFrame) {
+                throw new Error('startFrame must not be after endFrame');
+            }
+
+            console.log(`Analyzing ${thresholds.length} isotherms over frames ${startFrame}-${endFrame} (step ${step})`);
+            const series = await nativeEngine.analyzeIsothermsOverTime(startFrame, endFrame, step, isothermOptions);
+
+            return {
+                success: true,
+                ...series,
+                metadata: {
+                    analysisTime: Date.now() - analysisStartTime,
+                    startTime: this.convertFrameToTime(series.startFrame),
+                    timeStep: this.convertFrameToTime(series.step),
+                    temperatureVolumeAttached: this.temperatureVolume !== null
+                }
+            };
+
+        } catch (error) {
+            console.error('Error analyzing isotherms:', error);
+            return {
+                success: false,
+                error: `Failed to analyze isotherms: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Get the full temperature map for a frame in one native pass
+     * @param {number} frameNum - Frame number (0-based)
+     * @param {Object} options - { quantized: boolean } (Uint16 in 0.1 °C steps instead of Float32 °C)
+     * @returns {Promise<Object>} Temperature frame result with typed array data
+     */
+    async getTemperatureFrame(frameNum, options = {}) {
+        try {
+            const validatedFrame = this.validateFrameNumber(frameNum);
+            if (!validatedFrame.isValid) {
+                throw new Error(validatedFrame.error);
+            }
+
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const quantized = options.quantized === true;
+            const startTime = Date.now();
+            const data = await nativeEngine.getTemperatureFrame(validatedFrame.frameNumber, quantized);
+
+            if (!data) {
+                throw new Error(`Could not decode frame ${frameNum}`);
+            }
+
+            return {
+                success: true,
+                frameNumber: validatedFrame.frameNumber,
+                width: this.videoInfo.width,
+                height: this.videoInfo.height,
+                format: quantized ? 'uint16' : 'float32',
+                scale: quantized ? 0.1 : 1, // °C per stored unit
+                data: data,
+                metadata: {
+                    pixelCount: data.length,
+                    analysisTime: Date.now() - startTime
+                }
+            };
+
+        } catch (error) {
+            console.error(`Error getting temperature frame ${frameNum}:`, error);
+            return {
+                success: false,
+                error: `Failed to get temperature frame: ${error.message}`,
+                frameNumber: frameNum
+            };
+        }
+    }
+
+    /**
+     * Encode a frame as an image on a native worker thread
+     * @param {number} frameNum - Frame number (0-based)
+     * @param {Object} options - { format: 'jpeg'|'png'|'webp', quality: 1-100, width, height }
+     *   (width/height downscale only; give one of them to keep the aspect ratio)
+     * @returns {Promise<Object>} { success, data: Buffer, mimeType }
+     */
+    async exportFrame(frameNum, options = {}) {
+        try {
+            const validatedFrame = this.validateFrameNumber(frameNum);
+            if (!validatedFrame.isValid) {
+                throw new Error(validatedFrame.error);
+            }
+
+            const format = ThermalDataProcessor.IMAGE_FORMATS[options.format || 'jpeg'];
+            if (!format) {
+                throw new Error(`Unsupported image format: ${options.format}`);
+            }
+
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const encodeOptions = { format: format.codec };
+            for (const key of ['quality', 'width', 'height']) {
+                if (options[key] !== undefined) {
+                    encodeOptions[key] = Math.round(Number(options[key]));
+                }
+            }
+
+            const startTime = Date.now();
+            const data = await nativeEngine.exportFrame(validatedFrame.frameNumber, encodeOptions);
+
+            if (!data) {
+                throw new Error(`Could not decode frame ${frameNum}`);
+            }
+
+            return {
+                success: true,
+                frameNumber: validatedFrame.frameNumber,
+                mimeType: format.mimeType,
+                data: data,
+                metadata: {
+                    byteLength: data.length,
+                    encodeTime: Date.now() - startTime
+                }
+            };
+
+        } catch (error) {
+            console.error(`Error exporting frame ${frameNum}:`, error);
+            return {
+                success: false,
+                error: `Failed to export frame: ${error.message}`,
+                frameNumber: frameNum
+            };
+        }
+    }
+
+    /**
+     * Build a preview sprite sheet of every Nth frame plus the per-frame
+     * statistics series (for the max-temperature sparkline) in one native pass
+     * @param {Object} options - { every, thumbWidth, columns, format, quality, statsSidecarPath, onProgress(done, total) }
+     * @returns {Promise<Object>} Sheet geometry, encoded image Buffer and frame statistics
+     */
+    async buildThumbnails(options = {}) {
+        try {
+            const format = ThermalDataProcessor.IMAGE_FORMATS[options.format || 'jpeg'];
+            if (!format) {
+                throw new Error(`Unsupported image format: ${options.format}`);
+            }
+
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const sheetOptions = { format: format.codec };
+            for (const key of ['every', 'thumbWidth', 'columns', 'quality']) {
+                if (options[key] !== undefined) {
+                    sheetOptions[key] = Math.round(Number(options[key]));
+                }
+            }
+
+            console.log(`Building thermal thumbnail sheet (every ${sheetOptions.every ?? 'default'} frames)`);
+
+            const startTime = Date.now();
+            const sheet = await this.thermalReader.runOnSeparateEngine(engine => engine.buildThumbnails(
+                sheetOptions,
+                options.statsSidecarPath,
+                typeof options.onProgress === 'function' ? options.onProgress : undefined
+            ));
+
+            return {
+                success: true,
+                every: sheet.every,
+                thumbWidth: sheet.thumbWidth,
+                thumbHeight: sheet.thumbHeight,
+                columns: sheet.columns,
+                rows: sheet.rows,
+                count: sheet.count,
+                mimeType: format.mimeType,
+                image: sheet.image,
+                frameStats: sheet.frameStats,
+                metadata: {
+                    byteLength: sheet.image.length,
+                    processingTime: Date.now() - startTime
+                }
+            };
+
+        } catch (error) {
+            console.error('Error building thumbnails:', error);
+            return {
+                success: false,
+                error: `Failed to build thumbnails: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Build the precomputed temperature volume (whole video decoded once into
+     * compressed 0.1 °C temperatures) and attach it, so later line, ROI and
+     * time-series queries read temperatures without decoding video
+     * @param {string} volumePath - Volume file path
+     * @param {Object} options - { tileSize, onProgress(done, total) }
+     * @returns {Promise<Object>} Volume summary and attach state
+     */
+    async buildTemperatureVolume(volumePath, options = {}) {
+        try {
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            // The file is replaced; Windows cannot rename over a mapped file
+            if (this.temperatureVolume) {
+                await this.detachTemperatureVolume();
+            }
+
+            console.log(`Building thermal temperature volume (${this.videoInfo.frames} frames)`);
+
+            const startTime = Date.now();
+            const volume = await this.thermalReader.buildTemperatureVolume(
+                volumePath,
+                options.tileSize !== undefined ? { tileSize: Math.round(Number(options.tileSize)) } : {},
+                typeof options.onProgress === 'function' ? options.onProgress : undefined
+            );
+
+            const attached = await this.attachTemperatureVolume(volumePath);
+
+            return {
+                success: true,
+                ...volume,
+                attached: attached.attached,
+                metadata: {
+                    processingTime: Date.now() - startTime
+                }
+            };
+
+        } catch (error) {
+            console.error('Error building temperature volume:', error);
+            return {
+                success: false,
+                error: `Failed to build temperature volume: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Serve temperature queries from an existing volume file. A missing or
+     * stale file (other video, modified video or mapping) is not attached.
+     * @param {string} volumePath - Volume file path
+     * @returns {Promise<Object>} { success, attached }
+     */
+    async attachTemperatureVolume(volumePath) {
+        try {
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const attached = await nativeEngine.attachTemperatureVolume(volumePath);
+            if (attached) {
+                this.temperatureVolume = { path: volumePath, attachedAt: new Date() };
+                // Cached results came from video decoding at full precision
+                this.clearCache();
+            }
+
+            return { success: true, attached: attached };
+
+        } catch (error) {
+            console.error('Error attaching temperature volume:', error);
+            return {
+                success: false,
+                attached: false,
+                error: `Failed to attach temperature volume: ${error.message}`
+            };
+        }
+    }
+
+    /**
+     * Stop using the temperature volume (queries decode video again)
+     * @returns {Promise<Object>} { success, detached }
+     */
+    async detachTemperatureVolume() {
+        try {
+            const nativeEngine = this.thermalReader.getNativeEngine();
+            if (!nativeEngine) {
+                throw new Error('Native thermal engine not available');
+            }
+
+            const detached = await nativeEngine.detachTemperatureVolume();
+            this.temperatureVolume = null;
+            this.clearCache();
+
+            return { success: true, detached: detached };
+
+        } catch (error) {
+            console.error('Error detaching temperature volume:', error);
+            return {
+                success: false,
+                error: `Failed to detach temperature volume: ${error.message}`
+            };
+        }
+    }
+
     /**
      * Validate frame number against video bounds
      * @param {number} frameNum - Frame number to validate
@@ -280,7 +1029,7 @@ class ThermalDataProcessor {
      * @param {Object} line - Line coordinates {x1, y1, x2, y2}
      * @returns {Object} Validation result with corrected coordinates
      */
-    validateCoordinates(line) {
+    validateCoordinates(line, subPixel = false) {
         if (!line || typeof line !== 'object') {
             return { isValid: false, error: 'Line must be an object' };
         }
@@ -294,12 +1043,13 @@ class ThermalDataProcessor {
             return { isValid: false, error: 'All line coordinates must be valid numbers' };
         }
 
-        // Clamp coordinates to bounds
+        // Clamp coordinates to bounds (whole pixels unless sampling sub-pixel)
+        const round = subPixel ? (v => v) : Math.floor;
         const clampedLine = {
-            x1: Math.max(this.coordinateBounds.x.min, Math.min(Math.floor(x1), this.coordinateBounds.x.max)),
-            y1: Math.max(this.coordinateBounds.y.min, Math.min(Math.floor(y1), this.coordinateBounds.y.max)),
-            x2: Math.max(this.coordinateBounds.x.min, Math.min(Math.floor(x2), this.coordinateBounds.x.max)),
-            y2: Math.max(this.coordinateBounds.y.min, Math.min(Math.floor(y2), this.coordinateBounds.y.max))
+            x1: Math.max(this.coordinateBounds.x.min, Math.min(round(x1), this.coordinateBounds.x.max)),
+            y1: Math.max(this.coordinateBounds.y.min, Math.min(round(y1), this.coordinateBounds.y.max)),
+            x2: Math.max(this.coordinateBounds.x.min, Math.min(round(x2), this.coordinateBounds.x.max)),
+            y2: Math.max(this.coordinateBounds.y.min, Math.min(round(y2), this.coordinateBounds.y.max))
         };
 
         // Check if line has length
@@ -318,6 +1068,86 @@ class ThermalDataProcessor {
         };
     }
 
+    /**
+     * Validate line sampling options
+     * @param {Object} sampling - { mode: 'pixels' | 'bilinear', samples, width } or undefined
+     * @returns {Object} Validation result; sampling is null for the default pixel walk
+     */
+    validateSampling(sampling) {
+        if (sampling === undefined || sampling === null || sampling.mode === undefined || sampling.mode === 'pixels') {
+            return { isValid: true, sampling: null };
+        }
+
+        if (sampling.mode !== 'bilinear') {
+            return { isValid: false, error: `Unknown sampling mode: ${sampling.mode}` };
+        }
+
+        // Omitted samples = one sample per pixel of line length (native default)
+        const samples = sampling.samples === undefined ? null : Number(sampling.samples);
+        if (samples !== null && (!Number.isInteger(samples) || samples < 1 || samples > ThermalDataProcessor.MAX_LINE_SAMPLES)) {
+            return { isValid: false, error: `sampling.samples must be an integer between 1 and ${ThermalDataProcessor.MAX_LINE_SAMPLES}` };
+        }
+
+        const width = sampling.width === undefined ? 1 : Number(sampling.width);
+        if (!(width >= 1 && width <= ThermalDataProcessor.MAX_LINE_WIDTH)) {
+            return { isValid: false, error: `sampling.width must be between 1 and ${ThermalDataProcessor.MAX_LINE_WIDTH}` };
+        }
+
+        const normalized = { mode: 'bilinear', width: width };
+        if (samples !== null) {
+            normalized.samples = samples;
+        }
+        return { isValid: true, sampling: normalized };
+    }
+
+    /**
+     * Validate an ROI description against the video bounds
+     * @param {Object} roi - ROI object (rect, polygon or mask)
+     * @returns {Object} Validation result
+     */
+    validateRoi(roi) {
+        if (!roi || typeof roi !== 'object') {
+            return { isValid: false, error: 'ROI must be an object' };
+        }
+
+        const { width, height } = this.videoInfo;
+
+        switch (roi.type) {
+            case 'rect': {
+                const rect = ['x', 'y', 'width', 'height'].map(key => Math.round(roi[key]));
+                if (rect.some(v => !Number.isFinite(v))) {
+                    return { isValid: false, error: 'Rectangle ROI needs numeric x, y, width, height' };
+                }
+                if (rect[2] <= 0 || rect[3] <= 0) {
+                    return { isValid: false, error: 'Rectangle ROI must have positive width and height' };
+                }
+                const [x, y, w, h] = rect;
+                return { isValid: true, roi: { type: 'rect', x, y, width: w, height: h } };
+            }
+
+            case 'polygon': {
+                const points = Array.isArray(roi.points) && Array.isArray(roi.points[0])
+                    ? roi.points.flat()
+                    : Array.from(roi.points || []);
+                if (points.length < 6 || points.length % 2 !== 0 || points.some(v => !Number.isFinite(v))) {
+                    return { isValid: false, error: 'Polygon ROI needs at least 3 numeric x, y points' };
+                }
+                return { isValid: true, roi: { type: 'polygon', points } };
+            }
+
+            case 'mask': {
+                const data = roi.data instanceof Uint8Array ? roi.data : Uint8Array.from(roi.data || []);
+                if (data.length !== width * height) {
+                    return { isValid: false, error: `Mask ROI must have ${width * height} entries (${width}x${height})` };
+                }
+                return { isValid: true, roi: { type: 'mask', data } };
+            }
+
+            default:
+                return { isValid: false, error: "ROI type must be 'rect', 'polygon' or 'mask'" };
+        }
+    }
+
     /**
      * Validate RGB values
      * @param {number} r - Red value
@@ -442,9 +1272,10 @@ class ThermalDataProcessor {
      * Calculate temperature statistics for an array of temperatures
      * @private
      * @param {Array<number>} temperatures - Temperature values
+     * @param {Object} nativeStats - Optional { min, max, mean } already computed by the native engine
      * @returns {Object} Statistics object
      */
-    _calculateTemperatureStatistics(temperatures) {
+    _calculateTemperatureStatistics(temperatures, nativeStats = null) {
         if (!temperatures || temperatures.length === 0) {
             return {
                 count: 0,
@@ -472,11 +1303,12 @@ class ThermalDataProcessor {
             };
         }
 
-        // Calculate basic statistics
-        const min = Math.min(...validTemps);
-        const max = Math.max(...validTemps);
-        const sum = validTemps.reduce((a, b) => a + b, 0);
-        const avg = sum / validTemps.length;
+        // Calculate basic statistics (reuse native min/max/mean when available)
+        const hasNative = nativeStats && !isNaN(nativeStats.mean);
+        const min = hasNative ? nativeStats.min : Math.min(...validTemps);
+        const max = hasNative ? nativeStats.max : Math.max(...validTemps);
+        const avg = hasNative ? nativeStats.mean : validTemps.reduce((a, b) => a + b, 0) / validTemps.length;
+        const sum = avg * validTemps.length;
 
         // Calculate median
         const sortedTemps = [...validTemps].sort((a, b) => a - b);
@@ -545,4 +1377,19 @@ class ThermalDataProcessor {
     }
 }
 
+// Maximum number of thresholds per isotherm request
+ThermalDataProcessor.MAX_ISOTHERM_THRESHOLDS = 16;
+
+// Bilinear line sampling limits (mirror LineSampling in thermal_engine.cpp)
+ThermalDataProcessor.MAX_LINE_SAMPLES = 8192;
+ThermalDataProcessor.MAX_LINE_WIDTH = 64;
+
+// Image formats supported by exportFrame
+ThermalDataProcessor.IMAGE_FORMATS = {
+    jpeg: { codec: 'jpeg', mimeType: 'image/jpeg' },
+    jpg: { codec: 'jpeg', mimeType: 'image/jpeg' },
+    png: { codec: 'png', mimeType: 'image/png' },
+    webp: { codec: 'webp', mimeType: 'image/webp' }
+};
+
 module.exports = ThermalDataProcessor;
\ No newline at end of file
@@ -18,6 +18,7 @@ class ThermalReader {
         this.processingStats = {};
         
         // Thermal-specific properties
+        this.nativeModule = null;
         this.nativeEngine = null;
         this.videoInfo = {};
         this.temperatureMapping = null;
@@ -127,14 +128,14 @@ class ThermalReader {
             
             // Load temperature mapping (global CSV)
             console.log('Loading temperature mapping...');
-            const mappingLoaded = this.nativeEngine.loadTempMapping(this.csvMappingPath);
+            const mappingLoaded = await this.nativeEngine.loadTempMapping(this.csvMappingPath);
             if (!mappingLoaded) {
                 throw new Error('Failed to load temperature mapping');
             }
             
             // Load video file
             console.log('Loading thermal video...');
-            const videoLoaded = this.nativeEngine.loadVideo(this.filename);
+            const videoLoaded = await this.nativeEngine.loadVideo(this.filename);
             if (!videoLoaded) {
                 throw new Error('Failed to load thermal video');
             }
@@ -189,7 +190,11 @@ class ThermalReader {
             let moduleLoaded = false;
             for (const modulePath of possiblePaths) {
                 try {
-                    this.nativeEngine = require(modulePath);
+                    const nativeModule = require(modulePath);
+                    // One engine per reader: calls on it are serialized natively,
+                    // engines of different experiments run in parallel
+                    this.nativeEngine = new nativeModule.ThermalEngine();
+                    this.nativeModule = nativeModule;
                     console.log(`Loaded native thermal engine from: ${modulePath}`);
                     moduleLoaded = true;
                     break;
@@ -235,7 +240,7 @@ class ThermalReader {
             // Thermal-specific metadata
             thermalSpecific: {
                 temperatureMappingLoaded: true,
-                supportedAnalysis: ['line_analysis', 'pixel_temperature'],
+                supportedAnalysis: ['line_analysis', 'pixel_temperature', 'temperature_frame', 'line_over_time', 'frame_stats', 'roi_analysis', 'isotherms', 'frame_export', 'thumbnails', 'temperature_volume'],
                 coordinateSystem: 'pixel_based',
                 frameNavigation: 'frame_based',
                 fileFormat: 'AVI/OpenCV'
@@ -261,6 +266,14 @@ class ThermalReader {
                 capabilities: {
                     lineAnalysis: true,
                     pixelTemperature: true,
+                    temperatureFrame: true,
+                    lineOverTime: true,
+                    frameStats: true,
+                    roiAnalysis: true,
+                    isotherms: true,
+                    frameExport: true,
+                    thumbnails: true,
+                    temperatureVolume: true,
                     frameNavigation: true,
                     realTimeAnalysis: true
                 },
@@ -373,6 +386,47 @@ class ThermalReader {
         return this.nativeEngine;
     }
 
+    /**
+     * Run a long whole-video job on a separate engine instance, so queries on
+     * the reader's engine are not queued behind it. The engine is closed
+     * when the job has finished.
+     * @param {Function} job - async (engine) => result
+     * @returns {Promise<*>} Result of job
+     */
+    async runOnSeparateEngine(job) {
+        if (!this.nativeModule) {
+            throw new Error('Native thermal engine not loaded');
+        }
+
+        const engine = new this.nativeModule.ThermalEngine();
+        try {
+            if (!await engine.loadTempMapping(this.csvMappingPath)) {
+                throw new Error('Failed to load temperature mapping');
+            }
+            if (!await engine.loadVideo(this.filename)) {
+                throw new Error('Failed to load thermal video');
+            }
+
+            return await job(engine);
+        } finally {
+            await engine.close();
+        }
+    }
+
+    /**
+     * Build the precomputed temperature volume of this video on a separate
+     * engine instance. The volume is not attached.
+     * @param {string} volumePath - Output file path
+     * @param {Object} options - { tileSize }
+     * @param {Function} onProgress - Optional (done, total) callback
+     * @returns {Promise<Object>} { path, frames, width, height, tileSize, byteSize, compressionRatio }
+     */
+    async buildTemperatureVolume(volumePath, options = {}, onProgress) {
+        return this.runOnSeparateEngine(
+            engine => engine.buildTemperatureVolume(volumePath, options, onProgress)
+        );
+    }
+
     /**
      * Get video information
      * @returns {Object} Video properties
@@ -399,6 +453,7 @@ class ThermalReader {
         if (this.nativeEngine) {
             // Native engine cleanup is handled by C++ destructor
             this.nativeEngine = null;
+            this.nativeModule = null;
         }
         
         this.calculatedData = {};
@@ -35,6 +35,7 @@ class Acceleration {
             autoLoad: true,
             maxPoints: 6000,  // Higher for acceleration data
             plotHeight: 600,
+            previewInterval: 250,  // ms between preview polls while the CSV is parsed
             colors: {
                 acc_x: '#FF0000',  // Red for X-axis
                 acc_y: '#00FF00',  // Green for Y-axis
@@ -186,6 +187,14 @@ class Acceleration {
                 this.elements.experimentInfo.textContent = `Experiment: ${experimentId} - 3-axis acceleration data`;
             }
             
+            // Rough plot while a large CSV is still being parsed
+            await this.loadPreview();
+            
+            // Check if aborted
+            if (this.abortController.signal.aborted) {
+                return;
+            }
+            
             // Load metadata first
             await this.loadMetadata();
             
@@ -226,6 +235,39 @@ class Acceleration {
         }
     }
     
+    /**
+     * Start parsing the acceleration CSV and draw its coarse overview until
+     * the parse is done; errors are left to loadMetadata to report
+     */
+    async loadPreview() {
+        await CsvPreview.poll(
+            `${this.config.apiBaseUrl}/experiments/${this.state.experimentId}/acc-preview`,
+            this.abortController.signal,
+            this.config.previewInterval,
+            preview => this.drawPreview(preview)
+        );
+    }
+    
+    /**
+     * Plot the min/max band of each axis from a parse preview; createPlot
+     * replaces it with the full plot
+     * @param {Object} preview - { time (µs), channels: { acc_x: { min, max } }, progress }
+     */
+    async drawPreview(preview) {
+        const drawn = await CsvPreview.draw(this.elements.accelerationPlot, preview, {
+            channelIds: ['acc_x', 'acc_y', 'acc_z'],
+            time: preview.time.map(t => t === null ? null : t / 1000000),  // µs to seconds
+            color: channelId => this.config.colors[channelId],
+            name: channelId => `${channelId.replace('acc_', '').toUpperCase()}-Axis`,
+            layout: timeRange => {
+                this.state.currentTimeRange = timeRange;
+                return this.createAccelerationPlotLayout();
+            },
+            config: this.createPlotConfig()
+        });
+        if (drawn) this.showPlot();
+    }
+    
     /**
      * Load acceleration CSV metadata - MODIFIED: Added abort signal support
      */
@@ -35,6 +35,7 @@ class AmbientTemperature {
             autoLoad: true,
             maxPoints: 8000,
             plotHeight: 600,
+            previewInterval: 250,  // ms between preview polls while the CSV is parsed
             colors: {
                 temp_welding: '#D84315',      // Deep orange-red - primary welding temperature
                 temp_channel_1: '#FF5722',    // Orange-red
@@ -190,6 +191,14 @@ class AmbientTemperature {
                 this.elements.experimentInfo.textContent = `Experiment: ${experimentId}`;
             }
             
+            // Rough plot while a large CSV is still being parsed
+            await this.loadPreview();
+            
+            // Check if aborted
+            if (this.abortController.signal.aborted) {
+                return;
+            }
+            
             // Load metadata first
             await this.loadMetadata();
             
@@ -230,6 +239,38 @@ class AmbientTemperature {
         }
     }
     
+    /**
+     * Start parsing the temperature CSV and draw its coarse overview until
+     * the parse is done; errors are left to loadMetadata to report
+     */
+    async loadPreview() {
+        await CsvPreview.poll(
+            `${this.config.apiBaseUrl}/experiments/${this.state.experimentId}/temp-preview`,
+            this.abortController.signal,
+            this.config.previewInterval,
+            preview => this.drawPreview(preview)
+        );
+    }
+    
+    /**
+     * Plot the min/max band of each channel from a parse preview; createPlot
+     * replaces it with the full plot
+     * @param {Object} preview - { time (s), channels: { temp_welding: { min, max } }, progress }
+     */
+    async drawPreview(preview) {
+        const drawn = await CsvPreview.draw(this.elements.temperaturePlot, preview, {
+            channelIds: Object.keys(preview.channels),
+            color: channelId => this.config.colors[channelId] || '#FF6B35', // Fallback warm color
+            name: channelId => channelId,
+            layout: timeRange => {
+                this.state.currentTimeRange = timeRange;
+                return this.createTemperaturePlotLayout();
+            },
+            config: this.createPlotConfig()
+        });
+        if (drawn) this.showPlot();
+    }
+    
     /**
      * Load temperature CSV metadata - MODIFIED: Added abort signal support
      */
@@ -18,6 +18,7 @@ class ThermalIr {
             currentFrame: 0,
             totalFrames: 0, // Dynamic - starts at 0, updated from API
             fps: 0, // Dynamic - starts at 0, updated from API
+            videoTimestamps: null, // Frame timestamp map of the MP4 (null until loaded)
             isPlaying: false,
             
             // Line positions
@@ -239,6 +240,7 @@ class ThermalIr {
         this.state.currentFrame = 0;
         this.state.totalFrames = 0;
         this.state.fps = 0;
+        this.state.videoTimestamps = null;
         this.state.isPlaying = false;
         this.state.dragging = null;
         this.state.lastAnalysisTime = 0;
@@ -318,6 +320,9 @@ class ThermalIr {
                 console.log(`Video source set: ${videoUrl}`);
             }
             
+            // Frame timestamp map in background (resolves once the MP4 exists)
+            this.loadVideoTimestamps(experimentId);
+            
             // Check if aborted
             if (this.abortController.signal.aborted) {
                 return;
@@ -373,6 +378,7 @@ class ThermalIr {
         console.log(`Connecting to WebSocket: ${wsUrl}`);
         
         this.webSocket = new WebSocket(wsUrl);
+        this.webSocket.binaryType = 'arraybuffer'; // Line results arrive as packed Float32 frames
         
         this.webSocket.onopen = () => {
             if (this.abortController?.signal.aborted) {
@@ -411,6 +417,11 @@ class ThermalIr {
     
     handleWebSocketMessage(event) {
         try {
+            if (event.data instanceof ArrayBuffer) {
+                this.handleBinaryAnalysisResult(event.data);
+                return;
+            }
+            
             const message = JSON.parse(event.data);
             
             switch (message.type) {
@@ -737,11 +748,61 @@ class ThermalIr {
         }
     }
     
+    /**
+     * Load the MP4 frame timestamp map written by the video conversion.
+     * Without it (FFmpeg fallback, request failed) frame math uses state.fps.
+     */
+    async loadVideoTimestamps(experimentId) {
+        try {
+            const response = await fetch(
+                `${this.config.apiBaseUrl}/experiments/${experimentId}/thermal/video-timestamps`,
+                { signal: this.abortController?.signal }
+            );
+            if (!response.ok) return;
+            
+            const result = await response.json();
+            if (!result.success || this.state.experimentId !== experimentId) return;
+            
+            // Only native conversions carry a per-frame map
+            if (result.data.fps > 0 && result.data.frames > 0) {
+                this.state.videoTimestamps = result.data;
+                console.log(`Video timestamp map loaded: ${result.data.frames} frames @ ${result.data.fps} FPS`);
+            }
+        } catch (error) {
+            if (error.name !== 'AbortError') {
+                console.warn('Video timestamp map unavailable:', error.message);
+            }
+        }
+    }
+    
+    /**
+     * Frame shown at a video time. MP4 frame i covers [i / fps, (i + 1) / fps).
+     */
+    frameFromVideoTime(time) {
+        const map = this.state.videoTimestamps;
+        const fps = map ? map.fps : this.state.fps;
+        if (!(fps > 0)) return 0;
+        
+        // Small epsilon: currentTime after a seek can sit just below a frame boundary
+        const frame = Math.floor(time * fps + 1e-6);
+        const frameCount = map ? map.frames : this.state.totalFrames;
+        return frameCount > 0 ? Math.max(0, Math.min(frame, frameCount - 1)) : Math.max(0, frame);
+    }
+    
+    /**
+     * Seek target for a frame: its center, so decoders never land on the previous frame
+     */
+    videoTimeForFrame(frameNumber) {
+        const map = this.state.videoTimestamps;
+        const fps = map ? map.fps : this.state.fps;
+        return (frameNumber + 0.5) / fps;
+    }
+    
     handleVideoTimeUpdate() {
         if (!this.video || this.video.duration === 0) return;
         
-        // Calculate current frame using dynamic FPS
-        const currentFrame = Math.floor(this.video.currentTime * this.state.fps);
+        // Calculate current frame from the timestamp map (or dynamic FPS)
+        const currentFrame = this.frameFromVideoTime(this.video.currentTime);
         this.state.currentFrame = currentFrame;
         
         this.updateFrameInfo(currentFrame);
@@ -774,7 +835,7 @@ class ThermalIr {
     seekToFrame(frameNumber) {
         if (!this.video || this.state.fps === 0) return;
         
-        const time = frameNumber / this.state.fps;
+        const time = this.videoTimeForFrame(frameNumber);
         this.video.currentTime = time;
         this.state.currentFrame = frameNumber;
         this.updateFrameInfo(frameNumber);
@@ -838,7 +899,8 @@ class ThermalIr {
         this.sendWebSocketMessage('analyzeLines', {
             experimentId: this.state.experimentId,
             frameNum: this.state.currentFrame,
-            lines: lines
+            lines: lines,
+            format: 'binary'
         });
     }
     
@@ -854,6 +916,40 @@ class ThermalIr {
         };
     }
     
+    /**
+     * Unpack a binary line analysis result into the 'analysisResult' shape
+     * Layout (float32): [lineCount, frameNumber, totalSamples], offsets[lineCount + 1],
+     * stats[lineCount * 3] (min, max, mean), temperatures[totalSamples]
+     */
+    handleBinaryAnalysisResult(buffer) {
+        const packed = new Float32Array(buffer);
+        const lineCount = packed[0];
+        const offsetsStart = 3;
+        const statsStart = offsetsStart + lineCount + 1;
+        const samplesStart = statsStart + lineCount * 3;
+        
+        const results = [];
+        for (let i = 0; i < lineCount; i++) {
+            const from = samplesStart + packed[offsetsStart + i];
+            const to = samplesStart + packed[offsetsStart + i + 1];
+            results.push({
+                success: true,
+                temperatures: Array.from(packed.subarray(from, to)),
+                statistics: {
+                    min: packed[statsStart + i * 3],
+                    max: packed[statsStart + i * 3 + 1],
+                    mean: packed[statsStart + i * 3 + 2]
+                }
+            });
+        }
+        
+        this.handleAnalysisResult({
+            frameNum: packed[1],
+            lineCount: lineCount,
+            results: results
+        });
+    }
+    
     handleAnalysisResult(data) {
         console.log('Analysis result received:', data);
         
@@ -0,0 +1,89 @@
+/**
+ * CsvPreview - Coarse plot of a sensor CSV while the backend parses it
+ * Used by the CSV data modules: they poll their *-preview endpoint and draw
+ * the min/max band of each channel until the full data is loaded.
+ */
+
+const CsvPreview = {
+    /**
+     * Start (or join) parsing and call draw with each preview until the
+     * parse is done; errors are left to the module's metadata request
+     * @param {string} url - Preview endpoint
+     * @param {AbortSignal} signal - Stops polling when aborted
+     * @param {number} interval - ms between polls
+     * @param {Function} draw - async (preview) => void
+     */
+    async poll(url, signal, interval, draw) {
+        while (!signal.aborted) {
+            const response = await fetch(url, { signal });
+            if (!response.ok) return;
+
+            const result = await response.json();
+            if (!result.success || result.data.status !== 'parsing') return;
+
+            if (result.data.preview) {
+                await draw(result.data.preview);
+            }
+
+            await new Promise(resolve => setTimeout(resolve, interval));
+        }
+    },
+
+    /**
+     * Plot the min/max band of each channel; the module's full plot
+     * replaces it later
+     * @param {HTMLElement} plotElement - Plot container
+     * @param {Object} preview - { time, channels: { [channelId]: { min, max } }, progress, rows }
+     * @param {Object} options - { channelIds, time (x values, default preview.time),
+     *        color(channelId), name(channelId), layout(timeRange), config }, where
+     *        layout gets the { min, max } time range drawn and returns the plot layout
+     * @returns {Promise<boolean>} Whether anything was drawn (false if the
+     *          preview has none of the channels yet)
+     */
+    async draw(plotElement, preview, options) {
+        const time = options.time || preview.time;
+        const traces = [];
+
+        for (const channelId of options.channelIds) {
+            const envelope = preview.channels[channelId];
+            if (!envelope) continue;
+
+            const color = options.color(channelId);
+            traces.push({
+                x: time,
+                y: envelope.min,
+                type: 'scatter',
+                mode: 'lines',
+                line: { color: color, width: 1 },
+                showlegend: false,
+                hoverinfo: 'skip'
+            }, {
+                x: time,
+                y: envelope.max,
+                type: 'scatter',
+                mode: 'lines',
+                fill: 'tonexty',
+                name: `${options.name(channelId)} (preview)`,
+                line: { color: color, width: 1 },
+                hoverinfo: 'skip'
+            });
+        }
+        if (traces.length === 0) return false;
+
+        const finite = time.filter(t => t !== null);
+        const layout = options.layout({
+            min: finite.length ? finite[0] : 0,
+            max: finite.length ? finite[finite.length - 1] : 0
+        });
+        layout.title = {
+            text: `Parsing… ${Math.round(preview.progress * 100)}% (${preview.rows.toLocaleString()} rows)`,
+            font: { size: 14, color: '#666666' }
+        };
+
+        await Plotly.react(plotElement, traces, layout, options.config);
+        return true;
+    }
+};
+
+// Export for global access
+window.CsvPreview = CsvPreview;